@@ -24,6 +24,7 @@
 
 
 #include <aspect/adiabatic_conditions/interface.h>
+#include <aspect/utilities.h>
 
 #include <deal.II/base/parsed_function.h>
 
@@ -67,7 +68,8 @@ namespace aspect
         /**
          * Update function. By default does nothing, but if a time-dependent
          * surface condition function is used, this will reinitialize the
-         * adiabatic profile with the current conditions.
+         * adiabatic profile with the current conditions, if they differ
+         * from the ones the profile was computed with.
          */
         virtual void update ();
 
@@ -128,6 +130,20 @@ namespace aspect
          */
         unsigned int n_points;
 
+        /**
+         * An enum describing the methods to integrate the profile in depth.
+         */
+        enum IntegrationScheme
+        {
+          euler,
+          heun
+        };
+
+        /**
+         * The method used to integrate the profile in depth.
+         */
+        IntegrationScheme integration_scheme;
+
         /**
          * Vectors of values of temperatures and pressures on a transect into
          * depth at which we have computed them. The public member functions
@@ -137,6 +153,16 @@ namespace aspect
         std::vector<double> pressures;
         std::vector<double> densities;
 
+        /**
+         * The same values as above, in a form that allows to interpolate them
+         * efficiently. These are only set once the profile has been computed,
+         * until then the public member functions of this class use
+         * get_property() instead.
+         */
+        Utilities::UniformDepthProfile temperature_profile;
+        Utilities::UniformDepthProfile pressure_profile;
+        Utilities::UniformDepthProfile density_profile;
+
         /**
          * Interval spacing between each two data points in the tables above
          * with regard to the depth coordinate.
@@ -168,7 +194,7 @@ namespace aspect
          * Whether to use the surface_conditions_function to determine surface
          * conditions, or the adiabatic_surface_temperature and surface_pressure
          * parameters. If this is set to true the reference profile is updated
-         * every timestep.
+         * in every timestep in which the surface conditions change.
          */
         bool use_surface_condition_function;
 
@@ -178,6 +204,14 @@ namespace aspect
          */
         Functions::ParsedFunction<1> surface_condition_function;
 
+        /**
+         * Compute the values of temperature, pressure, and density at all
+         * points of the profile. This function is only called on the root
+         * process, initialize() then sends the profile to all other
+         * processes.
+         */
+        void compute_profile ();
+
         /**
          * Internal helper function. Returns the reference property at a
          * given point of the domain.
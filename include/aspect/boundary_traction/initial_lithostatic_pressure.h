@@ -24,6 +24,7 @@
 
 #include <aspect/boundary_traction/interface.h>
 #include <aspect/simulator_access.h>
+#include <aspect/utilities.h>
 
 
 namespace aspect
@@ -62,6 +63,17 @@ namespace aspect
         traction (const Point<dim> &position,
                   const Tensor<1,dim> &normal_vector) const;
 
+        /**
+         * Compute the boundary traction at all of the given positions at
+         * once, without a virtual function call per point.
+         */
+        virtual
+        void
+        boundary_tractions (const types::boundary_id boundary_indicator,
+                            const std::vector<Point<dim> > &positions,
+                            const std::vector<Tensor<1,dim> > &normal_vectors,
+                            std::vector<Tensor<1,dim> > &tractions) const;
+
 
         /**
          * Declare the parameters this class takes through input files.
@@ -97,17 +109,10 @@ namespace aspect
         Point<dim> representative_point;
 
         /**
-         * The computed lithostatic pressure profile.
+         * The computed lithostatic pressure profile, which is linearly
+         * interpolated in depth.
          */
-        std::vector<double> pressure;
-
-        /**
-         * Return the lithostatic pressure at a given point of the domain
-         * based on depth interpolation between computed pressure values.
-         */
-        double interpolate_pressure (const Point<dim> &p) const;
-
-
+        Utilities::UniformDepthProfile pressure_profile;
     };
   }
 }
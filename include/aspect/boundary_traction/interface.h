@@ -102,6 +102,22 @@ namespace aspect
                            const Point<dim> &position,
                            const Tensor<1,dim> &normal_vector) const;
 
+        /**
+         * Compute the boundary traction at all of the given @p positions,
+         * with the (outward) normal vectors @p normal_vectors, and store
+         * them in @p tractions, which already has the correct size. This
+         * function is used to assemble the traction boundary terms for all
+         * quadrature points of a face at once. The default implementation
+         * calls boundary_traction() for each point, but derived classes can
+         * overload it with a more efficient implementation.
+         */
+        virtual
+        void
+        boundary_tractions (const types::boundary_id boundary_indicator,
+                            const std::vector<Point<dim> > &positions,
+                            const std::vector<Tensor<1,dim> > &normal_vectors,
+                            std::vector<Tensor<1,dim> > &tractions) const;
+
         /**
          * Declare the parameters this class takes through input files. The
          * default implementation of this function does not describe any
@@ -27,7 +27,11 @@
 #include <aspect/compat.h>
 
 #include <array>
-#include <deal.II/base/function_lib.h>
+#include <map>
+#include <deal.II/base/table.h>
+#include <deal.II/base/thread_local_storage.h>
+
+#include <boost/signals2/connection.hpp>
 
 
 namespace aspect
@@ -62,12 +66,64 @@ namespace aspect
                         const Tensor<1,2> &surface_point_two) const;
 
           /**
-           * Loads a gplates .gpml velocity file. Throws an exception if the
-           * file does not exist.
+           * The information that is needed to look up the velocity at a
+           * given position in the lat/long grid, which only depends on the
+           * position and the size of the grid, but not on the velocities
+           * stored in it. It therefore can be computed once and reused for
+           * all data files with the same grid.
+           *
+           * The velocity is interpolated bilinearly at up to two points of
+           * the grid (two are needed close to the poles, see
+           * surface_velocity()). For each of these points, the stencil
+           * stores the grid cell that contains it, the interpolation
+           * weights of the four vertices of the cell, and the model
+           * velocities that correspond to a unit velocity in theta and phi
+           * direction, scaled by the weight of this point.
+           */
+          struct SurfacePointStencil
+          {
+            unsigned int n_points;
+            std::array<std::array<unsigned int,2>,2> cell;
+            std::array<std::array<double,4>,2> weights;
+            std::array<std::array<Tensor<1,dim>,2>,2> unit_velocities;
+          };
+
+          /**
+           * Loads a gplates velocity file, either in the .gpml format written
+           * by GPlates, or in the binary format written by
+           * write_binary_file(). The format is determined from the content
+           * of the file. Throws an exception if the file does not exist.
            */
           void load_file(const std::string &filename,
                          const MPI_Comm &comm);
 
+          /**
+           * Write the currently loaded velocities into a file in a binary
+           * format that can be read by load_file() much faster than a .gpml
+           * file. The file contains a header identifying the format, the
+           * number of grid points in theta and phi direction as 32 bit
+           * unsigned integers, and the theta and phi velocities in m/s at
+           * all grid points as doubles, with the phi index running
+           * fastest. The file uses the byte order of the machine it is
+           * written on. Only the root process of @p comm writes the file.
+           */
+          void write_binary_file(const std::string &filename,
+                                 const MPI_Comm &comm) const;
+
+          /**
+           * Return whether this object and @p other use grids of the same
+           * size, in which case they can share their SurfacePointStencil
+           * objects.
+           */
+          bool has_same_grid(const GPlatesLookup<dim> &other) const;
+
+          /**
+           * Compute the stencil that is needed to look up the velocity at
+           * @p position.
+           */
+          SurfacePointStencil
+          compute_stencil(const Point<dim> &position) const;
+
           /**
            * Returns the computed surface velocity in cartesian coordinates.
            * Takes as input the position. Actual velocity interpolation is
@@ -77,11 +133,19 @@ namespace aspect
            */
           Tensor<1,dim> surface_velocity(const Point<dim> &position) const;
 
+          /**
+           * Same as above, but use a stencil previously computed by
+           * compute_stencil().
+           */
+          Tensor<1,dim> surface_velocity(const SurfacePointStencil &stencil) const;
+
         private:
           /**
-           * Interpolation functions to access the velocities.
+           * The velocities at the points of the lat/long grid, with the theta
+           * component in the first and the phi component in the second
+           * entry of each tensor.
            */
-          std::array<std::unique_ptr<typename Functions::InterpolatedUniformGridData<2> >, 2> velocities;
+          Table<2,Tensor<1,2> > velocity_values;
 
           /**
            * Distances between adjacent point in the Lat/Long grid
@@ -139,11 +203,16 @@ namespace aspect
           cartesian_surface_coordinates(const Tensor<1,3> &sposition) const;
 
           /**
-           * This function looks up the north- and east-velocities at a given
-           * position and converts them to cartesian velocities.
+           * Add the point with the given spherical coordinates to
+           * @p stencil, i.e., compute the grid cell in which the north- and
+           * east-velocities need to be interpolated at this point, and how
+           * they are converted to cartesian velocities. The contribution of
+           * this point to the velocity is scaled by @p weight.
            */
-          Tensor<1,dim>
-          cartesian_velocity_at_surface_point(const std::array<double,3> &spherical_point) const;
+          void
+          add_point_to_stencil(const std::array<double,3> &spherical_point,
+                               const double weight,
+                               SurfacePointStencil &stencil) const;
 
           /**
            * Returns cartesian velocities calculated from surface velocities
@@ -183,6 +252,12 @@ namespace aspect
          */
         GPlates ();
 
+        /**
+         * Destructor. Disconnects this object from the signals of the
+         * triangulation.
+         */
+        ~GPlates ();
+
         /**
          * Return the boundary velocity as a function of position. For the
          * current class, this function returns value from gplates.
@@ -292,6 +367,13 @@ namespace aspect
          */
         double scale_factor;
 
+        /**
+         * Whether every velocity file that is read in the .gpml format
+         * should also be written in the binary format of
+         * internal::GPlatesLookup::write_binary_file().
+         */
+        bool write_binary_files;
+
         /**
          * Two user defined points that prescribe the plane from which the 2D
          * model takes the velocity boundary condition. One can think of this,
@@ -329,6 +411,50 @@ namespace aspect
          */
         std::shared_ptr<internal::GPlatesLookup<dim> > old_lookup;
 
+        /**
+         * Compares two points lexicographically, so that they can be used as
+         * keys of a std::map.
+         */
+        struct PointComparator
+        {
+          bool operator() (const Point<dim> &p1, const Point<dim> &p2) const;
+        };
+
+        /**
+         * For every position at which the boundary velocity has been
+         * requested since the mesh last changed, whether the position is
+         * located within the lithosphere, and the stencil that is needed to
+         * look up its velocity. Since the boundary velocity is evaluated at
+         * the same support points every time step, this avoids recomputing
+         * the rotation and the spherical coordinates of these points. The
+         * stencils are only used if lookup and old_lookup use grids of the
+         * same size.
+         *
+         * Every thread has its own cache, so that boundary_velocity() can
+         * be called from several threads at once without any locking. The
+         * caches are cleared whenever the mesh is refined, and at the
+         * beginning of every time step if the mesh is deformed (e.g., by a
+         * free surface), since the support points move in that case.
+         */
+        mutable Threads::ThreadLocalStorage<std::map<Point<dim>,
+                std::pair<bool,typename internal::GPlatesLookup<dim>::SurfacePointStencil>,
+                PointComparator> > stencil_cache;
+
+        /**
+         * The connection of the function that clears stencil_cache to the
+         * post_refinement signal of the triangulation. Since the function
+         * refers to this object, it has to be disconnected when this object
+         * is destroyed.
+         */
+        boost::signals2::connection post_refinement_connection;
+
+        /**
+         * Load the velocity file @p filename into @p lookup, and write it
+         * in binary format if requested.
+         */
+        void
+        load_file (const std::string &filename);
+
         /**
          * Handles the update of the velocity data in lookup. The input
          * parameter makes sure that both velocity files (n and n+1) can be
@@ -0,0 +1,229 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _aspect_cell_cost_model_h
+#define _aspect_cell_cost_model_h
+
+#include <aspect/simulator_access.h>
+
+#include <deal.II/base/parameter_handler.h>
+#include <deal.II/base/table_handler.h>
+#include <deal.II/distributed/tria.h>
+
+#include <array>
+#include <chrono>
+
+namespace aspect
+{
+  using namespace dealii;
+
+  /**
+   * A class that measures how expensive each locally owned cell is to
+   * assemble (including the evaluation of the material model and all other
+   * plugins called from within the assemblers), and that uses these
+   * measurements to weight cells when the mesh is repartitioned between
+   * processes. Cells are additionally sorted into categories (regular cells,
+   * cells in which melt transport is active, and cells adjacent to a free
+   * surface), and the average measured cost per category is used for cells
+   * that have not been measured yet, for example because they were just
+   * created by refinement.
+   *
+   * The class also computes the load imbalance between processes in each
+   * time step, writes it into the statistics file, and can request that the
+   * mesh is repartitioned without refinement if the imbalance exceeds a
+   * given threshold.
+   *
+   * @ingroup Simulator
+   */
+  template <int dim>
+  class CellCostModel : public SimulatorAccess<dim>
+  {
+    public:
+      /**
+       * The categories cells are sorted into.
+       */
+      enum Category
+      {
+        regular_cell,
+        melt_cell,
+        free_surface_cell,
+        n_categories
+      };
+
+      /**
+       * A class that measures the time spent between its construction and
+       * destruction and attributes it to the cell given to the constructor.
+       * Objects of this type are used to wrap the local assembly functions.
+       * If the cell cost model is disabled, or if @p active is false
+       * because the assembly is not part of the regular work of a time step,
+       * this class does nothing.
+       */
+      class ScopedCellTimer
+      {
+        public:
+          ScopedCellTimer (CellCostModel<dim> &cost_model,
+                           const typename DoFHandler<dim>::active_cell_iterator &cell,
+                           const bool active = true);
+
+          ~ScopedCellTimer ();
+
+        private:
+          CellCostModel<dim> &cost_model;
+          const typename DoFHandler<dim>::active_cell_iterator cell;
+          const bool active;
+          const std::chrono::steady_clock::time_point start_time;
+      };
+
+      /**
+       * Constructor.
+       */
+      CellCostModel ();
+
+      /**
+       * Declare the parameters this class takes through input files.
+       */
+      static
+      void
+      declare_parameters (ParameterHandler &prm);
+
+      /**
+       * Read the parameters this class declares from the parameter file.
+       */
+      void
+      parse_parameters (ParameterHandler &prm);
+
+      /**
+       * Connect the cell weight function of this class to the triangulation,
+       * if the cost model is enabled.
+       */
+      void
+      initialize ();
+
+      /**
+       * Return whether the cost model is enabled in the input file.
+       */
+      bool
+      is_enabled () const;
+
+      /**
+       * Discard all measured cell costs and resize the internal data
+       * structures for the current mesh. This function has to be called
+       * after every change of the mesh.
+       */
+      void
+      reinit ();
+
+      /**
+       * Attribute the time @p seconds to the cell @p cell. This function
+       * may be called concurrently from several threads as long as they
+       * work on different cells.
+       */
+      void
+      add_cell_cost (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                     const double seconds);
+
+      /**
+       * Finish the measurement of the current time step: update the
+       * average cost per cell category, compute the load imbalance
+       * between processes and, if requested, write these numbers into
+       * @p statistics.
+       */
+      void
+      end_timestep (TableHandler &statistics);
+
+      /**
+       * Return whether the load imbalance measured in the last time step
+       * exceeds the threshold given in the input file, in which case the
+       * mesh should be repartitioned even if it is not refined.
+       */
+      bool
+      rebalancing_requested () const;
+
+      /**
+       * The function connected to the cell_weight signal of the
+       * triangulation. It returns the additional weight of @p cell in units
+       * in which a cell with the reference cost (the average cost of a
+       * regular cell) has a weight of 1000.
+       */
+      unsigned int
+      cell_weight (const typename parallel::distributed::Triangulation<dim>::cell_iterator &cell,
+                   const typename parallel::distributed::Triangulation<dim>::CellStatus status) const;
+
+    private:
+      /**
+       * Return the category of the active cell @p cell.
+       */
+      Category
+      get_category (const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+      /**
+       * Return the measured cost of the active cell @p cell, or the
+       * average cost of its category if the cell has not been measured.
+       */
+      double
+      get_cell_cost (const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+      /**
+       * Whether the cost model is used at all.
+       */
+      bool enabled;
+
+      /**
+       * The relative load imbalance (maximal process cost divided by the
+       * average process cost, minus one) above which the mesh is
+       * repartitioned without refinement. A value of zero disables
+       * rebalancing.
+       */
+      double imbalance_threshold;
+
+      /**
+       * Whether to write the load imbalance statistics into the
+       * statistics file.
+       */
+      bool write_statistics;
+
+      /**
+       * The accumulated cost of each locally owned active cell since the
+       * last call to reinit(), indexed by the active cell index.
+       */
+      std::vector<double> cell_costs;
+
+      /**
+       * The cost of all locally owned cells measured in the current time
+       * step.
+       */
+      std::vector<double> cell_costs_in_timestep;
+
+      /**
+       * The globally averaged cost of a cell in each category, as
+       * computed in the last call to end_timestep().
+       */
+      std::array<double,n_categories> category_costs;
+
+      /**
+       * The relative load imbalance measured in the last time step.
+       */
+      double last_imbalance;
+  };
+}
+
+
+#endif
@@ -0,0 +1,172 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _aspect_cell_locator_h
+#define _aspect_cell_locator_h
+
+#include <aspect/simulator_access.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace aspect
+{
+  using namespace dealii;
+
+  /**
+   * A class that finds the cell of the mesh that contains a given point,
+   * among the locally owned and ghost cells of the current process. It is
+   * used where many points need to be located, for example when particles
+   * are generated at given positions, and replaces calls to
+   * GridTools::find_active_cell_around_point(), which start with a search
+   * over all vertices of the triangulation for every point.
+   *
+   * To this end, the class sorts the bounding boxes of all locally owned
+   * and ghost cells into the buckets of a regular grid that covers them.
+   * A query then only has to check the few cells whose bounding boxes
+   * overlap the bucket of the point, and points that are not in the part
+   * of the domain known to this process are rejected by a comparison with
+   * the bounding box of all cells. The buckets are computed when the class
+   * is first used after a change of the mesh.
+   *
+   * If a point lies on a face or vertex shared by several cells, the cell
+   * with the smallest CellId is returned. Since the CellId of a cell is the
+   * same on all processes, all processes that know these cells agree on the
+   * cell a point is located in, and for example generate a particle on a
+   * face only once.
+   *
+   * @ingroup Simulator
+   */
+  template <int dim>
+  class CellLocator : public SimulatorAccess<dim>
+  {
+    public:
+      typedef typename parallel::distributed::Triangulation<dim>::active_cell_iterator active_cell_iterator;
+
+      /**
+       * Constructor.
+       */
+      CellLocator ();
+
+      /**
+       * Discard the buckets. This function has to be called after every
+       * change of the mesh, including deformations of the mesh.
+       */
+      void
+      clear ();
+
+      /**
+       * Return the locally owned or ghost cell that contains @p point, and
+       * the coordinates of the point on the reference cell. If no such cell
+       * exists, the returned iterator is invalid, i.e., its
+       * <code>state()</code> is not IteratorState::valid.
+       *
+       * If the point is known to be close to a certain cell, e.g., because
+       * the previous point was located in it, this cell can be given as
+       * @p hint and is tested first.
+       */
+      std::pair<active_cell_iterator, Point<dim> >
+      find_cell_around_point (const Point<dim> &point,
+                              const active_cell_iterator &hint = active_cell_iterator()) const;
+
+      /**
+       * Same as above for all of the given @p points. Each point is first
+       * tested against the cell of the previous point, which makes this
+       * function efficient for sequences of points that are close to each
+       * other.
+       */
+      void
+      find_cells_around_points (const std::vector<Point<dim> > &points,
+                                std::vector<std::pair<active_cell_iterator, Point<dim> > > &cells) const;
+
+    private:
+      /**
+       * The bounding box of one cell, enlarged to also contain the parts of
+       * curved cells that bulge out of the bounding box of their vertices.
+       */
+      struct CellBox
+      {
+        active_cell_iterator cell;
+        Point<dim>           lower_corner;
+        Point<dim>           upper_corner;
+      };
+
+      /**
+       * Whether the buckets below are up to date, and a mutex that protects
+       * them while they are computed.
+       */
+      mutable std::atomic<bool> is_built;
+      mutable std::mutex        build_mutex;
+
+      /**
+       * The boxes of all locally owned and ghost cells.
+       */
+      mutable std::vector<CellBox> cell_boxes;
+
+      /**
+       * The bounding box of all cells, and the number and size of the
+       * buckets in each coordinate direction.
+       */
+      mutable Point<dim>                      lower_corner;
+      mutable Point<dim>                      upper_corner;
+      mutable std::array<unsigned int,dim>    n_buckets;
+      mutable Tensor<1,dim>                   one_over_bucket_size;
+
+      /**
+       * The indices into #cell_boxes of the cells that overlap each bucket,
+       * in compressed form: the cells of bucket <code>b</code> are
+       * <code>bucket_cells[bucket_start[b]] ... bucket_cells[bucket_start[b+1]-1]</code>.
+       */
+      mutable std::vector<unsigned int> bucket_start;
+      mutable std::vector<unsigned int> bucket_cells;
+
+      /**
+       * Compute the buckets for the current mesh if necessary.
+       */
+      void
+      build () const;
+
+      /**
+       * Return the index of the bucket in coordinate direction @p d that
+       * contains the coordinate @p x, clamped to the valid range.
+       */
+      unsigned int
+      bucket_index (const double x,
+                    const unsigned int d) const;
+
+      /**
+       * Compute the coordinates of @p point on the reference cell of
+       * @p cell, and return whether the point is inside the cell up to the
+       * tolerance @p tolerance (in reference coordinates).
+       */
+      bool
+      point_is_in_cell (const Point<dim> &point,
+                        const active_cell_iterator &cell,
+                        const double tolerance,
+                        Point<dim> &unit_point) const;
+  };
+}
+
+
+#endif
@@ -73,10 +73,31 @@ namespace aspect
 
         /**
          * Return the initial composition as a function of position.
+         *
+         * This function and initial_compositions() are called for the
+         * support points of different cells from several threads at the same
+         * time (see
+         * Simulator::set_initial_temperature_and_compositional_fields()),
+         * and implementations must therefore be thread-safe. In particular,
+         * they must not modify any member variables, including ones that
+         * are declared <code>mutable</code> to cache values.
          */
         virtual
         double initial_composition (const Point<dim> &position, const unsigned int n_comp) const = 0;
 
+        /**
+         * Return the initial values of all compositional fields as a
+         * function of position. @p compositions needs to have one entry per
+         * compositional field. The default implementation calls
+         * initial_composition() once for each field, but plugins that can
+         * compute all fields at once more cheaply than one at a time should
+         * overload it. Like initial_composition(), this function must be
+         * thread-safe.
+         */
+        virtual
+        void initial_compositions (const Point<dim> &position,
+                                   std::vector<double> &compositions) const;
+
 
         /**
          * Declare the parameters this class takes through input files. The
@@ -143,6 +164,18 @@ namespace aspect
         initial_composition (const Point<dim> &position,
                              const unsigned int n_comp) const;
 
+        /**
+         * A function that calls the initial_compositions functions of all
+         * individual initial composition objects and combines their values
+         * for each compositional field in the same way as
+         * initial_composition() does. @p compositions needs to have one entry
+         * per compositional field. Like the functions it calls, this function
+         * may be called from several threads at the same time.
+         */
+        void
+        initial_compositions (const Point<dim> &position,
+                              std::vector<double> &compositions) const;
+
         /**
          * A function that is used to register initial composition objects in
          * such a way that the Manager can deal with all of them without having
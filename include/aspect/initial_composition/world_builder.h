@@ -50,6 +50,15 @@ namespace aspect
         virtual
         double initial_composition (const Point<dim> &position, const unsigned int n_comp) const;
 
+        /**
+         * Return the initial values of all compositional fields as a
+         * function of position. This computes the depth of the point only
+         * once for all fields.
+         */
+        virtual
+        void initial_compositions (const Point<dim> &position,
+                                   std::vector<double> &compositions) const;
+
     };
   }
 }
@@ -73,6 +73,13 @@ namespace aspect
 
         /**
          * Return the initial temperature as a function of position.
+         *
+         * This function is called for the support points of different
+         * cells from several threads at the same time (see
+         * Simulator::set_initial_temperature_and_compositional_fields()),
+         * and implementations must therefore be thread-safe. In particular,
+         * they must not modify any member variables, including ones that
+         * are declared <code>mutable</code> to cache values.
          */
         virtual
         double initial_temperature (const Point<dim> &position) const = 0;
@@ -135,7 +142,8 @@ namespace aspect
         /**
          * A function that calls the initial_temperature functions of all the
          * individual initial condition objects and adds up the values of the
-         * individual calls.
+         * individual calls. Like the functions it calls, this function may
+         * be called from several threads at the same time.
          */
         double
         initial_temperature (const Point<dim> &position) const;
@@ -66,6 +66,16 @@ namespace aspect
         void
         evaluate (const typename Interface<dim>::MaterialModelInputs &in,
                   typename Interface<dim>::MaterialModelOutputs &out) const;
+
+        /**
+         * Function to compute the material properties in @p out for all
+         * points of the batch @p in. This evaluates the base model for the
+         * whole batch, and then scales the viscosities.
+         */
+        virtual
+        void
+        evaluate_batch (const MaterialModel::MaterialModelBatchInputs<dim> &in,
+                        MaterialModel::MaterialModelOutputs<dim> &out) const;
         /**
          * Method to declare parameters related to depth-dependent model
          */
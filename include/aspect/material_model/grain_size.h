@@ -132,6 +132,45 @@ namespace aspect
                                const std::vector<double> &pressures,
                                const unsigned int n_substeps = 1) const;
 
+          /**
+           * Compute tables of the derivatives of the enthalpy with respect to
+           * temperature and pressure at the points of the material table,
+           * using centered finite differences, and smooth them by averaging
+           * over a box of 2 @p smoothing_width + 1 table points in each
+           * direction. Averaging the derivative over a box is the same as
+           * taking the difference quotient of the enthalpy across the box,
+           * so this has a similar effect to the averaging over all pairs of
+           * points in enthalpy_derivatives(), but only has to be done once
+           * when the table is read.
+           */
+          void
+          compute_smoothed_enthalpy_derivatives (const unsigned int smoothing_width);
+
+          /**
+           * Return whether compute_smoothed_enthalpy_derivatives() has been
+           * called.
+           */
+          bool
+          has_smoothed_enthalpy_derivatives () const;
+
+          /**
+           * Compute the enthalpy derivatives for temperature and pressure
+           * averaged over the given set of temperature and pressure points
+           * by interpolating in the tables computed by
+           * compute_smoothed_enthalpy_derivatives(). The return value has
+           * the same form as the one of enthalpy_derivatives(), and can be
+           * used as a replacement for it, but the cost of this function is
+           * only linear in the number of points. Only points within the
+           * temperature and pressure range of the table are taken into
+           * account, and the number of these points is returned as the
+           * number of samples. If it is zero, the returned derivatives are
+           * zero as well, and callers have to compute them in a different
+           * way.
+           */
+          std::array<std::pair<double, unsigned int>,2>
+          smoothed_enthalpy_derivatives (const std::vector<double> &temperatures,
+                                         const std::vector<double> &pressures) const;
+
           double
           dRhodp (const double temperature,
                   const double pressure) const;
@@ -174,6 +213,14 @@ namespace aspect
           dealii::Table<2,double> vs_values;
           dealii::Table<2,double> enthalpy_values;
 
+          /**
+           * The smoothed derivatives of the enthalpy with respect to
+           * temperature and pressure. These tables are empty unless
+           * compute_smoothed_enthalpy_derivatives() has been called.
+           */
+          dealii::Table<2,double> smoothed_dHdT_values;
+          dealii::Table<2,double> smoothed_dHdp_values;
+
           double delta_press;
           double min_press;
           double max_press;
@@ -377,6 +424,17 @@ namespace aspect
         double min_thermal_expansivity;
         double max_thermal_expansivity;
         unsigned int max_latent_heat_substeps;
+
+        /**
+         * Whether to compute the cell-averaged enthalpy derivatives from
+         * smoothed derivative tables that are computed once from the
+         * material table, rather than from finite differences between all
+         * pairs of points in the cell, and the half width (in table points)
+         * of the smoothing box.
+         */
+        bool use_smoothed_enthalpy_derivatives;
+        unsigned int enthalpy_derivative_smoothing_width;
+
         double min_grain_size;
         double pv_grain_size_scaling;
 
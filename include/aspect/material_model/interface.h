@@ -356,6 +356,102 @@ namespace aspect
     };
 
 
+    /**
+     * A data structure that contains the inputs of the
+     * MaterialModel::Interface::evaluate_batch() function, i.e., the
+     * inputs for the points of many cells at once. In contrast to
+     * MaterialModelInputs, the compositional fields are stored with the
+     * field index first, so that the values of each field at all points
+     * are contiguous in memory, and all other vectors have one entry per
+     * point of all cells.
+     *
+     * Batches are built by calling add_cell() once for every cell, and
+     * can be reused for the next batch after calling clear(), which keeps
+     * the allocated memory.
+     */
+    template <int dim>
+    struct MaterialModelBatchInputs
+    {
+        /**
+         * Constructor. Create an empty batch for the given number of
+         * compositional fields.
+         */
+        explicit MaterialModelBatchInputs (const unsigned int n_comp);
+
+        /**
+         * Remove all points from the batch.
+         */
+        void clear ();
+
+        /**
+         * Append the quadrature points of @p fe_values, which has to be
+         * initialized for @p cell, and the values of @p solution_vector at
+         * these points to the batch. If @p use_strain_rate is false, no
+         * strain rates are stored, which indicates that the viscosity does
+         * not need to be computed. It has to have the same value for all
+         * cells of a batch.
+         */
+        void add_cell (const FEValuesBase<dim,dim> &fe_values,
+                       const typename DoFHandler<dim>::active_cell_iterator &cell,
+                       const Introspection<dim> &introspection,
+                       const LinearAlgebra::BlockVector &solution_vector,
+                       const bool use_strain_rate = true);
+
+        /**
+         * Copy the inputs of the @p cell_index th cell of the batch into
+         * @p cell_inputs, whose size has to match the number of points of this
+         * cell. This is used to evaluate material models that do not
+         * implement the batched interface.
+         */
+        void get_cell_inputs (const unsigned int cell_index,
+                              MaterialModelInputs<dim> &cell_inputs) const;
+
+        /**
+         * Return the number of points in the batch.
+         */
+        unsigned int n_points () const;
+
+        /**
+         * Return the number of cells in the batch.
+         */
+        unsigned int n_cells () const;
+
+        /**
+         * The positions, temperatures, pressures, pressure gradients,
+         * velocities, and strain rates of all points of the batch. The strain
+         * rate vector is empty if the viscosity does not need to be computed.
+         */
+        std::vector<Point<dim> > position;
+        std::vector<double> temperature;
+        std::vector<double> pressure;
+        std::vector<Tensor<1,dim> > pressure_gradient;
+        std::vector<Tensor<1,dim> > velocity;
+        std::vector<SymmetricTensor<2,dim> > strain_rate;
+
+        /**
+         * Values of the compositional fields at all points of the batch.
+         * composition[c][i] is the value of field c at point i.
+         */
+        std::vector<std::vector<double> > composition;
+
+        /**
+         * The cells the points belong to, and for each cell the index of its
+         * first point. The last entry of @p cell_offsets is the total number
+         * of points.
+         */
+        std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+        std::vector<unsigned int> cell_offsets;
+
+      private:
+        /**
+         * Scratch arrays for the values of a single cell.
+         */
+        std::vector<double> scalar_values;
+        std::vector<Tensor<1,dim> > vector_values;
+        std::vector<SymmetricTensor<2,dim> > symmetric_gradients;
+    };
+
+
     template <int dim>     class AdditionalMaterialOutputs;
 
 
@@ -572,6 +668,11 @@ namespace aspect
        * Given the averaging @p operation, a description of where the
        * quadrature points are located on the given cell, and a mapping,
        * perform this operation on all elements of the @p values structure.
+       *
+       * For the project_to_Q1 operation, the projection matrices of cells
+       * that are parallelograms or parallelepipeds only depend on the
+       * quadrature formula, and are therefore only computed once per
+       * quadrature formula and thread.
        */
       template <int dim>
       void average (const AveragingOperation operation,
@@ -589,6 +690,50 @@ namespace aspect
                              const FullMatrix<double>      &projection_matrix,
                              const FullMatrix<double>      &expansion_matrix,
                              std::vector<double>           &values_out);
+
+      /**
+       * Compute the matrices $M^{-1}F$ (the @p projection_matrix) and $E$
+       * (the @p expansion_matrix) that describe the project_to_Q1
+       * operation on the given cell for the given quadrature formula and
+       * mapping: $M^{-1}F$ projects values at the quadrature points onto
+       * the nodal values of a $Q_1$ function, and $E$ evaluates a $Q_1$
+       * function at the quadrature points.
+       */
+      template <int dim>
+      void compute_projection_matrix (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                                      const Quadrature<dim>   &quadrature_formula,
+                                      const Mapping<dim>      &mapping,
+                                      FullMatrix<double>      &projection_matrix,
+                                      FullMatrix<double>      &expansion_matrix);
+
+      /**
+       * The projection and expansion matrices of the project_to_Q1
+       * operation for affine cells, for one quadrature formula.
+       */
+      template <int dim>
+      struct AffineProjectionMatrices
+      {
+        std::vector<Point<dim> > quadrature_points;
+        std::vector<double>      quadrature_weights;
+        FullMatrix<double>       projection_matrix;
+        FullMatrix<double>       expansion_matrix;
+      };
+
+      /**
+       * Return the projection and expansion matrices for the affine cell
+       * @p cell, i.e., for a cell that is a parallelogram or
+       * parallelepiped. For affine cells, the Jacobian determinant is the
+       * same at all quadrature points, and it cancels in the product
+       * $M^{-1}F$, so the matrices computed by compute_projection_matrix()
+       * only depend on the quadrature formula. Consequently, this function
+       * computes them once per quadrature formula and thread, and returns
+       * the same matrices for all other affine cells.
+       */
+      template <int dim>
+      const AffineProjectionMatrices<dim> &
+      get_affine_projection_matrices (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                                      const Quadrature<dim>   &quadrature_formula,
+                                      const Mapping<dim>      &mapping);
     }
 
 
@@ -1034,6 +1179,27 @@ namespace aspect
         virtual
         void evaluate (const MaterialModel::MaterialModelInputs<dim> &in,
                        MaterialModel::MaterialModelOutputs<dim> &out) const = 0;
+
+        /**
+         * Function to compute the material properties in @p out for all
+         * points of the batch @p in, which may span many cells. @p out has
+         * to have the size of the batch. If
+         * MaterialModelBatchInputs::strain_rate has the length 0, then the
+         * viscosity does not need to be computed.
+         *
+         * The default implementation calls evaluate() once for every cell
+         * of the batch, which gives the same results as evaluating the
+         * cells one by one. Models whose properties only depend on the
+         * point values can overload this function to process all points in
+         * a single loop. This avoids the overhead of a virtual call and of
+         * point-major compositional fields per cell.
+         *
+         * Additional material model outputs are not supported by the
+         * default implementation.
+         */
+        virtual
+        void evaluate_batch (const MaterialModel::MaterialModelBatchInputs<dim> &in,
+                             MaterialModel::MaterialModelOutputs<dim> &out) const;
         /**
          * @name Functions used in dealing with run-time parameters
          * @{
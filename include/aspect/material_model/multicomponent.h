@@ -72,6 +72,15 @@ namespace aspect
         virtual void evaluate(const MaterialModel::MaterialModelInputs<dim> &in,
                               MaterialModel::MaterialModelOutputs<dim> &out) const;
 
+        /**
+         * Function to compute the material properties in @p out for all
+         * points of the batch @p in. This gives the same results as
+         * evaluate(), but computes the volume fractions without allocating
+         * memory for every point.
+         */
+        virtual void evaluate_batch(const MaterialModel::MaterialModelBatchInputs<dim> &in,
+                                    MaterialModel::MaterialModelOutputs<dim> &out) const;
+
         /**
          * @name Qualitative properties one can ask a material model
          * @{
@@ -152,6 +161,16 @@ namespace aspect
          * Vector for field specific heats, read from parameter file.
          */
         std::vector<double> specific_heats;
+
+        /**
+         * Fill the material properties of point @p i in @p out, given the
+         * temperature and the volume fractions of all materials (including
+         * the background material) at this point.
+         */
+        void evaluate_point (const double temperature,
+                             const std::vector<double> &volume_fractions,
+                             const unsigned int i,
+                             MaterialModel::MaterialModelOutputs<dim> &out) const;
     };
 
   }
@@ -47,6 +47,9 @@ namespace aspect
         virtual void evaluate(const MaterialModel::MaterialModelInputs<dim> &in,
                               MaterialModel::MaterialModelOutputs<dim> &out) const;
 
+        virtual void evaluate_batch(const MaterialModel::MaterialModelBatchInputs<dim> &in,
+                                    MaterialModel::MaterialModelOutputs<dim> &out) const;
+
         /**
          * @name Qualitative properties one can ask a material model
          * @{
@@ -112,6 +115,18 @@ namespace aspect
         double k_value;
 
         double compositional_delta_rho;
+
+        /**
+         * Fill the material properties of point @p i in @p out, given the
+         * temperature at this point, the number of compositional fields
+         * @p n_comp, and the value of the first compositional field (which
+         * is ignored if there are no compositional fields).
+         */
+        void evaluate_point (const double temperature,
+                             const unsigned int n_comp,
+                             const double first_composition,
+                             const unsigned int i,
+                             MaterialModel::MaterialModelOutputs<dim> &out) const;
     };
 
   }
@@ -270,6 +270,16 @@ namespace aspect
         bool latent_heat;
         bool use_lateral_average_temperature;
 
+        /**
+         * Whether to compute the latent heat contributions from enthalpy
+         * derivative tables that are smoothed over
+         * #enthalpy_derivative_smoothing_width table points in each
+         * direction, instead of from finite differences between all pairs
+         * of vertices of a cell.
+         */
+        bool use_smoothed_enthalpy_derivatives;
+        unsigned int enthalpy_derivative_smoothing_width;
+
         /**
          * Reference viscosity. Only used for pressure scaling purposes
          * and returned by the reference_viscosity() function.
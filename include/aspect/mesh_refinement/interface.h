@@ -25,6 +25,7 @@
 #include <aspect/global.h>
 #include <aspect/plugins.h>
 #include <aspect/simulator_access.h>
+#include <aspect/material_model/interface.h>
 
 #include <memory>
 #include <deal.II/base/table_handler.h>
@@ -114,6 +115,75 @@ namespace aspect
         void
         execute (Vector<float> &error_indicators) const;
 
+        /**
+         * Return whether this criterion computes its error indicators from
+         * a field that is a function of the material model outputs at the
+         * support points of the temperature element. For criteria that
+         * return true, the Manager does not call execute(), but evaluates
+         * the material model only once per cell for all of these criteria
+         * together, lets each of them compute its field from the outputs
+         * via compute_material_model_field_values(), and then passes the
+         * field to execute_from_material_model_field(). This saves one
+         * traversal of the mesh and one evaluation of the material model
+         * for every such criterion beyond the first one.
+         *
+         * The default implementation returns false, i.e., criteria that do
+         * not implement the functions below are executed through execute()
+         * as before.
+         */
+        virtual
+        bool
+        uses_material_model_field () const;
+
+        /**
+         * Return whether the material model inputs need to contain the strain
+         * rate to compute the field of this criterion, i.e., whether the
+         * field depends on the viscosity. Only called if
+         * uses_material_model_field() returns true. The default
+         * implementation returns true.
+         */
+        virtual
+        bool
+        material_model_field_needs_strain_rates () const;
+
+        /**
+         * Compute the values of the field this criterion is based on at the
+         * support points of the temperature element of one cell, given the
+         * inputs and outputs of the material model at these points. The
+         * points are enumerated in the same way as the temperature degrees of
+         * freedom of the cell. Only called if uses_material_model_field()
+         * returns true.
+         *
+         * @param[in] in The material model inputs at the support points.
+         * @param[in] out The material model outputs at the support points.
+         * @param[out] values The values of the field at the support points.
+         * This vector will already have the correct size when the function
+         * is called.
+         */
+        virtual
+        void
+        compute_material_model_field_values (const MaterialModel::MaterialModelInputs<dim> &in,
+                                             const MaterialModel::MaterialModelOutputs<dim> &out,
+                                             std::vector<double> &values) const;
+
+        /**
+         * Compute the error indicators from the field computed by
+         * compute_material_model_field_values(). Only called if
+         * uses_material_model_field() returns true.
+         *
+         * @param[in] field A vector with ghost entries whose temperature
+         * block contains the finite element interpolation of the field.
+         * The other blocks are zero.
+         * @param[out] error_indicators A vector that for every active cell of
+         * the current mesh (which may be a partition of a distributed mesh)
+         * provides an error indicator. This vector will already have the
+         * correct size when the function is called.
+         */
+        virtual
+        void
+        execute_from_material_model_field (const LinearAlgebra::BlockVector &field,
+                                           Vector<float> &error_indicators) const;
+
         /**
          * After cells have been marked for coarsening/refinement, apply
          * additional criteria independent of the error estimate. The default
@@ -161,6 +231,29 @@ namespace aspect
 
 
 
+    /**
+     * Evaluate the material model once on every locally owned cell at the
+     * support points of the temperature element, and compute the fields of
+     * all of the given @p criteria from its outputs. On return, @p fields
+     * contains one vector with ghost entries for each criterion, whose
+     * temperature block holds the finite element interpolation of the field
+     * of this criterion. All criteria need to return true from
+     * Interface::uses_material_model_field().
+     *
+     * This function is used by the Manager to evaluate all criteria based
+     * on the material model in a single pass over the mesh, and by the
+     * individual criteria to implement Interface::execute().
+     *
+     * @ingroup MeshRefinement
+     */
+    template <int dim>
+    void
+    compute_material_model_fields (const SimulatorAccess<dim> &simulator_access,
+                                   const std::vector<const Interface<dim> *> &criteria,
+                                   std::vector<LinearAlgebra::BlockVector> &fields);
+
+
+
     /**
      * A class that manages all objects that provide functionality to refine
      * meshes.
@@ -192,6 +285,10 @@ namespace aspect
          * in the input file. The error indicators are then each individually
          * normalized and merged according to the operation specified in the
          * input file (e.g., via a plus, a maximum operation, etc).
+         *
+         * All objects that compute their indicators from the material model
+         * outputs (see Interface::uses_material_model_field()) share a
+         * single evaluation of the material model on each cell.
          */
         virtual
         void
@@ -319,6 +416,12 @@ namespace aspect
          * parameter file.
          */
         std::list<std::unique_ptr<Interface<dim> > > mesh_refinement_objects;
+
+        /**
+         * The names of the mesh refinement objects stored in the
+         * #mesh_refinement_objects member variable, in the same order.
+         */
+        std::vector<std::string> plugin_names;
     };
 
 
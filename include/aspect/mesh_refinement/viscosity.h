@@ -54,6 +54,34 @@ namespace aspect
         virtual
         void
         execute (Vector<float> &error_indicators) const;
+
+        /**
+         * Return that this criterion is computed from the material model
+         * outputs, so that the material model can be evaluated together with
+         * other criteria that are computed from them.
+         */
+        virtual
+        bool
+        uses_material_model_field () const;
+
+        /**
+         * Compute the field this criterion is based on from the material
+         * model inputs and outputs at the support points of one cell.
+         */
+        virtual
+        void
+        compute_material_model_field_values (const MaterialModel::MaterialModelInputs<dim> &in,
+                                             const MaterialModel::MaterialModelOutputs<dim> &out,
+                                             std::vector<double> &values) const;
+
+        /**
+         * Compute the error indicators from the approximate gradient of the
+         * field computed by compute_material_model_field_values().
+         */
+        virtual
+        void
+        execute_from_material_model_field (const LinearAlgebra::BlockVector &field,
+                                           Vector<float> &error_indicators) const;
     };
   }
 }
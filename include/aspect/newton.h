@@ -162,6 +162,24 @@ namespace aspect
       bool                use_newton_residual_scaling_method;
       double              maximum_linear_stokes_solver_tolerance;
       double              SPD_safety_factor;
+
+      /**
+       * Whether to use the Jacobian-free Newton-Krylov method. In this case
+       * the assembled matrix is always the Picard (defect correction)
+       * matrix, which is used to build the preconditioner, while the
+       * product of the Newton Jacobian with a vector is approximated in
+       * each iteration of the linear solver by a finite difference of two
+       * evaluations of the Newton residual. The material model then does
+       * not need to provide derivatives.
+       */
+      bool                use_jacobian_free_newton_krylov;
+
+      /**
+       * The factor that determines the size of the finite difference step
+       * in the Jacobian-free Newton-Krylov method, relative to the norm of
+       * the current solution.
+       */
+      double              jacobian_free_perturbation_factor;
     };
 
 
@@ -182,6 +200,11 @@ namespace aspect
   class NewtonHandler : public SimulatorAccess<dim>
   {
     public:
+      /**
+       * Constructor.
+       */
+      NewtonHandler ();
+
       /**
        * Determine, based on the run-time parameters of the current simulation,
        * which functions need to be called in order to assemble linear systems,
@@ -196,11 +219,53 @@ namespace aspect
        */
       static void create_material_model_outputs(MaterialModel::MaterialModelOutputs<dim> &output);
 
+      /**
+       * Reset the number of, and the time spent in, the evaluations of the
+       * Newton residual done by the Jacobian-free Newton-Krylov method. This
+       * function is called at the beginning of every linear solve.
+       */
+      void reset_residual_evaluation_statistics ();
+
+      /**
+       * Record one evaluation of the Newton residual that took @p seconds.
+       */
+      void add_residual_evaluation (const double seconds);
+
+      /**
+       * Return the number of Newton residual evaluations since the last call
+       * to reset_residual_evaluation_statistics().
+       */
+      unsigned int get_n_residual_evaluations () const;
+
+      /**
+       * Return the wall time in seconds spent in Newton residual evaluations
+       * since the last call to reset_residual_evaluation_statistics().
+       */
+      double get_residual_evaluation_time () const;
+
       /**
        * The object that stores the run-time parameters that control the Newton
        * method.
        */
       Newton::Parameters parameters;
+
+      /**
+       * If the Jacobian-free Newton-Krylov method is used, the derivative
+       * terms are not assembled and Newton::Parameters::newton_derivative_scaling_factor
+       * is zero. This variable then stores the factor with which the finite
+       * difference approximation of the derivative terms is scaled in the
+       * current nonlinear iteration instead. A value of zero means that
+       * the linear solver uses the assembled (Picard) matrix.
+       */
+      double jacobian_free_derivative_scaling_factor;
+
+    private:
+      /**
+       * The number of, and the wall time spent in, Newton residual
+       * evaluations since the last call to reset_residual_evaluation_statistics().
+       */
+      unsigned int n_residual_evaluations;
+      double residual_evaluation_time;
   };
 
 
@@ -346,6 +346,7 @@ namespace aspect
      */
     double                         temperature_solver_tolerance;
     double                         composition_solver_tolerance;
+    bool                           cache_sparsity_patterns;
 
     // subsection: Stokes parameters
     bool                           use_direct_stokes_solver;
@@ -356,6 +357,8 @@ namespace aspect
     bool                           use_full_A_block_preconditioner;
     double                         linear_solver_S_block_tolerance;
     unsigned int                   stokes_gmres_restart_length;
+    bool                           use_communication_avoiding_krylov_methods;
+    bool                           use_single_precision_schur_complement_preconditioner;
 
     // subsection: AMG parameters
     std::string                    AMG_smoother_type;
@@ -458,6 +461,7 @@ namespace aspect
     unsigned int                   adaptive_refinement_interval;
     bool                           skip_solvers_on_initial_refinement;
     bool                           skip_setup_initial_conditions_on_initial_refinement;
+    bool                           incremental_initial_refinement;
     bool                           run_postprocessors_on_initial_refinement;
     bool                           run_postprocessors_on_nonlinear_iterations;
     /**
@@ -158,6 +158,24 @@ namespace aspect
           generate_particle(const Point<dim> &position,
                             const types::particle_index id) const;
 
+          /**
+           * Generate particles at all of the given @p positions that are
+           * located in locally owned cells, and insert them into
+           * @p particles. The particle at <code>positions[i]</code> gets the
+           * id <code>first_id+i</code>, independent of whether particles
+           * are generated at the previous positions on this process.
+           * Positions that are not in the local domain are skipped.
+           *
+           * This function is equivalent to calling the function above for
+           * each position and catching the ExcParticlePointNotInDomain
+           * exceptions, but it is considerably faster if subsequent
+           * positions are close to each other.
+           */
+          void
+          generate_particles_at_positions(const std::vector<Point<dim> > &positions,
+                                          const types::particle_index first_id,
+                                          std::multimap<Particles::internal::LevelInd, Particle<dim> > &particles) const;
+
           /**
            * Random number generator. For reproducibility of tests it is
            * initialized in the constructor with a constant.
@@ -101,6 +101,10 @@ namespace aspect
            * will be filled with computed properties, all other components
            * are not filled (or filled with invalid values).
            *
+           * This function may be called for different cells from several
+           * threads at the same time, and implementations must therefore
+           * not modify any member variables.
+           *
            * @param [in] particle_handler Reference to the particle handler
            * that allows accessing the particles in the domain.
            * @param [in] positions The vector of positions where the properties
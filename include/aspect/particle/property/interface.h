@@ -647,6 +647,12 @@ namespace aspect
            */
           std::list<std::shared_ptr<Interface<dim> > > property_list;
 
+          /**
+           * The names of the property objects in the list above, in the
+           * same order.
+           */
+          std::vector<std::string> plugin_names;
+
           /**
            * A class that stores all information about the particle properties,
            * their association with property plugins and their storage pattern.
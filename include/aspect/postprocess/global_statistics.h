@@ -126,6 +126,15 @@ namespace aspect
         std::vector<unsigned int> stokes_iterations_cheap;
         std::vector<unsigned int> stokes_iterations_expensive;
 
+        /**
+         * Variables that store the number of Newton residual evaluations,
+         * and the time spent in them, of every Stokes solve of the current
+         * timestep if the Jacobian-free Newton-Krylov method is used. They
+         * are empty otherwise, and cleared after writing the content.
+         */
+        std::vector<unsigned int> newton_residual_evaluations;
+        std::vector<double> newton_residual_evaluation_times;
+
         /**
          * A container that stores the advection solver history of the current
          * timestep, until it is written into the statistics object
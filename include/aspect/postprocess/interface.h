@@ -352,6 +352,12 @@ namespace aspect
          * parameter file.
          */
         std::vector<std::unique_ptr<Interface<dim> > > postprocessors;
+
+        /**
+         * The names of the postprocessors stored in the #postprocessors
+         * member variable, in the same order.
+         */
+        std::vector<std::string> postprocessor_names;
     };
 
 
@@ -61,7 +61,8 @@ namespace aspect
            */
           void build_patches(const Particle::ParticleHandler<dim> &particle_handler,
                              const aspect::Particle::Property::ParticlePropertyInformation &property_information,
-                             const bool only_group_3d_vectors);
+                             const bool only_group_3d_vectors,
+                             const unsigned int output_every_nth_particle = 1);
 
         private:
           /**
@@ -99,6 +100,111 @@ namespace aspect
            */
           std::vector<std::tuple<unsigned int, unsigned int, std::string> > vector_datasets;
       };
+
+
+
+      /**
+       * This class collects the positions, ids, and properties of the
+       * locally owned particles into contiguous buffers and writes them
+       * into a single HDF5 file that is shared by all processes. In contrast
+       * to the HDF5 output of deal.II that is used by the 'hdf5' output
+       * format, the datasets are chunked and can be compressed with the
+       * shuffle and deflate filters, or with the lossy scale-offset filter
+       * that only keeps a given number of significant decimal digits.
+       *
+       * All particle properties are stored in a single buffer with one row
+       * per particle (i.e., in the same layout they are stored in by the
+       * particles), and the individual datasets are written by selecting
+       * the corresponding columns of this buffer, so that no per-property
+       * copy of the data has to be created.
+       */
+      template <int dim>
+      class ChunkedHDF5ParticleOutput
+      {
+        public:
+          /**
+           * A structure that describes how the datasets are stored.
+           */
+          struct StorageOptions
+          {
+            /**
+             * The number of particles per chunk. Zero means that the
+             * datasets are not chunked (and consequently not compressed).
+             */
+            unsigned int chunk_size;
+
+            /**
+             * The deflate (gzip) compression level between 0 (no
+             * compression) and 9. If nonzero, the shuffle filter is
+             * applied before compression.
+             */
+            unsigned int deflate_level;
+
+            /**
+             * If nonzero, the number of significant decimal digits that
+             * are kept for floating point data by the lossy scale-offset
+             * filter.
+             */
+            unsigned int lossy_significant_digits;
+          };
+
+          /**
+           * Copy the data of every @p output_every_nth_particle th locally
+           * owned particle (selected by particle id) of @p particle_handler
+           * into the internal buffers, and compute the offset of the local
+           * particles in the global datasets. This function needs to be
+           * called on all processes at the same time.
+           */
+          void build_buffers (const Particle::ParticleHandler<dim> &particle_handler,
+                              const aspect::Particle::Property::ParticlePropertyInformation &property_information,
+                              const unsigned int output_every_nth_particle,
+                              const MPI_Comm &mpi_communicator);
+
+          /**
+           * Write the data previously collected by build_buffers() into
+           * the file @p filename. This function needs to be called on all
+           * processes at the same time.
+           */
+          void write (const std::string &filename,
+                      const StorageOptions &options,
+                      const MPI_Comm &mpi_communicator) const;
+
+          /**
+           * Create an XDMF entry that describes the datasets in the file
+           * @p filename (given relative to the location of the XDMF file)
+           * at time @p time.
+           */
+          XDMFEntry create_xdmf_entry (const std::string &filename,
+                                       const double time) const;
+
+        private:
+          /**
+           * The number of particles in the output of all processes, of the
+           * current process, and the index of the first particle of this
+           * process in the global datasets.
+           */
+          types::particle_index n_global_particles;
+          types::particle_index n_local_particles;
+          types::particle_index local_offset;
+
+          /**
+           * Contiguous buffers for the positions (dim values per particle),
+           * the ids, and the properties (n_property_components values per
+           * particle) of the local particles.
+           */
+          std::vector<double> positions;
+          std::vector<types::particle_index> ids;
+          std::vector<double> properties;
+          unsigned int n_property_components;
+
+          /**
+           * A list of the datasets to write for the properties, each
+           * described by its name, the first column in the properties
+           * buffer, and the number of columns (either one, or three for
+           * vectors in 3d).
+           */
+          std::vector<std::tuple<std::string, unsigned int, unsigned int> > property_datasets;
+      };
     }
 #endif
 
@@ -308,6 +414,18 @@ namespace aspect
          */
         bool write_in_background_thread;
 
+        /**
+         * Only particles whose id is a multiple of this number are written
+         * into the output files.
+         */
+        unsigned int output_every_nth_particle;
+
+        /**
+         * How the datasets of the 'chunked hdf5' output format are chunked
+         * and compressed.
+         */
+        typename internal::ChunkedHDF5ParticleOutput<dim>::StorageOptions hdf5_storage_options;
+
         /**
          * Handle to a thread that is used to write data in the background.
          * The writer() function runs on this background thread.
@@ -562,6 +562,12 @@ namespace aspect
          */
         std::list<std::shared_ptr<VisualizationPostprocessors::Interface<dim> > > postprocessors;
 
+        /**
+         * The names of the postprocessor objects in the list above, in the
+         * same order.
+         */
+        std::vector<std::string> postprocessor_names;
+
         /**
          * A list of pairs (time, pvtu_filename) that have so far been written
          * and that we will pass to DataOutInterface::write_pvd_record to
@@ -0,0 +1,313 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _aspect_profiler_h
+#define _aspect_profiler_h
+
+#include <aspect/global.h>
+
+#include <deal.II/base/parameter_handler.h>
+#include <deal.II/base/thread_local_storage.h>
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace aspect
+{
+  using namespace dealii;
+
+  /**
+   * A class that collects hierarchical timing information about the regions
+   * of the code that are wrapped into objects of type Profiler::Scope. In
+   * contrast to the TimerOutput object of the Simulator, which only measures
+   * a few coarse sections of each time step, regions can be nested, and the
+   * plugin managers create one region for every call to one of their
+   * plugins. This allows to attribute the run time to individual material
+   * models, heating models, postprocessors, etc.
+   *
+   * Each region is identified by its path, i.e., the names of all regions
+   * it is nested in, separated by slashes. For every path the class records
+   * the number of calls, the accumulated wall time, and optionally hardware
+   * counters (CPU cycles, instructions, and cache misses) read from the
+   * Linux perf_event interface. Regions may be entered concurrently from
+   * several threads; each thread records into its own data structures.
+   * Regions entered on a thread other than the one that created the
+   * profiler (e.g., in the worker threads of a WorkStream loop) are nested
+   * into the region that is currently open on the creating thread, and
+   * their times are summed over all threads.
+   *
+   * In regular intervals, the data of all processes is combined into the
+   * minimum, average, and maximum over all processes, and written into a
+   * machine-readable file in the output directory, either in JSON format or
+   * in the trace event format understood by the Chrome browser
+   * (chrome://tracing) and other trace viewers.
+   *
+   * If profiling is disabled in the input file, all functions of this class
+   * return immediately, and the overhead of a Scope object is a single
+   * branch.
+   *
+   * @ingroup Simulator
+   */
+  class Profiler
+  {
+    public:
+      /**
+       * The hardware counters that can be recorded.
+       */
+      enum Counter
+      {
+        cpu_cycles,
+        instructions,
+        cache_misses,
+        n_counters
+      };
+
+      /**
+       * The formats in which the profile can be written.
+       */
+      enum OutputFormat
+      {
+        json,
+        chrome_trace
+      };
+
+      /**
+       * An object that measures the time between its construction and its
+       * destruction and attributes it to a region with the given name,
+       * nested into the region that is currently open on this thread.
+       */
+      class Scope
+      {
+        public:
+          /**
+           * Open the region @p name.
+           */
+          Scope (const Profiler &profiler,
+                 const char *name);
+
+          /**
+           * Open the region @p name.
+           */
+          Scope (const Profiler &profiler,
+                 const std::string &name);
+
+          /**
+           * Open the region with the name "category: name". This is the
+           * form used by the plugin managers, e.g. with the category
+           * "Heating model" and the name of the plugin. The name of the
+           * region is only assembled if profiling is enabled.
+           */
+          Scope (const Profiler &profiler,
+                 const std::string &category,
+                 const std::string &name);
+
+          /**
+           * Same as above. This overload avoids creating a temporary string
+           * for the category in every call, which matters for plugins that
+           * are called once per point, e.g. boundary and initial conditions.
+           */
+          Scope (const Profiler &profiler,
+                 const char *category,
+                 const std::string &name);
+
+          /**
+           * Close the region.
+           */
+          ~Scope ();
+
+        private:
+          const Profiler &profiler;
+          const bool active;
+      };
+
+      /**
+       * Constructor.
+       */
+      Profiler ();
+
+      /**
+       * Declare the parameters this class takes through input files.
+       */
+      static
+      void
+      declare_parameters (ParameterHandler &prm);
+
+      /**
+       * Read the parameters this class declares from the parameter file.
+       * The @p output_directory is the directory the profiles are
+       * written to, and @p mpi_communicator the communicator over which
+       * the data of all processes is combined.
+       */
+      void
+      parse_parameters (ParameterHandler &prm,
+                        const std::string &output_directory,
+                        const MPI_Comm mpi_communicator);
+
+      /**
+       * Return whether profiling is enabled.
+       */
+      bool
+      is_enabled () const;
+
+      /**
+       * Write the profile if @p timestep_number is a multiple of the output
+       * frequency, or if @p force_output is set. This function has to be
+       * called on all processes at the same time, and no region may be open
+       * on any other thread.
+       */
+      void
+      maybe_write_profile (const unsigned int timestep_number,
+                           const bool force_output = false) const;
+
+    private:
+      /**
+       * The data recorded for one region path.
+       */
+      struct Measurement
+      {
+        Measurement ();
+
+        unsigned long int n_calls;
+        double wall_time;
+        std::array<long long int,n_counters> counters;
+      };
+
+      /**
+       * A region that is currently open on a thread.
+       */
+      struct Frame
+      {
+        std::string path;
+        std::chrono::steady_clock::time_point start_time;
+        std::array<long long int,n_counters> start_counters;
+      };
+
+      /**
+       * All data that belongs to one thread.
+       */
+      struct ThreadData
+      {
+        ThreadData ();
+        ~ThreadData ();
+
+        /**
+         * The regions that are currently open on this thread, the
+         * innermost one last.
+         */
+        std::vector<Frame> open_regions;
+
+        /**
+         * The accumulated data for all regions this thread has entered.
+         */
+        std::map<std::string,Measurement> measurements;
+
+        /**
+         * The file descriptors of the hardware counters of this thread,
+         * or -1 if a counter could not be opened.
+         */
+        std::array<int,n_counters> counter_file_descriptors;
+
+        /**
+         * Whether we have tried to open the hardware counters already.
+         */
+        bool counters_initialized;
+
+        /**
+         * Whether this object has been added to the list of all thread
+         * data objects yet.
+         */
+        bool registered;
+      };
+
+      /**
+       * Open a region with the given name on the current thread. If
+       * @p category is not a null pointer, the name of the region is
+       * "category: name".
+       */
+      void
+      enter_region (const char *category,
+                    const char *name) const;
+
+      /**
+       * Close the innermost region of the current thread.
+       */
+      void
+      leave_region () const;
+
+      /**
+       * Read the current values of the hardware counters of the current
+       * thread into @p values. Counters that are not available are set to
+       * zero.
+       */
+      void
+      read_counters (ThreadData &thread_data,
+                     std::array<long long int,n_counters> &values) const;
+
+      /**
+       * Return the path of the region that is currently open on the thread
+       * that created this object.
+       */
+      std::string
+      get_main_thread_path () const;
+
+      /**
+       * Run-time parameters.
+       */
+      bool enabled;
+      bool record_hardware_counters;
+      OutputFormat output_format;
+      unsigned int output_frequency;
+      std::string output_directory;
+      MPI_Comm mpi_communicator;
+
+      /**
+       * The id of the thread that created this object, and a mutex that
+       * protects reading the path of the regions open on that thread from
+       * other threads.
+       */
+      const std::thread::id main_thread_id;
+      mutable std::mutex main_thread_mutex;
+      mutable std::string main_thread_path;
+
+      /**
+       * The data of all threads, and a list of pointers to the data of all
+       * threads that have entered a region so far, together with a mutex
+       * that protects the list.
+       */
+      mutable Threads::ThreadLocalStorage<ThreadData> thread_data;
+      mutable std::vector<ThreadData *> all_thread_data;
+      mutable std::mutex all_thread_data_mutex;
+
+      /**
+       * The point in time this object was created. All times in the
+       * trace output are relative to this point.
+       */
+      const std::chrono::steady_clock::time_point creation_time;
+  };
+}
+
+
+#endif
@@ -0,0 +1,173 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _aspect_quadrature_point_geometry_h
+#define _aspect_quadrature_point_geometry_h
+
+#include <aspect/simulator_access.h>
+#include <aspect/material_model/interface.h>
+
+#include <deal.II/base/parameter_handler.h>
+
+#include <array>
+
+namespace aspect
+{
+  using namespace dealii;
+
+  /**
+   * A class that stores quantities that only depend on the position of a
+   * point (and possibly on time) at the quadrature points of all locally
+   * owned cells, for the quadrature formulas used to assemble the Stokes
+   * system and the advection systems. These are the depth, the spherical
+   * coordinates, the gravity vector, and the adiabatic temperature and
+   * pressure. Plugins that are evaluated at these quadrature points, e.g.,
+   * material and heating models called from the assemblers, can look them
+   * up instead of computing them again through virtual function calls and
+   * transcendental functions.
+   *
+   * The positions are computed whenever the mesh has changed (or in every
+   * time step if the mesh is deformed), and all other quantities at the
+   * beginning of every time step. A lookup is only successful if the
+   * cell, the index of the quadrature point, and its position all match
+   * one of the stored points, otherwise the lookup functions return a
+   * null pointer and the caller has to compute the values itself. This
+   * way, plugins can use the cache without knowing which quadrature
+   * formula they are evaluated with, or whether the cache is enabled at
+   * all.
+   *
+   * @ingroup Simulator
+   */
+  template <int dim>
+  class QuadraturePointGeometry : public SimulatorAccess<dim>
+  {
+    public:
+      /**
+       * The quantities stored for each quadrature point. The radius, i.e.,
+       * the distance from the origin, is the first of the spherical
+       * coordinates.
+       */
+      struct PointData
+      {
+        Point<dim>             position;
+        double                 depth;
+        std::array<double,dim> spherical_coordinates;
+        Tensor<1,dim>          gravity;
+        double                 adiabatic_temperature;
+        double                 adiabatic_pressure;
+      };
+
+      /**
+       * Constructor.
+       */
+      QuadraturePointGeometry ();
+
+      /**
+       * Declare the parameters this class takes through input files.
+       */
+      static
+      void
+      declare_parameters (ParameterHandler &prm);
+
+      /**
+       * Read the parameters this class declares from the parameter file.
+       */
+      void
+      parse_parameters (ParameterHandler &prm);
+
+      /**
+       * Return whether the cache is enabled in the input file.
+       */
+      bool
+      is_enabled () const;
+
+      /**
+       * Discard all stored values. This function has to be called after
+       * every change of the mesh. Until the next call to update(), all
+       * lookups fail.
+       */
+      void
+      clear ();
+
+      /**
+       * Compute the positions and depths of all quadrature points if they
+       * are not available (or if the mesh is deformed), and the gravity
+       * vector and adiabatic conditions at all of them. This function
+       * is called at the beginning of every time step, after the gravity
+       * model and the adiabatic conditions have been updated.
+       */
+      void
+      update ();
+
+      /**
+       * Return the stored values for quadrature point @p q of @p cell, if
+       * this point is located at @p position, or a null pointer if no
+       * values are stored for this point.
+       */
+      const PointData *
+      get_point_data (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                      const unsigned int q,
+                      const Point<dim> &position) const;
+
+      /**
+       * Same as above, for the point @p q of the material model inputs
+       * @p in, which need to be evaluated on the cell
+       * <code>in.current_cell</code>.
+       */
+      const PointData *
+      get_point_data (const MaterialModel::MaterialModelInputs<dim> &in,
+                      const unsigned int q) const;
+
+    private:
+      /**
+       * The values stored for one quadrature formula. The values of a cell
+       * start at the index <code>cell-@>active_cell_index() *
+       * n_q_points</code>; entries of cells that are not locally owned are
+       * not used.
+       */
+      struct QuadratureData
+      {
+        Quadrature<dim>        quadrature;
+        std::vector<PointData> points;
+      };
+
+      /**
+       * Whether the cache is used at all.
+       */
+      bool enabled;
+
+      /**
+       * The stored values for each of the quadrature formulas used in the
+       * assembly. Empty if the values need to be recomputed.
+       */
+      std::vector<QuadratureData> quadrature_data;
+
+      /**
+       * Compute the positions, depths and spherical coordinates of the
+       * quadrature points of all locally owned cells.
+       */
+      void
+      compute_positions ();
+  };
+}
+
+
+#endif
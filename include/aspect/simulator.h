@@ -48,6 +48,11 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #include <aspect/global.h>
 #include <aspect/simulator_access.h>
 #include <aspect/lateral_averaging.h>
+#include <aspect/cell_cost_model.h>
+#include <aspect/quadrature_point_geometry.h>
+#include <aspect/cell_locator.h>
+#include <aspect/profiler.h>
+#include <aspect/simulator/single_precision_ilu.h>
 #include <aspect/simulator_signals.h>
 #include <aspect/material_model/interface.h>
 #include <aspect/heating_model/interface.h>
@@ -411,6 +416,23 @@ namespace aspect
        */
       void compute_initial_pressure_field ();
 
+      /**
+       * Return whether the initial conditions only need to be computed on
+       * the cells stored in cells_changed_by_initial_refinement, because
+       * all other cells still have the correct values from the previous
+       * initial refinement cycle. This is the case after an initial
+       * refinement cycle if the 'Incremental initial refinement' parameter
+       * is set, unless compositional fields need to be normalized (which
+       * requires looking at all cells), unless this is the final cycle
+       * and the geometry may still change before the initial conditions
+       * are set, or unless a plugin modifies the initial state after it
+       * has been set.
+       *
+       * This function is implemented in
+       * <code>source/simulator/initial_conditions.cc</code>.
+       */
+      bool initial_conditions_are_incremental () const;
+
       /**
        * Fill the given @p constraints with constraints coming from the velocity boundary
        * conditions that do not change over time. This function is used by
@@ -439,6 +461,33 @@ namespace aspect
        */
       void compute_current_constraints ();
 
+      /**
+       * Add constraints to @p constraints that set all degrees of freedom
+       * on boundary faces with indicator @p boundary_id, whose components
+       * are selected by @p component_mask, to the values of @p function at
+       * their support points. Degrees of freedom that are already
+       * constrained are not changed. This does the same as
+       * VectorTools::interpolate_boundary_values(), but uses the boundary
+       * faces and support points stored in boundary_dof_cache, and it
+       * only evaluates @p function once per support point and only at
+       * support points of degrees of freedom that will be constrained.
+       *
+       * This function is implemented in
+       * <code>source/simulator/core.cc</code>.
+       */
+      void interpolate_boundary_values_from_cache (const types::boundary_id boundary_id,
+                                                   const Function<dim> &function,
+                                                   const ComponentMask &component_mask,
+                                                   ConstraintMatrix &constraints);
+
+      /**
+       * Fill boundary_dof_cache for the current mesh and mapping.
+       *
+       * This function is implemented in
+       * <code>source/simulator/core.cc</code>.
+       */
+      void setup_boundary_dof_cache ();
+
       /**
        * Do some housekeeping at the beginning of each time step. This
        * includes generating some screen output, adding some information to
@@ -776,6 +825,29 @@ namespace aspect
        */
       void refine_mesh (const unsigned int max_grid_level);
 
+      /**
+       * Redistribute the cells of the mesh between the processes without
+       * refining or coarsening it, and transfer the solution vectors to the
+       * new partition. This is used if the cell cost model detects that the
+       * load imbalance between processes has become too large.
+       *
+       * This function is implemented in
+       * <code>source/simulator/core.cc</code>.
+       */
+      void repartition_mesh ();
+
+      /**
+       * Execute the coarsening and refinement of the mesh according to the
+       * flags currently set on its cells (if any), which also repartitions
+       * the mesh between the processes. Then set up all data structures on
+       * the new mesh and transfer the solution vectors to it. This function
+       * is the common part of refine_mesh() and repartition_mesh().
+       *
+       * This function is implemented in
+       * <code>source/simulator/core.cc</code>.
+       */
+      void execute_mesh_change_and_transfer_solution ();
+
       /**
        * @}
        */
@@ -1515,6 +1587,27 @@ namespace aspect
       double
       compute_initial_newton_residual (const LinearAlgebra::BlockVector &linearized_stokes_initial_guess);
 
+      /**
+       * Compute the product of the Jacobian of the Newton Stokes system with
+       * the vector @p src without using the assembled derivative terms, as
+       * needed by the Jacobian-free Newton-Krylov method. The product is
+       * computed as
+       * $(1-s) A v + s (R(u+hv)-R(u))/h$, where $A$ is the assembled Picard
+       * matrix, $R$ the Newton residual, and $s$ the current derivative
+       * scaling factor. The residual $R(u+hv)$ is computed by assembling the
+       * right hand side at a perturbed linearization point. Both the
+       * current linearization point and the system right hand side are
+       * restored before the function returns. Both @p dst and @p src only
+       * contain the velocity and pressure blocks, with the pressure in the
+       * scaled units of the linear system.
+       *
+       * This function is implemented in
+       * <code>source/simulator/helper_functions.cc</code>.
+       */
+      void
+      compute_jacobian_free_newton_product (LinearAlgebra::BlockVector       &dst,
+                                            const LinearAlgebra::BlockVector &src);
+
       /**
        * This function computes the Eisenstat Walker linear tolerance used for the Newton iterations
        * in the `iterated Advection and Newton Stokes' solver scheme.
@@ -1630,6 +1723,13 @@ namespace aspect
 
       mutable TimerOutput                 computing_timer;
 
+      /**
+       * An object that records the time spent in the nested regions of
+       * the code, including all calls to plugins made by the plugin
+       * managers, if profiling is enabled in the input file.
+       */
+      Profiler                            profiler;
+
       /**
        * In output_statistics(), where we output the statistics object above,
        * we do the actual writing on a separate thread. This variable is the
@@ -1679,6 +1779,13 @@ namespace aspect
        * @}
        */
 
+      /**
+       * The cells that were created, by refinement or by coarsening, in the
+       * last initial adaptive refinement cycle. Only filled if the
+       * 'Incremental initial refinement' parameter is set.
+       */
+      std::set<CellId>                                          cells_changed_by_initial_refinement;
+
       /**
        * @name Variables related to simulation termination
        * @{
@@ -1697,6 +1804,33 @@ namespace aspect
        * @}
        */
 
+      /**
+       * @name Variables for measuring the cost of cells for load balancing
+       * @{
+       */
+      CellCostModel<dim>                                        cell_cost_model;
+      /**
+       * @}
+       */
+
+      /**
+       * @name Variables for caching values at quadrature points
+       * @{
+       */
+      QuadraturePointGeometry<dim>                              quadrature_point_geometry;
+      /**
+       * @}
+       */
+
+      /**
+       * @name Variables for locating points in the mesh
+       * @{
+       */
+      CellLocator<dim>                                          cell_locator;
+      /**
+       * @}
+       */
+
       /**
        * @name Variables that describe the spatial discretization
        * @{
@@ -1806,10 +1940,59 @@ namespace aspect
       // only used if operator split is enabled
       LinearAlgebra::BlockVector                                operator_split_reaction_vector;
 
+      /**
+       * The density, JxW value, and position at each quadrature point of
+       * the locally owned cells, as computed during the last assembly of the
+       * Stokes system that was not only used to evaluate a residual (see
+       * assemble_auxiliary_stokes_residual). The values of a cell start at the index
+       * <code>cell-@>active_cell_index() * n_q_points</code>. The functions
+       * that remove the nullspace after each Stokes solve use these values
+       * rather than evaluating the mapping and the material model again.
+       * The vectors are only filled if nullspace removal is enabled, and
+       * they are cleared in setup_dofs().
+       */
+      struct NullspaceQuadratureData
+      {
+        std::vector<double>     densities;
+        std::vector<double>     JxW_values;
+        std::vector<Point<dim>> positions;
+      };
+      NullspaceQuadratureData                                   nullspace_quadrature_data;
+
+      /**
+       * The degrees of freedom and support points on all boundary faces of
+       * the locally relevant cells, which are needed to interpolate
+       * Dirichlet boundary values into the constraints in
+       * interpolate_boundary_values_from_cache(). The support points of
+       * face degrees of freedom that share the same location (e.g., the
+       * different components of the velocity) are stored only once per
+       * face, and face_dof_point_index maps each face degree of freedom to
+       * its support point. The cache is built the first time it is needed
+       * after setup_dofs() has invalidated it, and, if the mesh is
+       * deformed, at the beginning of every call to
+       * compute_current_constraints().
+       */
+      struct BoundaryDoFCache
+      {
+        struct Face
+        {
+          typename DoFHandler<dim>::face_iterator face;
+          std::vector<types::global_dof_index> dof_indices;
+          std::vector<Point<dim> > support_points;
+        };
+
+        bool                      is_valid;
+        std::vector<unsigned int> face_dof_point_index;
+        std::vector<unsigned int> face_dof_component;
+        std::vector<Face>         faces;
+      };
+      BoundaryDoFCache                                          boundary_dof_cache;
+
 
 
       std::unique_ptr<LinearAlgebra::PreconditionAMG>           Amg_preconditioner;
       std::unique_ptr<LinearAlgebra::PreconditionBase>          Mp_preconditioner;
+      std::unique_ptr<SinglePrecisionILU>                       Mp_preconditioner_single_precision;
 
       bool                                                      rebuild_sparsity_and_matrices;
       bool                                                      rebuild_stokes_matrix;
@@ -1817,6 +2000,17 @@ namespace aspect
       bool                                                      assemble_newton_stokes_system;
       bool                                                      rebuild_stokes_preconditioner;
 
+      /**
+       * Whether the current call to assemble_stokes_system() only evaluates
+       * the residual at a state other than the one the next linear solve
+       * belongs to, as in compute_initial_newton_residual() and
+       * compute_jacobian_free_newton_product(). Such assemblies must not
+       * overwrite the quadrature point data used for the nullspace removal
+       * after the solve, and are not counted as cell costs by the
+       * CellCostModel.
+       */
+      bool                                                      assemble_auxiliary_stokes_residual;
+
       /**
        * @}
        */
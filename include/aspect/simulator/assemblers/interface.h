@@ -172,6 +172,19 @@ namespace aspect
           std::vector<double>                  velocity_divergence;
           std::vector<Tensor<1,dim> >          temperature_gradients;
 
+          /**
+           * Scalar products of the symmetric gradients of the velocity shape
+           * functions with tensors that are constant at a quadrature point,
+           * e.g. the strain rate or the derivative of the viscosity with
+           * respect to the strain rate. The Newton assemblers store them
+           * here to write the linearization terms as rank-1 updates of the
+           * local matrix instead of forming tensor products for every pair
+           * of shape functions.
+           */
+          std::vector<double>                  grads_phi_u_times_strain_rate;
+          std::vector<double>                  deta_deps_times_grads_phi_u;
+          std::vector<double>                  newton_matrix_column_factors;
+
           /**
            * Material model inputs and outputs computed at the current
            * linearization point.
@@ -183,6 +196,12 @@ namespace aspect
           MaterialModel::MaterialModelInputs<dim> face_material_model_inputs;
           MaterialModel::MaterialModelOutputs<dim> face_material_model_outputs;
 
+          /**
+           * The tractions of the boundary traction models at the quadrature
+           * points of the current face.
+           */
+          std::vector<Tensor<1,dim> >          face_tractions;
+
           /**
            * In some approximations of the Stokes equations the density used
            * for the mass conservation (/continuity) equation is some form
@@ -231,6 +250,15 @@ namespace aspect
 
           std::vector<types::global_dof_index>   local_dof_indices;
 
+          /**
+           * The indices of the shape functions of the global finite element
+           * that belong to the currently advected field, in the order in
+           * which they appear in the local matrix. This map is filled once
+           * per cell, so that the assemblers do not need to search for the
+           * shape functions of the field at every quadrature point.
+           */
+          std::vector<unsigned int>              field_shape_function_indices;
+
           /**
            * Variables describing the values and gradients of the
            * shape functions at the quadrature points, as they are
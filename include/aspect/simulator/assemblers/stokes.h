@@ -209,6 +209,164 @@ namespace aspect
         execute(internal::Assembly::Scratch::ScratchBase<dim>   &scratch_base,
                 internal::Assembly::CopyData::CopyDataBase<dim> &data_base) const;
     };
+
+    /**
+     * A description of the degrees of freedom of the Stokes system on a
+     * cell. It is computed once from the finite element, so that the
+     * assemblers below do not have to find out for every shape function at
+     * every quadrature point whether it belongs to the Stokes system, and to
+     * which of its components. All indices except the ones in
+     * shape_function_indices refer to the numbering of the local Stokes
+     * matrix and right hand side.
+     */
+    struct StokesDoFMap
+    {
+      /**
+       * Fill this object for the Stokes components of the finite element
+       * @p fe, as described by @p introspection.
+       */
+      template <int dim>
+      void
+      initialize (const FiniteElement<dim> &fe,
+                  const Introspection<dim> &introspection);
+
+      /**
+       * For each Stokes degree of freedom, the index of the corresponding
+       * shape function of the finite element, and the vector component
+       * of the finite element it belongs to.
+       */
+      std::vector<unsigned int> shape_function_indices;
+      std::vector<unsigned int> component_indices;
+
+      /**
+       * The Stokes degrees of freedom that belong to the velocity, and to
+       * the pressure.
+       */
+      std::vector<unsigned int> velocity_dofs;
+      std::vector<unsigned int> pressure_dofs;
+
+      /**
+       * The velocity degrees of freedom, sorted by the velocity component
+       * they belong to.
+       */
+      std::vector<std::vector<unsigned int> > velocity_dofs_per_component;
+    };
+
+    /**
+     * An assembler that computes the same terms as the
+     * StokesIncompressibleTerms class and, if @p compressible is true, the
+     * StokesCompressibleStrainRateViscosityTerm class, but does so in a
+     * single loop over the quadrature points. The shape functions are
+     * evaluated through a StokesDoFMap that is computed once in
+     * initialize(), the compressible term is selected at compile time, the
+     * symmetry of the velocity block is used, and the blocks of the matrix
+     * that are known to be zero are skipped. The resulting local matrix is
+     * the same as the one computed by the separate assemblers, up to
+     * round-off.
+     *
+     * Objects of this type are not meant to be created by the user. Rather,
+     * Simulator::set_assemblers() replaces the default Stokes assemblers by
+     * this class after all plugins had a chance to modify the list of
+     * assemblers, see select_specialized_stokes_assemblers().
+     */
+    template <int dim, bool compressible>
+    class StokesSystemKernel : public StokesIncompressibleTerms<dim>
+    {
+      public:
+        /**
+         * Compute the map of the Stokes degrees of freedom. This function
+         * has to be called after the SimulatorAccess base class has been
+         * initialized.
+         */
+        void
+        initialize ();
+
+        virtual
+        void
+        execute(internal::Assembly::Scratch::ScratchBase<dim>   &scratch_base,
+                internal::Assembly::CopyData::CopyDataBase<dim> &data_base) const;
+
+        /**
+         * Add the contributions of a single quadrature point with viscosity
+         * @p eta and weight @p JxW to @p local_matrix, given the symmetric
+         * gradients and divergences of the velocity shape functions and the
+         * values of the pressure shape functions at this point, indexed
+         * like the degrees of freedom in @p dof_map.
+         */
+        static
+        void
+        add_matrix_terms (const StokesDoFMap                         &dof_map,
+                          const std::vector<SymmetricTensor<2,dim> > &grads_phi_u,
+                          const std::vector<double>                  &div_phi_u,
+                          const std::vector<double>                  &phi_p,
+                          const double                                eta,
+                          const double                                pressure_scaling,
+                          const double                                JxW,
+                          FullMatrix<double>                         &local_matrix);
+
+      private:
+        StokesDoFMap dof_map;
+    };
+
+    /**
+     * An assembler that computes the same terms as the StokesPreconditioner
+     * class and, if @p compressible is true, the
+     * StokesCompressiblePreconditioner class, in the same way as the
+     * StokesSystemKernel class does for the Stokes system.
+     */
+    template <int dim, bool compressible>
+    class StokesPreconditionerKernel : public StokesPreconditioner<dim>
+    {
+      public:
+        /**
+         * Compute the map of the Stokes degrees of freedom. This function
+         * has to be called after the SimulatorAccess base class has been
+         * initialized.
+         */
+        void
+        initialize ();
+
+        virtual
+        void
+        execute(internal::Assembly::Scratch::ScratchBase<dim>   &scratch_base,
+                internal::Assembly::CopyData::CopyDataBase<dim> &data_base) const;
+
+        /**
+         * Add the contributions of a single quadrature point to
+         * @p local_matrix. The arguments are the same as for
+         * StokesSystemKernel::add_matrix_terms(), and
+         * @p assemble_A_approximation indicates whether the velocity
+         * blocks of the preconditioner are needed.
+         */
+        static
+        void
+        add_matrix_terms (const StokesDoFMap                         &dof_map,
+                          const std::vector<SymmetricTensor<2,dim> > &grads_phi_u,
+                          const std::vector<double>                  &div_phi_u,
+                          const std::vector<double>                  &phi_p,
+                          const double                                eta,
+                          const double                                pressure_scaling,
+                          const double                                JxW,
+                          const bool                                  assemble_A_approximation,
+                          FullMatrix<double>                         &local_matrix);
+
+      private:
+        StokesDoFMap dof_map;
+    };
+
+    /**
+     * Replace the default assemblers of the Stokes system and the Stokes
+     * preconditioner in @p assemblers by the equivalent StokesSystemKernel
+     * and StokesPreconditionerKernel objects. Only objects whose dynamic
+     * type is exactly one of the default classes are replaced; all other
+     * assemblers, including ones derived from the default classes, stay in
+     * the list and are executed as before. The new objects are initialized
+     * with @p simulator.
+     */
+    template <int dim>
+    void
+    select_specialized_stokes_assemblers (const Simulator<dim> &simulator,
+                                          Manager<dim>         &assemblers);
   }
 }
 
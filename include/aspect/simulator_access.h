@@ -65,6 +65,8 @@ namespace aspect
   template <int dim> class Simulator;
   template <int dim> struct SimulatorSignals;
   template <int dim> class LateralAveraging;
+  template <int dim> class QuadraturePointGeometry;
+  template <int dim> class CellLocator;
 
   namespace GravityModel
   {
@@ -142,6 +144,8 @@ namespace aspect
 
   template <int dim> class NewtonHandler;
 
+  class Profiler;
+
   /**
    * SimulatorAccess is a base class for different plugins like postprocessors.
    * It provides access to the various variables of the main class that
@@ -776,6 +780,33 @@ namespace aspect
       const LateralAveraging<dim> &
       get_lateral_averaging () const;
 
+      /**
+       * Return a reference to the object owned by the simulator that
+       * stores the depth, spherical coordinates, gravity, and adiabatic
+       * conditions at the quadrature points used in the assembly, if the
+       * 'Cache quadrature point geometry' parameter is set. See the
+       * QuadraturePointGeometry class for how to look up these values.
+       */
+      const QuadraturePointGeometry<dim> &
+      get_quadrature_point_geometry () const;
+
+      /**
+       * Return a reference to the object owned by the simulator that finds
+       * the locally owned or ghost cell around a given point. Use it
+       * instead of GridTools::find_active_cell_around_point() if many
+       * points need to be located.
+       */
+      const CellLocator<dim> &
+      get_cell_locator () const;
+
+      /**
+       * Return a reference to the profiler owned by the simulator. Plugins
+       * can create objects of type Profiler::Scope with it to measure the
+       * time spent in parts of their own code.
+       */
+      const Profiler &
+      get_profiler () const;
+
       /**
        * Return a pointer to the object that describes the DoF
        * constraints for the time step we are currently solving.
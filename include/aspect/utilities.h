@@ -405,6 +405,31 @@ namespace aspect
                           const MPI_Comm &comm,
                           bool silent);
 
+#ifdef DEAL_II_WITH_ZLIB
+    /**
+     * Compress @p data with zlib and write it into the file @p filename.
+     * The data is split into blocks of @p compression_block_size bytes
+     * (the last block may be smaller) that are compressed independently
+     * and in parallel. The file starts with a header that consists of the
+     * number of blocks, the uncompressed size of all but the last block,
+     * the uncompressed size of the last block, and the compressed sizes of
+     * all blocks, all stored as 32 bit unsigned integers. The compressed
+     * blocks follow the header. This is the same format deal.II uses for
+     * compressed data, and files with only a single block are the format
+     * previous versions of ASPECT wrote for checkpoints.
+     */
+    void write_compressed_file (const std::string &data,
+                                const std::string &filename,
+                                const unsigned int compression_block_size = 1 << 22);
+
+    /**
+     * Read a file written by write_compressed_file() and return the
+     * uncompressed data. The blocks are uncompressed in parallel. The
+     * block size is read from the header of the file.
+     */
+    std::string read_compressed_file (const std::string &filename);
+#endif
+
     /**
      * A namespace defining the cubic spline interpolation that can be used
      * between different spherical layers in the mantle.
@@ -1160,6 +1185,115 @@ namespace aspect
      */
     std::vector<Operator> create_model_operator_list(const std::vector<std::string> &operator_names);
 
+    /**
+     * A class that stores the values of a quantity at equidistant depths
+     * between the surface and a maximal depth, e.g., a pressure profile
+     * computed by integrating downward from the surface, and interpolates
+     * linearly between them. Because the depths are equidistant, the
+     * interval that contains a given depth is found by a single division,
+     * and the slopes of all intervals are computed once in reinit(), so that
+     * evaluating the profile only costs a few floating point operations.
+     * Depths above the surface or below the maximal depth are clamped to
+     * the first or last value.
+     */
+    class UniformDepthProfile
+    {
+      public:
+        /**
+         * Constructor. Creates an empty profile that needs to be
+         * initialized with reinit() before it can be evaluated.
+         */
+        UniformDepthProfile ();
+
+        /**
+         * Set the profile to the given @p values, with the first value at
+         * the surface and the last one at @p maximal_depth. At least two
+         * values are required.
+         */
+        void
+        reinit (const double maximal_depth,
+                const std::vector<double> &values);
+
+        /**
+         * Return the linear interpolation of the profile at @p depth.
+         */
+        double
+        value (const double depth) const;
+
+        /**
+         * Return the derivative of the profile with respect to depth at
+         * @p depth, i.e., the slope of the interval that contains @p depth.
+         * At the depth of one of the points of the profile, this is the
+         * slope of the interval above the point.
+         */
+        double
+        derivative (const double depth) const;
+
+        /**
+         * Return the values of the profile.
+         */
+        const std::vector<double> &
+        get_values () const;
+
+        /**
+         * Return the distance in depth between two points of the profile.
+         */
+        double
+        get_depth_spacing () const;
+
+      private:
+        /**
+         * The distance in depth between two points, and its inverse.
+         */
+        double delta_z;
+        double one_over_delta_z;
+
+        /**
+         * The values at the points, and the slopes of the intervals
+         * between them.
+         */
+        std::vector<double> values;
+        std::vector<double> slopes;
+    };
+
+
+
+    inline
+    double
+    UniformDepthProfile::value (const double depth) const
+    {
+      Assert (values.size() > 1,
+              ExcMessage ("The depth profile has not been initialized."));
+
+      if (depth <= 0)
+        return values.front();
+
+      const unsigned int i = static_cast<unsigned int>(depth * one_over_delta_z);
+      if (i >= slopes.size())
+        return values.back();
+
+      return values[i] + (depth - i * delta_z) * slopes[i];
+    }
+
+
+
+    inline
+    double
+    UniformDepthProfile::derivative (const double depth) const
+    {
+      Assert (values.size() > 1,
+              ExcMessage ("The depth profile has not been initialized."));
+
+      if (depth <= 0)
+        return slopes.front();
+
+      // if depth/delta_z is within [k-eps, k+eps] of a whole number k, round
+      // it down to k-1
+      const unsigned int i = static_cast<unsigned int>((depth * one_over_delta_z)
+                                                       * (1. - 2. * std::numeric_limits<double>::epsilon()));
+      return slopes[std::min<std::size_t>(i, slopes.size()-1)];
+    }
+
     /**
      * A function that returns a SymmetricTensor, whose entries are zero, except for
      * the k'th component, which is set to one. If k is not on the main diagonal the
@@ -96,6 +96,13 @@ namespace aspect
        */
       void initialize (ParameterHandler &prm);
 
+      /**
+       * Invalidate all data that depends on the mesh. Called from
+       * Simulator::setup_dofs() whenever the mesh or the degrees of freedom
+       * change.
+       */
+      void setup_dofs ();
+
       /**
        * Do initialization routine for all volume of fluid fields
        */
@@ -156,6 +163,13 @@ namespace aspect
        */
       Simulator<dim> &sim;
 
+      /**
+       * Compute the stencils of neighboring cells used in the interface
+       * reconstruction for the current mesh, and store them in
+       * reconstruction_stencil.
+       */
+      void update_reconstruction_stencil (const Quadrature<dim> &quadrature);
+
       /**
        * Function to copy assembled data to final system. Requires access to
        * the full matrix, so must be in this class.
@@ -178,6 +192,51 @@ namespace aspect
        */
       std::vector<VolumeOfFluidField<dim>> data;
 
+      /**
+       * A structure that holds the 3^dim stencil of neighboring cells of
+       * each locally owned cell that is used in the interface
+       * reconstruction. Finding these cells requires walking across the
+       * faces of each cell and its neighbors, so the stencils are only
+       * computed once after each change of the mesh and then reused for
+       * all fields and time steps.
+       */
+      struct ReconstructionStencil
+      {
+        /**
+         * Whether the stencils describe the current mesh.
+         */
+        bool is_valid;
+
+        /**
+         * The locally owned and ghost cells, indexed by their active cell
+         * index. Entries for artificial cells are invalid iterators.
+         */
+        std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+
+        /**
+         * The active cell indices of the locally owned cells.
+         */
+        std::vector<unsigned int> locally_owned_cells;
+
+        /**
+         * For each active cell index, the active cell indices of the cells
+         * of the stencil of this cell, or numbers::invalid_unsigned_int for
+         * stencil positions that are outside of the mesh or that are not
+         * covered by an active cell on the level of this cell. Only set for
+         * locally owned cells.
+         */
+        std::vector<unsigned int> neighbors;
+
+        /**
+         * The JxW values of each locally owned and ghost cell for the
+         * quadrature formula used in the reconstruction, indexed by
+         * active cell index and quadrature point.
+         */
+        std::vector<double> JxW_values;
+      };
+
+      ReconstructionStencil reconstruction_stencil;
+
       /**
        * Volume fraction threshold for the reconstruction and advection
        * algorithms indicating minimum relevant volume fraction.
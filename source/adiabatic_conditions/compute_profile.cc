@@ -46,8 +46,18 @@ namespace aspect
     {
       if (use_surface_condition_function)
         {
-          initialized = false;
           surface_condition_function.set_time(this->get_time());
+
+          // only recompute the profile if the surface conditions have
+          // actually changed since it was last computed
+          if (initialized
+              &&
+              surface_condition_function.value(Point<1>(0.0),0) == pressures[0]
+              &&
+              surface_condition_function.value(Point<1>(0.0),1) == temperatures[0])
+            return;
+
+          initialized = false;
           initialize();
         }
     }
@@ -66,6 +76,48 @@ namespace aspect
 
       delta_z = this->get_geometry_model().maximal_depth() / (n_points-1);
 
+      // the profile is the same on all processes, so only compute it on
+      // the root process and send it to all others. if the computation
+      // fails on the root process, let the other processes know so that
+      // they do not wait for the profile forever
+      const MPI_Comm mpi_communicator = this->get_mpi_communicator();
+      int error = 0;
+      if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+        {
+          try
+            {
+              compute_profile();
+            }
+          catch (...)
+            {
+              error = 1;
+              MPI_Bcast (&error, 1, MPI_INT, 0, mpi_communicator);
+              throw;
+            }
+        }
+
+      MPI_Bcast (&error, 1, MPI_INT, 0, mpi_communicator);
+      if (error != 0)
+        throw aspect::QuietException();
+
+      MPI_Bcast (temperatures.data(), n_points, MPI_DOUBLE, 0, mpi_communicator);
+      MPI_Bcast (pressures.data(), n_points, MPI_DOUBLE, 0, mpi_communicator);
+      MPI_Bcast (densities.data(), n_points, MPI_DOUBLE, 0, mpi_communicator);
+
+      const double maximal_depth = this->get_geometry_model().maximal_depth();
+      temperature_profile.reinit (maximal_depth, temperatures);
+      pressure_profile.reinit (maximal_depth, pressures);
+      density_profile.reinit (maximal_depth, densities);
+
+      initialized = true;
+    }
+
+
+
+    template <int dim>
+    void
+    ComputeProfile<dim>::compute_profile()
+    {
       MaterialModel::MaterialModelInputs<dim> in(1, this->n_compositional_fields());
       MaterialModel::MaterialModelOutputs<dim> out(1, this->n_compositional_fields());
 
@@ -85,78 +137,115 @@ namespace aspect
                                      1 :
                                      -1;
 
-      // now integrate downward using the explicit Euler method for simplicity
+      // set the position and the composition of the material model inputs
+      // to the ones of the point with index i of the profile
+      const auto set_position = [&] (const unsigned int i)
+      {
+        const double z = double(i)/double(n_points-1)*this->get_geometry_model().maximal_depth();
+        const Point<dim> representative_point = this->get_geometry_model().representative_point (z);
+
+        in.position[0] = representative_point;
+
+        if (reference_composition == initial_composition)
+          for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
+            in.composition[0][c] = this->get_initial_composition_manager().initial_composition(representative_point, c);
+        else if (reference_composition == reference_function)
+          {
+            const double depth = this->get_geometry_model().depth(representative_point);
+            const Point<1> p(depth);
+            for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
+              in.composition[0][c] = composition_function->value(p, c);
+          }
+        else
+          AssertThrow(false,ExcNotImplemented());
+      };
+
+      // evaluate the material model at the current position with the given
+      // pressure and temperature. we approximate the pressure gradient by
+      // extrapolating the values from the point above
+      const auto evaluate = [&] (const double pressure,
+                                 const double temperature,
+                                 const double pressure_above)
+      {
+        const Tensor <1,dim> g = this->get_gravity_model().gravity_vector(in.position[0]);
+
+        in.temperature[0] = temperature;
+        in.pressure[0] = pressure;
+        in.pressure_gradient[0] = g/(g.norm() != 0.0 ? g.norm() : 1.0)
+                                  * (pressure - pressure_above) / delta_z;
+
+        this->get_material_model().evaluate(in, out);
+      };
+
+      // return the derivatives of pressure and temperature with respect to
+      // depth for the current material model inputs and outputs
       //
       // note: p'(z) = rho(p,T) * |g|
       //       T'(z) = alpha |g| T / C_p
-      for (unsigned int i=0; i<n_points; ++i)
+      const auto derivatives = [&] ()
+      {
+        const double density = out.densities[0];
+        const double alpha = out.thermal_expansion_coefficients[0];
+        // Handle the case that cp is zero (happens in simple Stokes test problems like sol_cx). By setting
+        // 1/cp = 0.0 we will have a constant temperature profile with depth.
+        const double one_over_cp = (out.specific_heat[0]>0.0) ? 1.0/out.specific_heat[0] : 0.0;
+        // get the magnitude of gravity. we assume
+        // that gravity always points along the depth direction. this
+        // may not strictly be true always but is likely a good enough
+        // approximation here.
+        const double gravity = gravity_direction * this->get_gravity_model().gravity_vector(in.position[0]).norm();
+
+        return std::make_pair (density * gravity,
+                               (this->include_adiabatic_heating())
+                               ?
+                               alpha * gravity * in.temperature[0] * one_over_cp
+                               :
+                               0.0);
+      };
+
+      if (!use_surface_condition_function)
         {
-          if (i==0)
-            {
-              if (!use_surface_condition_function)
-                {
-                  pressures[0] = this->get_surface_pressure();
-                  temperatures[0] = this->get_adiabatic_surface_temperature();
-                }
-              else
-                {
-                  pressures[0] = surface_condition_function.value(Point<1>(0.0),0);
-                  temperatures[0] = surface_condition_function.value(Point<1>(0.0),1);
-                }
-            }
-          else
-            {
-              // use material properties calculated at i-1
-              const double density = out.densities[0];
-              const double alpha = out.thermal_expansion_coefficients[0];
-              // Handle the case that cp is zero (happens in simple Stokes test problems like sol_cx). By setting
-              // 1/cp = 0.0 we will have a constant temperature profile with depth.
-              const double one_over_cp = (out.specific_heat[0]>0.0) ? 1.0/out.specific_heat[0] : 0.0;
-              // get the magnitude of gravity. we assume
-              // that gravity always points along the depth direction. this
-              // may not strictly be true always but is likely a good enough
-              // approximation here.
-              const double gravity = gravity_direction * this->get_gravity_model().gravity_vector(in.position[0]).norm();
-
-              pressures[i] = pressures[i-1] + density * gravity * delta_z;
-              temperatures[i] = (this->include_adiabatic_heating())
-                                ?
-                                temperatures[i-1] * (1 + alpha * gravity * delta_z * one_over_cp)
-                                :
-                                temperatures[0];
-            }
+          pressures[0] = this->get_surface_pressure();
+          temperatures[0] = this->get_adiabatic_surface_temperature();
+        }
+      else
+        {
+          pressures[0] = surface_condition_function.value(Point<1>(0.0),0);
+          temperatures[0] = surface_condition_function.value(Point<1>(0.0),1);
+        }
 
-          const double z = double(i)/double(n_points-1)*this->get_geometry_model().maximal_depth();
-          const Point<dim> representative_point = this->get_geometry_model().representative_point (z);
-          const Tensor <1,dim> g = this->get_gravity_model().gravity_vector(representative_point);
+      set_position (0);
+      evaluate (pressures[0], temperatures[0], pressures[0]);
+      densities[0] = out.densities[0];
 
-          in.position[0] = representative_point;
-          in.temperature[0] = temperatures[i];
-          in.pressure[0] = pressures[i];
+      // now integrate downward. the derivatives at the beginning of each
+      // step are those computed from the material model outputs at the end
+      // of the previous step
+      for (unsigned int i=1; i<n_points; ++i)
+        {
+          const std::pair<double,double> derivatives_above = derivatives();
 
-          // we approximate the pressure gradient by extrapolating the values
-          // from the two points above
-          if (i>0)
-            in.pressure_gradient[0] = g/(g.norm() != 0.0 ? g.norm() : 1.0)
-                                      * (pressures[i] - pressures[i-1]) / delta_z;
-          else
-            in.pressure_gradient[0] = Tensor <1,dim> ();
+          // the explicit Euler step, which is also the predictor of Heun's
+          // method
+          pressures[i] = pressures[i-1] + derivatives_above.first * delta_z;
+          temperatures[i] = temperatures[i-1] + derivatives_above.second * delta_z;
 
-          if (reference_composition == initial_composition)
-            for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
-              in.composition[0][c] = this->get_initial_composition_manager().initial_composition(representative_point, c);
-          else if (reference_composition == reference_function)
+          set_position (i);
+
+          // for Heun's method, correct the step with the mean of the
+          // derivatives at both of its ends. this is second order accurate
+          // and needs far fewer points for the same accuracy, at the cost
+          // of a second material model evaluation per point
+          if (integration_scheme == heun)
             {
-              const double depth = this->get_geometry_model().depth(representative_point);
-              const Point<1> p(depth);
-              for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
-                in.composition[0][c] = composition_function->value(p, c);
-            }
-          else
-            AssertThrow(false,ExcNotImplemented());
+              evaluate (pressures[i], temperatures[i], pressures[i-1]);
+              const std::pair<double,double> derivatives_below = derivatives();
 
-          this->get_material_model().evaluate(in, out);
+              pressures[i] = pressures[i-1] + 0.5 * (derivatives_above.first + derivatives_below.first) * delta_z;
+              temperatures[i] = temperatures[i-1] + 0.5 * (derivatives_above.second + derivatives_below.second) * delta_z;
+            }
 
+          evaluate (pressures[i], temperatures[i], pressures[i-1]);
           densities[i] = out.densities[0];
         }
 
@@ -178,9 +267,6 @@ namespace aspect
       Assert (*std::min_element (temperatures.begin(), temperatures.end()) >=
               -std::numeric_limits<double>::epsilon() * temperatures.size(),
               ExcMessage("Adiabatic ComputeProfile encountered a negative temperature."));
-
-
-      initialized = true;
     }
 
 
@@ -197,6 +283,9 @@ namespace aspect
     template <int dim>
     double ComputeProfile<dim>::pressure (const Point<dim> &p) const
     {
+      if (initialized)
+        return pressure_profile.value(this->get_geometry_model().depth(p));
+
       return get_property(p,pressures);
     }
 
@@ -205,6 +294,9 @@ namespace aspect
     template <int dim>
     double ComputeProfile<dim>::temperature (const Point<dim> &p) const
     {
+      if (initialized)
+        return temperature_profile.value(this->get_geometry_model().depth(p));
+
       return get_property(p,temperatures);
     }
 
@@ -213,6 +305,9 @@ namespace aspect
     template <int dim>
     double ComputeProfile<dim>::density (const Point<dim> &p) const
     {
+      if (initialized)
+        return density_profile.value(this->get_geometry_model().depth(p));
+
       return get_property(p,densities);
     }
 
@@ -223,6 +318,9 @@ namespace aspect
     {
       const double z = this->get_geometry_model().depth(p);
 
+      if (initialized)
+        return density_profile.derivative(z);
+
       if (z >= this->get_geometry_model().maximal_depth())
         {
           Assert (z <= this->get_geometry_model().maximal_depth() + delta_z,
@@ -306,12 +404,24 @@ namespace aspect
                              "profile. The higher the number of points, the more accurate "
                              "the downward integration from the adiabatic surface "
                              "temperature will be.");
+          prm.declare_entry ("Integration scheme", "Euler",
+                             Patterns::Selection ("Euler|Heun"),
+                             "The method used to integrate the pressure and temperature "
+                             "downward from the surface. 'Euler' is the first order explicit "
+                             "Euler method that evaluates the material model once per point. "
+                             "'Heun' is the second order predictor-corrector method of Heun "
+                             "that evaluates the material model twice per point, but is "
+                             "much more accurate for the same number of points, so that "
+                             "the 'Number of points' can usually be reduced considerably. "
+                             "In either case, the profile is only computed on one process "
+                             "and then sent to all others.");
           prm.declare_entry ("Use surface condition function", "false",
                              Patterns::Bool(),
                              "Whether to use the 'Surface condition function' to determine surface "
                              "conditions, or the 'Adiabatic surface temperature' and 'Surface pressure' "
                              "parameters. If this is set to true the reference profile is updated "
-                             "every timestep. The function expression of the function should be "
+                             "every timestep in which the surface conditions change. The function "
+                             "expression of the function should be "
                              "independent of space, but can depend on time 't'. The function must "
                              "return two components, the first one being reference surface pressure, "
                              "the second one being reference surface temperature.");
@@ -366,6 +476,14 @@ namespace aspect
             }
 
           n_points = prm.get_integer ("Number of points");
+
+          if (prm.get ("Integration scheme") == "Euler")
+            integration_scheme = euler;
+          else if (prm.get ("Integration scheme") == "Heun")
+            integration_scheme = heun;
+          else
+            AssertThrow(false, ExcNotImplemented());
+
           use_surface_condition_function = prm.get_bool("Use surface condition function");
           if (use_surface_condition_function)
             {
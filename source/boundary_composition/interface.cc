@@ -24,6 +24,7 @@
 
 #include <aspect/utilities.h>
 #include <aspect/simulator_access.h>
+#include <aspect/profiler.h>
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/signaling_nan.h>
@@ -95,6 +96,9 @@ namespace aspect
     {
       for (unsigned int i=0; i<boundary_composition_objects.size(); ++i)
         {
+          const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                "Boundary composition model",
+                                                model_names[i]);
           boundary_composition_objects[i]->update();
         }
       return;
@@ -226,10 +230,15 @@ namespace aspect
       double composition = 0.0;
 
       for (unsigned int i=0; i<boundary_composition_objects.size(); ++i)
-        composition = model_operators[i](composition,
-                                         boundary_composition_objects[i]->boundary_composition(boundary_indicator,
-                                             position,
-                                             compositional_field));
+        {
+          const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                "Boundary composition model",
+                                                model_names[i]);
+          composition = model_operators[i](composition,
+                                           boundary_composition_objects[i]->boundary_composition(boundary_indicator,
+                                               position,
+                                               compositional_field));
+        }
 
       return composition;
     }
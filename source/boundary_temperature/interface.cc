@@ -22,6 +22,7 @@
 #include <aspect/global.h>
 #include <aspect/boundary_temperature/interface.h>
 #include <aspect/simulator_access.h>
+#include <aspect/profiler.h>
 
 #include <aspect/utilities.h>
 
@@ -94,6 +95,9 @@ namespace aspect
     {
       for (unsigned int i=0; i<boundary_temperature_objects.size(); ++i)
         {
+          const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                "Boundary temperature model",
+                                                model_names[i]);
           boundary_temperature_objects[i]->update();
         }
       return;
@@ -216,9 +220,14 @@ namespace aspect
       double temperature = 0.0;
 
       for (unsigned int i=0; i<boundary_temperature_objects.size(); ++i)
-        temperature = model_operators[i](temperature,
-                                         boundary_temperature_objects[i]->boundary_temperature(boundary_indicator,
-                                             position));
+        {
+          const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                "Boundary temperature model",
+                                                model_names[i]);
+          temperature = model_operators[i](temperature,
+                                           boundary_temperature_objects[i]->boundary_temperature(boundary_indicator,
+                                               position));
+        }
 
       return temperature;
     }
@@ -65,6 +65,7 @@ namespace aspect
       const unsigned int n_compositional_fields = this->n_compositional_fields();
 
       // The pressure at the surface
+      std::vector<double> pressure (n_points, -1);
       pressure[0]    = this->get_surface_pressure();
 
       // For spherical(-like) domains, modify the representative point:
@@ -117,40 +118,41 @@ namespace aspect
         AssertThrow(false, ExcNotImplemented());
 
       // Set up the input for the density function of the material model.
-      typename MaterialModel::Interface<dim>::MaterialModelInputs in0(1, n_compositional_fields);
-      typename MaterialModel::Interface<dim>::MaterialModelOutputs out0(1, n_compositional_fields);
+      // The same objects are used for all points of the profile.
+      typename MaterialModel::Interface<dim>::MaterialModelInputs in(1, n_compositional_fields);
+      typename MaterialModel::Interface<dim>::MaterialModelOutputs out(1, n_compositional_fields);
+
+      // We do not need the viscosity.
+      in.strain_rate.resize(0);
 
       // Where to calculate the density
       // for spherical domains
       if (dynamic_cast<const GeometryModel::Box<dim>*> (&this->get_geometry_model()) == nullptr &&
           dynamic_cast<const GeometryModel::TwoMergedBoxes<dim>*> (&this->get_geometry_model()) == nullptr)
-        in0.position[0] = Utilities::Coordinates::spherical_to_cartesian_coordinates<dim>(spherical_representative_point);
+        in.position[0] = Utilities::Coordinates::spherical_to_cartesian_coordinates<dim>(spherical_representative_point);
       // and for cartesian domains
       else
-        in0.position[0] = representative_point;
+        in.position[0] = representative_point;
 
       // We need the initial temperature at this point
-      in0.temperature[0] = this->get_initial_temperature_manager().initial_temperature(in0.position[0]);
+      in.temperature[0] = this->get_initial_temperature_manager().initial_temperature(in.position[0]);
 
       // and the surface pressure.
-      in0.pressure[0] = pressure[0];
+      in.pressure[0] = pressure[0];
 
       // Then the compositions at this point.
       for (unsigned int c=0; c<n_compositional_fields; ++c)
-        in0.composition[0][c] = this->get_initial_composition_manager().initial_composition(in0.position[0], c);
-
-      // We do not need the viscosity.
-      in0.strain_rate.resize(0);
+        in.composition[0][c] = this->get_initial_composition_manager().initial_composition(in.position[0], c);
 
       // Evaluate the material model to get the density.
-      this->get_material_model().evaluate(in0, out0);
-      const double density0 = out0.densities[0];
+      this->get_material_model().evaluate(in, out);
+      const double density0 = out.densities[0];
 
       // Get the magnitude of gravity. We assume
       // that gravity always points along the depth direction. This
       // may not strictly be true always but is likely a good enough
       // approximation here.
-      const double gravity0 = this->get_gravity_model().gravity_vector(in0.position[0]).norm();
+      const double gravity0 = this->get_gravity_model().gravity_vector(in.position[0]).norm();
 
       // Now integrate pressure downward using trapezoidal integration
       // p'(z) = rho(p,c,T) * |g| * delta_z
@@ -163,10 +165,6 @@ namespace aspect
                                                        + std::string(" is bigger than the size of the pressure vector ")
                                                        + dealii::Utilities::int_to_string(pressure.size())));
 
-          // Set up the input for the density function of the material model
-          typename MaterialModel::Interface<dim>::MaterialModelInputs in(1, n_compositional_fields);
-          typename MaterialModel::Interface<dim>::MaterialModelOutputs out(1, n_compositional_fields);
-
           // Where to calculate the density:
           // for spherical domains
           if (dynamic_cast<const GeometryModel::Box<dim>*> (&this->get_geometry_model()) == nullptr)
@@ -192,9 +190,6 @@ namespace aspect
           for (unsigned int c=0; c<n_compositional_fields; ++c)
             in.composition[0][c] = this->get_initial_composition_manager().initial_composition(in.position[0], c);
 
-          // We do not need the viscosity.
-          in.strain_rate.resize(0);
-
           // Evaluate the material model to get the density at the current point.
           this->get_material_model().evaluate(in, out);
           const double density = out.densities[0];
@@ -211,6 +206,7 @@ namespace aspect
               -std::numeric_limits<double>::epsilon() * pressure.size(),
               ExcInternalError());
 
+      pressure_profile.reinit (this->get_geometry_model().maximal_depth(), pressure);
     }
 
     template <int dim>
@@ -224,40 +220,27 @@ namespace aspect
       // components are left set to zero. We get the lithostatic pressure
       // from a linear interpolation of the calculated profile.
       Tensor<1,dim> traction;
-      traction = -interpolate_pressure(p) * normal;
+      traction = -pressure_profile.value(this->get_geometry_model().depth(p)) * normal;
 
       return traction;
     }
 
+
+
     template <int dim>
-    double
+    void
     InitialLithostaticPressure<dim>::
-    interpolate_pressure (const Point<dim> &p) const
+    boundary_tractions (const types::boundary_id,
+                        const std::vector<Point<dim> > &positions,
+                        const std::vector<Tensor<1,dim> > &normal_vectors,
+                        std::vector<Tensor<1,dim> > &tractions) const
     {
-      // The depth at which we need the pressure.
-      const double z = this->get_geometry_model().depth(p);
-
-      // Check that depth does not exceed the maximal depth.
-      if (z >= this->get_geometry_model().maximal_depth())
-        {
-          Assert (z <= this->get_geometry_model().maximal_depth() + delta_z,
-                  ExcInternalError());
-          // Return deepest (last) pressure
-          return pressure.back();
-        }
+      const GeometryModel::Interface<dim> &geometry_model = this->get_geometry_model();
 
-      const unsigned int i = static_cast<unsigned int>(z/delta_z);
-      Assert ((z/delta_z) >= 0, ExcInternalError());
-      Assert (i+1 < pressure.size(), ExcInternalError());
-
-      // Now do the linear interpolation.
-      const double d=1.0+i-z/delta_z;
-      Assert ((d>=0) && (d<=1), ExcInternalError());
-
-      return d*pressure[i]+(1-d)*pressure[i+1];
+      for (unsigned int q=0; q<positions.size(); ++q)
+        tractions[q] = -pressure_profile.value(geometry_model.depth(positions[q])) * normal_vectors[q];
     }
 
-
     template <int dim>
     void
     InitialLithostaticPressure<dim>::declare_parameters (ParameterHandler &prm)
@@ -312,8 +295,6 @@ namespace aspect
 
       // Check that we have enough integration points for this mesh.
       AssertThrow(std::pow(2.0,refinement) <= n_points, ExcMessage("Not enough integration points for this resolution."));
-
-      pressure.resize(n_points,-1);
     }
 
   }
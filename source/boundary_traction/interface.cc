@@ -85,6 +85,23 @@ namespace aspect
     DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 
 
+    template <int dim>
+    void
+    Interface<dim>::boundary_tractions (const types::boundary_id boundary_indicator,
+                                        const std::vector<Point<dim> > &positions,
+                                        const std::vector<Tensor<1,dim> > &normal_vectors,
+                                        std::vector<Tensor<1,dim> > &tractions) const
+    {
+      Assert (positions.size() == normal_vectors.size(),
+              ExcDimensionMismatch (positions.size(), normal_vectors.size()));
+      Assert (positions.size() == tractions.size(),
+              ExcDimensionMismatch (positions.size(), tractions.size()));
+
+      for (unsigned int q=0; q<positions.size(); ++q)
+        tractions[q] = this->boundary_traction (boundary_indicator, positions[q], normal_vectors[q]);
+    }
+
+
     template <int dim>
     void
     Interface<dim>::
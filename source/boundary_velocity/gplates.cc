@@ -25,6 +25,8 @@
 
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/table.h>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -41,6 +43,17 @@ namespace aspect
   {
     namespace internal
     {
+      namespace
+      {
+        /**
+         * The first bytes of a velocity file in the binary format written
+         * by GPlatesLookup::write_binary_file().
+         */
+        const std::string binary_file_header = "ASPECT GPlates velocities 1\n";
+      }
+
+
+
       template <int dim>
       GPlatesLookup<dim>::GPlatesLookup(const Tensor<1,2> &surface_point_one,
                                         const Tensor<1,2> &surface_point_two)
@@ -148,97 +161,142 @@ namespace aspect
                                     const MPI_Comm &comm)
       {
         // Read data from disk and distribute among processes
-        std::istringstream filecontent(
-          Utilities::read_and_distribute_file_content(filename, comm));
+        const std::string filecontent = Utilities::read_and_distribute_file_content(filename, comm);
 
-        boost::property_tree::ptree pt;
+        if (filecontent.compare(0, binary_file_header.size(), binary_file_header) == 0)
+          {
+            // Files in the binary format only need to be copied into the
+            // table of velocities
+            std::size_t position = binary_file_header.size();
+
+            AssertThrow(filecontent.size() >= position + 2*sizeof(std::uint32_t),
+                        ExcMessage (std::string("The binary velocity file <") + filename + "> is too short. File corrupted?"));
+
+            std::uint32_t n_theta, n_phi;
+            std::memcpy(&n_theta, &filecontent[position], sizeof(n_theta));
+            position += sizeof(n_theta);
+            std::memcpy(&n_phi, &filecontent[position], sizeof(n_phi));
+            position += sizeof(n_phi);
+
+            AssertThrow(n_theta >= 2 && n_phi >= 2
+                        &&
+                        filecontent.size() == position + 2*sizeof(double)*n_theta*n_phi,
+                        ExcMessage (std::string("The size of the binary velocity file <") + filename
+                                    + "> does not match the grid size given in its header. File corrupted?"));
+
+            velocity_values.reinit(n_theta,n_phi);
+            for (unsigned int idx_theta = 0; idx_theta < n_theta; ++idx_theta)
+              for (unsigned int idx_phi = 0; idx_phi < n_phi; ++idx_phi)
+                for (unsigned int c = 0; c < 2; ++c)
+                  {
+                    std::memcpy(&velocity_values[idx_theta][idx_phi][c], &filecontent[position], sizeof(double));
+                    position += sizeof(double);
+                  }
+          }
+        else
+          {
+            std::istringstream filestream(filecontent);
+            boost::property_tree::ptree pt;
 
-        // populate tree structure pt
-        read_xml(filecontent, pt);
+            // populate tree structure pt
+            read_xml(filestream, pt);
 
-        const unsigned int n_points = pt.get_child("gpml:FeatureCollection.gml:featureMember.gpml:VelocityField.gml:domainSet.gml:MultiPoint").size();
+            const unsigned int n_points = pt.get_child("gpml:FeatureCollection.gml:featureMember.gpml:VelocityField.gml:domainSet.gml:MultiPoint").size();
 
-        // These formulas look magic, but they are the proper solution to the equation:
-        // n_points = n_theta * n_phi with n_phi = 2 * (n_theta - 1)
-        // From the XML information we only know n_points, but need n_theta
-        // and n_phi to properly size the arrays and get the grip point positions
-        const double dn_theta = 0.5 + std::sqrt(0.25 + n_points/2);
-        const unsigned int n_theta = static_cast<unsigned int> (dn_theta);
-        const unsigned int n_phi = static_cast<unsigned int> (2 * (dn_theta - 1));
+            // These formulas look magic, but they are the proper solution to the equation:
+            // n_points = n_theta * n_phi with n_phi = 2 * (n_theta - 1)
+            // From the XML information we only know n_points, but need n_theta
+            // and n_phi to properly size the arrays and get the grip point positions
+            const double dn_theta = 0.5 + std::sqrt(0.25 + n_points/2);
+            const unsigned int n_theta = static_cast<unsigned int> (dn_theta);
+            const unsigned int n_phi = static_cast<unsigned int> (2 * (dn_theta - 1));
 
-        AssertThrow(dn_theta - n_theta <= 1e-5,
-                    ExcMessage("The velocity file has a grid structure that is not readable. Please refer to the manual for a proper grid structure."));
+            AssertThrow(dn_theta - n_theta <= 1e-5,
+                        ExcMessage("The velocity file has a grid structure that is not readable. Please refer to the manual for a proper grid structure."));
 
-        delta_theta =   numbers::PI / (n_theta-1);
-        delta_phi   = 2*numbers::PI / n_phi;
+            velocity_values.reinit(n_theta,n_phi);
 
-        /**
-         * Two tables (one for the theta and one for the phi component)
-         * which contain the velocities at every point.
-         * velocity_values[0] is the table for the theta component, whereas
-         * velocity_values[1] is the table for the phi component.
-         */
-        Table<2,double> velocity_values[2] = {Table<2,double>(n_theta,n_phi), Table<2,double>(n_theta,n_phi)};
+            std::string velos = pt.get<std::string>("gpml:FeatureCollection.gml:featureMember.gpml:VelocityField.gml:rangeSet.gml:DataBlock.gml:tupleList");
+            std::stringstream in(velos, std::ios::in);
+            AssertThrow (in,
+                         ExcMessage (std::string("Could not find velocities. Is file native gpml format for velocities?")));
 
-        std::string velos = pt.get<std::string>("gpml:FeatureCollection.gml:featureMember.gpml:VelocityField.gml:rangeSet.gml:DataBlock.gml:tupleList");
-        std::stringstream in(velos, std::ios::in);
-        AssertThrow (in,
-                     ExcMessage (std::string("Could not find velocities. Is file native gpml format for velocities?")));
+            // The lat-lon mesh has changed its starting longitude in gplates1.4
+            // correct for this while reading in the velocity data
+            unsigned int longitude_correction = 0;
+            if (gplates_1_4_or_higher(pt))
+              longitude_correction = n_phi/2;
 
-        // The lat-lon mesh has changed its starting longitude in gplates1.4
-        // correct for this while reading in the velocity data
-        unsigned int longitude_correction = 0;
-        if (gplates_1_4_or_higher(pt))
-          longitude_correction = n_phi/2;
+            unsigned int i = 0;
+            char sep;
+            Tensor<1,2> spherical_velocities;
 
-        unsigned int i = 0;
-        char sep;
-        Tensor<1,2> spherical_velocities;
+            while (in >> spherical_velocities[0] >> sep >> spherical_velocities[1])
+              {
+                const double cmyr_si = 0.01/year_in_seconds;
 
-        while (in >> spherical_velocities[0] >> sep >> spherical_velocities[1])
-          {
-            const double cmyr_si = 0.01/year_in_seconds;
+                const unsigned int idx_theta = i / n_phi;
+                const unsigned int idx_phi = (i + longitude_correction) % n_phi;
 
-            const unsigned int idx_theta = i / n_phi;
-            const unsigned int idx_phi = (i + longitude_correction) % n_phi;
+                velocity_values[idx_theta][idx_phi] = spherical_velocities * cmyr_si;
 
-            velocity_values[0][idx_theta][idx_phi]= spherical_velocities[0] * cmyr_si;
-            velocity_values[1][idx_theta][idx_phi]= spherical_velocities[1] * cmyr_si;
+                i++;
+              }
 
-            i++;
+            AssertThrow(i == n_points,
+                        ExcMessage (std::string("Number of read in points does not match number of points in file. File corrupted?")));
           }
 
-        // number of intervals in the direction of theta and phi
-        std::array<unsigned int,2> table_intervals;
-        table_intervals[0] = n_theta - 1;
-        table_intervals[1] = n_phi - 1;
+        delta_theta =   numbers::PI / (velocity_values.size(0)-1);
+        delta_phi   = 2*numbers::PI / velocity_values.size(1);
+      }
 
-        // Min and Max coordinates in data file
-        std::array<std::pair<double,double>,2> grid_extent;
 
-        // min and max extent of the grid in the direction of theta and phi (whole spheres in GPlates)
-        // polar angle theta: from 0° to 180°(PI)
-        grid_extent[0].first = 0;
-        grid_extent[0].second = numbers::PI;
-        // azimuthal angle phi: from 0° to 360°(2*PI)
-        grid_extent[1].first = 0;
-        grid_extent[1].second = 2 * numbers::PI;
 
-        for (unsigned int i = 0; i < 2; i++)
-          {
-            velocities[i]
-              = std_cxx14::make_unique<Functions::InterpolatedUniformGridData<2>> (grid_extent,
-                                                                                   table_intervals,
-                                                                                   velocity_values[i]);
-          }
+      template <int dim>
+      void
+      GPlatesLookup<dim>::write_binary_file(const std::string &filename,
+                                            const MPI_Comm &comm) const
+      {
+        if (Utilities::MPI::this_mpi_process(comm) != 0)
+          return;
+
+        std::ofstream file(filename.c_str(), std::ios::binary);
+        AssertThrow (file,
+                     ExcMessage (std::string("Could not open file <") + filename + "> for writing."));
 
-        AssertThrow(i == n_points,
-                    ExcMessage (std::string("Number of read in points does not match number of points in file. File corrupted?")));
+        const std::uint32_t n_theta = velocity_values.size(0);
+        const std::uint32_t n_phi = velocity_values.size(1);
+
+        file.write(binary_file_header.data(), binary_file_header.size());
+        file.write(reinterpret_cast<const char *>(&n_theta), sizeof(n_theta));
+        file.write(reinterpret_cast<const char *>(&n_phi), sizeof(n_phi));
+
+        for (unsigned int idx_theta = 0; idx_theta < n_theta; ++idx_theta)
+          for (unsigned int idx_phi = 0; idx_phi < n_phi; ++idx_phi)
+            for (unsigned int c = 0; c < 2; ++c)
+              file.write(reinterpret_cast<const char *>(&velocity_values[idx_theta][idx_phi][c]), sizeof(double));
+
+        AssertThrow (file,
+                     ExcMessage (std::string("Writing the file <") + filename + "> failed."));
       }
 
+
+
       template <int dim>
-      Tensor<1,dim>
-      GPlatesLookup<dim>::surface_velocity(const Point<dim> &position) const
+      bool
+      GPlatesLookup<dim>::has_same_grid(const GPlatesLookup<dim> &other) const
+      {
+        return (velocity_values.size(0) == other.velocity_values.size(0)
+                &&
+                velocity_values.size(1) == other.velocity_values.size(1));
+      }
+
+
+
+      template <int dim>
+      typename GPlatesLookup<dim>::SurfacePointStencil
+      GPlatesLookup<dim>::compute_stencil(const Point<dim> &position) const
       {
         const Point<3> internal_position ((dim == 2)
                                           ?
@@ -250,11 +308,13 @@ namespace aspect
         std::array<double,3> spherical_point =
           Utilities::Coordinates::cartesian_to_spherical_coordinates(internal_position);
 
-        Tensor<1,dim> output_boundary_velocity;
+        SurfacePointStencil stencil;
+        stencil.n_points = 0;
+
         // Handle all points that are not close to the poles
         if ((spherical_point[2] >= delta_theta) && (spherical_point[2] <= numbers::PI - delta_theta))
           {
-            output_boundary_velocity = cartesian_velocity_at_surface_point(spherical_point);
+            add_point_to_stencil(spherical_point, 1.0, stencil);
           }
 
         // The longitude of data points at the poles is set to zero (according to the internal
@@ -266,61 +326,129 @@ namespace aspect
           {
             const double theta = spherical_point[2];
             spherical_point[2] = delta_theta;
-            const Tensor<1,dim> first_velocity = cartesian_velocity_at_surface_point(spherical_point);
+            add_point_to_stencil(spherical_point, theta / delta_theta, stencil);
 
             spherical_point[1] = 0.0;
             spherical_point[2] = 0.0;
-            const Tensor<1,dim> polar_velocity = cartesian_velocity_at_surface_point(spherical_point);
-
-            output_boundary_velocity = (theta / delta_theta) * first_velocity
-                                       + (1.0 - theta / delta_theta) * polar_velocity;
+            add_point_to_stencil(spherical_point, 1.0 - theta / delta_theta, stencil);
           }
         else if (spherical_point[2] > numbers::PI - delta_theta)
           {
             const double theta = spherical_point[2];
             spherical_point[2] = numbers::PI - delta_theta;
-            const Tensor<1,dim> first_velocity = cartesian_velocity_at_surface_point(spherical_point);
+            add_point_to_stencil(spherical_point, (numbers::PI - theta) / delta_theta, stencil);
 
             spherical_point[1] = 0.0;
             spherical_point[2] = numbers::PI;
-            const Tensor<1,dim> polar_velocity = cartesian_velocity_at_surface_point(spherical_point);
-
-            output_boundary_velocity = ((numbers::PI - theta) / delta_theta) * first_velocity
-                                       + (1.0 - (numbers::PI - theta) / delta_theta) * polar_velocity;
+            add_point_to_stencil(spherical_point, 1.0 - (numbers::PI - theta) / delta_theta, stencil);
           }
         else
           Assert(false,ExcInternalError());
 
-        return output_boundary_velocity;
+        return stencil;
       }
 
+
+
       template <int dim>
       Tensor<1,dim>
-      GPlatesLookup<dim>::cartesian_velocity_at_surface_point(const std::array<double,3> &spherical_point) const
+      GPlatesLookup<dim>::surface_velocity(const Point<dim> &position) const
       {
-        // Re-sort the components of the spherical position from [r,phi,theta] to [theta, phi]
-        const Point<2> lookup_coordinates(spherical_point[2],spherical_point[1]);
+        return surface_velocity(compute_stencil(position));
+      }
 
-        // Main work, interpolate velocity at this point
-        Tensor<1,2> interpolated_velocity;
 
-        for (unsigned int i = 0; i < 2; i++)
-          interpolated_velocity[i] = velocities[i]->value(lookup_coordinates);
 
-        // Transform interpolated_velocity in cartesian coordinates
-        const Tensor<1,3> interpolated_velocity_in_cart = sphere_to_cart_velocity(interpolated_velocity,spherical_point);
+      template <int dim>
+      Tensor<1,dim>
+      GPlatesLookup<dim>::surface_velocity(const SurfacePointStencil &stencil) const
+      {
+        Tensor<1,dim> output_boundary_velocity;
 
-        // Convert_tensor conveniently also handles the projection to the 2D plane by
-        // omitting the z-component of velocity (since the 2D model lies in the x-y plane).
-        const Tensor<1,dim> output_boundary_velocity = (dim == 2)
-                                                       ?
-                                                       convert_tensor<3,dim>(transpose(rotation_matrix) * interpolated_velocity_in_cart)
-                                                       :
-                                                       convert_tensor<3,dim>(interpolated_velocity_in_cart);
+        for (unsigned int k = 0; k < stencil.n_points; ++k)
+          {
+            const unsigned int idx_theta = stencil.cell[k][0];
+            const unsigned int idx_phi = stencil.cell[k][1];
+            const std::array<double,4> &weights = stencil.weights[k];
+
+            // Main work, interpolate velocity at this point
+            const Tensor<1,2> interpolated_velocity = weights[0] * velocity_values[idx_theta][idx_phi]
+                                                      + weights[1] * velocity_values[idx_theta+1][idx_phi]
+                                                      + weights[2] * velocity_values[idx_theta][idx_phi+1]
+                                                      + weights[3] * velocity_values[idx_theta+1][idx_phi+1];
+
+            output_boundary_velocity += interpolated_velocity[0] * stencil.unit_velocities[k][0]
+                                        + interpolated_velocity[1] * stencil.unit_velocities[k][1];
+          }
 
         return output_boundary_velocity;
       }
 
+
+
+      template <int dim>
+      void
+      GPlatesLookup<dim>::add_point_to_stencil(const std::array<double,3> &spherical_point,
+                                               const double weight,
+                                               SurfacePointStencil &stencil) const
+      {
+        Assert (stencil.n_points < 2, ExcInternalError());
+        const unsigned int k = stencil.n_points++;
+
+        // Re-sort the components of the spherical position from [r,phi,theta] to [theta, phi]
+        const std::array<double,2> lookup_coordinates = {{spherical_point[2], spherical_point[1]}};
+
+        // The grid covers the whole sphere: the polar angle theta from 0 to PI
+        // and the azimuthal angle phi from 0 to 2*PI
+        const std::array<double,2> grid_extent = {{numbers::PI, 2 * numbers::PI}};
+        const unsigned int n_theta = velocity_values.size(0);
+        const unsigned int n_phi = velocity_values.size(1);
+        const std::array<unsigned int,2> table_intervals = {{n_theta - 1, n_phi - 1}};
+
+        // Find the grid cell that contains the point and the position of the
+        // point within this cell in the same way as
+        // Functions::InterpolatedUniformGridData, i.e., truncate points that lie
+        // outside the grid to its boundary
+        std::array<double,2> unit_point;
+        for (unsigned int d = 0; d < 2; ++d)
+          {
+            const double delta = grid_extent[d] / table_intervals[d];
+
+            if (lookup_coordinates[d] <= 0.0)
+              stencil.cell[k][d] = 0;
+            else if (lookup_coordinates[d] >= grid_extent[d] - delta)
+              stencil.cell[k][d] = table_intervals[d] - 1;
+            else
+              stencil.cell[k][d] = static_cast<unsigned int>(lookup_coordinates[d] / delta);
+
+            unit_point[d] = std::max(std::min((lookup_coordinates[d] - stencil.cell[k][d] * delta) / delta, 1.), 0.);
+          }
+
+        stencil.weights[k][0] = (1.0 - unit_point[0]) * (1.0 - unit_point[1]);
+        stencil.weights[k][1] = unit_point[0] * (1.0 - unit_point[1]);
+        stencil.weights[k][2] = (1.0 - unit_point[0]) * unit_point[1];
+        stencil.weights[k][3] = unit_point[0] * unit_point[1];
+
+        // The conversion of the interpolated velocity into cartesian coordinates
+        // is linear, so we can store the model velocities that correspond to
+        // unit velocities in theta and phi direction
+        for (unsigned int c = 0; c < 2; ++c)
+          {
+            Tensor<1,2> unit_velocity;
+            unit_velocity[c] = 1.0;
+
+            const Tensor<1,3> velocity_in_cart = sphere_to_cart_velocity(unit_velocity,spherical_point);
+
+            // Convert_tensor conveniently also handles the projection to the 2D plane by
+            // omitting the z-component of velocity (since the 2D model lies in the x-y plane).
+            stencil.unit_velocities[k][c] = weight * ((dim == 2)
+                                                      ?
+                                                      convert_tensor<3,dim>(transpose(rotation_matrix) * velocity_in_cart)
+                                                      :
+                                                      convert_tensor<3,dim>(velocity_in_cart));
+          }
+      }
+
       template <int dim>
       Tensor<1,3>
       GPlatesLookup<dim>::cartesian_surface_coordinates(const Tensor<1,3> &sposition) const
@@ -535,6 +663,7 @@ namespace aspect
       data_file_time_step(0.0),
       time_weight(0.0),
       time_dependent(true),
+      write_binary_files(false),
       point1("0.0,0.0"),
       point2("0.0,0.0"),
       lithosphere_thickness(0.0),
@@ -543,6 +672,13 @@ namespace aspect
     {}
 
 
+    template <int dim>
+    GPlates<dim>::~GPlates ()
+    {
+      post_refinement_connection.disconnect();
+    }
+
+
     template <int dim>
     void
     GPlates<dim>::initialize ()
@@ -573,6 +709,14 @@ namespace aspect
       // display the GPlates module information at model start.
       this->get_pcout() << lookup->screen_output(pointone, pointtwo);
 
+      // the boundary support points change when the mesh changes, so
+      // forget the stencils computed for the old ones
+      post_refinement_connection = this->get_triangulation().signals.post_refinement.connect(
+        [this]()
+      {
+        stencil_cache.clear();
+      });
+
       // Set the first file number and load the first files
       current_file_number = first_data_file_number;
 
@@ -588,7 +732,7 @@ namespace aspect
 
       const std::string filename (create_filename (current_file_number));
       if (Utilities::fexists(filename))
-        lookup->load_file(filename,this->get_mpi_communicator());
+        load_file(filename);
       else
         AssertThrow(false,
                     ExcMessage (std::string("GPlates data file <")
@@ -613,7 +757,7 @@ namespace aspect
           if (Utilities::fexists(filename))
             {
               lookup.swap(old_lookup);
-              lookup->load_file(filename,this->get_mpi_communicator());
+              load_file(filename);
             }
           else
             end_time_dependence ();
@@ -638,6 +782,11 @@ namespace aspect
     void
     GPlates<dim>::update ()
     {
+      // the boundary support points move if the mesh is deformed, so the
+      // stencils computed for their old positions can not be used anymore
+      if (this->get_parameters().free_surface_enabled)
+        stencil_cache.clear();
+
       const double time_since_start = this->get_time() - first_data_file_model_time;
 
       if (time_dependent && (time_since_start >= 0.0))
@@ -684,6 +833,25 @@ namespace aspect
         }
     }
 
+    template <int dim>
+    void
+    GPlates<dim>::load_file (const std::string &filename)
+    {
+      lookup->load_file(filename,this->get_mpi_communicator());
+
+      if (write_binary_files
+          &&
+          !(filename.size() >= 4 && filename.compare(filename.size()-4, 4, ".bin") == 0))
+        lookup->write_binary_file(filename + ".bin",this->get_mpi_communicator());
+
+      // the cached stencils can only be shared between files with grids of
+      // the same size
+      if (!lookup->has_same_grid(*old_lookup))
+        stencil_cache.clear();
+    }
+
+
+
     template <int dim>
     void
     GPlates<dim>::update_data (const bool load_both_files)
@@ -699,7 +867,7 @@ namespace aspect
           if (Utilities::fexists(filename))
             {
               lookup.swap(old_lookup);
-              lookup->load_file(filename,this->get_mpi_communicator());
+              load_file(filename);
             }
 
           // If loading current_time_step failed, end time dependent part with old_file_number.
@@ -720,7 +888,7 @@ namespace aspect
       if (Utilities::fexists(filename))
         {
           lookup.swap(old_lookup);
-          lookup->load_file(filename,this->get_mpi_communicator());
+          load_file(filename);
         }
 
       // If next file does not exist, end time dependent part with current_time_step.
@@ -759,13 +927,43 @@ namespace aspect
       // velocities are not prescribed at every point on the surface.
       const double magic_number = 1e-7 * this->get_geometry_model().maximal_depth();
 
-      if ((this->get_time() - first_data_file_model_time >= 0.0) && (this->get_geometry_model().depth(position) <= lithosphere_thickness + magic_number))
+      if (this->get_time() - first_data_file_model_time < 0.0)
+        return Tensor<1,dim>();
+
+      // if both data files use the same grid, the position only needs to be
+      // located in the grid once, and this information can be reused as long
+      // as the mesh does not change
+      if (!time_dependent || lookup->has_same_grid(*old_lookup))
         {
-          const Tensor<1,dim> data = lookup->surface_velocity(position);
+          auto &cache = stencil_cache.get();
+          auto cached_point_data = cache.find(position);
+          if (cached_point_data == cache.end())
+            {
+              std::pair<bool,typename internal::GPlatesLookup<dim>::SurfacePointStencil> new_point_data;
+              new_point_data.first = (this->get_geometry_model().depth(position) <= lithosphere_thickness + magic_number);
+              if (new_point_data.first)
+                new_point_data.second = lookup->compute_stencil(position);
+              cached_point_data = cache.emplace(position, new_point_data).first;
+            }
+          const std::pair<bool,typename internal::GPlatesLookup<dim>::SurfacePointStencil> &point_data
+            = cached_point_data->second;
+
+          if (!point_data.first)
+            return Tensor<1,dim>();
+
+          const Tensor<1,dim> data = lookup->surface_velocity(point_data.second);
 
           if (!time_dependent)
             return data;
 
+          const Tensor<1,dim> old_data = old_lookup->surface_velocity(point_data.second);
+
+          return time_weight * data + (1 - time_weight) * old_data;
+        }
+
+      if (this->get_geometry_model().depth(position) <= lithosphere_thickness + magic_number)
+        {
+          const Tensor<1,dim> data = lookup->surface_velocity(position);
           const Tensor<1,dim> old_data = old_lookup->surface_velocity(position);
 
           return time_weight * data + (1 - time_weight) * old_data;
@@ -775,6 +973,19 @@ namespace aspect
     }
 
 
+
+    template <int dim>
+    bool
+    GPlates<dim>::PointComparator::operator() (const Point<dim> &p1,
+                                               const Point<dim> &p2) const
+    {
+      for (unsigned int d = 0; d < dim; ++d)
+        if (p1[d] != p2[d])
+          return p1[d] < p2[d];
+      return false;
+    }
+
+
     template <int dim>
     void
     GPlates<dim>::declare_parameters (ParameterHandler &prm)
@@ -828,6 +1039,16 @@ namespace aspect
                              "You might want to use this to scale the velocities to a "
                              "reference model (e.g. with free-slip boundary) or another "
                              "plate reconstruction.");
+          prm.declare_entry ("Write binary velocity files", "false",
+                             Patterns::Bool (),
+                             "Whether every velocity file that is read in the gpml format "
+                             "should also be written in a binary format, to a file with the "
+                             "same name and the additional ending `.bin'. Reading these files "
+                             "is much faster than reading gpml files, because they do not need "
+                             "to be parsed. The plugin recognizes binary files by their content, "
+                             "so subsequent model runs can use them by appending `.bin' to the "
+                             "'Velocity file name'. The binary files use the byte order of the "
+                             "machine they were written on.");
           prm.declare_entry ("Point one", "1.570796,0.0",
                              Patterns::Anything (),
                              "Point that determines the plane in which a 2D model lies in. Has to be in the format `a,b' where a and b are theta (polar angle)  and phi in radians.");
@@ -861,6 +1082,7 @@ namespace aspect
           first_data_file_number     = prm.get_integer("First data file number");
           decreasing_file_order      = prm.get_bool   ("Decreasing file order");
           scale_factor               = prm.get_double ("Scale factor");
+          write_binary_files         = prm.get_bool   ("Write binary velocity files");
           point1                     = prm.get        ("Point one");
           point2                     = prm.get        ("Point two");
           lithosphere_thickness      = prm.get_double ("Lithosphere thickness");
@@ -883,6 +1105,12 @@ namespace aspect
 {
   namespace BoundaryVelocity
   {
+    namespace internal
+    {
+      template class GPlatesLookup<2>;
+      template class GPlatesLookup<3>;
+    }
+
     ASPECT_REGISTER_BOUNDARY_VELOCITY_MODEL(GPlates,
                                             "gplates",
                                             "Implementation of a model in which the boundary "
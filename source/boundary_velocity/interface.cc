@@ -22,6 +22,7 @@
 #include <aspect/global.h>
 #include <aspect/boundary_velocity/interface.h>
 #include <aspect/simulator_access.h>
+#include <aspect/profiler.h>
 
 #include <deal.II/base/exceptions.h>
 #include <tuple>
@@ -83,10 +84,16 @@ namespace aspect
       for (typename std::map<types::boundary_id,std::vector<std::shared_ptr<BoundaryVelocity::Interface<dim> > > >::const_iterator
            boundary = boundary_velocity_objects.begin();
            boundary != boundary_velocity_objects.end(); ++boundary)
-        for (typename std::vector<std::shared_ptr<BoundaryVelocity::Interface<dim>>>::const_iterator
-             p = boundary->second.begin();
-             p != boundary->second.end(); ++p)
-          (*p)->update();
+        {
+          const std::vector<std::string> &names = boundary_velocity_indicators.find(boundary->first)->second.second;
+          for (unsigned int i=0; i<boundary->second.size(); ++i)
+            {
+              const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                    "Boundary velocity model",
+                                                    names[i]);
+              boundary->second[i]->update();
+            }
+        }
 
       return;
     }
@@ -131,13 +138,18 @@ namespace aspect
                         "boundary velocity at a boundary that contains no active "
                         "boundary velocity plugin."));
 
+      const std::vector<std::string> &names = boundary_velocity_indicators.find(boundary_indicator)->second.second;
+
       Tensor<1,dim> velocity = Tensor<1,dim>();
 
-      for (typename std::vector<std::shared_ptr<BoundaryVelocity::Interface<dim> > >::const_iterator
-           plugin = boundary_plugins->second.begin();
-           plugin != boundary_plugins->second.end(); ++plugin)
-        velocity += (*plugin)->boundary_velocity(boundary_indicator,
-                                                 position);
+      for (unsigned int i=0; i<boundary_plugins->second.size(); ++i)
+        {
+          const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                "Boundary velocity model",
+                                                names[i]);
+          velocity += boundary_plugins->second[i]->boundary_velocity(boundary_indicator,
+                                                                     position);
+        }
 
       return velocity;
     }
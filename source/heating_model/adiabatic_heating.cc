@@ -21,6 +21,7 @@
 
 #include <aspect/heating_model/adiabatic_heating.h>
 #include <aspect/gravity_model/interface.h>
+#include <aspect/quadrature_point_geometry.h>
 
 
 namespace aspect
@@ -51,11 +52,20 @@ namespace aspect
                                                             * material_model_outputs.thermal_expansion_coefficients[q]
                                                             * material_model_inputs.temperature[q];
           else
-            heating_model_outputs.heating_source_terms[q] = (material_model_inputs.velocity[q]
-                                                             * this->get_gravity_model().gravity_vector(material_model_inputs.position[q]))
-                                                            * material_model_outputs.thermal_expansion_coefficients[q]
-                                                            * material_model_inputs.temperature[q]
-                                                            * material_model_outputs.densities[q];
+            {
+              const typename QuadraturePointGeometry<dim>::PointData *point_data
+                = this->get_quadrature_point_geometry().get_point_data(material_model_inputs, q);
+              const Tensor<1,dim> gravity = (point_data != nullptr
+                                             ?
+                                             point_data->gravity
+                                             :
+                                             this->get_gravity_model().gravity_vector(material_model_inputs.position[q]));
+
+              heating_model_outputs.heating_source_terms[q] = (material_model_inputs.velocity[q] * gravity)
+                                                              * material_model_outputs.thermal_expansion_coefficients[q]
+                                                              * material_model_inputs.temperature[q]
+                                                              * material_model_outputs.densities[q];
+            }
 
           heating_model_outputs.lhs_latent_heat_terms[q] = 0.0;
         }
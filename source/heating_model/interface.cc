@@ -21,6 +21,7 @@
 
 #include <aspect/global.h>
 #include <aspect/utilities.h>
+#include <aspect/profiler.h>
 #include <aspect/heating_model/interface.h>
 #include <aspect/heating_model/adiabatic_heating.h>
 #include <aspect/heating_model/shear_heating.h>
@@ -207,10 +208,14 @@ namespace aspect
     void
     Manager<dim>::update ()
     {
+      unsigned int index = 0;
       for (typename std::list<std::shared_ptr<HeatingModel::Interface<dim> > >::const_iterator
            heating_model = heating_model_objects.begin();
-           heating_model != heating_model_objects.end(); ++heating_model)
+           heating_model != heating_model_objects.end(); ++heating_model, ++index)
         {
+          const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                "Heating model",
+                                                model_names[index]);
           (*heating_model)->update();
         }
     }
@@ -236,11 +241,17 @@ namespace aspect
       const MaterialModel::ReactionRateOutputs<dim> *reaction_rate_outputs
         = material_model_outputs.template get_additional_output<MaterialModel::ReactionRateOutputs<dim> >();
 
+      unsigned int index = 0;
       for (typename std::list<std::shared_ptr<HeatingModel::Interface<dim> > >::const_iterator
            heating_model = heating_model_objects.begin();
-           heating_model != heating_model_objects.end(); ++heating_model)
+           heating_model != heating_model_objects.end(); ++heating_model, ++index)
         {
-          (*heating_model)->evaluate(material_model_inputs, material_model_outputs, individual_heating_outputs);
+          {
+            const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                  "Heating model",
+                                                  model_names[index]);
+            (*heating_model)->evaluate(material_model_inputs, material_model_outputs, individual_heating_outputs);
+          }
           for (unsigned int q=0; q<heating_model_outputs.heating_source_terms.size(); ++q)
             {
               heating_model_outputs.heating_source_terms[q] += individual_heating_outputs.heating_source_terms[q];
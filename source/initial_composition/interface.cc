@@ -22,6 +22,7 @@
 #include <aspect/global.h>
 #include <aspect/utilities.h>
 #include <aspect/initial_composition/interface.h>
+#include <aspect/profiler.h>
 
 #include <deal.II/base/exceptions.h>
 #include <tuple>
@@ -44,6 +45,16 @@ namespace aspect
     {}
 
 
+    template <int dim>
+    void
+    Interface<dim>::initial_compositions (const Point<dim> &position,
+                                          std::vector<double> &compositions) const
+    {
+      for (unsigned int c=0; c<compositions.size(); ++c)
+        compositions[c] = initial_composition (position, c);
+    }
+
+
     template <int dim>
     void
     Interface<dim>::
@@ -169,6 +180,9 @@ namespace aspect
            initial_composition_object != initial_composition_objects.end();
            ++initial_composition_object)
         {
+          const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                "Initial composition model",
+                                                model_names[i]);
           composition = model_operators[i](composition,
                                            (*initial_composition_object)->initial_composition(position,n_comp));
           i++;
@@ -178,6 +192,33 @@ namespace aspect
     }
 
 
+    template <int dim>
+    void
+    Manager<dim>::initial_compositions (const Point<dim> &position,
+                                        std::vector<double> &compositions) const
+    {
+      std::fill (compositions.begin(), compositions.end(), 0.0);
+      std::vector<double> plugin_compositions (compositions.size());
+      int i = 0;
+
+      for (typename std::list<std::shared_ptr<InitialComposition::Interface<dim> > >::const_iterator
+           initial_composition_object = initial_composition_objects.begin();
+           initial_composition_object != initial_composition_objects.end();
+           ++initial_composition_object)
+        {
+          {
+            const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                  "Initial composition model",
+                                                  model_names[i]);
+            (*initial_composition_object)->initial_compositions(position, plugin_compositions);
+          }
+          for (unsigned int c=0; c<compositions.size(); ++c)
+            compositions[c] = model_operators[i](compositions[c], plugin_compositions[c]);
+          i++;
+        }
+    }
+
+
     template <int dim>
     const std::vector<std::string> &
     Manager<dim>::get_active_initial_composition_names () const
@@ -39,6 +39,21 @@ namespace aspect
                                                    n_comp);
     }
 
+
+
+    template <int dim>
+    void
+    WorldBuilder<dim>::
+    initial_compositions (const Point<dim> &position,
+                          std::vector<double> &compositions) const
+    {
+      const std::array<double,dim> point = Utilities::convert_point_to_array(position);
+      const double depth = this->get_geometry_model().depth(position);
+
+      for (unsigned int c=0; c<compositions.size(); ++c)
+        compositions[c] = this->get_world_builder().composition(point, depth, c);
+    }
+
   }
 }
 
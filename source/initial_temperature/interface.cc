@@ -21,6 +21,7 @@
 
 #include <aspect/global.h>
 #include <aspect/initial_temperature/interface.h>
+#include <aspect/profiler.h>
 
 #include <deal.II/base/exceptions.h>
 #include <tuple>
@@ -157,6 +158,9 @@ namespace aspect
            initial_temperature_object != initial_temperature_objects.end();
            ++initial_temperature_object)
         {
+          const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                "Initial temperature model",
+                                                model_names[i]);
           temperature = model_operators[i](temperature,
                                            (*initial_temperature_object)->initial_temperature(position));
           i++;
@@ -21,6 +21,7 @@
 #include <aspect/material_model/depth_dependent.h>
 #include <aspect/utilities.h>
 #include <aspect/geometry_model/interface.h>
+#include <aspect/quadrature_point_geometry.h>
 
 #include <array>
 
@@ -171,7 +172,13 @@ namespace aspect
           // Scale the base model viscosity value by the depth dependent prefactor
           for (unsigned int i=0; i < out.viscosities.size(); ++i)
             {
-              const double depth = this->get_geometry_model().depth(in.position[i]);
+              const typename QuadraturePointGeometry<dim>::PointData *point_data
+                = this->get_quadrature_point_geometry().get_point_data(in, i);
+              const double depth = (point_data != nullptr
+                                    ?
+                                    point_data->depth
+                                    :
+                                    this->get_geometry_model().depth(in.position[i]));
               out.viscosities[i] *= calculate_depth_dependent_prefactor( depth );
             }
         }
@@ -179,6 +186,32 @@ namespace aspect
 
 
 
+    template <int dim>
+    void
+    DepthDependent<dim>::evaluate_batch(const MaterialModel::MaterialModelBatchInputs<dim> &in,
+                                        MaterialModel::MaterialModelOutputs<dim> &out) const
+    {
+      base_model->evaluate_batch(in,out);
+      if (in.strain_rate.size())
+        {
+          // Scale the base model viscosity value by the depth dependent prefactor
+          for (unsigned int c=0; c < in.n_cells(); ++c)
+            for (unsigned int i=in.cell_offsets[c]; i < in.cell_offsets[c+1]; ++i)
+              {
+                const typename QuadraturePointGeometry<dim>::PointData *point_data
+                  = this->get_quadrature_point_geometry().get_point_data(in.cells[c], i-in.cell_offsets[c], in.position[i]);
+                const double depth = (point_data != nullptr
+                                      ?
+                                      point_data->depth
+                                      :
+                                      this->get_geometry_model().depth(in.position[i]));
+                out.viscosities[i] *= calculate_depth_dependent_prefactor( depth );
+              }
+        }
+    }
+
+
+
     template <int dim>
     void
     DepthDependent<dim>::declare_parameters (ParameterHandler &prm)
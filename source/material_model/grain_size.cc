@@ -83,6 +83,55 @@ namespace aspect
 
     namespace Lookup
     {
+      namespace
+      {
+        /**
+         * Return a table in which every entry is the average of the entries
+         * of @p values in a box of 2 @p width + 1 entries in each direction
+         * around it. The box is clipped at the edges of the table. The
+         * averages are computed from a table of partial sums, so the cost
+         * does not depend on @p width.
+         */
+        Table<2,double>
+        box_average (const Table<2,double> &values,
+                     const unsigned int width)
+        {
+          const unsigned int n_rows = values.n_rows();
+          const unsigned int n_cols = values.n_cols();
+
+          // partial_sums[i][j] is the sum of all values[k][l] with k<i and l<j
+          Table<2,double> partial_sums (n_rows+1, n_cols+1);
+          for (unsigned int i=0; i<n_rows; ++i)
+            for (unsigned int j=0; j<n_cols; ++j)
+              partial_sums[i+1][j+1] = values[i][j]
+                                       + partial_sums[i][j+1]
+                                       + partial_sums[i+1][j]
+                                       - partial_sums[i][j];
+
+          Table<2,double> averages (n_rows, n_cols);
+          for (unsigned int i=0; i<n_rows; ++i)
+            {
+              const unsigned int row_begin = (i > width ? i - width : 0);
+              const unsigned int row_end = std::min (i + width + 1, n_rows);
+
+              for (unsigned int j=0; j<n_cols; ++j)
+                {
+                  const unsigned int col_begin = (j > width ? j - width : 0);
+                  const unsigned int col_end = std::min (j + width + 1, n_cols);
+
+                  const double sum = partial_sums[row_end][col_end]
+                                     - partial_sums[row_begin][col_end]
+                                     - partial_sums[row_end][col_begin]
+                                     + partial_sums[row_begin][col_begin];
+
+                  averages[i][j] = sum / ((row_end - row_begin) * (col_end - col_begin));
+                }
+            }
+
+          return averages;
+        }
+      }
+
       double
       MaterialLookup::specific_heat(double temperature,
                                     double pressure) const
@@ -216,6 +265,87 @@ namespace aspect
         return derivatives;
       }
 
+      void
+      MaterialLookup::compute_smoothed_enthalpy_derivatives (const unsigned int smoothing_width)
+      {
+        AssertThrow (n_temperature > 1 && n_pressure > 1,
+                     ExcMessage ("Smoothed enthalpy derivatives can only be computed for material "
+                                 "tables with at least two temperature and two pressure points."));
+        AssertThrow (enthalpy_values.n_rows() == n_temperature
+                     && enthalpy_values.n_cols() == n_pressure,
+                     ExcMessage ("The material table does not contain enthalpy values."));
+
+        Table<2,double> dHdT_values (n_temperature, n_pressure);
+        Table<2,double> dHdp_values (n_temperature, n_pressure);
+
+        // use centered differences in the interior of the table, and
+        // one-sided differences at its edges
+        for (unsigned int i=0; i<n_temperature; ++i)
+          {
+            const unsigned int i_minus = (i > 0 ? i-1 : i);
+            const unsigned int i_plus = (i+1 < n_temperature ? i+1 : i);
+
+            for (unsigned int j=0; j<n_pressure; ++j)
+              {
+                const unsigned int j_minus = (j > 0 ? j-1 : j);
+                const unsigned int j_plus = (j+1 < n_pressure ? j+1 : j);
+
+                dHdT_values[i][j] = (enthalpy_values[i_plus][j] - enthalpy_values[i_minus][j])
+                                    / ((i_plus - i_minus) * delta_temp);
+                dHdp_values[i][j] = (enthalpy_values[i][j_plus] - enthalpy_values[i][j_minus])
+                                    / ((j_plus - j_minus) * delta_press);
+              }
+          }
+
+        smoothed_dHdT_values = box_average (dHdT_values, smoothing_width);
+        smoothed_dHdp_values = box_average (dHdp_values, smoothing_width);
+      }
+
+      bool
+      MaterialLookup::has_smoothed_enthalpy_derivatives () const
+      {
+        return (smoothed_dHdT_values.n_rows() == n_temperature
+                && smoothed_dHdT_values.n_cols() == n_pressure
+                && n_temperature > 0);
+      }
+
+      std::array<std::pair<double, unsigned int>,2>
+      MaterialLookup::smoothed_enthalpy_derivatives (const std::vector<double> &temperatures,
+                                                     const std::vector<double> &pressures) const
+      {
+        Assert(temperatures.size() == pressures.size(),ExcInternalError());
+        Assert(has_smoothed_enthalpy_derivatives(),
+               ExcMessage("The smoothed enthalpy derivatives have not been computed."));
+
+        const unsigned int n_q_points = temperatures.size();
+        unsigned int n_samples(0);
+        double dHdT(0.0), dHdp(0.0);
+
+        // only average over the points that lie within the table. outside
+        // of it, value() would return the derivatives at its edge, which
+        // are not derivatives at these points
+        for (unsigned int q=0; q<n_q_points; ++q)
+          if (temperatures[q] >= min_temp && temperatures[q] <= max_temp
+              &&
+              pressures[q] >= min_press && pressures[q] <= max_press)
+            {
+              dHdT += value(temperatures[q],pressures[q],smoothed_dHdT_values,true);
+              dHdp += value(temperatures[q],pressures[q],smoothed_dHdp_values,true);
+              ++n_samples;
+            }
+
+        if (n_samples > 0)
+          {
+            dHdT /= n_samples;
+            dHdp /= n_samples;
+          }
+
+        std::array<std::pair<double, unsigned int>,2> derivatives;
+        derivatives[0] = std::make_pair(dHdT,n_samples);
+        derivatives[1] = std::make_pair(dHdp,n_samples);
+        return derivatives;
+      }
+
       double
       MaterialLookup::dRhodp (const double temperature,
                               const double pressure) const
@@ -637,6 +767,9 @@ namespace aspect
                                                                this->get_mpi_communicator()));
           else
             AssertThrow (false, ExcNotImplemented());
+
+          if (use_table_properties && use_enthalpy && use_smoothed_enthalpy_derivatives)
+            material_lookup.back()->compute_smoothed_enthalpy_derivatives (enthalpy_derivative_smoothing_width);
         }
     }
 
@@ -1270,9 +1403,14 @@ namespace aspect
           // we use might be on a finer grid than our model. Because of that we compute the enthalpy
           // derivatives by using finite differences that average over the whole temperature and
           // pressure range that is used in this cell. This way we should not miss any phase transformation.
-          derivative = material_lookup[0]->enthalpy_derivatives(temperatures,
-                                                                pressures,
-                                                                max_latent_heat_substeps);
+          // The smoothed derivative tables achieve the same by averaging over a fixed range of the table.
+          if (use_smoothed_enthalpy_derivatives)
+            derivative = material_lookup[0]->smoothed_enthalpy_derivatives(temperatures,
+                                                                           pressures);
+          else
+            derivative = material_lookup[0]->enthalpy_derivatives(temperatures,
+                                                                  pressures,
+                                                                  max_latent_heat_substeps);
         }
 
       return derivative;
@@ -1680,6 +1818,25 @@ namespace aspect
                              Patterns::Integer (1),
                              "The maximum number of substeps over the temperature pressure range "
                              "to calculate the averaged enthalpy gradient over a cell.");
+          prm.declare_entry ("Use smoothed enthalpy derivatives", "false",
+                             Patterns::Bool (),
+                             "Whether to compute the derivatives of the enthalpy with respect to "
+                             "temperature and pressure once for all points of the material table, "
+                             "smooth them, and average the interpolated values at the quadrature "
+                             "points of a cell to compute the thermal expansivity and specific "
+                             "heat. If false, the derivatives are computed by averaging finite "
+                             "differences between all pairs of vertices of a cell, whose cost "
+                             "grows quadratically with the number of vertices and linearly with "
+                             "the number of latent heat substeps. Only used if "
+                             "'Use enthalpy for material properties' is set.");
+          prm.declare_entry ("Enthalpy derivative smoothing width", "1",
+                             Patterns::Integer (0),
+                             "If smoothed enthalpy derivatives are used, the derivatives at each "
+                             "point of the material table are averaged over this many table points "
+                             "in each direction of temperature and pressure. Choose this value so "
+                             "that the smoothing box roughly covers the temperature and pressure "
+                             "range of a cell, so that phase transitions that are narrower than a "
+                             "cell are not missed.");
           prm.declare_entry ("Minimum grain size", "1e-5",
                              Patterns::Double (0),
                              "The minimum grain size that is used for the material model. This parameter "
@@ -1845,6 +2002,8 @@ namespace aspect
           min_thermal_expansivity               = prm.get_double ("Minimum thermal expansivity");
           max_thermal_expansivity               = prm.get_double ("Maximum thermal expansivity");
           max_latent_heat_substeps              = prm.get_integer ("Maximum latent heat substeps");
+          use_smoothed_enthalpy_derivatives     = prm.get_bool ("Use smoothed enthalpy derivatives");
+          enthalpy_derivative_smoothing_width   = prm.get_integer ("Enthalpy derivative smoothing width");
           min_grain_size                        = prm.get_double ("Minimum grain size");
           pv_grain_size_scaling                 = prm.get_double ("Lower mantle grain size scaling");
 
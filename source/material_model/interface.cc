@@ -26,6 +26,7 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <tuple>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/fe_q.h>
@@ -106,6 +107,55 @@ namespace aspect
     {}
 
 
+
+    template <int dim>
+    void
+    Interface<dim>::evaluate_batch (const MaterialModel::MaterialModelBatchInputs<dim> &in,
+                                    MaterialModel::MaterialModelOutputs<dim> &out) const
+    {
+      Assert (out.additional_outputs.empty(),
+              ExcMessage ("The default implementation of MaterialModel::Interface::evaluate_batch() "
+                          "does not support additional material model outputs."));
+      Assert (out.viscosities.size() == in.n_points(),
+              ExcDimensionMismatch (out.viscosities.size(), in.n_points()));
+
+      const unsigned int n_comp = in.composition.size();
+
+      // evaluate the model cell by cell, and only create new input and
+      // output objects if the number of points changes
+      std::unique_ptr<MaterialModelInputs<dim> > cell_in;
+      std::unique_ptr<MaterialModelOutputs<dim> > cell_out;
+      for (unsigned int cell=0; cell<in.n_cells(); ++cell)
+        {
+          const unsigned int first_point = in.cell_offsets[cell];
+          const unsigned int n_points = in.cell_offsets[cell+1] - first_point;
+
+          if (!cell_in || cell_in->position.size() != n_points)
+            {
+              cell_in = std_cxx14::make_unique<MaterialModelInputs<dim> > (n_points, n_comp);
+              cell_out = std_cxx14::make_unique<MaterialModelOutputs<dim> > (n_points, n_comp);
+            }
+
+          in.get_cell_inputs (cell, *cell_in);
+          evaluate (*cell_in, *cell_out);
+
+          for (unsigned int q=0; q<n_points; ++q)
+            {
+              const unsigned int i = first_point + q;
+              out.viscosities[i] = cell_out->viscosities[q];
+              out.densities[i] = cell_out->densities[q];
+              out.thermal_expansion_coefficients[i] = cell_out->thermal_expansion_coefficients[q];
+              out.specific_heat[i] = cell_out->specific_heat[q];
+              out.thermal_conductivities[i] = cell_out->thermal_conductivities[q];
+              out.compressibilities[i] = cell_out->compressibilities[q];
+              out.entropy_derivative_pressure[i] = cell_out->entropy_derivative_pressure[q];
+              out.entropy_derivative_temperature[i] = cell_out->entropy_derivative_temperature[q];
+              out.reaction_terms[i] = cell_out->reaction_terms[q];
+            }
+        }
+    }
+
+
 // -------------------------------- Deal with registering material models and automating
 // -------------------------------- their setup and selection at run time
 
@@ -397,6 +447,142 @@ namespace aspect
 
     }
 
+    template <int dim>
+    MaterialModelBatchInputs<dim>::MaterialModelBatchInputs (const unsigned int n_comp)
+      :
+      composition (n_comp),
+      cell_offsets (1, 0)
+    {}
+
+
+
+    template <int dim>
+    void
+    MaterialModelBatchInputs<dim>::clear ()
+    {
+      position.clear ();
+      temperature.clear ();
+      pressure.clear ();
+      pressure_gradient.clear ();
+      velocity.clear ();
+      strain_rate.clear ();
+      for (unsigned int c=0; c<composition.size(); ++c)
+        composition[c].clear ();
+      cells.clear ();
+      cell_offsets.resize (1);
+    }
+
+
+
+    template <int dim>
+    void
+    MaterialModelBatchInputs<dim>::add_cell (const FEValuesBase<dim,dim> &fe_values,
+                                             const typename DoFHandler<dim>::active_cell_iterator &cell,
+                                             const Introspection<dim> &introspection,
+                                             const LinearAlgebra::BlockVector &solution_vector,
+                                             const bool use_strain_rate)
+    {
+      Assert (composition.size() == introspection.n_compositional_fields,
+              ExcDimensionMismatch (composition.size(), introspection.n_compositional_fields));
+      Assert (cells.empty() || (strain_rate.size() > 0) == use_strain_rate,
+              ExcMessage ("All cells of a batch need to either use strain rates or not."));
+
+      const unsigned int n_q_points = fe_values.n_quadrature_points;
+      scalar_values.resize (n_q_points);
+      vector_values.resize (n_q_points);
+
+      const std::vector<Point<dim> > &quadrature_points = fe_values.get_quadrature_points();
+      position.insert (position.end(), quadrature_points.begin(), quadrature_points.end());
+
+      fe_values[introspection.extractors.temperature].get_function_values (solution_vector, scalar_values);
+      temperature.insert (temperature.end(), scalar_values.begin(), scalar_values.end());
+
+      fe_values[introspection.extractors.pressure].get_function_values (solution_vector, scalar_values);
+      pressure.insert (pressure.end(), scalar_values.begin(), scalar_values.end());
+
+      fe_values[introspection.extractors.pressure].get_function_gradients (solution_vector, vector_values);
+      pressure_gradient.insert (pressure_gradient.end(), vector_values.begin(), vector_values.end());
+
+      fe_values[introspection.extractors.velocities].get_function_values (solution_vector, vector_values);
+      velocity.insert (velocity.end(), vector_values.begin(), vector_values.end());
+
+      if (use_strain_rate)
+        {
+          symmetric_gradients.resize (n_q_points);
+          fe_values[introspection.extractors.velocities].get_function_symmetric_gradients (solution_vector, symmetric_gradients);
+          strain_rate.insert (strain_rate.end(), symmetric_gradients.begin(), symmetric_gradients.end());
+        }
+
+      for (unsigned int c=0; c<composition.size(); ++c)
+        {
+          fe_values[introspection.extractors.compositional_fields[c]].get_function_values (solution_vector, scalar_values);
+          composition[c].insert (composition[c].end(), scalar_values.begin(), scalar_values.end());
+        }
+
+      cells.push_back (cell);
+      cell_offsets.push_back (position.size());
+    }
+
+
+
+    template <int dim>
+    void
+    MaterialModelBatchInputs<dim>::get_cell_inputs (const unsigned int cell_index,
+                                                    MaterialModelInputs<dim> &cell_inputs) const
+    {
+      AssertIndexRange (cell_index, n_cells());
+      const unsigned int first_point = cell_offsets[cell_index];
+      const unsigned int n_points = cell_offsets[cell_index+1] - first_point;
+      Assert (cell_inputs.position.size() == n_points,
+              ExcDimensionMismatch (cell_inputs.position.size(), n_points));
+
+      for (unsigned int q=0; q<n_points; ++q)
+        {
+          const unsigned int i = first_point + q;
+          cell_inputs.position[q] = position[i];
+          cell_inputs.temperature[q] = temperature[i];
+          cell_inputs.pressure[q] = pressure[i];
+          cell_inputs.pressure_gradient[q] = pressure_gradient[i];
+          cell_inputs.velocity[q] = velocity[i];
+          for (unsigned int c=0; c<composition.size(); ++c)
+            cell_inputs.composition[q][c] = composition[c][i];
+        }
+
+      if (strain_rate.size() > 0)
+        {
+          cell_inputs.strain_rate.resize (n_points);
+          for (unsigned int q=0; q<n_points; ++q)
+            cell_inputs.strain_rate[q] = strain_rate[first_point + q];
+        }
+      else
+        cell_inputs.strain_rate.resize (0);
+
+      cell_inputs.current_cell = cells[cell_index];
+      DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
+      cell_inputs.cell = (cell_inputs.current_cell.state() == IteratorState::valid ? &cell_inputs.current_cell : nullptr);
+      DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
+    }
+
+
+
+    template <int dim>
+    unsigned int
+    MaterialModelBatchInputs<dim>::n_points () const
+    {
+      return position.size();
+    }
+
+
+
+    template <int dim>
+    unsigned int
+    MaterialModelBatchInputs<dim>::n_cells () const
+    {
+      return cells.size();
+    }
+
+
+
     template <int dim>
     MaterialModelOutputs<dim>::MaterialModelOutputs(const unsigned int n_points,
                                                     const unsigned int n_comp)
@@ -504,20 +690,18 @@ namespace aspect
 
             case harmonic_average:
             {
-              // if one of the values is zero, the average is 0.0
-              for (unsigned int i=0; i<N; ++i)
-                if (values_out[i] == 0.0)
-                  {
-                    for (unsigned int j=0; j<N; ++j)
-                      values_out[j] = 0.0;
-                    return;
-                  }
-
+              // if one of the values is zero, the average is 0.0. check
+              // this in the same sweep in which we sum the inverses
+              // to avoid a branch in the loop
+              bool has_zero_value = false;
               double sum = 0;
               for (unsigned int i=0; i<N; ++i)
-                sum += 1./values_out[i];
+                {
+                  has_zero_value |= (values_out[i] == 0.0);
+                  sum += 1./values_out[i];
+                }
 
-              const double average = 1./(sum/N);
+              const double average = (has_zero_value ? 0.0 : 1./(sum/N));
               for (unsigned int i=0; i<N; ++i)
                 values_out[i] = average;
               break;
@@ -707,6 +891,138 @@ namespace aspect
       }
 
 
+      /**
+       * Return whether the cell, as described by the given mapping, is an
+       * affine image of the reference cell, i.e., a parallelogram or
+       * parallelepiped. This is the case if the cell and all of its faces
+       * and edges are associated with a flat manifold (so that the mapping
+       * does not curve them), and if each vertex is the sum of the first
+       * vertex and the edge vectors that lead to it.
+       */
+      template <int dim>
+      bool cell_is_affine (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                           const Mapping<dim>      &mapping)
+      {
+        if (cell->manifold_id() != numbers::flat_manifold_id)
+          return false;
+        for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+          if (cell->face(f)->manifold_id() != numbers::flat_manifold_id)
+            return false;
+        if (dim == 3)
+          for (unsigned int l=0; l<GeometryInfo<dim>::lines_per_cell; ++l)
+            if (cell->line(l)->manifold_id() != numbers::flat_manifold_id)
+              return false;
+
+        const std::array<Point<dim>, GeometryInfo<dim>::vertices_per_cell> vertices
+          = mapping.get_vertices (typename Triangulation<dim>::cell_iterator(cell));
+
+        const double tolerance = 1e-12 * vertices[0].distance (vertices[GeometryInfo<dim>::vertices_per_cell-1]);
+        for (unsigned int v=1; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            // vertex v lies at the end of the edges in the coordinate
+            // directions whose bits are set in v
+            Point<dim> expected_vertex = vertices[0];
+            for (unsigned int d=0; d<dim; ++d)
+              if (v & (1U << d))
+                expected_vertex += vertices[1U << d] - vertices[0];
+
+            if (expected_vertex.distance (vertices[v]) > tolerance)
+              return false;
+          }
+
+        return true;
+      }
+
+
+
+      template <int dim>
+      const AffineProjectionMatrices<dim> &
+      get_affine_projection_matrices (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                                      const Quadrature<dim>   &quadrature_formula,
+                                      const Mapping<dim>      &mapping)
+      {
+        static Threads::ThreadLocalStorage<std::list<AffineProjectionMatrices<dim> > > cache;
+        std::list<AffineProjectionMatrices<dim> > &matrices = cache.get();
+
+        for (const AffineProjectionMatrices<dim> &entry : matrices)
+          if (entry.quadrature_weights == quadrature_formula.get_weights()
+              &&
+              entry.quadrature_points == quadrature_formula.get_points())
+            return entry;
+
+        matrices.emplace_back ();
+        AffineProjectionMatrices<dim> &entry = matrices.back();
+        entry.quadrature_points = quadrature_formula.get_points();
+        entry.quadrature_weights = quadrature_formula.get_weights();
+        compute_projection_matrix (cell,
+                                   quadrature_formula,
+                                   mapping,
+                                   entry.projection_matrix,
+                                   entry.expansion_matrix);
+        return entry;
+      }
+
+
+
+      /**
+       * Perform the project_to_Q1 operation on all of the given arrays at
+       * once. Instead of projecting each array separately, the arrays are
+       * collected as the columns of a matrix, so that the projection and
+       * expansion are each a single matrix-matrix product.
+       */
+      void project_properties_to_Q1 (const FullMatrix<double> &projection_matrix,
+                                     const FullMatrix<double> &expansion_matrix,
+                                     const std::vector<std::vector<double> *> &properties)
+      {
+        const unsigned int N = expansion_matrix.m();
+        const unsigned int P = expansion_matrix.n();
+
+        // skip the output fields that have not been filled (because
+        // they were not requested)
+        std::vector<std::vector<double> *> filled_properties;
+        filled_properties.reserve (properties.size());
+        for (std::vector<double> *property : properties)
+          if (property->size() != 0)
+            {
+              Assert (property->size() == N,
+                      ExcDimensionMismatch (property->size(), N));
+              filled_properties.push_back (property);
+            }
+
+        const unsigned int K = filled_properties.size();
+        if (K == 0)
+          return;
+
+        FullMatrix<double> values (N, K);
+        FullMatrix<double> q1_values (P, K);
+        std::vector<double> min (K, std::numeric_limits<double>::max());
+        std::vector<double> max (K, -std::numeric_limits<double>::max());
+        for (unsigned int k=0; k<K; ++k)
+          for (unsigned int i=0; i<N; ++i)
+            {
+              const double value = (*filled_properties[k])[i];
+              values(i,k) = value;
+              min[k] = std::min (min[k], value);
+              max[k] = std::max (max[k], value);
+            }
+
+        // project onto Q1, restrict the Q1 values to the min/max range of
+        // the original data, and expand back to the quadrature points
+        projection_matrix.mmult (q1_values, values);
+        for (unsigned int i=0; i<P; ++i)
+          for (unsigned int k=0; k<K; ++k)
+            q1_values(i,k) = std::max (min[k],
+                                       std::min (max[k],
+                                                 q1_values(i,k)));
+        expansion_matrix.mmult (values, q1_values);
+
+        for (unsigned int k=0; k<K; ++k)
+          for (unsigned int i=0; i<N; ++i)
+            (*filled_properties[k])[i] = values(i,k);
+      }
+
+
+
       template <int dim>
       void average (const AveragingOperation operation,
                     const typename DoFHandler<dim>::active_cell_iterator &cell,
@@ -714,43 +1030,74 @@ namespace aspect
                     const Mapping<dim>            &mapping,
                     MaterialModelOutputs<dim>     &values_out)
       {
+        const std::vector<std::vector<double> *> properties
+          = { &values_out.viscosities,
+              &values_out.densities,
+              &values_out.thermal_expansion_coefficients,
+              &values_out.specific_heat,
+              &values_out.thermal_conductivities,
+              &values_out.compressibilities,
+              &values_out.entropy_derivative_pressure,
+              &values_out.entropy_derivative_temperature
+            };
+
         FullMatrix<double> projection_matrix;
         FullMatrix<double> expansion_matrix;
 
         if (operation == project_to_Q1)
           {
-            projection_matrix.reinit (quadrature_formula.size(),
-                                      quadrature_formula.size());
-            compute_projection_matrix (cell,
-                                       quadrature_formula,
-                                       mapping,
-                                       projection_matrix,
-                                       expansion_matrix);
+            // use the cached matrices for affine cells, and compute the
+            // matrices for the current cell otherwise
+            const FullMatrix<double> *projection = &projection_matrix;
+            const FullMatrix<double> *expansion = &expansion_matrix;
+            if (cell_is_affine (cell, mapping))
+              {
+                const AffineProjectionMatrices<dim> &matrices
+                  = get_affine_projection_matrices (cell, quadrature_formula, mapping);
+                projection = &matrices.projection_matrix;
+                expansion = &matrices.expansion_matrix;
+              }
+            else
+              compute_projection_matrix (cell,
+                                         quadrature_formula,
+                                         mapping,
+                                         projection_matrix,
+                                         expansion_matrix);
+
+#ifdef DEBUG
+#ifdef ASPECT_USE_FP_EXCEPTIONS
+            // disable floating point exceptions while averaging. Errors will be reported
+            // as soon as somebody will try to use the averaged values later.
+            fedisableexcept(FE_DIVBYZERO|FE_INVALID);
+#endif
+#endif
+
+            project_properties_to_Q1 (*projection, *expansion, properties);
+
+#ifdef DEBUG
+#ifdef ASPECT_USE_FP_EXCEPTIONS
+            // enable floating point exceptions again:
+            feenableexcept(FE_DIVBYZERO|FE_INVALID);
+#endif
+#endif
+
+            // average all additional outputs
+            for (unsigned int i=0; i<values_out.additional_outputs.size(); ++i)
+              values_out.additional_outputs[i]->average (operation, *projection, *expansion);
           }
+        else
+          {
+            for (std::vector<double> *property : properties)
+              average_property (operation, projection_matrix, expansion_matrix, *property);
 
-        average_property (operation, projection_matrix, expansion_matrix, values_out.viscosities);
-        average_property (operation, projection_matrix, expansion_matrix,
-                          values_out.densities);
-        average_property (operation, projection_matrix, expansion_matrix,
-                          values_out.thermal_expansion_coefficients);
-        average_property (operation, projection_matrix, expansion_matrix,
-                          values_out.specific_heat);
-        average_property (operation, projection_matrix, expansion_matrix,
-                          values_out.thermal_conductivities);
-        average_property (operation, projection_matrix, expansion_matrix,
-                          values_out.compressibilities);
-        average_property (operation, projection_matrix, expansion_matrix,
-                          values_out.entropy_derivative_pressure);
-        average_property (operation, projection_matrix, expansion_matrix,
-                          values_out.entropy_derivative_temperature);
+            // average all additional outputs
+            for (unsigned int i=0; i<values_out.additional_outputs.size(); ++i)
+              values_out.additional_outputs[i]->average (operation, projection_matrix, expansion_matrix);
+          }
 
         // the reaction terms are unfortunately stored in reverse
         // indexing. it's also not quite clear whether these should
         // really be averaged, so avoid this for now
-
-        // average all additional outputs
-        for (unsigned int i=0; i<values_out.additional_outputs.size(); ++i)
-          values_out.additional_outputs[i]->average (operation, projection_matrix, expansion_matrix);
       }
     }
 
@@ -954,6 +1301,8 @@ namespace aspect
   \
   template struct MaterialModelInputs<dim>; \
   \
+  template struct MaterialModelBatchInputs<dim>; \
+  \
   template struct MaterialModelOutputs<dim>; \
   \
   template class AdditionalMaterialOutputs<dim>; \
@@ -974,6 +1323,19 @@ namespace aspect
                   const Quadrature<dim>     &quadrature_formula, \
                   const Mapping<dim>        &mapping, \
                   MaterialModelOutputs<dim>      &values_out); \
+    \
+    template \
+    void compute_projection_matrix (const DoFHandler<dim>::active_cell_iterator &cell, \
+                                    const Quadrature<dim>   &quadrature_formula, \
+                                    const Mapping<dim>      &mapping, \
+                                    FullMatrix<double>      &projection_matrix, \
+                                    FullMatrix<double>      &expansion_matrix); \
+    \
+    template \
+    const AffineProjectionMatrices<dim> & \
+    get_affine_projection_matrices (const DoFHandler<dim>::active_cell_iterator &cell, \
+                                    const Quadrature<dim>   &quadrature_formula, \
+                                    const Mapping<dim>      &mapping); \
   }
 
 
@@ -30,6 +30,55 @@ namespace aspect
 {
   namespace MaterialModel
   {
+    template <int dim>
+    void
+    Multicomponent<dim>::
+    evaluate_point(const double temperature,
+                   const std::vector<double> &volume_fractions,
+                   const unsigned int i,
+                   MaterialModel::MaterialModelOutputs<dim> &out) const
+    {
+      out.viscosities[i] = MaterialUtilities::average_value (volume_fractions, viscosities, viscosity_averaging);
+      out.specific_heat[i] = MaterialUtilities::average_value (volume_fractions, specific_heats, MaterialUtilities::arithmetic);
+
+
+      // Arithmetic averaging of thermal conductivities
+      // This may not be strictly the most reasonable thing, but for most Earth materials we hope
+      // that they do not vary so much that it is a big problem.
+      out.thermal_conductivities[i] = MaterialUtilities::average_value (volume_fractions, thermal_conductivities, MaterialUtilities::arithmetic);
+
+      double density = 0.0;
+      for (unsigned int j=0; j < volume_fractions.size(); ++j)
+        {
+          // not strictly correct if thermal expansivities are different, since we are interpreting
+          // these compositions as volume fractions, but the error introduced should not be too bad.
+          const double temperature_factor= (1.0 - thermal_expansivities[j] * (temperature - reference_T));
+          density += volume_fractions[j] * densities[j] * temperature_factor;
+        }
+      out.densities[i] = density;
+
+
+      out.thermal_expansion_coefficients[i] = MaterialUtilities::average_value (volume_fractions, thermal_expansivities, MaterialUtilities::arithmetic);
+
+
+      // Compressibility at the given positions.
+      // The compressibility is given as
+      // $\frac 1\rho \frac{\partial\rho}{\partial p}$.
+      // (here we use an incompressible medium)
+      out.compressibilities[i] = 0.0;
+      // Pressure derivative of entropy at the given positions.
+      out.entropy_derivative_pressure[i] = 0.0;
+      // Temperature derivative of entropy at the given positions.
+      out.entropy_derivative_temperature[i] = 0.0;
+      // Change in composition due to chemical reactions at the
+      // given positions. The term reaction_terms[i][c] is the
+      // change in compositional field c at point i.
+      for (unsigned int c=0; c<volume_fractions.size()-1; ++c)
+        out.reaction_terms[i][c] = 0.0;
+    }
+
+
+
     template <int dim>
     void
     Multicomponent<dim>::
@@ -38,48 +87,44 @@ namespace aspect
     {
       for (unsigned int i=0; i < in.temperature.size(); ++i)
         {
-          const double temperature = in.temperature[i];
-          const std::vector<double> composition = in.composition[i];
-          const std::vector<double> volume_fractions = MaterialUtilities::compute_volume_fractions(composition);
+          const std::vector<double> volume_fractions = MaterialUtilities::compute_volume_fractions(in.composition[i]);
+          evaluate_point (in.temperature[i], volume_fractions, i, out);
+        }
+    }
 
-          out.viscosities[i] = MaterialUtilities::average_value (volume_fractions, viscosities, viscosity_averaging);
-          out.specific_heat[i] = MaterialUtilities::average_value (volume_fractions, specific_heats, MaterialUtilities::arithmetic);
 
 
-          // Arithmetic averaging of thermal conductivities
-          // This may not be strictly the most reasonable thing, but for most Earth materials we hope
-          // that they do not vary so much that it is a big problem.
-          out.thermal_conductivities[i] = MaterialUtilities::average_value (volume_fractions, thermal_conductivities, MaterialUtilities::arithmetic);
+    template <int dim>
+    void
+    Multicomponent<dim>::
+    evaluate_batch(const MaterialModel::MaterialModelBatchInputs<dim> &in,
+                   MaterialModel::MaterialModelOutputs<dim> &out) const
+    {
+      const unsigned int n_comp = in.composition.size();
+      std::vector<double> volume_fractions (n_comp+1);
 
-          double density = 0.0;
-          for (unsigned int j=0; j < volume_fractions.size(); ++j)
+      for (unsigned int i=0; i < in.n_points(); ++i)
+        {
+          // compute the volume fractions in the same way as
+          // MaterialUtilities::compute_volume_fractions(), but into
+          // the preallocated vector
+          double sum_composition = 0.0;
+          for (unsigned int c=0; c<n_comp; ++c)
             {
-              // not strictly correct if thermal expansivities are different, since we are interpreting
-              // these compositions as volume fractions, but the error introduced should not be too bad.
-              const double temperature_factor= (1.0 - thermal_expansivities[j] * (temperature - reference_T));
-              density += volume_fractions[j] * densities[j] * temperature_factor;
+              volume_fractions[c+1] = std::min(std::max(in.composition[c][i], 0.0), 1.0);
+              sum_composition += volume_fractions[c+1];
             }
-          out.densities[i] = density;
-
-
-          out.thermal_expansion_coefficients[i] = MaterialUtilities::average_value (volume_fractions, thermal_expansivities, MaterialUtilities::arithmetic);
 
+          if (sum_composition >= 1.0)
+            {
+              volume_fractions[0] = 0.0;
+              for (unsigned int c=0; c<n_comp; ++c)
+                volume_fractions[c+1] /= sum_composition;
+            }
+          else
+            volume_fractions[0] = 1.0 - sum_composition;
 
-          // Compressibility at the given positions.
-          // The compressibility is given as
-          // $\frac 1\rho \frac{\partial\rho}{\partial p}$.
-          // (here we use an incompressible medium)
-          out.compressibilities[i] = 0.0;
-          // Pressure derivative of entropy at the given positions.
-          out.entropy_derivative_pressure[i] = 0.0;
-          // Temperature derivative of entropy at the given positions.
-          out.entropy_derivative_temperature[i] = 0.0;
-          // Change in composition due to chemical reactions at the
-          // given positions. The term reaction_terms[i][c] is the
-          // change in compositional field c at point i.
-          for (unsigned int c=0; c<in.composition[i].size(); ++c)
-            out.reaction_terms[i][c] = 0.0;
-
+          evaluate_point (in.temperature[i], volume_fractions, i, out);
         }
     }
 
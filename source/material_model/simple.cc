@@ -26,6 +26,63 @@ namespace aspect
 {
   namespace MaterialModel
   {
+    template <int dim>
+    void
+    Simple<dim>::
+    evaluate_point(const double temperature,
+                   const unsigned int n_comp,
+                   const double first_composition,
+                   const unsigned int i,
+                   MaterialModel::MaterialModelOutputs<dim> &out) const
+    {
+      const double delta_temp = temperature-reference_T;
+      const double temperature_dependence
+        = (reference_T > 0
+           ?
+           std::max(std::min(std::exp(-thermal_viscosity_exponent *
+                                      delta_temp/reference_T),
+                             maximum_thermal_prefactor),
+                    minimum_thermal_prefactor)
+           :
+           1.0);
+
+      out.viscosities[i] = ((composition_viscosity_prefactor != 1.0) && (n_comp>0))
+                           ?
+                           // Geometric interpolation
+                           std::pow(10.0, ((1-first_composition) * std::log10(eta *
+                                                                              temperature_dependence)
+                                           + first_composition * std::log10(eta *
+                                                                            composition_viscosity_prefactor *
+                                                                            temperature_dependence)))
+                           :
+                           temperature_dependence * eta;
+
+      const double c = (n_comp>0)
+                       ?
+                       std::max(0.0, first_composition)
+                       :
+                       0.0;
+
+      out.densities[i] = reference_rho * (1 - thermal_alpha * (temperature - reference_T))
+                         + compositional_delta_rho * c;
+
+      out.thermal_expansion_coefficients[i] = thermal_alpha;
+      out.specific_heat[i] = reference_specific_heat;
+      out.thermal_conductivities[i] = k_value;
+      out.compressibilities[i] = 0.0;
+      // Pressure derivative of entropy at the given positions.
+      out.entropy_derivative_pressure[i] = 0.0;
+      // Temperature derivative of entropy at the given positions.
+      out.entropy_derivative_temperature[i] = 0.0;
+      // Change in composition due to chemical reactions at the
+      // given positions. The term reaction_terms[i][c] is the
+      // change in compositional field c at point i.
+      for (unsigned int c=0; c<n_comp; ++c)
+        out.reaction_terms[i][c] = 0.0;
+    }
+
+
+
     template <int dim>
     void
     Simple<dim>::
@@ -33,52 +90,28 @@ namespace aspect
              MaterialModel::MaterialModelOutputs<dim> &out) const
     {
       for (unsigned int i=0; i < in.position.size(); ++i)
-        {
-          const double delta_temp = in.temperature[i]-reference_T;
-          const double temperature_dependence
-            = (reference_T > 0
-               ?
-               std::max(std::min(std::exp(-thermal_viscosity_exponent *
-                                          delta_temp/reference_T),
-                                 maximum_thermal_prefactor),
-                        minimum_thermal_prefactor)
-               :
-               1.0);
-
-          out.viscosities[i] = ((composition_viscosity_prefactor != 1.0) && (in.composition[i].size()>0))
-                               ?
-                               // Geometric interpolation
-                               std::pow(10.0, ((1-in.composition[i][0]) * std::log10(eta *
-                                                                                     temperature_dependence)
-                                               + in.composition[i][0] * std::log10(eta *
-                                                                                   composition_viscosity_prefactor *
-                                                                                   temperature_dependence)))
-                               :
-                               temperature_dependence * eta;
-
-          const double c = (in.composition[i].size()>0)
-                           ?
-                           std::max(0.0, in.composition[i][0])
-                           :
-                           0.0;
-
-          out.densities[i] = reference_rho * (1 - thermal_alpha * (in.temperature[i] - reference_T))
-                             + compositional_delta_rho * c;
-
-          out.thermal_expansion_coefficients[i] = thermal_alpha;
-          out.specific_heat[i] = reference_specific_heat;
-          out.thermal_conductivities[i] = k_value;
-          out.compressibilities[i] = 0.0;
-          // Pressure derivative of entropy at the given positions.
-          out.entropy_derivative_pressure[i] = 0.0;
-          // Temperature derivative of entropy at the given positions.
-          out.entropy_derivative_temperature[i] = 0.0;
-          // Change in composition due to chemical reactions at the
-          // given positions. The term reaction_terms[i][c] is the
-          // change in compositional field c at point i.
-          for (unsigned int c=0; c<in.composition[i].size(); ++c)
-            out.reaction_terms[i][c] = 0.0;
-        }
+        evaluate_point (in.temperature[i],
+                        in.composition[i].size(),
+                        (in.composition[i].size()>0 ? in.composition[i][0] : 0.0),
+                        i,
+                        out);
+    }
+
+
+
+    template <int dim>
+    void
+    Simple<dim>::
+    evaluate_batch(const MaterialModel::MaterialModelBatchInputs<dim> &in,
+                   MaterialModel::MaterialModelOutputs<dim> &out) const
+    {
+      const unsigned int n_comp = in.composition.size();
+      for (unsigned int i=0; i < in.n_points(); ++i)
+        evaluate_point (in.temperature[i],
+                        n_comp,
+                        (n_comp>0 ? in.composition[0][i] : 0.0),
+                        i,
+                        out);
     }
 
 
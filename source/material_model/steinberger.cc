@@ -23,6 +23,7 @@
 #include <aspect/adiabatic_conditions/interface.h>
 #include <aspect/utilities.h>
 #include <aspect/lateral_averaging.h>
+#include <aspect/quadrature_point_geometry.h>
 
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/fe/fe_values.h>
@@ -135,6 +136,8 @@ namespace aspect
       for (unsigned i = 0; i < material_file_names.size(); i++)
         material_lookup.push_back(std::make_shared<Lookup::PerplexReader>
                                   (data_directory+material_file_names[i],interpolation,this->get_mpi_communicator()));
+      if (latent_heat && use_smoothed_enthalpy_derivatives)
+        material_lookup[0]->compute_smoothed_enthalpy_derivatives (enthalpy_derivative_smoothing_width);
       lateral_viscosity_lookup
         = std::make_shared<internal::LateralViscosityLookup>(data_directory+lateral_viscosity_file_name,
                                                              this->get_mpi_communicator());
@@ -456,9 +459,13 @@ namespace aspect
       // pressures in this cell. The 1 means we only do one substep for this
       // computation (see documentation of the called function for more
       // information.
-      derivative = material_lookup[0]->enthalpy_derivatives(temperatures,
-                                                            pressures,
-                                                            1);
+      if (use_smoothed_enthalpy_derivatives)
+        derivative = material_lookup[0]->smoothed_enthalpy_derivatives(temperatures,
+                                                                       pressures);
+      else
+        derivative = material_lookup[0]->enthalpy_derivatives(temperatures,
+                                                              pressures,
+                                                              1);
 
       return derivative;
     }
@@ -521,7 +528,13 @@ namespace aspect
             {
               // Use the adiabatic pressure instead of the real one,
               // to stabilize against pressure oscillations in phase transitions
-              const double pressure = this->get_adiabatic_conditions().pressure(in.position[i]);
+              const typename QuadraturePointGeometry<dim>::PointData *point_data
+                = this->get_quadrature_point_geometry().get_point_data(in, i);
+              const double pressure = (point_data != nullptr
+                                       ?
+                                       point_data->adiabatic_pressure
+                                       :
+                                       this->get_adiabatic_conditions().pressure(in.position[i]));
 
               // If all of the derivatives were computed successfully
               if ((in.current_cell.state() == IteratorState::valid)
@@ -600,6 +613,19 @@ namespace aspect
                              "Whether to include latent heat effects in the "
                              "calculation of thermal expansivity and specific heat. "
                              "Following the approach of Nakagawa et al. 2009. ");
+          prm.declare_entry ("Use smoothed enthalpy derivatives", "false",
+                             Patterns::Bool (),
+                             "If latent heat effects are included, whether to compute the "
+                             "cell-averaged derivatives of the enthalpy by interpolating in "
+                             "smoothed derivative tables that are computed once when the "
+                             "material file is read, instead of averaging finite differences "
+                             "between all pairs of vertices of each cell. The former is "
+                             "considerably cheaper for higher order or three-dimensional cells. ");
+          prm.declare_entry ("Enthalpy derivative smoothing width", "1",
+                             Patterns::Integer (0),
+                             "The number of table points in each direction of temperature and "
+                             "pressure over which the smoothed enthalpy derivatives are averaged. "
+                             "Only used if 'Use smoothed enthalpy derivatives' is set. ");
           prm.declare_entry ("Reference viscosity", "1e23",
                              Patterns::Double(0),
                              "The reference viscosity that is used for pressure scaling. "
@@ -664,6 +690,8 @@ namespace aspect
           n_lateral_slices = prm.get_integer("Number lateral average bands");
           interpolation        = prm.get_bool ("Bilinear interpolation");
           latent_heat          = prm.get_bool ("Latent heat");
+          use_smoothed_enthalpy_derivatives   = prm.get_bool ("Use smoothed enthalpy derivatives");
+          enthalpy_derivative_smoothing_width = prm.get_integer ("Enthalpy derivative smoothing width");
           reference_eta        = prm.get_double ("Reference viscosity");
           min_eta              = prm.get_double ("Minimum viscosity");
           max_eta              = prm.get_double ("Maximum viscosity");
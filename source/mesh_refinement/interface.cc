@@ -21,6 +21,9 @@
 
 #include <aspect/mesh_refinement/interface.h>
 #include <aspect/utilities.h>
+#include <aspect/profiler.h>
+
+#include <deal.II/fe/fe_values.h>
 
 #include <typeinfo>
 
@@ -56,6 +59,47 @@ namespace aspect
     }
 
 
+    template <int dim>
+    bool
+    Interface<dim>::uses_material_model_field () const
+    {
+      return false;
+    }
+
+
+    template <int dim>
+    bool
+    Interface<dim>::material_model_field_needs_strain_rates () const
+    {
+      return true;
+    }
+
+
+    template <int dim>
+    void
+    Interface<dim>::compute_material_model_field_values (const MaterialModel::MaterialModelInputs<dim> &,
+                                                         const MaterialModel::MaterialModelOutputs<dim> &,
+                                                         std::vector<double> &) const
+    {
+      AssertThrow (false,
+                   ExcMessage ("A mesh refinement criterion that indicates that it uses a "
+                               "field computed from the material model outputs needs to "
+                               "implement the function compute_material_model_field_values()."));
+    }
+
+
+    template <int dim>
+    void
+    Interface<dim>::execute_from_material_model_field (const LinearAlgebra::BlockVector &,
+                                                       Vector<float> &) const
+    {
+      AssertThrow (false,
+                   ExcMessage ("A mesh refinement criterion that indicates that it uses a "
+                               "field computed from the material model outputs needs to "
+                               "implement the function execute_from_material_model_field()."));
+    }
+
+
     template <int dim>
     void
     Interface<dim>::tag_additional_cells () const
@@ -76,6 +120,94 @@ namespace aspect
 
 
 
+// ------------------------------ Shared material model evaluation -----------------------------
+
+    template <int dim>
+    void
+    compute_material_model_fields (const SimulatorAccess<dim> &simulator_access,
+                                   const std::vector<const Interface<dim> *> &criteria,
+                                   std::vector<LinearAlgebra::BlockVector> &fields)
+    {
+      const Introspection<dim> &introspection = simulator_access.introspection();
+      const FiniteElement<dim> &finite_element = simulator_access.get_fe();
+
+      // only compute the strain rates if one of the criteria needs the viscosity
+      bool use_strain_rates = false;
+      for (const auto criterion : criteria)
+        {
+          Assert (criterion->uses_material_model_field(), ExcInternalError());
+          if (criterion->material_model_field_needs_strain_rates())
+            use_strain_rates = true;
+        }
+
+      // create vectors in which we set the temperature block to be a finite
+      // element interpolation of the fields. we do so by setting up a
+      // quadrature formula with the temperature unit support points, then
+      // looping over these points, compute the material model outputs at
+      // them, and writing the fields computed from them into the output
+      // vectors in the same order (because quadrature points and temperature
+      // dofs are, by design of the quadrature formula, numbered in the same
+      // way)
+      std::vector<LinearAlgebra::BlockVector> distributed_fields (criteria.size());
+      for (auto &field : distributed_fields)
+        field.reinit (introspection.index_sets.system_partitioning,
+                      simulator_access.get_mpi_communicator());
+
+      const Quadrature<dim> quadrature(finite_element.base_element(introspection.base_elements.temperature).get_unit_support_points());
+      const unsigned int n_temperature_dofs = finite_element.base_element(introspection.base_elements.temperature).dofs_per_cell;
+
+      std::vector<types::global_dof_index> local_dof_indices (finite_element.dofs_per_cell);
+      FEValues<dim> fe_values (simulator_access.get_mapping(),
+                               finite_element,
+                               quadrature,
+                               update_quadrature_points | update_values | update_gradients);
+
+      MaterialModel::MaterialModelInputs<dim> in(quadrature.size(),
+                                                 simulator_access.n_compositional_fields());
+      MaterialModel::MaterialModelOutputs<dim> out(quadrature.size(),
+                                                   simulator_access.n_compositional_fields());
+      std::vector<double> values (quadrature.size());
+
+      for (const auto &cell : simulator_access.get_dof_handler().active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            fe_values.reinit(cell);
+            in.reinit(fe_values, cell, introspection, simulator_access.get_solution(), use_strain_rates);
+            simulator_access.get_material_model().evaluate(in, out);
+
+            cell->get_dof_indices (local_dof_indices);
+
+            for (unsigned int c=0; c<criteria.size(); ++c)
+              {
+                criteria[c]->compute_material_model_field_values (in, out, values);
+
+                for (unsigned int i=0; i<n_temperature_dofs; ++i)
+                  {
+                    const unsigned int system_local_dof
+                      = finite_element.component_to_system_index(introspection.component_indices.temperature,
+                                                                 /*dof index within component=*/i);
+
+                    distributed_fields[c](local_dof_indices[system_local_dof]) = values[i];
+                  }
+              }
+          }
+
+      // now create vectors with the requisite ghost elements
+      // that can be used for estimating the gradients
+      fields.resize (criteria.size());
+      for (unsigned int c=0; c<criteria.size(); ++c)
+        {
+          distributed_fields[c].compress(VectorOperation::insert);
+
+          fields[c].reinit (introspection.index_sets.system_partitioning,
+                            introspection.index_sets.system_relevant_partitioning,
+                            simulator_access.get_mpi_communicator());
+          fields[c] = distributed_fields[c];
+        }
+    }
+
+
+
 // ------------------------------ Manager -----------------------------
 
     template <int dim>
@@ -99,6 +231,9 @@ namespace aspect
         {
           try
             {
+              const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                    "Mesh refinement criterion",
+                                                    plugin_names[index]);
               (*p)->update ();
             }
 
@@ -160,6 +295,17 @@ namespace aspect
       // verify that its values are non-negative numbers
       std::vector<Vector<float> > all_error_indicators (mesh_refinement_objects.size(),
                                                         Vector<float>(error_indicators.size()));
+
+      // the criteria that are computed from the material model outputs
+      // share a single evaluation of the material model, which we do
+      // before the first of them is executed
+      std::vector<const Interface<dim> *> material_model_criteria;
+      for (const auto &p : mesh_refinement_objects)
+        if (p->uses_material_model_field())
+          material_model_criteria.push_back (p.get());
+      std::vector<LinearAlgebra::BlockVector> material_model_fields;
+      unsigned int material_model_index = 0;
+
       unsigned int index = 0;
       for (typename std::list<std::unique_ptr<Interface<dim> > >::const_iterator
            p = mesh_refinement_objects.begin();
@@ -167,7 +313,32 @@ namespace aspect
         {
           try
             {
-              (*p)->execute (all_error_indicators[index]);
+              if ((*p)->uses_material_model_field())
+                {
+                  if (material_model_fields.empty())
+                    {
+                      const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                            "Mesh refinement criterion",
+                                                            "shared material model evaluation");
+                      compute_material_model_fields (*this,
+                                                     material_model_criteria,
+                                                     material_model_fields);
+                    }
+
+                  const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                        "Mesh refinement criterion",
+                                                        plugin_names[index]);
+                  (*p)->execute_from_material_model_field (material_model_fields[material_model_index],
+                                                           all_error_indicators[index]);
+                  ++material_model_index;
+                }
+              else
+                {
+                  const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                        "Mesh refinement criterion",
+                                                        plugin_names[index]);
+                  (*p)->execute (all_error_indicators[index]);
+                }
 
               for (unsigned int i=0; i<error_indicators.size(); ++i)
                 Assert (all_error_indicators[index](i) >= 0,
@@ -446,7 +617,6 @@ namespace aspect
 
       // find out which plugins are requested and the various other
       // parameters we declare here
-      std::vector<std::string> plugin_names;
       prm.enter_subsection("Mesh refinement");
       {
         plugin_names
@@ -546,7 +716,12 @@ namespace aspect
   {
 #define INSTANTIATE(dim) \
   template class Interface<dim>; \
-  template class Manager<dim>;
+  template class Manager<dim>; \
+  template \
+  void \
+  compute_material_model_fields (const SimulatorAccess<dim> &, \
+                                 const std::vector<const Interface<dim> *> &, \
+                                 std::vector<LinearAlgebra::BlockVector> &);
 
     ASPECT_INSTANTIATE(INSTANTIATE)
   }
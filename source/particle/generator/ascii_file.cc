@@ -45,20 +45,15 @@ namespace aspect
           }
 
         // Read data lines
-        types::particle_index particle_index = 0;
+        std::vector<Point<dim> > particle_positions;
         Point<dim> particle_position;
 
         while (in >> particle_position)
-          {
-            // Try to add the particle. If it is not in this domain, do not
-            // worry about it and move on to next point.
-            try
-              {
-                particles.insert(this->generate_particle(particle_position,particle_index++));
-              }
-            catch (ExcParticlePointNotInDomain &)
-              {}
-          }
+          particle_positions.push_back(particle_position);
+
+        // Add the particles at all positions in the local domain, and
+        // ignore the others
+        this->generate_particles_at_positions(particle_positions,0,particles);
       }
 
 
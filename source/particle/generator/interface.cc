@@ -19,9 +19,9 @@
  */
 
 #include <aspect/particle/generator/interface.h>
+#include <aspect/cell_locator.h>
 
 #include <tuple>
-#include <deal.II/grid/grid_tools.h>
 
 #include <boost/lexical_cast.hpp>
 
@@ -55,28 +55,39 @@ namespace aspect
         // Try to find the cell of the given position. If the position is not
         // in the domain on the local process, throw a ExcParticlePointNotInDomain
         // exception.
-        try
-          {
-            std::pair<const typename parallel::distributed::Triangulation<dim>::active_cell_iterator,
-                Point<dim> > it =
-                  GridTools::find_active_cell_around_point<> (this->get_mapping(), this->get_triangulation(), position);
-
-            // Only try to add the point if the cell it is in, is on this processor
-            AssertThrow(it.first->is_locally_owned(),
-                        ExcParticlePointNotInDomain());
-
-            const Particle<dim> particle(position, it.second, id);
-            const Particles::internal::LevelInd cell(it.first->level(), it.first->index());
-            return std::make_pair(cell,particle);
-          }
-        catch (GridTools::ExcPointNotFound<dim> &)
-          {
-            AssertThrow(false,
-                        ExcParticlePointNotInDomain());
-          }
+        const std::pair<typename parallel::distributed::Triangulation<dim>::active_cell_iterator,
+              Point<dim> > it = this->get_cell_locator().find_cell_around_point(position);
+
+        // Only try to add the point if the cell it is in, is on this processor
+        AssertThrow(it.first.state() == IteratorState::valid
+                    &&
+                    it.first->is_locally_owned(),
+                    ExcParticlePointNotInDomain());
+
+        const Particle<dim> particle(position, it.second, id);
+        const Particles::internal::LevelInd cell(it.first->level(), it.first->index());
+        return std::make_pair(cell,particle);
+      }
 
-        // Avoid warnings about missing return
-        return std::pair<Particles::internal::LevelInd,Particle<dim> >();
+      template <int dim>
+      void
+      Interface<dim>::generate_particles_at_positions(const std::vector<Point<dim> > &positions,
+                                                      const types::particle_index first_id,
+                                                      std::multimap<Particles::internal::LevelInd, Particle<dim> > &particles) const
+      {
+        std::vector<std::pair<typename parallel::distributed::Triangulation<dim>::active_cell_iterator,
+            Point<dim> > > cells;
+        this->get_cell_locator().find_cells_around_points(positions, cells);
+
+        for (unsigned int i=0; i<positions.size(); ++i)
+          if (cells[i].first.state() == IteratorState::valid
+              &&
+              cells[i].first->is_locally_owned())
+            {
+              const Particle<dim> particle(positions[i], cells[i].second, first_id+i);
+              const Particles::internal::LevelInd cell(cells[i].first->level(), cells[i].first->index());
+              particles.insert(std::make_pair(cell,particle));
+            }
       }
 
       template <int dim>
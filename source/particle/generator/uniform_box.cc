@@ -56,42 +56,26 @@ namespace aspect
 
         types::particle_index particle_index = 0;
 
+        // Collect the positions of one row of particles at a time, which
+        // keeps subsequent positions close to each other, and add the
+        // particles at the positions that are in the local domain
+        std::vector<Point<dim> > particle_positions;
         for (unsigned int i = 0; i < n_particles_per_direction[0]; ++i)
           {
+            particle_positions.clear();
             for (unsigned int j = 0; j < n_particles_per_direction[1]; ++j)
               {
                 if (dim == 2)
-                  {
-                    const Point<dim> particle_position = Point<dim> (P_min[0]+i*spacing[0],P_min[1]+j*spacing[1]);
-
-                    // Try to add the particle. If it is not in this domain, do not
-                    // worry about it and move on to next point.
-                    try
-                      {
-                        particles.insert(this->generate_particle(particle_position,particle_index));
-                      }
-                    catch (ExcParticlePointNotInDomain &)
-                      {}
-                    particle_index++;
-                  }
+                  particle_positions.push_back(Point<dim> (P_min[0]+i*spacing[0],P_min[1]+j*spacing[1]));
                 else if (dim == 3)
                   for (unsigned int k = 0; k < n_particles_per_direction[2]; ++k)
-                    {
-                      const Point<dim> particle_position = Point<dim> (P_min[0]+i*spacing[0],P_min[1]+j*spacing[1],P_min[2]+k*spacing[2]);
-
-                      // Try to add the particle. If it is not in this domain, do not
-                      // worry about it and move on to next point.
-                      try
-                        {
-                          particles.insert(this->generate_particle(particle_position,particle_index));
-                        }
-                      catch (ExcParticlePointNotInDomain &)
-                        {}
-                      particle_index++;
-                    }
+                    particle_positions.push_back(Point<dim> (P_min[0]+i*spacing[0],P_min[1]+j*spacing[1],P_min[2]+k*spacing[2]));
                 else
                   ExcNotImplemented();
               }
+
+            this->generate_particles_at_positions(particle_positions,particle_index,particles);
+            particle_index += particle_positions.size();
           }
       }
 
@@ -69,8 +69,13 @@ namespace aspect
 
         types::particle_index particle_index = 0;
         std::array<double,dim> spherical_coordinates;
+
+        // Collect the positions of one layer of particles at a time, and
+        // add the particles at the positions that are in the local domain
+        std::vector<Point<dim> > particle_positions;
         for (unsigned int i = 0; i < radial_layers; ++i)
           {
+            particle_positions.clear();
             spherical_coordinates[0] = P_min[0] + (radial_spacing * i);
             if (dim == 2)
               {
@@ -79,17 +84,7 @@ namespace aspect
                 for (unsigned int j = 0; j < particles_per_layer[i]; ++j)
                   {
                     spherical_coordinates[1] = P_min[1] + j * phi_spacing;
-                    const Point<dim> particle_position = Utilities::Coordinates::spherical_to_cartesian_coordinates<dim>(spherical_coordinates) + P_center;
-
-                    // Try to add the particle. If it is not in this domain, do not
-                    // worry about it and move on to next point.
-                    try
-                      {
-                        particles.insert(this->generate_particle(particle_position,particle_index));
-                      }
-                    catch (ExcParticlePointNotInDomain &)
-                      {}
-                    particle_index++;
+                    particle_positions.push_back(Utilities::Coordinates::spherical_to_cartesian_coordinates<dim>(spherical_coordinates) + P_center);
                   }
               }
             else if (dim == 3)
@@ -113,22 +108,15 @@ namespace aspect
                     for (unsigned int k = 0; k < adjusted_phi_particles; ++k)
                       {
                         spherical_coordinates[1] = P_min[1] + k * phi_spacing;
-                        const Point<dim> particle_position = Utilities::Coordinates::spherical_to_cartesian_coordinates<dim>(spherical_coordinates) + P_center;
-
-                        // Try to add the particle. If it is not in this domain, do not
-                        // worry about it and move on to next point.
-                        try
-                          {
-                            particles.insert(this->generate_particle(particle_position,particle_index));
-                          }
-                        catch (ExcParticlePointNotInDomain &)
-                          {}
-                        particle_index++;
+                        particle_positions.push_back(Utilities::Coordinates::spherical_to_cartesian_coordinates<dim>(spherical_coordinates) + P_center);
                       }
                   }
               }
             else
               ExcNotImplemented();
+
+            this->generate_particles_at_positions(particle_positions,particle_index,particles);
+            particle_index += particle_positions.size();
           }
       }
 
@@ -22,9 +22,11 @@
 #include <aspect/postprocess/particles.h>
 #include <aspect/simulator.h>
 
-#include <deal.II/grid/grid_tools.h>
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/lac/full_matrix.templates.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+
+#include <array>
 
 #include <boost/lexical_cast.hpp>
 
@@ -34,6 +36,66 @@ namespace aspect
   {
     namespace Interpolator
     {
+      namespace
+      {
+        /**
+         * Solve the linear systems $Bc_k=r_k$ with the symmetric matrix $B$
+         * for all right hand sides $r_k$ given in @p rhs_and_solutions,
+         * which are overwritten by the solutions $c_k$. The function
+         * uses a Cholesky decomposition of $B$, and returns false without
+         * touching @p rhs_and_solutions if $B$ is not numerically positive
+         * definite.
+         */
+        template <std::size_t n>
+        bool
+        cholesky_solve (const std::array<std::array<double,n>,n> &B,
+                        std::vector<std::array<double,n> > &rhs_and_solutions)
+        {
+          double max_diagonal = 0;
+          for (unsigned int i=0; i<n; ++i)
+            max_diagonal = std::max(max_diagonal, B[i][i]);
+
+          std::array<std::array<double,n>,n> L;
+          for (unsigned int i=0; i<n; ++i)
+            for (unsigned int j=0; j<=i; ++j)
+              {
+                double sum = B[i][j];
+                for (unsigned int k=0; k<j; ++k)
+                  sum -= L[i][k] * L[j][k];
+
+                if (i == j)
+                  {
+                    if (!(sum > 1e-12 * max_diagonal))
+                      return false;
+                    L[i][i] = std::sqrt(sum);
+                  }
+                else
+                  L[i][j] = sum / L[j][j];
+              }
+
+          for (auto &c : rhs_and_solutions)
+            {
+              // forward substitution with L, then backward substitution with L^T
+              for (unsigned int i=0; i<n; ++i)
+                {
+                  for (unsigned int k=0; k<i; ++k)
+                    c[i] -= L[i][k] * c[k];
+                  c[i] /= L[i][i];
+                }
+              for (int i=static_cast<int>(n)-1; i>=0; --i)
+                {
+                  for (unsigned int k=i+1; k<n; ++k)
+                    c[i] -= L[k][i] * c[k];
+                  c[i] /= L[i][i];
+                }
+            }
+
+          return true;
+        }
+      }
+
+
+
       template <int dim>
       std::vector<std::vector<double> >
       BilinearLeastSquares<dim>::properties_at_points(const ParticleHandler<dim> &particle_handler,
@@ -43,18 +105,21 @@ namespace aspect
       {
         const unsigned int n_particle_properties = particle_handler.n_properties_per_particle();
 
-        const unsigned int property_index = selected_properties.first_selected_component(selected_properties.size());
-
-        AssertThrow(property_index != numbers::invalid_unsigned_int,
+        AssertThrow(selected_properties.first_selected_component(selected_properties.size()) != numbers::invalid_unsigned_int,
                     ExcMessage("Internal error: the particle property interpolator was "
                                "called without a specified component to interpolate."));
 
         AssertThrow(dim == 2,
                     ExcMessage("Currently, the particle interpolator `bilinear' is only supported for 2D models."));
 
-        AssertThrow(selected_properties.n_selected_components(n_particle_properties) == 1,
-                    ExcNotImplemented("Interpolation of multiple components is not supported."));
+        Assert(positions.size() > 0,
+               ExcMessage("The particle property interpolator was not given any "
+                          "positions to evaluate the particle cell_properties at."));
 
+        std::vector<unsigned int> property_indices;
+        for (unsigned int i = 0; i < n_particle_properties; ++i)
+          if (selected_properties[i])
+            property_indices.push_back(i);
 
         const Point<dim> approximated_cell_midpoint = std::accumulate (positions.begin(), positions.end(), Point<dim>())
                                                       / static_cast<double> (positions.size());
@@ -63,18 +128,13 @@ namespace aspect
 
         if (cell == typename parallel::distributed::Triangulation<dim>::active_cell_iterator())
           {
-            // We can not simply use one of the points as input for find_active_cell_around_point
+            // We can not simply use one of the points as input for find_cell_around_point
             // because for vertices of mesh cells we might end up getting ghost_cells as return value
             // instead of the local active cell. So make sure we are well in the inside of a cell.
-            Assert(positions.size() > 0,
-                   ExcMessage("The particle property interpolator was not given any "
-                              "positions to evaluate the particle cell_properties at."));
-
-
-            found_cell =
-              (GridTools::find_active_cell_around_point<> (this->get_mapping(),
-                                                           this->get_triangulation(),
-                                                           approximated_cell_midpoint)).first;
+            found_cell = this->get_cell_locator().find_cell_around_point(approximated_cell_midpoint).first;
+            AssertThrow(found_cell.state() == IteratorState::valid,
+                        ExcMessage("The particle property interpolator was given positions "
+                                   "that are not located in the local domain."));
           }
         else
           found_cell = cell;
@@ -82,75 +142,109 @@ namespace aspect
         const typename ParticleHandler<dim>::particle_iterator_range particle_range =
           particle_handler.particles_in_cell(found_cell);
 
-
-        std::vector<std::vector<double> > cell_properties(positions.size(),
-                                                          std::vector<double>(n_particle_properties,
-                                                                              numbers::signaling_nan<double>()));
-
-        const unsigned int n_particles = std::distance(particle_range.begin(),particle_range.end());
-
-        AssertThrow(n_particles != 0,
+        AssertThrow(particle_range.begin() != particle_range.end(),
                     ExcMessage("At least one cell contained no particles. The `bilinear'"
                                "interpolation scheme does not support this case. "));
 
-
-        // Noticed that the size of matrix A is n_particles x matrix_dimension
-        // which usually is not a square matrix. Therefore, we solve Ax=r by
-        // solving A^TAx= A^Tr.
+        // The bilinear function c_0 + c_1 x + c_2 y + c_3 xy, with coordinates
+        // relative to the midpoint of the positions and scaled by the cell
+        // diameter, that fits the property values r of the particles best
+        // in the least squares sense solves the normal equations A^TAc=A^Tr,
+        // where the rows of A are the values of the four basis functions at
+        // the particle positions. Instead of forming A, we add up the small
+        // matrix B=A^TA and the right hand sides A^Tr of all selected
+        // properties in one pass over the particles of the cell.
         const unsigned int matrix_dimension = 4;
-        dealii::LAPACKFullMatrix<double> A(n_particles, matrix_dimension);
-        Vector<double> r(n_particles);
-        r = 0;
+        const double one_over_cell_diameter = 1.0 / found_cell->diameter();
+
+        const auto basis_functions = [&] (const Point<dim> &position)
+        {
+          const double x = (position[0] - approximated_cell_midpoint[0]) * one_over_cell_diameter;
+          const double y = (position[1] - approximated_cell_midpoint[1]) * one_over_cell_diameter;
+          const std::array<double,matrix_dimension> phi = {{1, x, y, x*y}};
+          return phi;
+        };
+
+        std::array<std::array<double,matrix_dimension>,matrix_dimension> B;
+        for (auto &row : B)
+          row.fill(0);
+
+        std::array<double,matrix_dimension> zero;
+        zero.fill(0);
+        std::vector<std::array<double,matrix_dimension> > c(property_indices.size(), zero);
 
-        unsigned int index = 0;
-        const double cell_diameter = found_cell->diameter();
         for (typename ParticleHandler<dim>::particle_iterator particle = particle_range.begin();
-             particle != particle_range.end(); ++particle, ++index)
+             particle != particle_range.end(); ++particle)
           {
-            const double particle_property_value = particle->get_properties()[property_index];
-            r[index] = particle_property_value;
-
-            const Point<dim> position = particle->get_location();
-            A(index,0) = 1;
-            A(index,1) = (position[0] - approximated_cell_midpoint[0])/cell_diameter;
-            A(index,2) = (position[1] - approximated_cell_midpoint[1])/cell_diameter;
-            A(index,3) = (position[0] - approximated_cell_midpoint[0]) * (position[1] - approximated_cell_midpoint[1])/std::pow(cell_diameter,2);
+            const std::array<double,matrix_dimension> phi = basis_functions(particle->get_location());
+
+            for (unsigned int i = 0; i < matrix_dimension; ++i)
+              for (unsigned int j = 0; j <= i; ++j)
+                B[i][j] += phi[i] * phi[j];
+
+            const ArrayView<const double> particle_properties = particle->get_properties();
+            for (unsigned int k = 0; k < property_indices.size(); ++k)
+              {
+                const double particle_property_value = particle_properties[property_indices[k]];
+                for (unsigned int i = 0; i < matrix_dimension; ++i)
+                  c[k][i] += phi[i] * particle_property_value;
+              }
           }
 
-        dealii::LAPACKFullMatrix<double> B(matrix_dimension, matrix_dimension);
+        for (unsigned int i = 0; i < matrix_dimension; ++i)
+          for (unsigned int j = i+1; j < matrix_dimension; ++j)
+            B[i][j] = B[j][i];
 
-        Vector<double> c_ATr(matrix_dimension);
-        Vector<double> c(matrix_dimension);
+        // B is symmetric and positive definite unless the particles do not
+        // determine all coefficients, e.g., if there are fewer than four of
+        // them or if they are all located on one line. Only in this case
+        // we fall back to the pseudo-inverse computed by a singular value
+        // decomposition.
+        if (!cholesky_solve(B, c))
+          {
+            const double threshold = 1e-15;
 
-        const double threshold = 1e-15;
-        unsigned int index_positions = 0;
+            dealii::LAPACKFullMatrix<double> B_inverse(matrix_dimension, matrix_dimension);
+            for (unsigned int i = 0; i < matrix_dimension; ++i)
+              for (unsigned int j = 0; j < matrix_dimension; ++j)
+                B_inverse(i,j) = B[i][j];
+            B_inverse.compute_inverse_svd(threshold);
 
-        // Matrix A can be rank deficient if it does not have full rank, therefore singular.
-        // To circumvent this issue, we solve A^TAx=A^Tr by using singular value
-        // decomposition (SVD).
-        A.Tmmult(B, A, false);
-        A.Tvmult(c_ATr,r);
+            Vector<double> c_ATr(matrix_dimension);
+            Vector<double> c_k(matrix_dimension);
+            for (unsigned int k = 0; k < property_indices.size(); ++k)
+              {
+                std::copy(c[k].begin(), c[k].end(), c_ATr.begin());
+                B_inverse.vmult(c_k, c_ATr);
+                std::copy(c_k.begin(), c_k.end(), c[k].begin());
+              }
+          }
 
-        dealii::LAPACKFullMatrix<double> B_inverse(B);
-        B_inverse.compute_inverse_svd(threshold);
-        B_inverse.vmult(c, c_ATr);
+        std::vector<std::vector<double> > cell_properties(positions.size(),
+                                                          std::vector<double>(n_particle_properties,
+                                                                              numbers::signaling_nan<double>()));
 
-        for (typename std::vector<Point<dim> >::const_iterator itr = positions.begin(); itr != positions.end(); ++itr, ++index_positions)
+        for (unsigned int index_positions = 0; index_positions < positions.size(); ++index_positions)
           {
-            const Point<dim> support_point = *itr;
-            double interpolated_value = c[0] +
-                                        c[1]*(support_point[0] - approximated_cell_midpoint[0])/cell_diameter +
-                                        c[2]*(support_point[1] - approximated_cell_midpoint[1])/cell_diameter +
-                                        c[3]*(support_point[0] - approximated_cell_midpoint[0])*(support_point[1] - approximated_cell_midpoint[1])/std::pow(cell_diameter,2);
-
-            // Overshoot and undershoot correction of interpolated particle property.
-            if (use_global_valued_limiter)
+            const std::array<double,matrix_dimension> phi = basis_functions(positions[index_positions]);
+
+            for (unsigned int k = 0; k < property_indices.size(); ++k)
               {
-                interpolated_value = std::min(interpolated_value, global_maximum_particle_properties[property_index]);
-                interpolated_value = std::max(interpolated_value, global_minimum_particle_properties[property_index]);
-              }
+                const unsigned int property_index = property_indices[k];
 
-            cell_properties[index_positions][property_index] = interpolated_value;
+                double interpolated_value = 0;
+                for (unsigned int i = 0; i < matrix_dimension; ++i)
+                  interpolated_value += c[k][i] * phi[i];
+
+                // Overshoot and undershoot correction of interpolated particle property.
+                if (use_global_valued_limiter)
+                  {
+                    interpolated_value = std::min(interpolated_value, global_maximum_particle_properties[property_index]);
+                    interpolated_value = std::max(interpolated_value, global_minimum_particle_properties[property_index]);
+                  }
+
+                cell_properties[index_positions][property_index] = interpolated_value;
+              }
           }
         return cell_properties;
       }
@@ -42,7 +42,7 @@ namespace aspect
 
         if (cell == typename parallel::distributed::Triangulation<dim>::active_cell_iterator())
           {
-            // We can not simply use one of the points as input for find_active_cell_around_point
+            // We can not simply use one of the points as input for find_cell_around_point
             // because for vertices of mesh cells we might end up getting ghost_cells as return value
             // instead of the local active cell. So make sure we are well in the inside of a cell.
             Assert(positions.size() > 0,
@@ -52,10 +52,10 @@ namespace aspect
             const Point<dim> approximated_cell_midpoint = std::accumulate (positions.begin(), positions.end(), Point<dim>())
                                                           / static_cast<double> (positions.size());
 
-            found_cell =
-              (GridTools::find_active_cell_around_point<> (this->get_mapping(),
-                                                           this->get_triangulation(),
-                                                           approximated_cell_midpoint)).first;
+            found_cell = this->get_cell_locator().find_cell_around_point(approximated_cell_midpoint).first;
+            AssertThrow(found_cell.state() == IteratorState::valid,
+                        ExcMessage("The particle property interpolator was given positions "
+                                   "that are not located in the local domain."));
           }
         else
           found_cell = cell;
@@ -20,8 +20,8 @@
 
 #include <aspect/particle/property/interface.h>
 #include <aspect/utilities.h>
-
-#include <deal.II/grid/grid_tools.h>
+#include <aspect/cell_locator.h>
+#include <aspect/profiler.h>
 
 #include <list>
 
@@ -262,9 +262,13 @@ namespace aspect
         std::vector<double> particle_properties;
         particle_properties.reserve(property_information.n_components());
 
+        unsigned int plugin_index = 0;
         for (typename std::list<std::shared_ptr<Interface<dim> > >::const_iterator
-             p = property_list.begin(); p!=property_list.end(); ++p)
+             p = property_list.begin(); p!=property_list.end(); ++p,++plugin_index)
           {
+            const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                  "Particle property",
+                                                  plugin_names[plugin_index]);
             (*p)->initialize_one_particle_property(particle->get_location(),
                                                    particle_properties);
           }
@@ -306,6 +310,9 @@ namespace aspect
 
                 case aspect::Particle::Property::initialize:
                 {
+                  const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                        "Particle property",
+                                                        plugin_names[property_index]);
                   (*p)->initialize_one_particle_property(particle_location,
                                                          particle_properties);
                   break;
@@ -317,9 +324,9 @@ namespace aspect
 
                   if (cell == typename parallel::distributed::Triangulation<dim>::active_cell_iterator())
                     {
-                      found_cell = (GridTools::find_active_cell_around_point<> (this->get_mapping(),
-                                                                                this->get_triangulation(),
-                                                                                particle_location)).first;
+                      found_cell = this->get_cell_locator().find_cell_around_point(particle_location).first;
+                      AssertThrow(found_cell.state() == IteratorState::valid,
+                                  ExcMessage("A new particle is located outside of the local domain."));
                     }
                   else
                     found_cell = cell;
@@ -353,6 +360,9 @@ namespace aspect
         for (typename std::list<std::shared_ptr<Interface<dim> > >::const_iterator
              p = property_list.begin(); p!=property_list.end(); ++p,++plugin_index)
           {
+            const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                  "Particle property",
+                                                  plugin_names[plugin_index]);
             (*p)->update_one_particle_property(property_information.get_position_by_plugin_index(plugin_index),
                                                particle->get_location(),
                                                solution,
@@ -505,6 +515,7 @@ namespace aspect
 
             property_list.push_back (std::shared_ptr<Property::Interface<dim> >
                                      (particle_property));
+            plugin_names.push_back (prop_names[name]);
 
             if (SimulatorAccess<dim> *sim = dynamic_cast<SimulatorAccess<dim>*>(&*property_list.back()))
               sim->initialize_simulator (this->get_simulator());
@@ -21,6 +21,7 @@
 
 #include <aspect/postprocess/global_statistics.h>
 #include <aspect/simulator.h>
+#include <aspect/newton.h>
 
 namespace aspect
 {
@@ -74,6 +75,8 @@ namespace aspect
       list_of_A_iterations.clear();
       stokes_iterations_cheap.clear();
       stokes_iterations_expensive.clear();
+      newton_residual_evaluations.clear();
+      newton_residual_evaluation_times.clear();
       advection_iterations.clear();
     }
 
@@ -90,6 +93,13 @@ namespace aspect
       list_of_A_iterations.push_back(number_A_iterations);
       stokes_iterations_cheap.push_back(solver_control_cheap.last_step());
       stokes_iterations_expensive.push_back(solver_control_expensive.last_step());
+
+      if (this->get_parameters().nonlinear_solver == Parameters<dim>::NonlinearSolver::iterated_Advection_and_Newton_Stokes
+          && this->get_newton_handler().parameters.use_jacobian_free_newton_krylov)
+        {
+          newton_residual_evaluations.push_back(this->get_newton_handler().get_n_residual_evaluations());
+          newton_residual_evaluation_times.push_back(this->get_newton_handler().get_residual_evaluation_time());
+        }
     }
 
 
@@ -157,6 +167,14 @@ namespace aspect
                                      list_of_S_iterations[iteration]);
               }
 
+            if (iteration < newton_residual_evaluations.size())
+              {
+                statistics.add_value("Newton residual evaluations",
+                                     newton_residual_evaluations[iteration]);
+                statistics.add_value("Newton residual evaluation time (s)",
+                                     newton_residual_evaluation_times[iteration]);
+              }
+
           }
       else
         {
@@ -165,6 +183,8 @@ namespace aspect
           unsigned int A_iterations = 0;
           unsigned int S_iterations = 0;
           unsigned int Stokes_outer_iterations = 0;
+          unsigned int residual_evaluations = 0;
+          double residual_evaluation_time = 0;
           std::vector<unsigned int> advection_outer_iterations(advection_iterations.size(),0);
 
           for (unsigned int iteration = 0; iteration < nonlinear_iterations; ++iteration)
@@ -180,6 +200,12 @@ namespace aspect
                   Stokes_outer_iterations += stokes_iterations_cheap[iteration] +
                                              stokes_iterations_expensive[iteration];
                 }
+
+              if (iteration < newton_residual_evaluations.size())
+                {
+                  residual_evaluations += newton_residual_evaluations[iteration];
+                  residual_evaluation_time += newton_residual_evaluation_times[iteration];
+                }
             }
 
           // only output the number of nonlinear iterations if we actually
@@ -206,6 +232,14 @@ namespace aspect
               statistics.add_value("Schur complement iterations in Stokes preconditioner",
                                    S_iterations);
             }
+
+          if (newton_residual_evaluations.size() > 0)
+            {
+              statistics.add_value("Newton residual evaluations",
+                                   residual_evaluations);
+              statistics.add_value("Newton residual evaluation time (s)",
+                                   residual_evaluation_time);
+            }
         }
 
       clear_data();
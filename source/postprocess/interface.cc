@@ -21,6 +21,7 @@
 
 #include <aspect/postprocess/interface.h>
 #include <aspect/utilities.h>
+#include <aspect/profiler.h>
 
 #include <typeinfo>
 
@@ -98,10 +99,15 @@ namespace aspect
       // call the execute() functions of all postprocessor objects we have
       // here in turns
       std::list<std::pair<std::string,std::string> > output_list;
-      for (auto &p : postprocessors)
+      for (unsigned int i=0; i<postprocessors.size(); ++i)
         {
+          const std::unique_ptr<Interface<dim> > &p = postprocessors[i];
           try
             {
+              const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                    "Postprocessor",
+                                                    postprocessor_names[i]);
+
               // first call the update() function.
               p->update();
 
@@ -217,7 +223,7 @@ namespace aspect
               ExcMessage ("No postprocessors registered!?"));
 
       // first find out which postprocessors are requested
-      std::vector<std::string> postprocessor_names;
+      postprocessor_names.clear();
       prm.enter_subsection("Postprocess");
       {
         postprocessor_names
@@ -392,6 +398,7 @@ namespace aspect
       // finally swap the unsorted list with the sorted list and only
       // keep the latter
       postprocessors.swap (sorted_postprocessors);
+      postprocessor_names.swap (sorted_names);
     }
 
 
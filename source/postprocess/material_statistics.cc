@@ -46,13 +46,33 @@ namespace aspect
                                update_quadrature_points |
                                update_JxW_values);
 
-      MaterialModel::MaterialModelInputs<dim> in(fe_values.n_quadrature_points, this->n_compositional_fields());
-      MaterialModel::MaterialModelOutputs<dim> out(fe_values.n_quadrature_points, this->n_compositional_fields());
+      // the material model is evaluated for batches of this many cells
+      // at once
+      const unsigned int n_cells_per_batch = 64;
+      MaterialModel::MaterialModelBatchInputs<dim> in(this->n_compositional_fields());
+      std::vector<double> JxW_values;
+      JxW_values.reserve (n_cells_per_batch * n_q_points);
 
       double local_volume = 0.0;
       double local_mass = 0.0;
       double local_viscosity = 0.0;
 
+      auto integrate_batch = [&] ()
+      {
+        MaterialModel::MaterialModelOutputs<dim> out(in.n_points(), this->n_compositional_fields());
+        this->get_material_model().evaluate_batch(in, out);
+
+        for (unsigned int i=0; i<in.n_points(); ++i)
+          {
+            local_mass += out.densities[i] * JxW_values[i];
+            local_viscosity += out.viscosities[i] * JxW_values[i];
+            local_volume += JxW_values[i];
+          }
+
+        in.clear();
+        JxW_values.clear();
+      };
+
       typename DoFHandler<dim>::active_cell_iterator
       cell = this->get_dof_handler().begin_active(),
       endc = this->get_dof_handler().end();
@@ -62,18 +82,16 @@ namespace aspect
         if (cell->is_locally_owned())
           {
             fe_values.reinit (cell);
-            in.reinit(fe_values, cell, this->introspection(), this->get_solution());
-
-            this->get_material_model().fill_additional_material_model_inputs(in, this->get_solution(), fe_values, this->introspection());
-            this->get_material_model().evaluate(in, out);
+            in.add_cell(fe_values, cell, this->introspection(), this->get_solution());
+            JxW_values.insert (JxW_values.end(),
+                               fe_values.get_JxW_values().begin(),
+                               fe_values.get_JxW_values().end());
 
-            for (unsigned int q=0; q<n_q_points; ++q)
-              {
-                local_mass += out.densities[q] * fe_values.JxW(q);
-                local_viscosity += out.viscosities[q] * fe_values.JxW(q);
-                local_volume += fe_values.JxW(q);
-              }
+            if (in.n_cells() == n_cells_per_batch)
+              integrate_batch ();
           }
+      if (in.n_cells() > 0)
+        integrate_batch ();
 
       // compute the sum over all processors
       const double global_mass = Utilities::MPI::sum (local_mass, this->get_mpi_communicator());
@@ -25,6 +25,10 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 
+#ifdef DEAL_II_WITH_HDF5
+#include <hdf5.h>
+#endif
+
 #include <stdio.h>
 #include <unistd.h>
 
@@ -39,7 +43,8 @@ namespace aspect
       void
       ParticleOutput<dim>::build_patches(const Particle::ParticleHandler<dim> &particle_handler,
                                          const aspect::Particle::Property::ParticlePropertyInformation &property_information,
-                                         const bool only_group_3d_vectors)
+                                         const bool only_group_3d_vectors,
+                                         const unsigned int output_every_nth_particle)
       {
         // First store the names of the data fields
         dataset_names.reserve(property_information.n_components()+1);
@@ -86,25 +91,34 @@ namespace aspect
           }
 
 
-        // Third build the actual patch data
-        patches.resize(particle_handler.n_locally_owned_particles());
+        // Third build the actual patch data. If only a subset of particles
+        // is written, select them by their id, which does not change over
+        // the lifetime of a particle.
+        patches.clear();
+        patches.reserve(particle_handler.n_locally_owned_particles() / output_every_nth_particle + 1);
 
         typename dealii::Particles::ParticleHandler<dim>::particle_iterator particle = particle_handler.begin();
 
-        for (unsigned int i=0; particle != particle_handler.end(); ++particle, ++i)
+        for (; particle != particle_handler.end(); ++particle)
           {
-            patches[i].vertices[0] = particle->get_location();
-            patches[i].patch_index = i;
-            patches[i].n_subdivisions = 1;
-            patches[i].data.reinit(property_information.n_components()+1,1);
+            if (particle->get_id() % output_every_nth_particle != 0)
+              continue;
+
+            patches.emplace_back();
+            DataOutBase::Patch<0,dim> &patch = patches.back();
+
+            patch.vertices[0] = particle->get_location();
+            patch.patch_index = patches.size()-1;
+            patch.n_subdivisions = 1;
+            patch.data.reinit(property_information.n_components()+1,1);
 
-            patches[i].data(0,0) = particle->get_id();
+            patch.data(0,0) = particle->get_id();
 
             if (particle->has_properties())
               {
                 const ArrayView<const double> properties = particle->get_properties();
                 for (unsigned int property_index = 0; property_index < properties.size(); ++property_index)
-                  patches[i].data(property_index+1,0) = properties[property_index];
+                  patch.data(property_index+1,0) = properties[property_index];
               }
           }
       }
@@ -130,6 +144,281 @@ namespace aspect
         return vector_datasets;
       }
 
+
+
+      template <int dim>
+      void
+      ChunkedHDF5ParticleOutput<dim>::build_buffers (const Particle::ParticleHandler<dim> &particle_handler,
+                                                     const aspect::Particle::Property::ParticlePropertyInformation &property_information,
+                                                     const unsigned int output_every_nth_particle,
+                                                     const MPI_Comm &mpi_communicator)
+      {
+        n_property_components = property_information.n_components();
+
+        // Describe the datasets. Only 3d vectors are written as vector
+        // datasets, because XDMF does not know about 2d vectors.
+        property_datasets.clear();
+        for (unsigned int field_index = 0; field_index < property_information.n_fields(); ++field_index)
+          {
+            const unsigned int n_components = property_information.get_components_by_field_index(field_index);
+            const unsigned int field_position = property_information.get_position_by_field_index(field_index);
+            const std::string field_name = property_information.get_field_name_by_index(field_index);
+
+            if (n_components == 1 || (dim == 3 && n_components == 3))
+              property_datasets.emplace_back(field_name, field_position, n_components);
+            else
+              for (unsigned int component_index=0; component_index<n_components; ++component_index)
+                property_datasets.emplace_back(field_name + "_" + Utilities::to_string(component_index),
+                                               field_position + component_index,
+                                               1);
+          }
+
+        // Copy all selected particles into the buffers in a single pass
+        const std::size_t n_expected_particles = particle_handler.n_locally_owned_particles() / output_every_nth_particle + 1;
+        positions.clear();
+        positions.reserve(dim * n_expected_particles);
+        ids.clear();
+        ids.reserve(n_expected_particles);
+        properties.clear();
+        properties.reserve(n_property_components * n_expected_particles);
+
+        for (typename Particle::ParticleHandler<dim>::particle_iterator particle = particle_handler.begin();
+             particle != particle_handler.end(); ++particle)
+          {
+            if (particle->get_id() % output_every_nth_particle != 0)
+              continue;
+
+            const Point<dim> location = particle->get_location();
+            for (unsigned int d=0; d<dim; ++d)
+              positions.push_back(location[d]);
+
+            ids.push_back(particle->get_id());
+
+            if (n_property_components > 0)
+              {
+                const ArrayView<const double> particle_properties = particle->get_properties();
+                properties.insert(properties.end(), particle_properties.begin(), particle_properties.end());
+              }
+          }
+
+        n_local_particles = ids.size();
+
+        // Get the offset of the local particles among all processes
+        types::particle_index local_particle_index_offset;
+        MPI_Scan(&n_local_particles, &local_particle_index_offset, 1, PARTICLE_INDEX_MPI_TYPE, MPI_SUM, mpi_communicator);
+        local_offset = local_particle_index_offset - n_local_particles;
+
+        n_global_particles = Utilities::MPI::sum (n_local_particles, mpi_communicator);
+      }
+
+
+
+#ifdef DEAL_II_WITH_HDF5
+      namespace
+      {
+        /**
+         * Create the dataset creation property list for a dataset with
+         * @p n_global_particles rows and @p n_columns columns according to
+         * the given @p options.
+         */
+        hid_t
+        create_dataset_properties (const hsize_t n_global_particles,
+                                   const hsize_t n_columns,
+                                   const bool floating_point_data,
+                                   const unsigned int chunk_size,
+                                   const unsigned int deflate_level,
+                                   const unsigned int lossy_significant_digits)
+        {
+          const hid_t dataset_properties = H5Pcreate(H5P_DATASET_CREATE);
+
+          // chunks must not be larger than the dataset, and empty datasets
+          // can not be chunked at all
+          if (chunk_size == 0 || n_global_particles == 0)
+            return dataset_properties;
+
+          const hsize_t chunk_dimensions[2] = {std::min<hsize_t>(chunk_size, n_global_particles), n_columns};
+          H5Pset_chunk(dataset_properties, 2, chunk_dimensions);
+
+          if (floating_point_data && lossy_significant_digits > 0)
+            H5Pset_scaleoffset(dataset_properties, H5Z_SO_FLOAT_DSCALE, lossy_significant_digits);
+
+          if (deflate_level > 0)
+            {
+              H5Pset_shuffle(dataset_properties);
+              H5Pset_deflate(dataset_properties, deflate_level);
+            }
+
+          return dataset_properties;
+        }
+
+
+
+        /**
+         * Write the columns [first_column, first_column+n_columns) of the
+         * row-major buffer @p data with @p n_buffer_columns columns and
+         * @p n_local_particles rows into the dataset @p name of @p h5_file,
+         * starting at row @p local_offset.
+         */
+        void
+        write_dataset (const hid_t h5_file,
+                       const std::string &name,
+                       const hid_t file_type,
+                       const hid_t memory_type,
+                       const void *data,
+                       const hsize_t n_buffer_columns,
+                       const hsize_t first_column,
+                       const hsize_t n_columns,
+                       const hsize_t n_local_particles,
+                       const hsize_t n_global_particles,
+                       const hsize_t local_offset,
+                       const hid_t dataset_properties,
+                       const hid_t write_properties)
+        {
+          const hsize_t global_dataset_size[2] = {n_global_particles, n_columns};
+          const hid_t file_dataspace = H5Screate_simple(2, global_dataset_size, nullptr);
+
+#if H5Dcreate_vers == 1
+          const hid_t dataset = H5Dcreate(h5_file, name.c_str(), file_type, file_dataspace, dataset_properties);
+#else
+          const hid_t dataset = H5Dcreate(h5_file, name.c_str(), file_type, file_dataspace, H5P_DEFAULT, dataset_properties, H5P_DEFAULT);
+#endif
+
+          const hsize_t file_offset[2] = {local_offset, 0};
+          const hsize_t local_dataset_size[2] = {n_local_particles, n_columns};
+          H5Sselect_hyperslab(file_dataspace, H5S_SELECT_SET, file_offset, nullptr, local_dataset_size, nullptr);
+
+          // describe the buffer in memory, and select the requested
+          // columns of it. processes without particles still need to
+          // take part in the collective write, but select nothing
+          const hsize_t buffer_size[2] = {std::max<hsize_t>(n_local_particles, 1), n_buffer_columns};
+          const hid_t memory_dataspace = H5Screate_simple(2, buffer_size, nullptr);
+          const hsize_t memory_offset[2] = {0, first_column};
+          if (n_local_particles > 0)
+            H5Sselect_hyperslab(memory_dataspace, H5S_SELECT_SET, memory_offset, nullptr, local_dataset_size, nullptr);
+          else
+            {
+              H5Sselect_none(memory_dataspace);
+              H5Sselect_none(file_dataspace);
+            }
+
+          H5Dwrite(dataset, memory_type, memory_dataspace, file_dataspace, write_properties, data);
+
+          H5Sclose(memory_dataspace);
+          H5Sclose(file_dataspace);
+          H5Dclose(dataset);
+        }
+      }
+#endif
+
+
+
+      template <int dim>
+      void
+      ChunkedHDF5ParticleOutput<dim>::write (const std::string &filename,
+                                             const StorageOptions &options,
+                                             const MPI_Comm &mpi_communicator) const
+      {
+#ifdef DEAL_II_WITH_HDF5
+#ifdef DEAL_II_WITH_64BIT_INDICES
+        const hid_t particle_index_type = H5T_NATIVE_ULLONG;
+#else
+        const hid_t particle_index_type = H5T_NATIVE_UINT;
+#endif
+
+        // Create parallel file access
+        const hid_t file_access_properties = H5Pcreate(H5P_FILE_ACCESS);
+        // Create property list for collective dataset write
+        const hid_t write_properties = H5Pcreate(H5P_DATASET_XFER);
+#ifdef H5_HAVE_PARALLEL
+        H5Pset_fapl_mpio(file_access_properties, mpi_communicator, MPI_INFO_NULL);
+        H5Pset_dxpl_mpio(write_properties, H5FD_MPIO_COLLECTIVE);
+#else
+        (void) mpi_communicator;
+#endif
+
+        const hid_t h5_file = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, file_access_properties);
+        H5Pclose(file_access_properties);
+
+        AssertThrow (h5_file >= 0,
+                     ExcMessage ("Could not create the particle output file <" + filename + ">."));
+
+        // Datasets that are stored with the same number of columns share
+        // their creation properties
+        std::map<std::pair<hsize_t,bool>, hid_t> dataset_properties;
+        const auto get_dataset_properties = [&] (const hsize_t n_columns,
+                                                 const bool floating_point_data) -> hid_t
+        {
+          const std::pair<hsize_t,bool> key (n_columns, floating_point_data);
+          if (dataset_properties.find(key) == dataset_properties.end())
+            dataset_properties[key] = create_dataset_properties (n_global_particles,
+                                                                 n_columns,
+                                                                 floating_point_data,
+                                                                 options.chunk_size,
+                                                                 options.deflate_level,
+                                                                 options.lossy_significant_digits);
+          return dataset_properties[key];
+        };
+
+        // The XDMF description of point data needs a 'cells' dataset
+        // that lists the vertex of each cell, i.e., the particle index.
+        std::vector<types::particle_index> cell_data (n_local_particles);
+        for (types::particle_index i=0; i<n_local_particles; ++i)
+          cell_data[i] = local_offset + i;
+
+        write_dataset (h5_file, "nodes", H5T_NATIVE_DOUBLE, H5T_NATIVE_DOUBLE,
+                       positions.data(), dim, 0, dim,
+                       n_local_particles, n_global_particles, local_offset,
+                       get_dataset_properties(dim, true), write_properties);
+
+        write_dataset (h5_file, "cells", particle_index_type, particle_index_type,
+                       cell_data.data(), 1, 0, 1,
+                       n_local_particles, n_global_particles, local_offset,
+                       get_dataset_properties(1, false), write_properties);
+
+        write_dataset (h5_file, "id", particle_index_type, particle_index_type,
+                       ids.data(), 1, 0, 1,
+                       n_local_particles, n_global_particles, local_offset,
+                       get_dataset_properties(1, false), write_properties);
+
+        for (const auto &dataset : property_datasets)
+          write_dataset (h5_file, std::get<0>(dataset), H5T_NATIVE_DOUBLE, H5T_NATIVE_DOUBLE,
+                         properties.data(), n_property_components, std::get<1>(dataset), std::get<2>(dataset),
+                         n_local_particles, n_global_particles, local_offset,
+                         get_dataset_properties(std::get<2>(dataset), true), write_properties);
+
+        for (const auto &property_list : dataset_properties)
+          H5Pclose(property_list.second);
+
+        H5Pclose(write_properties);
+        H5Fclose(h5_file);
+#else
+        (void) filename;
+        (void) options;
+        (void) mpi_communicator;
+        AssertThrow (false,
+                     ExcMessage ("deal.II was not compiled with HDF5 support, "
+                                 "so HDF5 output is not possible. Please "
+                                 "recompile deal.II with HDF5 support turned on "
+                                 "or select a different particle output format."));
+#endif
+      }
+
+
+
+      template <int dim>
+      XDMFEntry
+      ChunkedHDF5ParticleOutput<dim>::create_xdmf_entry (const std::string &filename,
+                                                         const double time) const
+      {
+        // Every particle is described as a cell with a single vertex
+        XDMFEntry entry (filename, filename, time, n_global_particles, n_global_particles, 0, dim);
+
+        entry.add_attribute("id", 1);
+        for (const auto &dataset : property_datasets)
+          entry.add_attribute(std::get<0>(dataset), std::get<2>(dataset));
+
+        return entry;
+      }
     }
 #endif
 
@@ -144,7 +433,8 @@ namespace aspect
 #if DEAL_II_VERSION_GTE(9,0,0)
       ,output_file_number (numbers::invalid_unsigned_int),
       group_files(0),
-      write_in_background_thread(false)
+      write_in_background_thread(false),
+      output_every_nth_particle(1)
 #endif
     {}
 
@@ -353,12 +643,21 @@ namespace aspect
       else
         ++output_file_number;
 
-      // Create the particle output
+      // Create the particle output. The 'chunked hdf5' format collects its
+      // own data, so we only need to build patches if one of the output
+      // formats of deal.II is requested.
       const bool output_hdf5 = std::find(output_formats.begin(), output_formats.end(),"hdf5") != output_formats.end();
+      bool output_deal_ii_format = false;
+      for (const std::string &output_format : output_formats)
+        if (output_format != "none" && output_format != "chunked hdf5")
+          output_deal_ii_format = true;
+
       internal::ParticleOutput<dim> data_out;
-      data_out.build_patches(world.get_particle_handler(),
-                             world.get_property_manager().get_data_info(),
-                             output_hdf5);
+      if (output_deal_ii_format)
+        data_out.build_patches(world.get_particle_handler(),
+                               world.get_property_manager().get_data_info(),
+                               output_hdf5,
+                               output_every_nth_particle);
 
       // Now prepare everything for writing the output and choose output format
       std::string particle_file_prefix = "particles-" + Utilities::int_to_string (output_file_number, 5);
@@ -398,6 +697,25 @@ namespace aspect
               data_out.write_xdmf_file(xdmf_entries, this->get_output_directory() + xdmf_filename,
                                        this->get_mpi_communicator());
             }
+          else if (*output_format=="chunked hdf5")
+            {
+              const std::string particle_file_name = "particles/" + particle_file_prefix + ".h5";
+              const std::string xdmf_filename = "particles.xdmf";
+
+              internal::ChunkedHDF5ParticleOutput<dim> hdf5_output;
+              hdf5_output.build_buffers(world.get_particle_handler(),
+                                        world.get_property_manager().get_data_info(),
+                                        output_every_nth_particle,
+                                        this->get_mpi_communicator());
+              hdf5_output.write(this->get_output_directory() + particle_file_name,
+                                hdf5_storage_options,
+                                this->get_mpi_communicator());
+
+              xdmf_entries.push_back(hdf5_output.create_xdmf_entry(particle_file_name,
+                                                                   time_in_years_or_seconds));
+              data_out.write_xdmf_file(xdmf_entries, this->get_output_directory() + xdmf_filename,
+                                       this->get_mpi_communicator());
+            }
           else if (*output_format == "vtu")
             {
               // Write master files (.pvtu,.pvd,.visit) on the master process
@@ -628,11 +946,54 @@ namespace aspect
           // in deal.II was implemented. It is nearly identical to the gnuplot format, thus
           // we now simply replace "ascii" by "gnuplot" should it be selected.
           prm.declare_entry ("Data output format", "vtu",
-                             Patterns::MultipleSelection (DataOutBase::get_output_format_names ()+"|ascii"),
+                             Patterns::MultipleSelection (DataOutBase::get_output_format_names ()+"|ascii|chunked hdf5"),
                              "A comma separated list of file formats to be used for graphical "
                              "output. The list of possible output formats that can be given "
                              "here is documented in the appendix of the manual where the current "
-                             "parameter is described.");
+                             "parameter is described. In addition to the formats supported "
+                             "by deal.II, the format 'chunked hdf5' writes all particles "
+                             "into a single HDF5 file with chunked and optionally "
+                             "compressed datasets, see the parameters 'HDF5 chunk size', "
+                             "'HDF5 compression level', and 'HDF5 lossy significant digits'. "
+                             "These files are always written on the main thread, "
+                             "independent of the parameter 'Write in background thread'. "
+                             "The formats 'hdf5' and 'chunked hdf5' write files with "
+                             "the same names and can therefore not be selected "
+                             "together.");
+
+          prm.declare_entry ("Output every nth particle", "1",
+                             Patterns::Integer(1),
+                             "Only write particles whose id is a multiple of this "
+                             "number into the output files. Because particle ids do "
+                             "not change over time, the same subset of particles is "
+                             "written in every output step. This reduces the size "
+                             "of the output files of models with many particles.");
+
+          prm.declare_entry ("HDF5 chunk size", "65536",
+                             Patterns::Integer(0),
+                             "The number of particles per chunk of the datasets "
+                             "written by the 'chunked hdf5' output format. A value "
+                             "of zero writes contiguous datasets, which can not be "
+                             "compressed.");
+
+          prm.declare_entry ("HDF5 compression level", "1",
+                             Patterns::Integer(0,9),
+                             "The deflate compression level of the datasets written "
+                             "by the 'chunked hdf5' output format, between 0 (no "
+                             "compression) and 9 (best compression). If nonzero, the "
+                             "data is also shuffled before compression, which improves "
+                             "the compression of floating point data. Writing "
+                             "compressed datasets in parallel requires HDF5 1.10.2 "
+                             "or newer.");
+
+          prm.declare_entry ("HDF5 lossy significant digits", "0",
+                             Patterns::Integer(0),
+                             "If nonzero, floating point data written by the 'chunked "
+                             "hdf5' output format is compressed with a lossy filter "
+                             "that only keeps the given number of decimal digits after "
+                             "the decimal point. Note that this is an absolute, not a "
+                             "relative precision, so the data should be of order one. "
+                             "A value of zero disables the lossy compression.");
 
           prm.declare_entry ("Number of grouped files", "16",
                              Patterns::Integer(0),
@@ -719,6 +1080,55 @@ namespace aspect
           write_in_background_thread = prm.get_bool("Write in background thread");
           temporary_output_location = prm.get("Temporary output location");
 
+          output_every_nth_particle = prm.get_integer("Output every nth particle");
+          hdf5_storage_options.chunk_size = prm.get_integer("HDF5 chunk size");
+          hdf5_storage_options.deflate_level = prm.get_integer("HDF5 compression level");
+          hdf5_storage_options.lossy_significant_digits = prm.get_integer("HDF5 lossy significant digits");
+
+          if (std::find (output_formats.begin(),
+                         output_formats.end(),
+                         "chunked hdf5") != output_formats.end())
+            {
+#ifdef DEAL_II_WITH_HDF5
+#if !H5_VERSION_GE(1,10,2)
+              AssertThrow (Utilities::MPI::n_mpi_processes(this->get_mpi_communicator()) == 1
+                           ||
+                           (hdf5_storage_options.deflate_level == 0
+                            &&
+                            hdf5_storage_options.lossy_significant_digits == 0),
+                           ExcMessage ("Writing compressed HDF5 datasets in parallel requires "
+                                       "HDF5 1.10.2 or newer. Please set the parameters 'HDF5 "
+                                       "compression level' and 'HDF5 lossy significant digits' "
+                                       "to zero."));
+#endif
+#else
+              AssertThrow (false,
+                           ExcMessage ("deal.II was not compiled with HDF5 support, "
+                                       "so HDF5 output is not possible. Please "
+                                       "recompile deal.II with HDF5 support turned on "
+                                       "or select a different particle output format."));
+#endif
+
+              AssertThrow (hdf5_storage_options.chunk_size > 0
+                           ||
+                           (hdf5_storage_options.deflate_level == 0
+                            &&
+                            hdf5_storage_options.lossy_significant_digits == 0),
+                           ExcMessage ("HDF5 datasets can only be compressed if they are "
+                                       "chunked. Please set the parameter 'HDF5 chunk size' "
+                                       "to a nonzero value."));
+
+              // Both HDF5 formats write particles/particles-XXXXX.h5 and
+              // particles.xdmf, so they would overwrite each other's files.
+              AssertThrow (std::find (output_formats.begin(),
+                                      output_formats.end(),
+                                      "hdf5") == output_formats.end(),
+                           ExcMessage ("The particle output formats 'hdf5' and 'chunked hdf5' "
+                                       "write files with the same names and can therefore not "
+                                       "be selected at the same time. Please select only one "
+                                       "of them for the parameter \"Data output format\"."));
+            }
+
           if (temporary_output_location != "")
             {
               // Check if a command-processor is available by calling system() with a
@@ -755,7 +1165,8 @@ namespace aspect
     namespace internal
     {
 #define INSTANTIATE(dim) \
-  template class ParticleOutput<dim>;
+  template class ParticleOutput<dim>; \
+  template class ChunkedHDF5ParticleOutput<dim>;
 
       ASPECT_INSTANTIATE(INSTANTIATE)
     }
@@ -23,6 +23,7 @@
 #include <aspect/global.h>
 #include <aspect/utilities.h>
 #include <aspect/simulator_access.h>
+#include <aspect/profiler.h>
 #include <aspect/geometry_model/interface.h>
 
 #include <deal.II/dofs/dof_tools.h>
@@ -331,9 +332,15 @@ namespace aspect
     Visualization<dim>::update ()
     {
       //Call the .update() method for each visualization postprocessor.
+      unsigned int index = 0;
       for (typename std::list<std::shared_ptr<VisualizationPostprocessors::Interface<dim> > >::const_iterator
-           p = postprocessors.begin(); p!=postprocessors.end(); ++p)
-        (*p)->update();
+           p = postprocessors.begin(); p!=postprocessors.end(); ++p, ++index)
+        {
+          const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                "Visualization postprocessor",
+                                                postprocessor_names[index]);
+          (*p)->update();
+        }
     }
 
 
@@ -401,11 +408,16 @@ namespace aspect
       // pointers to data vectors created by cell data visualization
       // postprocessors that will later be deleted
       std::list<std::shared_ptr<Vector<float> > > cell_data_vectors;
+      unsigned int index = 0;
       for (typename std::list<std::shared_ptr<VisualizationPostprocessors::Interface<dim> > >::const_iterator
-           p = postprocessors.begin(); p!=postprocessors.end(); ++p)
+           p = postprocessors.begin(); p!=postprocessors.end(); ++p, ++index)
         {
           try
             {
+              const Profiler::Scope profiler_scope (this->get_profiler(),
+                                                    "Visualization postprocessor",
+                                                    postprocessor_names[index]);
+
               // there are two ways of writing visualization postprocessors:
               // - deriving from DataPostprocessor
               // - deriving from DataVectorCreator
@@ -491,13 +503,20 @@ namespace aspect
                                         this->get_stokes_velocity_degree()
                                         :
                                         0;
-      data_out.build_patches (this->get_mapping(),
-                              subdivisions,
-                              this->get_geometry_model().has_curved_elements()
-                              ?
-                              DataOut<dim>::curved_inner_cells
-                              :
-                              DataOut<dim>::no_curved_cells);
+      // This is where the postprocessors derived from DataPostprocessor
+      // are evaluated, so they are profiled together in this region.
+      {
+        const Profiler::Scope profiler_scope (this->get_profiler(),
+                                              "Visualization postprocessor",
+                                              "build patches");
+        data_out.build_patches (this->get_mapping(),
+                                subdivisions,
+                                this->get_geometry_model().has_curved_elements()
+                                ?
+                                DataOut<dim>::curved_inner_cells
+                                :
+                                DataOut<dim>::no_curved_cells);
+      }
 
       // Now prepare everything for writing the output and choose output format
       std::string solution_file_prefix = "solution-" + Utilities::int_to_string (output_file_number, 5);
@@ -1046,6 +1065,7 @@ namespace aspect
 
           postprocessors.push_back (std::shared_ptr<VisualizationPostprocessors::Interface<dim> >
                                     (viz_postprocessor));
+          postprocessor_names.push_back (viz_names[name]);
 
           if (SimulatorAccess<dim> *sim = dynamic_cast<SimulatorAccess<dim>*>(&*postprocessors.back()))
             sim->initialize_simulator (this->get_simulator());
@@ -59,7 +59,6 @@ namespace aspect
       internal::Assembly::CopyData::AdvectionSystem<dim> &data = dynamic_cast<internal::Assembly::CopyData::AdvectionSystem<dim>& > (data_base);
 
       const Introspection<dim> &introspection = this->introspection();
-      const FiniteElement<dim> &fe = this->get_fe();
 
       const typename Simulator<dim>::AdvectionField advection_field = *scratch.advection_field;
       const unsigned int n_q_points = scratch.finite_element_values.n_quadrature_points;
@@ -73,7 +72,6 @@ namespace aspect
                                                      (time_step + old_time_step)) : 1.0;
 
       const bool advection_field_is_temperature = advection_field.is_temperature();
-      const unsigned int solution_component = advection_field.component_index(introspection);
 
       const FEValuesExtractors::Scalar solution_field = advection_field.scalar_extractor(introspection);
 
@@ -87,15 +85,11 @@ namespace aspect
           // We only need to look up values of shape functions if they
           // belong to 'our' component. They are zero otherwise anyway.
           // Note that we later only look at the values that we do set here.
-          for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell;/*increment at end of loop*/)
+          for (unsigned int i_advection=0; i_advection<advection_dofs_per_cell; ++i_advection)
             {
-              if (fe.system_to_component_index(i).first == solution_component)
-                {
-                  scratch.grad_phi_field[i_advection] = scratch.finite_element_values[solution_field].gradient (i,q);
-                  scratch.phi_field[i_advection]      = scratch.finite_element_values[solution_field].value (i,q);
-                  ++i_advection;
-                }
-              ++i;
+              const unsigned int i = scratch.field_shape_function_indices[i_advection];
+              scratch.grad_phi_field[i_advection] = scratch.finite_element_values[solution_field].gradient (i,q);
+              scratch.phi_field[i_advection]      = scratch.finite_element_values[solution_field].value (i,q);
             }
 
           const double density_c_P              =
@@ -269,7 +263,6 @@ namespace aspect
 
       const Parameters<dim> &parameters = this->get_parameters();
       const Introspection<dim> &introspection = this->introspection();
-      const FiniteElement<dim> &fe = this->get_fe();
 
       const typename Simulator<dim>::AdvectionField advection_field = *scratch.advection_field;
 
@@ -280,7 +273,6 @@ namespace aspect
       const unsigned int n_q_points = scratch.finite_element_values.n_quadrature_points;
       const unsigned int advection_dofs_per_cell = data.local_dof_indices.size();
 
-      const unsigned int solution_component = advection_field.component_index(introspection);
       const FEValuesExtractors::Scalar solution_field = advection_field.scalar_extractor(introspection);
 
       for (unsigned int q=0; q<n_q_points; ++q)
@@ -289,15 +281,11 @@ namespace aspect
           // We only need to look up values of shape functions if they
           // belong to 'our' component. They are zero otherwise anyway.
           // Note that we later only look at the values that we do set here.
-          for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell;/*increment at end of loop*/)
+          for (unsigned int i_advection=0; i_advection<advection_dofs_per_cell; ++i_advection)
             {
-              if (fe.system_to_component_index(i).first == solution_component)
-                {
-                  scratch.grad_phi_field[i_advection] = scratch.finite_element_values[solution_field].gradient (i,q);
-                  scratch.phi_field[i_advection]      = scratch.finite_element_values[solution_field].value (i,q);
-                  ++i_advection;
-                }
-              ++i;
+              const unsigned int i = scratch.field_shape_function_indices[i_advection];
+              scratch.grad_phi_field[i_advection] = scratch.finite_element_values[solution_field].gradient (i,q);
+              scratch.phi_field[i_advection]      = scratch.finite_element_values[solution_field].value (i,q);
             }
 
           const double JxW = scratch.finite_element_values.JxW(q);
@@ -347,7 +335,6 @@ namespace aspect
       internal::Assembly::CopyData::AdvectionSystem<dim> &data = dynamic_cast<internal::Assembly::CopyData::AdvectionSystem<dim>& > (data_base);
 
       const Introspection<dim> &introspection = this->introspection();
-      const FiniteElement<dim> &fe = this->get_fe();
 
       const typename Simulator<dim>::AdvectionField advection_field = *scratch.advection_field;
 
@@ -367,7 +354,6 @@ namespace aspect
       Assert (advection_dofs_per_cell < scratch.face_finite_element_values->get_fe().dofs_per_cell, ExcInternalError());
       Assert (scratch.face_phi_field.size() == advection_dofs_per_cell, ExcInternalError());
 
-      const unsigned int solution_component = advection_field.component_index(introspection);
       const FEValuesExtractors::Scalar solution_field = advection_field.scalar_extractor(introspection);
 
       if (this->get_fixed_heat_flux_boundary_indicators().find(face->boundary_id())
@@ -394,14 +380,10 @@ namespace aspect
               // We only need to look up values of shape functions if they
               // belong to 'our' component. They are zero otherwise anyway.
               // Note that we later only look at the values that we do set here.
-              for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell; /*increment at end of loop*/)
+              for (unsigned int i_advection=0; i_advection<advection_dofs_per_cell; ++i_advection)
                 {
-                  if (fe.system_to_component_index(i).first == solution_component)
-                    {
-                      scratch.face_phi_field[i_advection]      = (*scratch.face_finite_element_values)[solution_field].value (i, q);
-                      ++i_advection;
-                    }
-                  ++i;
+                  const unsigned int i = scratch.field_shape_function_indices[i_advection];
+                  scratch.face_phi_field[i_advection]      = (*scratch.face_finite_element_values)[solution_field].value (i, q);
                 }
 
               for (unsigned int i=0; i<advection_dofs_per_cell; ++i)
@@ -428,7 +410,6 @@ namespace aspect
 
       const Parameters<dim> &parameters = this->get_parameters();
       const Introspection<dim> &introspection = this->introspection();
-      const FiniteElement<dim> &fe = this->get_fe();
 
       const typename Simulator<dim>::AdvectionField advection_field = *scratch.advection_field;
 
@@ -450,8 +431,6 @@ namespace aspect
       Assert (scratch.face_grad_phi_field.size() == advection_dofs_per_cell, ExcInternalError());
       Assert (scratch.face_phi_field.size() == advection_dofs_per_cell, ExcInternalError());
 
-      const unsigned int solution_component = advection_field.component_index(introspection);
-
       const FEValuesExtractors::Scalar solution_field = advection_field.scalar_extractor(introspection);
 
 
@@ -482,15 +461,11 @@ namespace aspect
               // We only need to look up values of shape functions if they
               // belong to 'our' component. They are zero otherwise anyway.
               // Note that we later only look at the values that we do set here.
-              for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell; /*increment at end of loop*/)
+              for (unsigned int i_advection=0; i_advection<advection_dofs_per_cell; ++i_advection)
                 {
-                  if (fe.system_to_component_index(i).first == solution_component)
-                    {
-                      scratch.face_grad_phi_field[i_advection] = (*scratch.face_finite_element_values)[solution_field].gradient (i, q);
-                      scratch.face_phi_field[i_advection]      = (*scratch.face_finite_element_values)[solution_field].value (i, q);
-                      ++i_advection;
-                    }
-                  ++i;
+                  const unsigned int i = scratch.field_shape_function_indices[i_advection];
+                  scratch.face_grad_phi_field[i_advection] = (*scratch.face_finite_element_values)[solution_field].gradient (i, q);
+                  scratch.face_phi_field[i_advection]      = (*scratch.face_finite_element_values)[solution_field].value (i, q);
                 }
 
               const double density_c_P              =
@@ -665,7 +640,6 @@ namespace aspect
       Assert (n_q_points == scratch.subface_finite_element_values->n_quadrature_points, ExcInternalError());
       Assert (n_q_points == scratch.neighbor_face_finite_element_values->n_quadrature_points, ExcInternalError());
 
-      const unsigned int solution_component = advection_field.component_index(introspection);
 
       const FEValuesExtractors::Scalar solution_field = advection_field.scalar_extractor(introspection);
 
@@ -727,14 +701,10 @@ namespace aspect
               // get all dof indices on the neighbor, then extract those
               // that correspond to the solution_field we are interested in
               neighbor->get_dof_indices (neighbor_dof_indices);
-              for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell;/*increment at end of loop*/)
+              for (unsigned int i_advection=0; i_advection<advection_dofs_per_cell; ++i_advection)
                 {
-                  if (fe.system_to_component_index(i).first == solution_component)
-                    {
-                      data.neighbor_dof_indices[face_no * GeometryInfo<dim>::max_children_per_face][i_advection] = neighbor_dof_indices[i];
-                      ++i_advection;
-                    }
-                  ++i;
+                  const unsigned int i = scratch.field_shape_function_indices[i_advection];
+                  data.neighbor_dof_indices[face_no * GeometryInfo<dim>::max_children_per_face][i_advection] = neighbor_dof_indices[i];
                 }
               data.assembled_matrices[face_no * GeometryInfo<dim>::max_children_per_face] = true;
 
@@ -744,17 +714,13 @@ namespace aspect
                   // We only need to look up values of shape functions if they
                   // belong to 'our' component. They are zero otherwise anyway.
                   // Note that we later only look at the values that we do set here.
-                  for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell;/*increment at end of loop*/)
+                  for (unsigned int i_advection=0; i_advection<advection_dofs_per_cell; ++i_advection)
                     {
-                      if (fe.system_to_component_index(i).first == solution_component)
-                        {
-                          scratch.face_grad_phi_field[i_advection]          = (*scratch.face_finite_element_values)[solution_field].gradient (i, q);
-                          scratch.face_phi_field[i_advection]               = (*scratch.face_finite_element_values)[solution_field].value (i, q);
-                          scratch.neighbor_face_grad_phi_field[i_advection] = (*scratch.neighbor_face_finite_element_values)[solution_field].gradient (i, q);
-                          scratch.neighbor_face_phi_field[i_advection]      = (*scratch.neighbor_face_finite_element_values)[solution_field].value (i, q);
-                          ++i_advection;
-                        }
-                      ++i;
+                      const unsigned int i = scratch.field_shape_function_indices[i_advection];
+                      scratch.face_grad_phi_field[i_advection]          = (*scratch.face_finite_element_values)[solution_field].gradient (i, q);
+                      scratch.face_phi_field[i_advection]               = (*scratch.face_finite_element_values)[solution_field].value (i, q);
+                      scratch.neighbor_face_grad_phi_field[i_advection] = (*scratch.neighbor_face_finite_element_values)[solution_field].gradient (i, q);
+                      scratch.neighbor_face_phi_field[i_advection]      = (*scratch.neighbor_face_finite_element_values)[solution_field].value (i, q);
                     }
 
                   const double density_c_P              =
@@ -1083,14 +1049,10 @@ namespace aspect
               // get all dof indices on the neighbor, then extract those
               // that correspond to the solution_field we are interested in
               neighbor_child->get_dof_indices (neighbor_dof_indices);
-              for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell;/*increment at end of loop*/)
+              for (unsigned int i_advection=0; i_advection<advection_dofs_per_cell; ++i_advection)
                 {
-                  if (fe.system_to_component_index(i).first == solution_component)
-                    {
-                      data.neighbor_dof_indices[face_no * GeometryInfo<dim>::max_children_per_face + subface_no][i_advection] = neighbor_dof_indices[i];
-                      ++i_advection;
-                    }
-                  ++i;
+                  const unsigned int i = scratch.field_shape_function_indices[i_advection];
+                  data.neighbor_dof_indices[face_no * GeometryInfo<dim>::max_children_per_face + subface_no][i_advection] = neighbor_dof_indices[i];
                 }
               data.assembled_matrices[face_no * GeometryInfo<dim>::max_children_per_face + subface_no] = true;
 
@@ -1100,17 +1062,13 @@ namespace aspect
                   // We only need to look up values of shape functions if they
                   // belong to 'our' component. They are zero otherwise anyway.
                   // Note that we later only look at the values that we do set here.
-                  for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell; /*increment at end of loop*/)
+                  for (unsigned int i_advection=0; i_advection<advection_dofs_per_cell; ++i_advection)
                     {
-                      if (fe.system_to_component_index(i).first == solution_component)
-                        {
-                          scratch.face_grad_phi_field[i_advection]          = (*scratch.subface_finite_element_values)[solution_field].gradient (i, q);
-                          scratch.face_phi_field[i_advection]               = (*scratch.subface_finite_element_values)[solution_field].value (i, q);
-                          scratch.neighbor_face_grad_phi_field[i_advection] = (*scratch.neighbor_face_finite_element_values)[solution_field].gradient (i, q);
-                          scratch.neighbor_face_phi_field[i_advection]      = (*scratch.neighbor_face_finite_element_values)[solution_field].value (i, q);
-                          ++i_advection;
-                        }
-                      ++i;
+                      const unsigned int i = scratch.field_shape_function_indices[i_advection];
+                      scratch.face_grad_phi_field[i_advection]          = (*scratch.subface_finite_element_values)[solution_field].gradient (i, q);
+                      scratch.face_phi_field[i_advection]               = (*scratch.subface_finite_element_values)[solution_field].value (i, q);
+                      scratch.neighbor_face_grad_phi_field[i_advection] = (*scratch.neighbor_face_finite_element_values)[solution_field].gradient (i, q);
+                      scratch.neighbor_face_phi_field[i_advection]      = (*scratch.neighbor_face_finite_element_values)[solution_field].value (i, q);
                     }
 
                   const double density_c_P              =
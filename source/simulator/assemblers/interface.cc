@@ -135,8 +135,12 @@ namespace aspect
           velocity_values (quadrature.size(), numbers::signaling_nan<Tensor<1,dim> >()),
           velocity_divergence(quadrature.size(), numbers::signaling_nan<double>()),
           temperature_gradients (quadrature.size(), numbers::signaling_nan<Tensor<1,dim> >()),
+          grads_phi_u_times_strain_rate (stokes_dofs_per_cell, numbers::signaling_nan<double>()),
+          deta_deps_times_grads_phi_u (stokes_dofs_per_cell, numbers::signaling_nan<double>()),
+          newton_matrix_column_factors (stokes_dofs_per_cell, numbers::signaling_nan<double>()),
           face_material_model_inputs(face_quadrature.size(), n_compositional_fields),
           face_material_model_outputs(face_quadrature.size(), n_compositional_fields),
+          face_tractions(face_quadrature.size(), numbers::signaling_nan<Tensor<1,dim> >()),
           reference_densities(use_reference_density_profile ? quadrature.size() : 0, numbers::signaling_nan<double>()),
           reference_densities_depth_derivative(use_reference_density_profile ? quadrature.size() : 0, numbers::signaling_nan<double>()),
           rebuild_newton_stokes_matrix(rebuild_newton_stokes_matrix)
@@ -159,8 +163,12 @@ namespace aspect
           velocity_values (scratch.velocity_values),
           velocity_divergence (scratch.velocity_divergence),
           temperature_gradients (scratch.temperature_gradients),
+          grads_phi_u_times_strain_rate (scratch.grads_phi_u_times_strain_rate),
+          deta_deps_times_grads_phi_u (scratch.deta_deps_times_grads_phi_u),
+          newton_matrix_column_factors (scratch.newton_matrix_column_factors),
           face_material_model_inputs(scratch.face_material_model_inputs),
           face_material_model_outputs(scratch.face_material_model_outputs),
+          face_tractions(scratch.face_tractions),
           reference_densities(scratch.reference_densities),
           reference_densities_depth_derivative(scratch.reference_densities_depth_derivative),
           rebuild_newton_stokes_matrix(scratch.rebuild_newton_stokes_matrix)
@@ -218,6 +226,7 @@ namespace aspect
                                          :
                                          nullptr),
           local_dof_indices (finite_element.dofs_per_cell),
+          field_shape_function_indices (advection_element.dofs_per_cell, numbers::invalid_unsigned_int),
 
           phi_field (advection_element.dofs_per_cell, numbers::signaling_nan<double>()),
           grad_phi_field (advection_element.dofs_per_cell, numbers::signaling_nan<Tensor<1,dim> >()),
@@ -308,6 +317,7 @@ namespace aspect
                                          :
                                          nullptr),
           local_dof_indices (scratch.finite_element_values.get_fe().dofs_per_cell),
+          field_shape_function_indices (scratch.field_shape_function_indices),
 
           phi_field (scratch.phi_field),
           grad_phi_field (scratch.grad_phi_field),
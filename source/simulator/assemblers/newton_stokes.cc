@@ -267,6 +267,32 @@ namespace aspect
       const unsigned int stokes_dofs_per_cell = data.local_dof_indices.size();
       const unsigned int n_q_points    = scratch.finite_element_values.n_quadrature_points;
       const double derivative_scaling_factor = this->get_newton_handler().parameters.newton_derivative_scaling_factor;
+      const double pressure_scaling = this->get_pressure_scaling();
+
+      // Look up the material model derivatives and the stabilization
+      // parameters only once per cell rather than at every quadrature point
+      const bool assemble_newton_terms = (scratch.rebuild_newton_stokes_matrix
+                                          && derivative_scaling_factor != 0);
+      const MaterialModel::MaterialModelDerivatives<dim> *derivatives
+        = (assemble_newton_terms
+           ?
+           scratch.material_model_outputs.template get_additional_output<MaterialModel::MaterialModelDerivatives<dim> >()
+           :
+           nullptr);
+
+      // This one is only available in debug mode, because normally
+      // the AssertTrow in the preconditioner should already have
+      // caught the problem.
+      Assert(!assemble_newton_terms || derivatives != nullptr,
+             ExcMessage ("Error: The Newton method requires the material to "
+                         "compute derivatives."));
+
+      const typename Newton::Parameters::Stabilization
+      velocity_block_stabilization = this->get_newton_handler().parameters.velocity_block_stabilization;
+      const bool use_spd_factor = (velocity_block_stabilization & Newton::Parameters::Stabilization::PD)
+                                  != Newton::Parameters::Stabilization::none;
+      const bool symmetrize = (velocity_block_stabilization & Newton::Parameters::Stabilization::symmetric)
+                              != Newton::Parameters::Stabilization::none;
 
       for (unsigned int q=0; q<n_q_points; ++q)
         {
@@ -303,11 +329,16 @@ namespace aspect
           const double density = scratch.material_model_outputs.densities[q];
 
           const double JxW = scratch.finite_element_values.JxW(q);
-          const double pressure_scaling = this->get_pressure_scaling();
+
+          // The contraction eps(phi_i):eps(u) appears both in the right hand
+          // side and in all Newton terms, so compute it only once per shape
+          // function
+          for (unsigned int i=0; i<stokes_dofs_per_cell; ++i)
+            scratch.grads_phi_u_times_strain_rate[i] = scratch.grads_phi_u[i] * strain_rate;
 
           // first assemble the rhs
           for (unsigned int i=0; i<stokes_dofs_per_cell; ++i)
-            data.local_rhs(i) -= (eta * 2.0 * (scratch.grads_phi_u[i] * strain_rate)
+            data.local_rhs(i) -= (eta * 2.0 * scratch.grads_phi_u_times_strain_rate[i]
                                   - (scratch.div_phi_u[i] * pressure)
                                   - (pressure_scaling * scratch.phi_p[i] * velocity_divergence)
                                   -(density * gravity * scratch.phi_u[i]))
@@ -335,66 +366,79 @@ namespace aspect
 
               // then also see whether we have to add terms due to the
               // Newton linearization
-              if (derivative_scaling_factor != 0)
+              if (assemble_newton_terms)
                 {
-                  const MaterialModel::MaterialModelDerivatives<dim> *derivatives
-                    = scratch.material_model_outputs.template get_additional_output<MaterialModel::MaterialModelDerivatives<dim> >();
-
-                  // This one is only available in debug mode, because normally
-                  // the AssertTrow in the preconditioner should already have
-                  // caught the problem.
-                  Assert(derivatives != nullptr,
-                         ExcMessage ("Error: The Newton method requires the material to "
-                                     "compute derivatives."));
-
-                  const SymmetricTensor<2,dim> viscosity_derivative_wrt_strain_rate = derivatives->viscosity_derivative_wrt_strain_rate[q];
+                  const SymmetricTensor<2,dim> &viscosity_derivative_wrt_strain_rate = derivatives->viscosity_derivative_wrt_strain_rate[q];
                   const double viscosity_derivative_wrt_pressure = derivatives->viscosity_derivative_wrt_pressure[q];
-                  typename Newton::Parameters::Stabilization velocity_block_stabilization = this->get_newton_handler().parameters.velocity_block_stabilization;
 
                   // use the spd factor when the stabilization is PD or SPD
-                  const double alpha =  (velocity_block_stabilization & Newton::Parameters::Stabilization::PD) != Newton::Parameters::Stabilization::none ?
-                                        Utilities::compute_spd_factor<dim>(eta, strain_rate, viscosity_derivative_wrt_strain_rate,
-                                                                           this->get_newton_handler().parameters.SPD_safety_factor)
-                                        :
-                                        1;
-
-                  // pre-compute the tensor contractions
-                  std::vector<SymmetricTensor<2,dim> > deta_deps_times_eps_times_phi(stokes_dofs_per_cell);
-                  for (unsigned int i = 0; i < stokes_dofs_per_cell; ++i)
-                    deta_deps_times_eps_times_phi[i] = (viscosity_derivative_wrt_strain_rate * scratch.grads_phi_u[i]) * strain_rate;
-
+                  const double alpha = use_spd_factor ?
+                                       Utilities::compute_spd_factor<dim>(eta, strain_rate, viscosity_derivative_wrt_strain_rate,
+                                                                          this->get_newton_handler().parameters.SPD_safety_factor)
+                                       :
+                                       1;
+
+                  // The Newton terms are
+                  //   alpha * (eps(phi_i):eps(u)) * (deta/deps:eps(phi_j))
+                  //   + 2 * deta/dp * (eps(phi_i):eps(u)) * phi_p[j]
+                  // (plus the transpose of the first term if we symmetrize),
+                  // i.e., a rank-1 (or rank-2) update of the local matrix.
+                  // Precompute the factors that only depend on one of the
+                  // two shape functions, so that the double loop below only
+                  // consists of scalar multiply-adds.
+                  const double strain_rate_factor = derivative_scaling_factor * alpha * JxW;
+                  const double pressure_factor = derivative_scaling_factor * pressure_scaling * 2.0
+                                                 * viscosity_derivative_wrt_pressure * JxW;
+
+                  for (unsigned int j=0; j<stokes_dofs_per_cell; ++j)
+                    {
+                      scratch.deta_deps_times_grads_phi_u[j] = strain_rate_factor
+                                                               * (viscosity_derivative_wrt_strain_rate * scratch.grads_phi_u[j]);
+                      scratch.newton_matrix_column_factors[j] = (symmetrize ? 1.0 : 2.0) * scratch.deta_deps_times_grads_phi_u[j]
+                                                                + pressure_factor * scratch.phi_p[j];
+                    }
 
                   // symmetrize when the stabilization is symmetric or SPD
-                  if ((velocity_block_stabilization & Newton::Parameters::Stabilization::symmetric) != Newton::Parameters::Stabilization::none)
+                  if (symmetrize)
                     {
                       for (unsigned int i=0; i<stokes_dofs_per_cell; ++i)
-                        for (unsigned int j=0; j<stokes_dofs_per_cell; ++j)
-                          {
-                            data.local_matrix(i,j) += ( derivative_scaling_factor * alpha * (scratch.grads_phi_u[i] * deta_deps_times_eps_times_phi[j]
-                                                                                             + scratch.grads_phi_u[j] * deta_deps_times_eps_times_phi[i])
-                                                        + derivative_scaling_factor * pressure_scaling * 2.0 * viscosity_derivative_wrt_pressure * scratch.phi_p[j] * scratch.grads_phi_u[i] * strain_rate )
-                                                      * JxW;
-
-                            Assert(dealii::numbers::is_finite(data.local_matrix(i,j)),
-                                   ExcMessage ("Error: Assembly matrix is not finite." +
-                                               Utilities::to_string(data.local_matrix(i,j)) +
-                                               " = " + Utilities::to_string(eta)));
-                          }
+                        {
+                          const double row_factor = scratch.grads_phi_u_times_strain_rate[i];
+                          const double transposed_row_factor = scratch.deta_deps_times_grads_phi_u[i];
+
+                          for (unsigned int j=0; j<stokes_dofs_per_cell; ++j)
+                            {
+                              data.local_matrix(i,j) += row_factor * scratch.newton_matrix_column_factors[j]
+                                                        + transposed_row_factor * scratch.grads_phi_u_times_strain_rate[j];
+
+                              Assert(dealii::numbers::is_finite(data.local_matrix(i,j)),
+                                     ExcMessage ("Error: Assembly matrix is not finite." +
+                                                 Utilities::to_string(data.local_matrix(i,j)) +
+                                                 " = " + Utilities::to_string(eta)));
+                            }
+                        }
                     }
                   else
                     {
                       for (unsigned int i=0; i<stokes_dofs_per_cell; ++i)
-                        for (unsigned int j=0; j<stokes_dofs_per_cell; ++j)
-                          {
-                            data.local_matrix(i,j) += ( derivative_scaling_factor * alpha * 2.0 * (scratch.grads_phi_u[i] * deta_deps_times_eps_times_phi[j])
-                                                        + derivative_scaling_factor * pressure_scaling * 2.0 * viscosity_derivative_wrt_pressure * scratch.phi_p[j] * scratch.grads_phi_u[i] * strain_rate )
-                                                      * JxW;
-
-                            Assert(dealii::numbers::is_finite(data.local_matrix(i,j)),
-                                   ExcMessage ("Error: Assembly matrix is not finite." +
-                                               Utilities::to_string(data.local_matrix(i,j)) +
-                                               " = " + Utilities::to_string(eta)));
-                          }
+                        {
+                          const double row_factor = scratch.grads_phi_u_times_strain_rate[i];
+
+                          // the velocity shape functions of the pressure
+                          // DoFs are zero, so there is nothing to add
+                          if (row_factor == 0)
+                            continue;
+
+                          for (unsigned int j=0; j<stokes_dofs_per_cell; ++j)
+                            {
+                              data.local_matrix(i,j) += row_factor * scratch.newton_matrix_column_factors[j];
+
+                              Assert(dealii::numbers::is_finite(data.local_matrix(i,j)),
+                                     ExcMessage ("Error: Assembly matrix is not finite." +
+                                                 Utilities::to_string(data.local_matrix(i,j)) +
+                                                 " = " + Utilities::to_string(eta)));
+                            }
+                        }
                     }
                 }
             }
@@ -24,6 +24,9 @@
 
 #include <deal.II/base/signaling_nan.h>
 
+#include <algorithm>
+#include <typeinfo>
+
 namespace aspect
 {
   namespace Assemblers
@@ -624,20 +627,26 @@ namespace aspect
 
       const typename DoFHandler<dim>::face_iterator face = scratch.cell->face(scratch.face_number);
 
-      if (this->get_boundary_traction()
-          .find (face->boundary_id())
-          !=
-          this->get_boundary_traction().end())
+      const auto boundary_traction = this->get_boundary_traction().find (face->boundary_id());
+      if (boundary_traction != this->get_boundary_traction().end())
         {
+          // compute the tractions at all quadrature points of the face at once
+          scratch.face_tractions.resize (scratch.face_finite_element_values.n_quadrature_points);
+          {
+            const Profiler::Scope profiler_scope (this->get_profiler(), "Boundary traction model", "evaluate");
+            boundary_traction->second->boundary_tractions (face->boundary_id(),
+                                                           scratch.face_finite_element_values.get_quadrature_points(),
+#if DEAL_II_VERSION_GTE(9,0,0)
+                                                           scratch.face_finite_element_values.get_normal_vectors(),
+#else
+                                                           scratch.face_finite_element_values.get_all_normal_vectors(),
+#endif
+                                                           scratch.face_tractions);
+          }
+
           for (unsigned int q=0; q<scratch.face_finite_element_values.n_quadrature_points; ++q)
             {
-              const Tensor<1,dim> traction
-                = this->get_boundary_traction().find(
-                    face->boundary_id()
-                  )->second
-                  ->boundary_traction (face->boundary_id(),
-                                       scratch.face_finite_element_values.quadrature_point(q),
-                                       scratch.face_finite_element_values.normal_vector(q));
+              const Tensor<1,dim> &traction = scratch.face_tractions[q];
 
               for (unsigned int i=0, i_stokes=0; i_stokes<stokes_dofs_per_cell; /*increment at end of loop*/)
                 {
@@ -653,6 +662,392 @@ namespace aspect
             }
         }
     }
+
+
+    template <int dim>
+    void
+    StokesDoFMap::initialize (const FiniteElement<dim> &fe,
+                              const Introspection<dim> &introspection)
+    {
+      shape_function_indices.clear();
+      component_indices.clear();
+      velocity_dofs.clear();
+      pressure_dofs.clear();
+      velocity_dofs_per_component.assign (dim, std::vector<unsigned int>());
+
+      for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+        {
+          const unsigned int component = fe.system_to_component_index(i).first;
+          if (!introspection.is_stokes_component(component))
+            continue;
+
+          const unsigned int i_stokes = shape_function_indices.size();
+          shape_function_indices.push_back (i);
+          component_indices.push_back (component);
+
+          if (component == introspection.component_indices.pressure)
+            pressure_dofs.push_back (i_stokes);
+          else
+            {
+              const unsigned int velocity_component = component - introspection.component_indices.velocities[0];
+              AssertIndexRange (velocity_component, dim);
+
+              velocity_dofs.push_back (i_stokes);
+              velocity_dofs_per_component[velocity_component].push_back (i_stokes);
+            }
+        }
+    }
+
+
+
+    template <int dim, bool compressible>
+    void
+    StokesSystemKernel<dim,compressible>::initialize ()
+    {
+      dof_map.initialize (this->get_fe(), this->introspection());
+    }
+
+
+
+    template <int dim, bool compressible>
+    void
+    StokesSystemKernel<dim,compressible>::
+    add_matrix_terms (const StokesDoFMap                         &dof_map,
+                      const std::vector<SymmetricTensor<2,dim> > &grads_phi_u,
+                      const std::vector<double>                  &div_phi_u,
+                      const std::vector<double>                  &phi_p,
+                      const double                                eta,
+                      const double                                pressure_scaling,
+                      const double                                JxW,
+                      FullMatrix<double>                         &local_matrix)
+    {
+      const double two_eta_JxW = 2.0 * eta * JxW;
+      const double two_thirds_eta_JxW = 2.0 / 3.0 * eta * JxW;
+      const double pressure_scaling_JxW = pressure_scaling * JxW;
+
+      const unsigned int n_velocity_dofs = dof_map.velocity_dofs.size();
+      for (unsigned int a=0; a<n_velocity_dofs; ++a)
+        {
+          const unsigned int i = dof_map.velocity_dofs[a];
+
+          // the velocity block is symmetric, so only compute its upper
+          // triangle and copy it into the lower one
+          for (unsigned int b=a; b<n_velocity_dofs; ++b)
+            {
+              const unsigned int j = dof_map.velocity_dofs[b];
+
+              double value = two_eta_JxW * (grads_phi_u[i] * grads_phi_u[j]);
+              if (compressible)
+                value -= two_thirds_eta_JxW * (div_phi_u[i] * div_phi_u[j]);
+
+              local_matrix(i,j) += value;
+              if (j != i)
+                local_matrix(j,i) += value;
+            }
+
+          // assemble \nabla p as -(p, div v), and the term -div(u) as
+          // -(div u, q), which is the transpose of the former. the
+          // pressure-pressure block is zero
+          for (const unsigned int j : dof_map.pressure_dofs)
+            {
+              const double value = - pressure_scaling_JxW * (div_phi_u[i] * phi_p[j]);
+              local_matrix(i,j) += value;
+              local_matrix(j,i) += value;
+            }
+        }
+    }
+
+
+
+    template <int dim, bool compressible>
+    void
+    StokesSystemKernel<dim,compressible>::
+    execute (internal::Assembly::Scratch::ScratchBase<dim>   &scratch_base,
+             internal::Assembly::CopyData::CopyDataBase<dim> &data_base) const
+    {
+      // this class is only ever used for the Stokes system, so we can
+      // avoid the cost of a dynamic_cast in optimized mode
+      Assert (dynamic_cast<internal::Assembly::Scratch::StokesSystem<dim> *> (&scratch_base) != nullptr,
+              ExcInternalError());
+      Assert (dynamic_cast<internal::Assembly::CopyData::StokesSystem<dim> *> (&data_base) != nullptr,
+              ExcInternalError());
+      internal::Assembly::Scratch::StokesSystem<dim> &scratch = static_cast<internal::Assembly::Scratch::StokesSystem<dim>& > (scratch_base);
+      internal::Assembly::CopyData::StokesSystem<dim> &data = static_cast<internal::Assembly::CopyData::StokesSystem<dim>& > (data_base);
+
+      Assert (dof_map.shape_function_indices.size() == data.local_dof_indices.size(),
+              ExcMessage ("The map of the Stokes degrees of freedom has not been initialized "
+                          "for the current finite element."));
+
+      const Introspection<dim> &introspection = this->introspection();
+      const FEValuesViews::Vector<dim> &velocity_values = scratch.finite_element_values[introspection.extractors.velocities];
+      const FEValuesViews::Scalar<dim> &pressure_values = scratch.finite_element_values[introspection.extractors.pressure];
+      const unsigned int n_q_points    = scratch.finite_element_values.n_quadrature_points;
+      const double pressure_scaling = this->get_pressure_scaling();
+
+      const MaterialModel::AdditionalMaterialOutputsStokesRHS<dim>
+      *force = (this->get_parameters().enable_additional_stokes_rhs
+                ?
+                scratch.material_model_outputs.template get_additional_output<MaterialModel::AdditionalMaterialOutputsStokesRHS<dim> >()
+                :
+                nullptr);
+
+      const MaterialModel::ElasticOutputs<dim>
+      *elastic_outputs = (this->get_parameters().enable_elasticity
+                          ?
+                          scratch.material_model_outputs.template get_additional_output<MaterialModel::ElasticOutputs<dim> >()
+                          :
+                          nullptr);
+
+      const bool need_gradients = (scratch.rebuild_stokes_matrix || elastic_outputs != nullptr);
+
+      for (unsigned int q=0; q<n_q_points; ++q)
+        {
+          for (const unsigned int i : dof_map.velocity_dofs)
+            {
+              const unsigned int shape_function = dof_map.shape_function_indices[i];
+              scratch.phi_u[i] = velocity_values.value (shape_function, q);
+              if (need_gradients)
+                scratch.grads_phi_u[i] = velocity_values.symmetric_gradient (shape_function, q);
+              if (scratch.rebuild_stokes_matrix)
+                scratch.div_phi_u[i] = velocity_values.divergence (shape_function, q);
+            }
+          for (const unsigned int i : dof_map.pressure_dofs)
+            scratch.phi_p[i] = pressure_values.value (dof_map.shape_function_indices[i], q);
+
+          const Tensor<1,dim>
+          gravity = this->get_gravity_model().gravity_vector (scratch.finite_element_values.quadrature_point(q));
+
+          const double JxW = scratch.finite_element_values.JxW(q);
+
+          Tensor<1,dim> body_force = scratch.material_model_outputs.densities[q] * gravity;
+          if (force != nullptr)
+            body_force += force->rhs_u[q];
+
+          for (const unsigned int i : dof_map.velocity_dofs)
+            {
+              double value = body_force * scratch.phi_u[i];
+              if (elastic_outputs != nullptr)
+                value += scalar_product(elastic_outputs->elastic_force[q],Tensor<2,dim>(scratch.grads_phi_u[i]));
+              data.local_rhs(i) += value * JxW;
+            }
+
+          if (force != nullptr)
+            for (const unsigned int i : dof_map.pressure_dofs)
+              data.local_rhs(i) += pressure_scaling * force->rhs_p[q] * scratch.phi_p[i] * JxW;
+
+          if (scratch.rebuild_stokes_matrix)
+            add_matrix_terms (dof_map,
+                              scratch.grads_phi_u,
+                              scratch.div_phi_u,
+                              scratch.phi_p,
+                              scratch.material_model_outputs.viscosities[q],
+                              pressure_scaling,
+                              JxW,
+                              data.local_matrix);
+        }
+    }
+
+
+
+    template <int dim, bool compressible>
+    void
+    StokesPreconditionerKernel<dim,compressible>::initialize ()
+    {
+      dof_map.initialize (this->get_fe(), this->introspection());
+    }
+
+
+
+    template <int dim, bool compressible>
+    void
+    StokesPreconditionerKernel<dim,compressible>::
+    add_matrix_terms (const StokesDoFMap                         &dof_map,
+                      const std::vector<SymmetricTensor<2,dim> > &grads_phi_u,
+                      const std::vector<double>                  &div_phi_u,
+                      const std::vector<double>                  &phi_p,
+                      const double                                eta,
+                      const double                                pressure_scaling,
+                      const double                                JxW,
+                      const bool                                  assemble_A_approximation,
+                      FullMatrix<double>                         &local_matrix)
+    {
+      // the preconditioner only couples shape functions of the same
+      // vector component, and all of its blocks are symmetric
+      if (assemble_A_approximation || compressible)
+        {
+          const double two_eta_JxW = 2.0 * eta * JxW;
+          const double two_thirds_eta_JxW = 2.0 / 3.0 * eta * JxW;
+
+          for (unsigned int d=0; d<dim; ++d)
+            {
+              const std::vector<unsigned int> &velocity_dofs = dof_map.velocity_dofs_per_component[d];
+              const unsigned int n_velocity_dofs = velocity_dofs.size();
+
+              for (unsigned int a=0; a<n_velocity_dofs; ++a)
+                {
+                  const unsigned int i = velocity_dofs[a];
+                  for (unsigned int b=a; b<n_velocity_dofs; ++b)
+                    {
+                      const unsigned int j = velocity_dofs[b];
+
+                      double value = 0.0;
+                      if (assemble_A_approximation)
+                        value += two_eta_JxW * (grads_phi_u[i] * grads_phi_u[j]);
+                      if (compressible)
+                        value -= two_thirds_eta_JxW * (div_phi_u[i] * div_phi_u[j]);
+
+                      local_matrix(i,j) += value;
+                      if (j != i)
+                        local_matrix(j,i) += value;
+                    }
+                }
+            }
+        }
+
+      const double pressure_factor = pressure_scaling * pressure_scaling / eta * JxW;
+      const unsigned int n_pressure_dofs = dof_map.pressure_dofs.size();
+      for (unsigned int a=0; a<n_pressure_dofs; ++a)
+        {
+          const unsigned int i = dof_map.pressure_dofs[a];
+          for (unsigned int b=a; b<n_pressure_dofs; ++b)
+            {
+              const unsigned int j = dof_map.pressure_dofs[b];
+              const double value = pressure_factor * (phi_p[i] * phi_p[j]);
+
+              local_matrix(i,j) += value;
+              if (j != i)
+                local_matrix(j,i) += value;
+            }
+        }
+    }
+
+
+
+    template <int dim, bool compressible>
+    void
+    StokesPreconditionerKernel<dim,compressible>::
+    execute (internal::Assembly::Scratch::ScratchBase<dim>   &scratch_base,
+             internal::Assembly::CopyData::CopyDataBase<dim> &data_base) const
+    {
+      Assert (dynamic_cast<internal::Assembly::Scratch::StokesPreconditioner<dim> *> (&scratch_base) != nullptr,
+              ExcInternalError());
+      Assert (dynamic_cast<internal::Assembly::CopyData::StokesPreconditioner<dim> *> (&data_base) != nullptr,
+              ExcInternalError());
+      internal::Assembly::Scratch::StokesPreconditioner<dim> &scratch = static_cast<internal::Assembly::Scratch::StokesPreconditioner<dim>& > (scratch_base);
+      internal::Assembly::CopyData::StokesPreconditioner<dim> &data = static_cast<internal::Assembly::CopyData::StokesPreconditioner<dim>& > (data_base);
+
+      Assert (dof_map.shape_function_indices.size() == data.local_dof_indices.size(),
+              ExcMessage ("The map of the Stokes degrees of freedom has not been initialized "
+                          "for the current finite element."));
+
+      const Introspection<dim> &introspection = this->introspection();
+      const FEValuesViews::Vector<dim> &velocity_values = scratch.finite_element_values[introspection.extractors.velocities];
+      const FEValuesViews::Scalar<dim> &pressure_values = scratch.finite_element_values[introspection.extractors.pressure];
+      const unsigned int n_q_points           = scratch.finite_element_values.n_quadrature_points;
+      const double pressure_scaling = this->get_pressure_scaling();
+      const bool assemble_A_approximation = !this->get_parameters().use_full_A_block_preconditioner;
+
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          if (assemble_A_approximation || compressible)
+            for (const unsigned int i : dof_map.velocity_dofs)
+              {
+                const unsigned int shape_function = dof_map.shape_function_indices[i];
+                if (assemble_A_approximation)
+                  scratch.grads_phi_u[i] = velocity_values.symmetric_gradient (shape_function, q);
+                if (compressible)
+                  scratch.div_phi_u[i] = velocity_values.divergence (shape_function, q);
+              }
+          for (const unsigned int i : dof_map.pressure_dofs)
+            scratch.phi_p[i] = pressure_values.value (dof_map.shape_function_indices[i], q);
+
+          add_matrix_terms (dof_map,
+                            scratch.grads_phi_u,
+                            scratch.div_phi_u,
+                            scratch.phi_p,
+                            scratch.material_model_outputs.viscosities[q],
+                            pressure_scaling,
+                            scratch.finite_element_values.JxW(q),
+                            assemble_A_approximation,
+                            data.local_matrix);
+        }
+    }
+
+
+
+    namespace
+    {
+      /**
+       * Return an iterator to the first element of @p assemblers whose
+       * dynamic type is exactly @p type.
+       */
+      template <int dim>
+      typename std::vector<std::unique_ptr<Interface<dim> > >::iterator
+      find_assembler_of_type (std::vector<std::unique_ptr<Interface<dim> > > &assemblers,
+                              const std::type_info                            &type)
+      {
+        return std::find_if (assemblers.begin(), assemblers.end(),
+                             [&] (const std::unique_ptr<Interface<dim> > &assembler)
+        {
+          return (typeid(*assembler) == type);
+        });
+      }
+
+
+
+      /**
+       * Create an assembler of type KernelType and initialize it.
+       */
+      template <class KernelType, int dim>
+      std::unique_ptr<Interface<dim> >
+      create_kernel (const Simulator<dim> &simulator)
+      {
+        std::unique_ptr<KernelType> kernel = std_cxx14::make_unique<KernelType>();
+        kernel->initialize_simulator (simulator);
+        kernel->initialize ();
+        return std::unique_ptr<Interface<dim> > (std::move(kernel));
+      }
+    }
+
+
+
+    template <int dim>
+    void
+    select_specialized_stokes_assemblers (const Simulator<dim> &simulator,
+                                          Manager<dim>         &assemblers)
+    {
+      const auto incompressible_terms
+        = find_assembler_of_type (assemblers.stokes_system, typeid(StokesIncompressibleTerms<dim>));
+      if (incompressible_terms != assemblers.stokes_system.end())
+        {
+          const auto compressible_terms
+            = find_assembler_of_type (assemblers.stokes_system, typeid(StokesCompressibleStrainRateViscosityTerm<dim>));
+
+          if (compressible_terms != assemblers.stokes_system.end())
+            {
+              *incompressible_terms = create_kernel<StokesSystemKernel<dim,true> > (simulator);
+              assemblers.stokes_system.erase (compressible_terms);
+            }
+          else
+            *incompressible_terms = create_kernel<StokesSystemKernel<dim,false> > (simulator);
+        }
+
+      const auto preconditioner
+        = find_assembler_of_type (assemblers.stokes_preconditioner, typeid(StokesPreconditioner<dim>));
+      if (preconditioner != assemblers.stokes_preconditioner.end())
+        {
+          const auto compressible_preconditioner
+            = find_assembler_of_type (assemblers.stokes_preconditioner, typeid(StokesCompressiblePreconditioner<dim>));
+
+          if (compressible_preconditioner != assemblers.stokes_preconditioner.end())
+            {
+              *preconditioner = create_kernel<StokesPreconditionerKernel<dim,true> > (simulator);
+              assemblers.stokes_preconditioner.erase (compressible_preconditioner);
+            }
+          else
+            *preconditioner = create_kernel<StokesPreconditionerKernel<dim,false> > (simulator);
+        }
+    }
   }
 } // namespace aspect
 
@@ -671,7 +1066,13 @@ namespace aspect
   template class StokesIsothermalCompressionTerm<dim>; \
   template class StokesHydrostaticCompressionTerm<dim>; \
   template class StokesPressureRHSCompatibilityModification<dim>; \
-  template class StokesBoundaryTraction<dim>;
+  template class StokesBoundaryTraction<dim>; \
+  template class StokesSystemKernel<dim,false>; \
+  template class StokesSystemKernel<dim,true>; \
+  template class StokesPreconditionerKernel<dim,false>; \
+  template class StokesPreconditionerKernel<dim,true>; \
+  template void StokesDoFMap::initialize (const FiniteElement<dim> &, const Introspection<dim> &); \
+  template void select_specialized_stokes_assemblers (const Simulator<dim> &, Manager<dim> &);
 
     ASPECT_INSTANTIATE(INSTANTIATE)
   }
@@ -296,6 +296,12 @@ namespace aspect
     initialize_simulator(*this,assemblers->advection_system);
     initialize_simulator(*this,assemblers->advection_system_on_boundary_face);
     initialize_simulator(*this,assemblers->advection_system_on_interior_face);
+
+    // finally replace the default Stokes assemblers by the equivalent
+    // specialized ones. this has to happen after the signal above, so
+    // that user assemblers that replace or derive from the default
+    // classes keep being used as they are
+    aspect::Assemblers::select_specialized_stokes_assemblers (*this, *assemblers);
   }
 
 
@@ -328,8 +334,11 @@ namespace aspect
     for (unsigned int i=0; i<assemblers->stokes_preconditioner.size(); ++i)
       assemblers->stokes_preconditioner[i]->create_additional_material_model_outputs(scratch.material_model_outputs);
 
-    material_model->evaluate(scratch.material_model_inputs,
-                             scratch.material_model_outputs);
+    {
+      const Profiler::Scope profiler_scope (profiler, "Material model");
+      material_model->evaluate(scratch.material_model_inputs,
+                               scratch.material_model_outputs);
+    }
     MaterialModel::MaterialAveraging::average (parameters.material_averaging,
                                                cell,
                                                scratch.finite_element_values.get_quadrature(),
@@ -385,6 +394,7 @@ namespace aspect
                       internal::Assembly::Scratch::StokesPreconditioner<dim> &scratch,
                       internal::Assembly::CopyData::StokesPreconditioner<dim> &data)
     {
+      const typename CellCostModel<dim>::ScopedCellTimer cell_timer (cell_cost_model, cell);
       this->local_assemble_stokes_preconditioner(cell, scratch, data);
     };
 
@@ -427,6 +437,7 @@ namespace aspect
       return;
 
     TimerOutput::Scope timer (computing_timer, "Build Stokes preconditioner");
+    const Profiler::Scope profiler_scope (profiler, "Build Stokes preconditioner");
     pcout << "   Rebuilding Stokes preconditioner..." << std::flush;
 
     // first assemble the raw matrices necessary for the preconditioner
@@ -441,6 +452,8 @@ namespace aspect
 
     if (parameters.include_melt_transport)
       Mp_preconditioner = std_cxx14::make_unique<LinearAlgebra::PreconditionAMG>();
+    else if (parameters.use_single_precision_schur_complement_preconditioner)
+      Mp_preconditioner_single_precision = std_cxx14::make_unique<SinglePrecisionILU>();
     else
       Mp_preconditioner = std_cxx14::make_unique<LinearAlgebra::PreconditionILU>();
 
@@ -481,7 +494,9 @@ namespace aspect
      *  does the mass matrix, we just reuse the same system_preconditioner_matrix
      *  for the Mp_preconditioner block.  Maybe a bit messy*/
 
-    if (parameters.include_melt_transport == false)
+    if (Mp_preconditioner_single_precision)
+      Mp_preconditioner_single_precision->initialize (system_preconditioner_matrix.block(1,1));
+    else if (parameters.include_melt_transport == false)
       {
         LinearAlgebra::PreconditionILU *Mp_preconditioner_ILU
           = dynamic_cast<LinearAlgebra::PreconditionILU *> (Mp_preconditioner.get());
@@ -564,8 +579,29 @@ namespace aspect
     for (unsigned int i=0; i<assemblers->stokes_system.size(); ++i)
       assemblers->stokes_system[i]->create_additional_material_model_outputs(scratch.material_model_outputs);
 
-    material_model->evaluate(scratch.material_model_inputs,
-                             scratch.material_model_outputs);
+    {
+      const Profiler::Scope profiler_scope (profiler, "Material model");
+      material_model->evaluate(scratch.material_model_inputs,
+                               scratch.material_model_outputs);
+    }
+
+    // keep the (unaveraged) densities for the nullspace removal after
+    // the solve. every cell writes to its own range of entries, so this
+    // is safe to do from several threads at once
+    if (parameters.nullspace_removal != NullspaceRemoval::none
+        &&
+        !assemble_auxiliary_stokes_residual)
+      {
+        const unsigned int n_q_points = scratch.finite_element_values.n_quadrature_points;
+        const unsigned int first_index = cell->active_cell_index() * n_q_points;
+        for (unsigned int q=0; q<n_q_points; ++q)
+          {
+            nullspace_quadrature_data.densities[first_index+q] = scratch.material_model_outputs.densities[q];
+            nullspace_quadrature_data.JxW_values[first_index+q] = scratch.finite_element_values.JxW(q);
+            nullspace_quadrature_data.positions[first_index+q] = scratch.material_model_inputs.position[q];
+          }
+      }
+
     MaterialModel::MaterialAveraging::average (parameters.material_averaging,
                                                cell,
                                                scratch.finite_element_values.get_quadrature(),
@@ -620,8 +656,11 @@ namespace aspect
                   for (unsigned int i=0; i<assemblers->stokes_system_on_boundary_face.size(); ++i)
                     assemblers->stokes_system_on_boundary_face[i]->create_additional_material_model_outputs(scratch.face_material_model_outputs);
 
-                  material_model->evaluate(scratch.face_material_model_inputs,
-                                           scratch.face_material_model_outputs);
+                  {
+                    const Profiler::Scope profiler_scope (profiler, "Material model");
+                    material_model->evaluate(scratch.face_material_model_inputs,
+                                             scratch.face_material_model_outputs);
+                  }
 
                   // TODO: Currently we do not supply reference density values to Stokes face assemblers.
                   // This seems acceptable for now, since the only face assemblers are the ones for the melt
@@ -682,6 +721,7 @@ namespace aspect
                                  "Assemble Stokes system Newton")
                                 :
                                 "Assemble Stokes system rhs")));
+    const Profiler::Scope profiler_scope (profiler, "Assemble Stokes system");
 
     if (rebuild_stokes_matrix == true)
       system_matrix = 0;
@@ -691,8 +731,12 @@ namespace aspect
     // when having inhomogeneous constraints. Make sure that we can not have
     // this situation (no active boundary conditions means that only
     // no-slip/free slip are used). This should not happen as we set this up
-    // correctly before calling this function.
-    Assert(rebuild_stokes_matrix || boundary_velocity_manager.get_active_boundary_velocity_conditions().size()==0,
+    // correctly before calling this function. The exception are the Newton
+    // iterations after the first one, in which the constraints for the
+    // Newton update are always homogeneous.
+    Assert(rebuild_stokes_matrix
+           || boundary_velocity_manager.get_active_boundary_velocity_conditions().size()==0
+           || (assemble_newton_stokes_system && nonlinear_iteration > 0),
            ExcInternalError("If we have inhomogeneous constraints, we must re-assemble the system matrix."));
 
     system_rhs = 0;
@@ -702,6 +746,16 @@ namespace aspect
     const QGauss<dim>   quadrature_formula(parameters.stokes_velocity_degree+1);
     const QGauss<dim-1> face_quadrature_formula(parameters.stokes_velocity_degree+1);
 
+    if (parameters.nullspace_removal != NullspaceRemoval::none
+        &&
+        !assemble_auxiliary_stokes_residual)
+      {
+        const unsigned int n_entries = triangulation.n_active_cells() * quadrature_formula.size();
+        nullspace_quadrature_data.densities.resize (n_entries);
+        nullspace_quadrature_data.JxW_values.resize (n_entries);
+        nullspace_quadrature_data.positions.resize (n_entries);
+      }
+
     typedef
     FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>
     CellFilter;
@@ -750,6 +804,10 @@ namespace aspect
                       internal::Assembly::Scratch::StokesSystem<dim> &scratch,
                       internal::Assembly::CopyData::StokesSystem<dim> &data)
     {
+      // residual evaluations at other states are not part of the cost of a
+      // cell in a regular time step, so do not time them
+      const typename CellCostModel<dim>::ScopedCellTimer cell_timer (cell_cost_model, cell,
+                                                                     !assemble_auxiliary_stokes_residual);
       this->local_assemble_stokes_system(cell, scratch, data);
     };
 
@@ -807,6 +865,9 @@ namespace aspect
     TimerOutput::Scope timer (computing_timer, (advection_field.is_temperature() ?
                                                 "Build temperature preconditioner" :
                                                 "Build composition preconditioner"));
+    const Profiler::Scope profiler_scope (profiler, (advection_field.is_temperature() ?
+                                                     "Build temperature preconditioner" :
+                                                     "Build composition preconditioner"));
 
     const unsigned int block_idx = advection_field.block_index(introspection);
     preconditioner.initialize (system_matrix.block(block_idx, block_idx));
@@ -829,6 +890,7 @@ namespace aspect
     Assert (advection_dofs_per_cell < scratch.finite_element_values.get_fe().dofs_per_cell, ExcInternalError());
     Assert (scratch.grad_phi_field.size() == advection_dofs_per_cell, ExcInternalError());
     Assert (scratch.phi_field.size() == advection_dofs_per_cell, ExcInternalError());
+    Assert (scratch.field_shape_function_indices.size() == advection_dofs_per_cell, ExcInternalError());
 
     const FEValuesExtractors::Scalar solution_field = advection_field.scalar_extractor(introspection);
 
@@ -837,13 +899,16 @@ namespace aspect
     scratch.reinit(cell);
 
     // get all dof indices on the current cell, then extract those
-    // that correspond to the solution_field we are interested in
+    // that correspond to the solution_field we are interested in. at the
+    // same time, record which shape functions these are, so that the
+    // assemblers can loop over them directly
     cell->get_dof_indices (scratch.local_dof_indices);
     for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell; /*increment at end of loop*/)
       {
         if (finite_element.system_to_component_index(i).first == solution_component)
           {
             data.local_dof_indices[i_advection] = scratch.local_dof_indices[i];
+            scratch.field_shape_function_indices[i_advection] = i;
             ++i_advection;
           }
         ++i;
@@ -887,8 +952,11 @@ namespace aspect
                                                           scratch.finite_element_values,
                                                           introspection);
 
-    material_model->evaluate(scratch.material_model_inputs,
-                             scratch.material_model_outputs);
+    {
+      const Profiler::Scope profiler_scope (profiler, "Material model");
+      material_model->evaluate(scratch.material_model_inputs,
+                               scratch.material_model_outputs);
+    }
     if (parameters.formulation_temperature_equation ==
         Parameters<dim>::Formulation::TemperatureEquation::reference_density_profile)
       {
@@ -1002,8 +1070,11 @@ namespace aspect
                                                                       *scratch.face_finite_element_values,
                                                                       introspection);
 
-                material_model->evaluate(scratch.face_material_model_inputs,
-                                         scratch.face_material_model_outputs);
+                {
+                  const Profiler::Scope profiler_scope (profiler, "Material model");
+                  material_model->evaluate(scratch.face_material_model_inputs,
+                                           scratch.face_material_model_outputs);
+                }
 
                 if (parameters.formulation_temperature_equation ==
                     Parameters<dim>::Formulation::TemperatureEquation::reference_density_profile)
@@ -1092,6 +1163,9 @@ namespace aspect
     TimerOutput::Scope timer (computing_timer, (advection_field.is_temperature() ?
                                                 "Assemble temperature system" :
                                                 "Assemble composition system"));
+    const Profiler::Scope profiler_scope (profiler, (advection_field.is_temperature() ?
+                                                     "Assemble temperature system" :
+                                                     "Assemble composition system"));
 
     const unsigned int block_idx = advection_field.block_index(introspection);
 
@@ -1156,6 +1230,7 @@ namespace aspect
                       internal::Assembly::Scratch::AdvectionSystem<dim> &scratch,
                       internal::Assembly::CopyData::AdvectionSystem<dim> &data)
     {
+      const typename CellCostModel<dim>::ScopedCellTimer cell_timer (cell_cost_model, cell);
       this->local_assemble_advection_system(advection_field, viscosity_per_cell, cell, scratch, data);
     };
 
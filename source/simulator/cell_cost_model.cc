@@ -0,0 +1,361 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <aspect/cell_cost_model.h>
+#include <aspect/melt.h>
+
+#include <deal.II/base/mpi.h>
+
+
+namespace aspect
+{
+  template <int dim>
+  CellCostModel<dim>::ScopedCellTimer::
+  ScopedCellTimer (CellCostModel<dim> &cost_model,
+                   const typename DoFHandler<dim>::active_cell_iterator &cell,
+                   const bool active)
+    :
+    cost_model (cost_model),
+    cell (cell),
+    active (active && cost_model.is_enabled()),
+    start_time (this->active
+                ?
+                std::chrono::steady_clock::now()
+                :
+                std::chrono::steady_clock::time_point())
+  {}
+
+
+
+  template <int dim>
+  CellCostModel<dim>::ScopedCellTimer::~ScopedCellTimer ()
+  {
+    if (active)
+      cost_model.add_cell_cost (cell,
+                                std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                              - start_time).count());
+  }
+
+
+
+  template <int dim>
+  CellCostModel<dim>::CellCostModel ()
+    :
+    enabled (false),
+    imbalance_threshold (0.0),
+    write_statistics (false),
+    last_imbalance (0.0)
+  {
+    category_costs.fill(0.0);
+  }
+
+
+
+  template <int dim>
+  void
+  CellCostModel<dim>::declare_parameters (ParameterHandler &prm)
+  {
+    prm.enter_subsection ("Mesh refinement");
+    {
+      prm.enter_subsection ("Load balancing");
+      {
+        prm.declare_entry ("Use cell cost model", "false",
+                           Patterns::Bool (),
+                           "Whether to measure the time spent assembling each cell "
+                           "(including the evaluation of the material model and "
+                           "all other plugins called during assembly) and to use "
+                           "these measurements as cell weights whenever the mesh "
+                           "is distributed among the processes. Cells that have "
+                           "not been measured yet are assigned the average cost "
+                           "of cells of the same category (regular cells, cells "
+                           "in which melt transport is active, and cells adjacent "
+                           "to a free surface). If particles are used, their "
+                           "weight is added to the weight computed here.");
+        prm.declare_entry ("Load imbalance threshold", "0",
+                           Patterns::Double (0),
+                           "If the cell cost model is used, the relative load "
+                           "imbalance between processes, defined as the maximal "
+                           "measured cost of any process divided by the average "
+                           "cost of all processes minus one, above which the mesh "
+                           "is repartitioned at the end of a time step even if it "
+                           "is not refined in that time step. A value of zero "
+                           "disables this repartitioning.");
+        prm.declare_entry ("Write load imbalance statistics", "false",
+                           Patterns::Bool (),
+                           "If the cell cost model is used, whether to write the "
+                           "minimal, average, and maximal measured cost of all "
+                           "processes, and the resulting load imbalance, into the "
+                           "statistics file in each time step. These are wall "
+                           "clock times, so the statistics file is different in "
+                           "every model run if this parameter is set.");
+      }
+      prm.leave_subsection ();
+    }
+    prm.leave_subsection ();
+  }
+
+
+
+  template <int dim>
+  void
+  CellCostModel<dim>::parse_parameters (ParameterHandler &prm)
+  {
+    prm.enter_subsection ("Mesh refinement");
+    {
+      prm.enter_subsection ("Load balancing");
+      {
+        enabled             = prm.get_bool ("Use cell cost model");
+        imbalance_threshold = prm.get_double ("Load imbalance threshold");
+        write_statistics    = prm.get_bool ("Write load imbalance statistics");
+      }
+      prm.leave_subsection ();
+    }
+    prm.leave_subsection ();
+  }
+
+
+
+  template <int dim>
+  void
+  CellCostModel<dim>::initialize ()
+  {
+    if (enabled)
+      this->get_triangulation().signals.cell_weight.connect(
+        [&] (const typename parallel::distributed::Triangulation<dim>::cell_iterator &cell,
+             const typename parallel::distributed::Triangulation<dim>::CellStatus status)
+        -> unsigned int
+      {
+        return this->cell_weight(cell, status);
+      });
+  }
+
+
+
+  template <int dim>
+  bool
+  CellCostModel<dim>::is_enabled () const
+  {
+    return enabled;
+  }
+
+
+
+  template <int dim>
+  void
+  CellCostModel<dim>::reinit ()
+  {
+    if (!enabled)
+      return;
+
+    const unsigned int n_active_cells = this->get_triangulation().n_active_cells();
+    cell_costs.assign (n_active_cells, 0.0);
+    cell_costs_in_timestep.assign (n_active_cells, 0.0);
+
+    // the imbalance we measured belongs to the old partition, so
+    // there is no reason to rebalance the new one right away
+    last_imbalance = 0.0;
+  }
+
+
+
+  template <int dim>
+  void
+  CellCostModel<dim>::add_cell_cost (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                                     const double seconds)
+  {
+    Assert (cell->active_cell_index() < cell_costs_in_timestep.size(),
+            ExcIndexRange (cell->active_cell_index(), 0, cell_costs_in_timestep.size()));
+    cell_costs_in_timestep[cell->active_cell_index()] += seconds;
+  }
+
+
+
+  template <int dim>
+  void
+  CellCostModel<dim>::end_timestep (TableHandler &statistics)
+  {
+    if (!enabled)
+      return;
+
+    // sum up the cost of all cells and the cost per category on this process
+    double local_cost = 0.0;
+    std::vector<double> local_category_data (2*n_categories, 0.0);
+
+    for (const auto &cell : this->get_triangulation().active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const double cost = cell_costs_in_timestep[cell->active_cell_index()];
+          if (cost > 0.0)
+            {
+              const Category category = get_category(cell);
+              local_category_data[category] += cost;
+              local_category_data[n_categories+category] += 1.0;
+            }
+          local_cost += cost;
+        }
+
+    std::vector<double> global_category_data (2*n_categories, 0.0);
+    Utilities::MPI::sum (local_category_data,
+                         this->get_mpi_communicator(),
+                         global_category_data);
+
+    // only update the category averages if this time step measured
+    // any cells of the category. otherwise keep the old estimate
+    for (unsigned int c=0; c<n_categories; ++c)
+      if (global_category_data[n_categories+c] > 0)
+        category_costs[c] = global_category_data[c] / global_category_data[n_categories+c];
+
+    const Utilities::MPI::MinMaxAvg cost_statistics
+      = Utilities::MPI::min_max_avg (local_cost, this->get_mpi_communicator());
+
+    last_imbalance = (cost_statistics.avg > 0.0
+                      ?
+                      cost_statistics.max / cost_statistics.avg - 1.0
+                      :
+                      0.0);
+
+    if (write_statistics)
+      {
+        statistics.add_value ("Minimal assembly cost per process (s)", cost_statistics.min);
+        statistics.add_value ("Average assembly cost per process (s)", cost_statistics.avg);
+        statistics.add_value ("Maximal assembly cost per process (s)", cost_statistics.max);
+        statistics.add_value ("Load imbalance", last_imbalance);
+
+        statistics.set_precision ("Load imbalance", 4);
+      }
+
+    // keep the measurements of this time step for the next repartitioning,
+    // and start a new measurement
+    cell_costs.swap (cell_costs_in_timestep);
+    std::fill (cell_costs_in_timestep.begin(), cell_costs_in_timestep.end(), 0.0);
+  }
+
+
+
+  template <int dim>
+  bool
+  CellCostModel<dim>::rebalancing_requested () const
+  {
+    return (enabled
+            &&
+            imbalance_threshold > 0.0
+            &&
+            last_imbalance > imbalance_threshold);
+  }
+
+
+
+  template <int dim>
+  typename CellCostModel<dim>::Category
+  CellCostModel<dim>::get_category (const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    if (this->include_melt_transport())
+      {
+        const typename DoFHandler<dim>::active_cell_iterator
+        dof_cell (&this->get_triangulation(),
+                  cell->level(),
+                  cell->index(),
+                  &this->get_dof_handler());
+        if (this->get_melt_handler().is_melt_cell(dof_cell))
+          return melt_cell;
+      }
+
+    if (cell->at_boundary() && this->get_free_surface_boundary_indicators().size() > 0)
+      for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->at_boundary(f)
+            &&
+            this->get_free_surface_boundary_indicators().find(cell->face(f)->boundary_id())
+            != this->get_free_surface_boundary_indicators().end())
+          return free_surface_cell;
+
+    return regular_cell;
+  }
+
+
+
+  template <int dim>
+  double
+  CellCostModel<dim>::get_cell_cost (const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    const double measured_cost = (cell->active_cell_index() < cell_costs.size()
+                                  ?
+                                  cell_costs[cell->active_cell_index()]
+                                  :
+                                  0.0);
+
+    if (measured_cost > 0.0)
+      return measured_cost;
+    else
+      return category_costs[get_category(cell)];
+  }
+
+
+
+  template <int dim>
+  unsigned int
+  CellCostModel<dim>::cell_weight (const typename parallel::distributed::Triangulation<dim>::cell_iterator &cell,
+                                   const typename parallel::distributed::Triangulation<dim>::CellStatus status) const
+  {
+    if (cell->active() && !cell->is_locally_owned())
+      return 0;
+
+    // nothing has been measured yet, so we can not do better than
+    // the default weight of the triangulation
+    const double reference_cost = category_costs[regular_cell];
+    if (reference_cost <= 0.0)
+      return 0;
+
+    double cost = 0.0;
+    if (status == parallel::distributed::Triangulation<dim>::CELL_PERSIST)
+      cost = get_cell_cost(typename Triangulation<dim>::active_cell_iterator(cell));
+    else if (status == parallel::distributed::Triangulation<dim>::CELL_REFINE)
+      // the triangulation assigns the returned weight to each of the
+      // children, which will share the cost of the parent between them
+      cost = get_cell_cost(typename Triangulation<dim>::active_cell_iterator(cell))
+             / GeometryInfo<dim>::max_children_per_cell;
+    else if (status == parallel::distributed::Triangulation<dim>::CELL_COARSEN)
+      {
+        for (unsigned int child_index = 0; child_index < GeometryInfo<dim>::max_children_per_cell; ++child_index)
+          cost += get_cell_cost(typename Triangulation<dim>::active_cell_iterator(cell->child(child_index)));
+      }
+    else
+      Assert (false, ExcInternalError());
+
+    // the triangulation adds a weight of 1000 to every cell, which
+    // corresponds to the cost of a regular cell. the weight we return
+    // here is the additional cost relative to that
+    const double additional_weight = 1000. * (cost / reference_cost - 1.);
+
+    // limit the weight to avoid overflow in the accumulated weights
+    // of all cells in case a single measurement is completely off
+    return static_cast<unsigned int>(std::min (std::max (additional_weight, 0.), 1e5));
+  }
+}
+
+
+// explicit instantiation of the functions we implement in this file
+namespace aspect
+{
+#define INSTANTIATE(dim) \
+  template class CellCostModel<dim>;
+
+  ASPECT_INSTANTIATE(INSTANTIATE)
+}
@@ -0,0 +1,342 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <aspect/cell_locator.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+#include <deal.II/grid/tria_accessor.h>
+
+
+namespace aspect
+{
+  namespace
+  {
+    /**
+     * Call @p f with the linear index of every bucket between the
+     * multi-indices @p lower and @p upper (inclusive) of a grid with
+     * @p n_buckets buckets in each direction.
+     */
+    template <int dim, typename Function>
+    void
+    for_each_bucket (const std::array<unsigned int,dim> &lower,
+                     const std::array<unsigned int,dim> &upper,
+                     const std::array<unsigned int,dim> &n_buckets,
+                     const Function &f)
+    {
+      std::array<unsigned int,dim> index = lower;
+      while (true)
+        {
+          unsigned int linear_index = 0;
+          for (int d=dim-1; d>=0; --d)
+            linear_index = linear_index * n_buckets[d] + index[d];
+          f (linear_index);
+
+          // go to the next multi-index, or stop if we have visited all of them
+          unsigned int d = 0;
+          for (; d<dim; ++d)
+            {
+              if (index[d] < upper[d])
+                {
+                  ++index[d];
+                  break;
+                }
+              index[d] = lower[d];
+            }
+          if (d == dim)
+            return;
+        }
+    }
+  }
+
+
+
+  template <int dim>
+  CellLocator<dim>::CellLocator ()
+    :
+    is_built (false)
+  {}
+
+
+
+  template <int dim>
+  void
+  CellLocator<dim>::clear ()
+  {
+    std::lock_guard<std::mutex> lock (build_mutex);
+
+    is_built = false;
+    cell_boxes.clear ();
+    bucket_start.clear ();
+    bucket_cells.clear ();
+  }
+
+
+
+  template <int dim>
+  unsigned int
+  CellLocator<dim>::bucket_index (const double x,
+                                  const unsigned int d) const
+  {
+    const double index = (x - lower_corner[d]) * one_over_bucket_size[d];
+    if (index <= 0)
+      return 0;
+    return std::min (static_cast<unsigned int>(index), n_buckets[d]-1);
+  }
+
+
+
+  template <int dim>
+  void
+  CellLocator<dim>::build () const
+  {
+    if (is_built)
+      return;
+
+    std::lock_guard<std::mutex> lock (build_mutex);
+    if (is_built)
+      return;
+
+    // first compute the bounding boxes of all cells from the positions of
+    // a uniform grid of points in each cell, mapped by the mapping of the
+    // model, so that the boxes contain the parts of curved cells that bulge
+    // out of the box of their vertices. the mapped cell can only bulge out
+    // of the box of these points between the points, by an amount that
+    // decreases quadratically with their distance, so a small safety margin
+    // is enough
+    const unsigned int n_subdivisions = 4;
+    const QIterated<dim> quadrature (QTrapez<1>(), n_subdivisions);
+    const FE_Q<dim> fe (1);
+    FEValues<dim> fe_values (this->get_mapping(), fe, quadrature, update_quadrature_points);
+
+    cell_boxes.clear ();
+    for (const auto &cell : this->get_triangulation().active_cell_iterators())
+      if (cell->is_locally_owned() || cell->is_ghost())
+        {
+          fe_values.reinit (cell);
+          const std::vector<Point<dim> > &points = fe_values.get_quadrature_points();
+
+          CellBox box;
+          box.cell = cell;
+          box.lower_corner = points[0];
+          box.upper_corner = points[0];
+          for (unsigned int q=1; q<points.size(); ++q)
+            for (unsigned int d=0; d<dim; ++d)
+              {
+                box.lower_corner[d] = std::min (box.lower_corner[d], points[q][d]);
+                box.upper_corner[d] = std::max (box.upper_corner[d], points[q][d]);
+              }
+
+          double max_extent = 0;
+          for (unsigned int d=0; d<dim; ++d)
+            max_extent = std::max (max_extent, box.upper_corner[d] - box.lower_corner[d]);
+          const double margin = max_extent / (2 * n_subdivisions * n_subdivisions);
+          for (unsigned int d=0; d<dim; ++d)
+            {
+              box.lower_corner[d] -= margin;
+              box.upper_corner[d] += margin;
+            }
+
+          cell_boxes.push_back (box);
+        }
+
+    if (cell_boxes.empty())
+      {
+        bucket_start.assign (1, 0);
+        bucket_cells.clear ();
+        is_built = true;
+        return;
+      }
+
+    // then set up a grid of buckets that covers all cells. choose the size
+    // of the buckets so that they are approximately cubes and that there
+    // are about as many buckets as cells
+    lower_corner = cell_boxes[0].lower_corner;
+    upper_corner = cell_boxes[0].upper_corner;
+    for (const auto &box : cell_boxes)
+      for (unsigned int d=0; d<dim; ++d)
+        {
+          lower_corner[d] = std::min (lower_corner[d], box.lower_corner[d]);
+          upper_corner[d] = std::max (upper_corner[d], box.upper_corner[d]);
+        }
+
+    double volume = 1;
+    for (unsigned int d=0; d<dim; ++d)
+      volume *= upper_corner[d] - lower_corner[d];
+    const double bucket_size = std::pow (volume / cell_boxes.size(), 1./dim);
+
+    unsigned int n_total_buckets = 1;
+    for (unsigned int d=0; d<dim; ++d)
+      {
+        const double extent = upper_corner[d] - lower_corner[d];
+        n_buckets[d] = std::max (1u, static_cast<unsigned int>(std::ceil (extent / bucket_size)));
+        one_over_bucket_size[d] = n_buckets[d] / extent;
+        n_total_buckets *= n_buckets[d];
+      }
+
+    // finally sort the cells into all buckets their boxes overlap: count
+    // the cells per bucket first, and then fill in the indices
+    std::vector<std::array<unsigned int,dim> > lower_indices (cell_boxes.size());
+    std::vector<std::array<unsigned int,dim> > upper_indices (cell_boxes.size());
+    for (unsigned int c=0; c<cell_boxes.size(); ++c)
+      for (unsigned int d=0; d<dim; ++d)
+        {
+          lower_indices[c][d] = bucket_index (cell_boxes[c].lower_corner[d], d);
+          upper_indices[c][d] = bucket_index (cell_boxes[c].upper_corner[d], d);
+        }
+
+    bucket_start.assign (n_total_buckets+1, 0);
+    for (unsigned int c=0; c<cell_boxes.size(); ++c)
+      for_each_bucket<dim> (lower_indices[c], upper_indices[c], n_buckets,
+                            [&] (const unsigned int b)
+      {
+        ++bucket_start[b+1];
+      });
+
+    for (unsigned int b=0; b<n_total_buckets; ++b)
+      bucket_start[b+1] += bucket_start[b];
+
+    bucket_cells.resize (bucket_start.back());
+    std::vector<unsigned int> next_index (bucket_start.begin(), bucket_start.end()-1);
+    for (unsigned int c=0; c<cell_boxes.size(); ++c)
+      for_each_bucket<dim> (lower_indices[c], upper_indices[c], n_buckets,
+                            [&] (const unsigned int b)
+      {
+        bucket_cells[next_index[b]++] = c;
+      });
+
+    is_built = true;
+  }
+
+
+
+  template <int dim>
+  bool
+  CellLocator<dim>::point_is_in_cell (const Point<dim> &point,
+                                      const active_cell_iterator &cell,
+                                      const double tolerance,
+                                      Point<dim> &unit_point) const
+  {
+    try
+      {
+        unit_point = this->get_mapping().transform_real_to_unit_cell (cell, point);
+      }
+    catch (typename Mapping<dim>::ExcTransformationFailed &)
+      {
+        // the point is too far outside of the cell for the
+        // transformation to converge
+        return false;
+      }
+
+    return GeometryInfo<dim>::is_inside_unit_cell (unit_point, tolerance);
+  }
+
+
+
+  template <int dim>
+  std::pair<typename CellLocator<dim>::active_cell_iterator, Point<dim> >
+  CellLocator<dim>::find_cell_around_point (const Point<dim> &point,
+                                            const active_cell_iterator &hint) const
+  {
+    build ();
+
+    // only accept the hint if the point is in the interior of the cell,
+    // for points on its boundary we need to consider all neighboring cells
+    // to consistently choose one of them
+    if (hint.state() == IteratorState::valid
+        &&
+        (hint->is_locally_owned() || hint->is_ghost()))
+      {
+        Point<dim> unit_point;
+        if (point_is_in_cell (point, hint, -1e-10, unit_point))
+          return std::make_pair (hint, unit_point);
+      }
+
+    std::pair<active_cell_iterator, Point<dim> > result;
+
+    if (cell_boxes.empty())
+      return result;
+    for (unsigned int d=0; d<dim; ++d)
+      if (point[d] < lower_corner[d] || point[d] > upper_corner[d])
+        return result;
+
+    std::array<unsigned int,dim> index;
+    for (unsigned int d=0; d<dim; ++d)
+      index[d] = bucket_index (point[d], d);
+
+    unsigned int bucket = 0;
+    for (int d=dim-1; d>=0; --d)
+      bucket = bucket * n_buckets[d] + index[d];
+
+    for (unsigned int i=bucket_start[bucket]; i<bucket_start[bucket+1]; ++i)
+      {
+        const CellBox &box = cell_boxes[bucket_cells[i]];
+
+        bool point_is_in_box = true;
+        for (unsigned int d=0; d<dim; ++d)
+          if (point[d] < box.lower_corner[d] || point[d] > box.upper_corner[d])
+            {
+              point_is_in_box = false;
+              break;
+            }
+
+        Point<dim> unit_point;
+        if (point_is_in_box
+            &&
+            (result.first.state() != IteratorState::valid || box.cell->id() < result.first->id())
+            &&
+            point_is_in_cell (point, box.cell, 1e-10, unit_point))
+          result = std::make_pair (box.cell, unit_point);
+      }
+
+    return result;
+  }
+
+
+
+  template <int dim>
+  void
+  CellLocator<dim>::find_cells_around_points (const std::vector<Point<dim> > &points,
+                                              std::vector<std::pair<active_cell_iterator, Point<dim> > > &cells) const
+  {
+    cells.resize (points.size());
+
+    active_cell_iterator hint;
+    for (unsigned int i=0; i<points.size(); ++i)
+      {
+        cells[i] = find_cell_around_point (points[i], hint);
+        if (cells[i].first.state() == IteratorState::valid)
+          hint = cells[i].first;
+      }
+  }
+}
+
+
+// explicit instantiation of the functions we implement in this file
+namespace aspect
+{
+#define INSTANTIATE(dim) \
+  template class CellLocator<dim>;
+
+  ASPECT_INSTANTIATE(INSTANTIATE)
+}
@@ -28,10 +28,6 @@
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/distributed/solution_transfer.h>
 
-#ifdef DEAL_II_WITH_ZLIB
-#  include <zlib.h>
-#endif
-
 namespace aspect
 {
   namespace
@@ -122,6 +118,7 @@ namespace aspect
   void Simulator<dim>::create_snapshot()
   {
     TimerOutput::Scope timer (computing_timer, "Create snapshot");
+    const Profiler::Scope profiler_scope (profiler, "Create snapshot");
     unsigned int my_id = Utilities::MPI::this_mpi_process (mpi_communicator);
 
     if (my_id == 0)
@@ -204,41 +201,8 @@ namespace aspect
       // compress with zlib and write to file on the root processor
 #ifdef DEAL_II_WITH_ZLIB
       if (my_id == 0)
-        {
-          uLongf compressed_data_length = compressBound (oss.str().length());
-          std::vector<char *> compressed_data (compressed_data_length);
-          int err = compress2 ((Bytef *) &compressed_data[0],
-                               &compressed_data_length,
-                               (const Bytef *) oss.str().data(),
-                               oss.str().length(),
-                               Z_BEST_COMPRESSION);
-          (void)err;
-          Assert (err == Z_OK, ExcInternalError());
-
-          // build compression header
-          const uint32_t compression_header[4]
-            = { 1,                                   /* number of blocks */
-                (uint32_t)oss.str().length(), /* size of block */
-                (uint32_t)oss.str().length(), /* size of last block */
-                (uint32_t)compressed_data_length
-              }; /* list of compressed sizes of blocks */
-
-          std::ofstream f ((parameters.output_directory + "restart.resume.z").c_str());
-          f.write((const char *)compression_header, 4 * sizeof(compression_header[0]));
-          f.write((char *)&compressed_data[0], compressed_data_length);
-          f.close();
-
-          // We check the fail state of the stream _after_ closing the file to
-          // make sure the writes were completed correctly. This also catches
-          // the cases where the file could not be opened in the first place
-          // or one of the write() commands fails, as the fail state is
-          // "sticky".
-          if (!f)
-            AssertThrow(false, ExcMessage ("Writing of the checkpoint file '" + parameters.output_directory
-                                           + "restart.resume.z' with size "
-                                           + Utilities::to_string(4 * sizeof(compression_header[0])+compressed_data_length)
-                                           + " failed on processor 0."));
-        }
+        Utilities::write_compressed_file (oss.str(),
+                                          parameters.output_directory + "restart.resume.z");
 #else
       AssertThrow (false,
                    ExcMessage ("You need to have deal.II configured with the `libz' "
@@ -343,29 +307,9 @@ namespace aspect
     try
       {
 #ifdef DEAL_II_WITH_ZLIB
-        std::ifstream ifs ((parameters.output_directory + "restart.resume.z").c_str());
-        AssertThrow(ifs.is_open(),
-                    ExcMessage("Cannot open snapshot resume file."));
-
-        uint32_t compression_header[4];
-        ifs.read((char *)compression_header, 4 * sizeof(compression_header[0]));
-        Assert(compression_header[0]==1, ExcInternalError());
-
-        std::vector<char> compressed(compression_header[3]);
-        std::vector<char> uncompressed(compression_header[1]);
-        ifs.read(&compressed[0],compression_header[3]);
-        uLongf uncompressed_size = compression_header[1];
-
-        const int err = uncompress((Bytef *)&uncompressed[0], &uncompressed_size,
-                                   (Bytef *)&compressed[0], compression_header[3]);
-        AssertThrow (err == Z_OK,
-                     ExcMessage (std::string("Uncompressing the data buffer resulted in an error with code <")
-                                 +
-                                 Utilities::int_to_string(err)));
-
         {
           std::istringstream ss;
-          ss.str(std::string (&uncompressed[0], uncompressed_size));
+          ss.str (Utilities::read_compressed_file (parameters.output_directory + "restart.resume.z"));
 
           aspect::iarchive ia (ss);
           load_and_check_critical_parameters(this->parameters, ia);
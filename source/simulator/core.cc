@@ -216,7 +216,8 @@ namespace aspect
     rebuild_stokes_matrix (true),
     assemble_newton_stokes_matrix (true),
     assemble_newton_stokes_system (parameters.nonlinear_solver == NonlinearSolver::iterated_Advection_and_Newton_Stokes ? true : false),
-    rebuild_stokes_preconditioner (true)
+    rebuild_stokes_preconditioner (true),
+    assemble_auxiliary_stokes_residual (false)
   {
     if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
       {
@@ -233,6 +234,9 @@ namespace aspect
     // now that we have output set up, we can start timer sections
     TimerOutput::Scope timer (computing_timer, "Initialization");
 
+    profiler.parse_parameters (prm, parameters.output_directory, mpi_communicator);
+    const Profiler::Scope profiler_scope (profiler, "Initialization");
+
 
     // if any plugin wants access to the Simulator by deriving from SimulatorAccess, initialize it and
     // call the initialize() functions immediately after.
@@ -382,6 +386,15 @@ namespace aspect
 
     lateral_averaging.initialize_simulator (*this);
 
+    cell_cost_model.initialize_simulator (*this);
+    cell_cost_model.parse_parameters (prm);
+    cell_cost_model.initialize ();
+
+    quadrature_point_geometry.initialize_simulator (*this);
+    quadrature_point_geometry.parse_parameters (prm);
+
+    cell_locator.initialize_simulator (*this);
+
     geometry_model->create_coarse_mesh (triangulation);
     global_Omega_diameter = GridTools::diameter (triangulation);
 
@@ -630,6 +643,7 @@ namespace aspect
     if (rebuild_sparsity_and_matrices)
       {
         TimerOutput::Scope timer (computing_timer, "Setup matrices");
+        const Profiler::Scope profiler_scope (profiler, "Setup matrices");
 
         rebuild_sparsity_and_matrices = false;
         setup_system_matrix (introspection.index_sets.system_partitioning);
@@ -640,12 +654,25 @@ namespace aspect
     // notify different system components that we started the next time step
     // TODO: implement this for all plugins that might need it at one place.
     // Temperature BC are currently updated in compute_current_constraints
-    material_model->update();
-    gravity_model->update();
+    {
+      const Profiler::Scope profiler_scope (profiler, "Material model", "update");
+      material_model->update();
+    }
+    {
+      const Profiler::Scope profiler_scope (profiler, "Gravity model", "update");
+      gravity_model->update();
+    }
     heating_model_manager.update();
-    adiabatic_conditions->update();
+    {
+      const Profiler::Scope profiler_scope (profiler, "Adiabatic conditions", "update");
+      adiabatic_conditions->update();
+    }
     mesh_refinement_manager.update();
 
+    // now that gravity and the adiabatic conditions are current, store
+    // them at the quadrature points if requested
+    quadrature_point_geometry.update();
+
     if (prescribed_stokes_solution.get())
       prescribed_stokes_solution->update();
 
@@ -654,7 +681,10 @@ namespace aspect
     // the constraints object when calling compute_current_constraints()
     // above
     for (auto &p : boundary_traction)
-      p.second->update ();
+      {
+        const Profiler::Scope profiler_scope (profiler, "Boundary traction model", "update");
+        p.second->update ();
+      }
   }
 
 
@@ -665,6 +695,11 @@ namespace aspect
   {
     // We put the constraints we compute into a separate ConstraintMatrix so we can check
     // if the set of constraints has changed. If it did, we need to update the sparsity patterns.
+    // the support points of the boundary degrees of freedom move with
+    // the mesh if it is deformed
+    if (parameters.free_surface_enabled)
+      boundary_dof_cache.is_valid = false;
+
     ConstraintMatrix new_current_constraints;
     new_current_constraints.clear ();
     new_current_constraints.reinit (introspection.index_sets.system_relevant_set);
@@ -707,12 +742,10 @@ namespace aspect
               introspection.component_masks.temperature.first_selected_component(),
               introspection.n_components);
 
-            VectorTools::interpolate_boundary_values (*mapping,
-                                                      dof_handler,
-                                                      *p,
-                                                      vector_function_object,
-                                                      new_current_constraints,
-                                                      introspection.component_masks.temperature);
+            interpolate_boundary_values_from_cache (*p,
+                                                    vector_function_object,
+                                                    introspection.component_masks.temperature,
+                                                    new_current_constraints);
           }
       }
 
@@ -750,12 +783,10 @@ namespace aspect
                 introspection.component_masks.compositional_fields[c].first_selected_component(),
                 introspection.n_components);
 
-              VectorTools::interpolate_boundary_values (*mapping,
-                                                        dof_handler,
-                                                        *p,
-                                                        vector_function_object,
-                                                        new_current_constraints,
-                                                        introspection.component_masks.compositional_fields[c]);
+              interpolate_boundary_values_from_cache (*p,
+                                                      vector_function_object,
+                                                      introspection.component_masks.compositional_fields[c],
+                                                      new_current_constraints);
             }
       }
 
@@ -815,6 +846,32 @@ namespace aspect
           }
 #endif
 
+        // If the sparsity patterns were built from the mesh constraints only
+        // and with entries for all constrained degrees of freedom (see
+        // setup_system_matrix()), they can be kept as long as all constraints
+        // that couple degrees of freedom are already part of the mesh
+        // constraints. This is the case for all constraints that simply
+        // prescribe values, e.g., the ones for boundary conditions.
+        if (constrained_dofs_set_changed && parameters.cache_sparsity_patterns)
+          {
+            constrained_dofs_set_changed = false;
+            for (const auto row : new_current_constraints.get_local_lines())
+              {
+                const std::vector<std::pair<types::global_dof_index,double> > *new_entries
+                  = new_current_constraints.get_constraint_entries(row);
+                if (new_entries == nullptr || new_entries->empty())
+                  continue;
+
+                const std::vector<std::pair<types::global_dof_index,double> > *mesh_entries
+                  = constraints.get_constraint_entries(row);
+                if (mesh_entries == nullptr || *mesh_entries != *new_entries)
+                  {
+                    constrained_dofs_set_changed = true;
+                    break;
+                  }
+              }
+          }
+
         const bool any_constrained_dofs_set_changed = Utilities::MPI::sum(constrained_dofs_set_changed ? 1 : 0,
                                                                           mpi_communicator) > 0;
         if (any_constrained_dofs_set_changed)
@@ -924,6 +981,18 @@ namespace aspect
         }
     }
 
+    // If we cache the sparsity patterns, build them from the constraints
+    // that only depend on the mesh, and keep the entries of constrained
+    // degrees of freedom. The resulting pattern is a superset of the one
+    // we would get for any set of current_constraints that only adds
+    // constraints to prescribed values, see compute_current_constraints().
+    const ConstraintMatrix &sparsity_constraints = (parameters.cache_sparsity_patterns
+                                                    ?
+                                                    constraints
+                                                    :
+                                                    current_constraints);
+    const bool keep_constrained_dofs = parameters.cache_sparsity_patterns;
+
     LinearAlgebra::BlockDynamicSparsityPattern sp;
 #ifdef ASPECT_USE_PETSC
     sp.reinit (introspection.index_sets.system_relevant_partitioning);
@@ -960,7 +1029,7 @@ namespace aspect
 
         DoFTools::make_flux_sparsity_pattern (dof_handler,
                                               sp,
-                                              current_constraints, false,
+                                              sparsity_constraints, keep_constrained_dofs,
                                               coupling,
                                               face_coupling,
                                               Utilities::MPI::
@@ -969,7 +1038,7 @@ namespace aspect
     else
       DoFTools::make_sparsity_pattern (dof_handler,
                                        coupling, sp,
-                                       current_constraints, false,
+                                       sparsity_constraints, keep_constrained_dofs,
                                        Utilities::MPI::
                                        this_mpi_process(mpi_communicator));
 
@@ -1011,6 +1080,7 @@ namespace aspect
   {
     Amg_preconditioner.reset ();
     Mp_preconditioner.reset ();
+    Mp_preconditioner_single_precision.reset ();
     system_preconditioner_matrix.clear ();
 
     // The preconditioner matrix is only used for the Stokes block (velocity and Schur complement) and is of course not
@@ -1052,6 +1122,14 @@ namespace aspect
     // its sparsity pattern here -- the corresponding entries of
     // 'coupling' simply remain at DoFTools::none
 
+    // see setup_system_matrix() for the choice of constraints
+    const ConstraintMatrix &sparsity_constraints = (parameters.cache_sparsity_patterns
+                                                    ?
+                                                    constraints
+                                                    :
+                                                    current_constraints);
+    const bool keep_constrained_dofs = parameters.cache_sparsity_patterns;
+
     LinearAlgebra::BlockDynamicSparsityPattern sp;
 
 #ifdef ASPECT_USE_PETSC
@@ -1065,7 +1143,7 @@ namespace aspect
 
     DoFTools::make_sparsity_pattern (dof_handler,
                                      coupling, sp,
-                                     current_constraints, false,
+                                     sparsity_constraints, keep_constrained_dofs,
                                      Utilities::MPI::
                                      this_mpi_process(mpi_communicator));
 
@@ -1199,32 +1277,149 @@ namespace aspect
 
         if (!assemble_newton_stokes_system || (assemble_newton_stokes_system && nonlinear_iteration == 0))
           {
-            VectorTools::interpolate_boundary_values (*mapping,
-                                                      dof_handler,
-                                                      p->first,
-                                                      vel,
-                                                      constraints,
-                                                      mask);
+            interpolate_boundary_values_from_cache (p->first,
+                                                    vel,
+                                                    ComponentMask(mask),
+                                                    constraints);
           }
         else
           {
-            VectorTools::interpolate_boundary_values (*mapping,
-                                                      dof_handler,
-                                                      p->first,
-                                                      ZeroFunction<dim>(introspection.n_components),
-                                                      constraints,
-                                                      mask);
+            interpolate_boundary_values_from_cache (p->first,
+                                                    ZeroFunction<dim>(introspection.n_components),
+                                                    ComponentMask(mask),
+                                                    constraints);
           }
       }
   }
 
 
+
+  template <int dim>
+  void Simulator<dim>::setup_boundary_dof_cache ()
+  {
+    const unsigned int dofs_per_face = finite_element.dofs_per_face;
+
+    // find the distinct support points of the face degrees of freedom on
+    // the reference face. all face degrees of freedom belong to continuous
+    // elements, so they all have support points
+    std::vector<Point<dim-1> > unit_support_points;
+    boundary_dof_cache.face_dof_point_index.resize (dofs_per_face);
+    boundary_dof_cache.face_dof_component.resize (dofs_per_face);
+    for (unsigned int i=0; i<dofs_per_face; ++i)
+      {
+        const Point<dim-1> &unit_support_point = finite_element.unit_face_support_point(i);
+        const auto existing_point = std::find (unit_support_points.begin(),
+                                               unit_support_points.end(),
+                                               unit_support_point);
+
+        boundary_dof_cache.face_dof_point_index[i] = existing_point - unit_support_points.begin();
+        if (existing_point == unit_support_points.end())
+          unit_support_points.push_back (unit_support_point);
+
+        boundary_dof_cache.face_dof_component[i] = finite_element.face_system_to_component_index(i).first;
+      }
+
+    // then store the degrees of freedom and the location of the support
+    // points of all boundary faces of cells that are not artificial, just
+    // like VectorTools::interpolate_boundary_values() would use them
+    boundary_dof_cache.faces.clear ();
+    if (unit_support_points.size() > 0)
+      {
+        FEFaceValues<dim> fe_face_values (*mapping,
+                                          finite_element,
+                                          Quadrature<dim-1>(unit_support_points),
+                                          update_quadrature_points);
+
+        for (const auto &cell : dof_handler.active_cell_iterators())
+          if (!cell->is_artificial())
+            for (unsigned int face_no=0; face_no<GeometryInfo<dim>::faces_per_cell; ++face_no)
+              if (cell->face(face_no)->at_boundary())
+                {
+                  fe_face_values.reinit (cell, face_no);
+
+                  typename BoundaryDoFCache::Face face;
+                  face.face = cell->face(face_no);
+                  face.dof_indices.resize (dofs_per_face);
+                  face.face->get_dof_indices (face.dof_indices);
+                  face.support_points = fe_face_values.get_quadrature_points();
+
+                  boundary_dof_cache.faces.push_back (face);
+                }
+      }
+
+    boundary_dof_cache.is_valid = true;
+  }
+
+
+
+  template <int dim>
+  void Simulator<dim>::interpolate_boundary_values_from_cache (const types::boundary_id boundary_id,
+                                                               const Function<dim> &function,
+                                                               const ComponentMask &component_mask,
+                                                               ConstraintMatrix &constraints)
+  {
+    Assert (function.n_components == introspection.n_components,
+            ExcDimensionMismatch (function.n_components, introspection.n_components));
+
+    if (!boundary_dof_cache.is_valid)
+      setup_boundary_dof_cache ();
+
+    const std::vector<unsigned int> &point_index = boundary_dof_cache.face_dof_point_index;
+    const std::vector<unsigned int> &component = boundary_dof_cache.face_dof_component;
+
+    const unsigned int n_points = (point_index.size() > 0
+                                   ?
+                                   *std::max_element (point_index.begin(), point_index.end()) + 1
+                                   :
+                                   0);
+    std::vector<bool> point_needed (n_points);
+    std::vector<Vector<double> > point_values (n_points, Vector<double>(introspection.n_components));
+
+    // a degree of freedom is set if its component is selected, and if it
+    // is not yet constrained (e.g., by an adjacent face we have already
+    // visited, or by a constraint that takes precedence)
+    auto needs_value = [&] (const types::global_dof_index dof,
+                            const unsigned int i) -> bool
+    {
+      return (component_mask[component[i]]
+              &&
+              constraints.can_store_line (dof)
+              &&
+              !constraints.is_constrained (dof));
+    };
+
+    for (const auto &face : boundary_dof_cache.faces)
+      if (face.face->boundary_id() == boundary_id)
+        {
+          // first evaluate the function at all support points we need ...
+          std::fill (point_needed.begin(), point_needed.end(), false);
+          for (unsigned int i=0; i<face.dof_indices.size(); ++i)
+            if (needs_value (face.dof_indices[i], i))
+              point_needed[point_index[i]] = true;
+
+          for (unsigned int q=0; q<n_points; ++q)
+            if (point_needed[q])
+              function.vector_value (face.support_points[q], point_values[q]);
+
+          // ... and then constrain the degrees of freedom to these values
+          for (unsigned int i=0; i<face.dof_indices.size(); ++i)
+            if (needs_value (face.dof_indices[i], i))
+              {
+                constraints.add_line (face.dof_indices[i]);
+                constraints.set_inhomogeneity (face.dof_indices[i],
+                                               point_values[point_index[i]][component[i]]);
+              }
+        }
+  }
+
+
   template <int dim>
   void Simulator<dim>::setup_dofs ()
   {
     signals.edit_parameters_pre_setup_dofs(*this, parameters);
 
     TimerOutput::Scope timer (computing_timer, "Setup dof systems");
+    const Profiler::Scope profiler_scope (profiler, "Setup dof systems");
 
     dof_handler.distribute_dofs(finite_element);
 
@@ -1287,6 +1482,15 @@ namespace aspect
     if (parameters.free_surface_enabled)
       free_surface->setup_dofs();
 
+    if (parameters.volume_of_fluid_tracking_enabled)
+      volume_of_fluid_handler->setup_dofs();
+
+    // the quadrature point data stored for the nullspace removal refers
+    // to the old mesh, so it has to be recomputed in the next assembly
+    nullspace_quadrature_data = NullspaceQuadratureData();
+
+    // the same is true for the boundary degrees of freedom
+    boundary_dof_cache.is_valid = false;
 
     // reinit the constraints matrix and make hanging node constraints
     constraints.clear();
@@ -1336,6 +1540,15 @@ namespace aspect
 
     rebuild_stokes_matrix         = true;
     rebuild_stokes_preconditioner = true;
+
+    // discard the cost measurements of the old mesh
+    cell_cost_model.reinit ();
+
+    // and the values stored at the quadrature points of the old mesh
+    quadrature_point_geometry.clear ();
+
+    // the cells need to be located again on the new mesh
+    cell_locator.clear ();
   }
 
 
@@ -1406,6 +1619,7 @@ namespace aspect
   void Simulator<dim>::postprocess ()
   {
     TimerOutput::Scope timer (computing_timer, "Postprocessing");
+    const Profiler::Scope profiler_scope (profiler, "Postprocessing");
     pcout << "   Postprocessing:" << std::endl;
 
     // run all the postprocessing routines and then write
@@ -1413,6 +1627,10 @@ namespace aspect
     std::list<std::pair<std::string,std::string> >
     output_list = postprocess_manager.execute (statistics);
 
+    // add the load imbalance measured during this time step to the
+    // statistics of the current time step
+    cell_cost_model.end_timestep (statistics);
+
     // if we are on processor zero, print to screen
     // whatever the postprocessors have generated
     if (Utilities::MPI::this_mpi_process(mpi_communicator)==0)
@@ -1449,14 +1667,9 @@ namespace aspect
   template <int dim>
   void Simulator<dim>::refine_mesh (const unsigned int max_grid_level)
   {
-    parallel::distributed::SolutionTransfer<dim,LinearAlgebra::BlockVector>
-    system_trans(dof_handler);
-
-    std::unique_ptr<parallel::distributed::SolutionTransfer<dim,LinearAlgebra::Vector> >
-    freesurface_trans;
-
     {
       TimerOutput::Scope timer (computing_timer, "Refine mesh structure, part 1");
+      const Profiler::Scope profiler_scope (profiler, "Refine mesh structure, part 1");
 
       Vector<float> estimated_error_per_cell (triangulation.n_active_cells());
       mesh_refinement_manager.execute (estimated_error_per_cell);
@@ -1511,6 +1724,39 @@ namespace aspect
                cell != triangulation.end_active(parameters.min_grid_level); ++cell)
             cell->clear_coarsen_flag ();
         }
+    } // leave the timed section
+
+    execute_mesh_change_and_transfer_solution ();
+  }
+
+
+
+  template <int dim>
+  void Simulator<dim>::repartition_mesh ()
+  {
+    pcout << "   Repartitioning the mesh to reduce the load imbalance." << std::endl
+          << std::endl;
+
+    // no cell is flagged for refinement or coarsening at this point, so
+    // executing the (empty) mesh change only redistributes the cells
+    // according to the weights provided by the cell cost model
+    execute_mesh_change_and_transfer_solution ();
+  }
+
+
+
+  template <int dim>
+  void Simulator<dim>::execute_mesh_change_and_transfer_solution ()
+  {
+    parallel::distributed::SolutionTransfer<dim,LinearAlgebra::BlockVector>
+    system_trans(dof_handler);
+
+    std::unique_ptr<parallel::distributed::SolutionTransfer<dim,LinearAlgebra::Vector> >
+    freesurface_trans;
+
+    {
+      TimerOutput::Scope timer (computing_timer, "Refine mesh structure, part 1");
+      const Profiler::Scope profiler_scope (profiler, "Refine mesh structure, part 1");
 
       std::vector<const LinearAlgebra::BlockVector *> x_system (2);
       x_system[0] = &solution;
@@ -1546,6 +1792,7 @@ namespace aspect
 
     {
       TimerOutput::Scope timer (computing_timer, "Refine mesh structure, part 2");
+      const Profiler::Scope profiler_scope (profiler, "Refine mesh structure, part 2");
 
       LinearAlgebra::BlockVector distributed_system;
       LinearAlgebra::BlockVector old_distributed_system;
@@ -1643,7 +1890,12 @@ namespace aspect
     // free_surface_execute() after the Stokes solve, it will be before we know what the appropriate
     // time step to take is, and we will timestep the boundary incorrectly.
     if (parameters.free_surface_enabled)
-      free_surface->execute ();
+      {
+        free_surface->execute ();
+
+        // the cells have moved, so they need to be located again
+        cell_locator.clear ();
+      }
 
     // Compute the reactions of compositional fields and temperature in case of operator splitting.
     if (parameters.use_operator_splitting)
@@ -1770,6 +2022,7 @@ namespace aspect
     if (parameters.resume_computation == false)
       {
         TimerOutput::Scope timer (computing_timer, "Setup initial conditions");
+        const Profiler::Scope profiler_scope (profiler, "Setup initial conditions");
 
         timestep_number           = 0;
         time_step = old_time_step = 0;
@@ -1824,8 +2077,15 @@ namespace aspect
         // see if we want to refine the mesh
         maybe_refine_mesh(new_time_step,max_refinement_level);
 
+        // if the cell cost model measured a load imbalance that is too large,
+        // redistribute the cells between processes. this is not necessary
+        // if the mesh was just refined, because that also repartitions it
+        if (cell_cost_model.rebalancing_requested())
+          repartition_mesh ();
+
         // see if we want to write a timing summary
         maybe_write_timing_output();
+        profiler.maybe_write_profile (timestep_number);
 
         // update values for timestep, increment time step by one. then prepare
         // for the next time step by shifting solution vectors
@@ -1858,6 +2118,7 @@ namespace aspect
     // we disable automatic summary printing so that it won't happen when
     // throwing an exception. Therefore, we have to do this manually here:
     computing_timer.print_summary ();
+    profiler.maybe_write_profile (timestep_number, true);
 
     CitationInfo::print_info_block (pcout);
   }
@@ -278,6 +278,7 @@ namespace aspect
       return;
 
     TimerOutput::Scope timer (sim.computing_timer, "Free surface");
+    const Profiler::Scope profiler_scope (sim.profiler, "Free surface");
 
     // Make the constraints for the elliptic problem.  On the free surface, we
     // constrain mesh velocity to be v.n, on free slip it is constrained to
@@ -374,7 +374,31 @@ namespace aspect
         if (parameters.run_postprocessors_on_initial_refinement && (!parameters.run_postprocessors_on_nonlinear_iterations))
           postprocess ();
 
-        refine_mesh (max_refinement_level);
+        if (parameters.incremental_initial_refinement)
+          {
+            // record which cells the refinement creates, so that the
+            // initial conditions only need to be evaluated on those
+            cells_changed_by_initial_refinement.clear ();
+
+            const boost::signals2::scoped_connection refinement_connection
+              = triangulation.signals.post_refinement_on_cell.connect (
+                  [&] (const typename Triangulation<dim>::cell_iterator &cell)
+            {
+              for (unsigned int child=0; child<cell->n_children(); ++child)
+                cells_changed_by_initial_refinement.insert (cell->child(child)->id());
+            });
+            const boost::signals2::scoped_connection coarsening_connection
+              = triangulation.signals.pre_coarsening_on_cell.connect (
+                  [&] (const typename Triangulation<dim>::cell_iterator &cell)
+            {
+              cells_changed_by_initial_refinement.insert (cell->id());
+            });
+
+            refine_mesh (max_refinement_level);
+          }
+        else
+          refine_mesh (max_refinement_level);
+
         ++pre_refinement_step;
         return true;
       }
@@ -382,6 +406,7 @@ namespace aspect
       {
         // invalidate the value of pre_refinement_step since it will no longer be used from here on
         pre_refinement_step = std::numeric_limits<unsigned int>::max();
+        cells_changed_by_initial_refinement.clear ();
         return false;
       }
   }
@@ -2268,7 +2293,9 @@ namespace aspect
 
     compute_current_constraints ();
 
+    assemble_auxiliary_stokes_residual = true;
     assemble_stokes_system();
+    assemble_auxiliary_stokes_residual = false;
 
     last_pressure_normalization_adjustment = normalize_pressure(current_linearization_point);
 
@@ -2284,6 +2311,119 @@ namespace aspect
 
 
 
+  template <int dim>
+  void
+  Simulator<dim>::compute_jacobian_free_newton_product (LinearAlgebra::BlockVector       &dst,
+                                                        const LinearAlgebra::BlockVector &src)
+  {
+    const unsigned int block_vel = introspection.block_indices.velocities;
+    const unsigned int block_p = introspection.block_indices.pressure;
+    Assert(block_vel == 0, ExcNotImplemented());
+    Assert(block_p == 1, ExcNotImplemented());
+    Assert(src.n_blocks() == 2, ExcInternalError());
+    Assert(dst.n_blocks() == 2, ExcInternalError());
+
+    const double derivative_scaling_factor = newton_handler->jacobian_free_derivative_scaling_factor;
+
+    // first compute the product with the assembled (Picard) matrix
+    system_matrix.block(0,0).vmult(dst.block(0), src.block(0));
+    system_matrix.block(0,1).vmult_add(dst.block(0), src.block(1));
+    system_matrix.block(1,0).vmult(dst.block(1), src.block(0));
+    system_matrix.block(1,1).vmult_add(dst.block(1), src.block(1));
+
+    if (derivative_scaling_factor == 0)
+      return;
+
+    Timer timer;
+
+    // The Newton update satisfies homogeneous constraints, so make the
+    // direction conforming before we use it to perturb the solution
+    LinearAlgebra::BlockVector direction (src);
+    current_constraints.distribute (direction);
+
+    // Store the current linearization point and right hand side, i.e., the
+    // negative residual R(u), so that we can restore them below
+    LinearAlgebra::BlockVector unperturbed_linearization_point (introspection.index_sets.stokes_partitioning, mpi_communicator);
+    unperturbed_linearization_point.block(block_vel) = current_linearization_point.block(block_vel);
+    unperturbed_linearization_point.block(block_p) = current_linearization_point.block(block_p);
+
+    LinearAlgebra::BlockVector unperturbed_rhs (introspection.index_sets.stokes_partitioning, mpi_communicator);
+    unperturbed_rhs.block(block_vel) = system_rhs.block(block_vel);
+    unperturbed_rhs.block(block_p) = system_rhs.block(block_p);
+
+    // Choose the finite difference step relative to the size of the current
+    // solution in the (pressure scaled) variables of the linear system, as
+    // suggested by Knoll and Keyes (2004)
+    const double velocity_norm = unperturbed_linearization_point.block(block_vel).l2_norm();
+    const double pressure_norm = unperturbed_linearization_point.block(block_p).l2_norm() / pressure_scaling;
+    const double solution_norm = std::sqrt(velocity_norm * velocity_norm + pressure_norm * pressure_norm);
+    const double direction_norm = direction.l2_norm();
+
+    LinearAlgebra::BlockVector derivative_product (introspection.index_sets.stokes_partitioning, mpi_communicator);
+    if (direction_norm > 0)
+      {
+        const double step = newton_handler->parameters.jacobian_free_perturbation_factor
+                            * (1.0 + solution_norm) / direction_norm;
+
+        LinearAlgebra::BlockVector perturbed_linearization_point (unperturbed_linearization_point);
+        perturbed_linearization_point.block(block_vel).add (step, direction.block(block_vel));
+        perturbed_linearization_point.block(block_p).add (step * pressure_scaling, direction.block(block_p));
+
+        current_linearization_point.block(block_vel) = perturbed_linearization_point.block(block_vel);
+        current_linearization_point.block(block_p) = perturbed_linearization_point.block(block_p);
+
+        // Only assemble the right hand side, i.e., leave the system matrix
+        // (which is used by the preconditioner) untouched
+        const bool rebuild_stokes_matrix_backup = rebuild_stokes_matrix;
+        const bool assemble_newton_stokes_matrix_backup = assemble_newton_stokes_matrix;
+        rebuild_stokes_matrix = assemble_newton_stokes_matrix = false;
+
+        assemble_auxiliary_stokes_residual = true;
+        assemble_stokes_system ();
+        assemble_auxiliary_stokes_residual = false;
+
+        rebuild_stokes_matrix = rebuild_stokes_matrix_backup;
+        assemble_newton_stokes_matrix = assemble_newton_stokes_matrix_backup;
+
+        // The right hand side is the negative residual, so
+        // J v = (R(u+hv)-R(u))/h = (rhs(u)-rhs(u+hv))/h
+        derivative_product.block(block_vel) = unperturbed_rhs.block(block_vel);
+        derivative_product.block(block_vel).add (-1.0, system_rhs.block(block_vel));
+        derivative_product.block(block_p) = unperturbed_rhs.block(block_p);
+        derivative_product.block(block_p).add (-1.0, system_rhs.block(block_p));
+        derivative_product /= step;
+
+        // restore the state we found when entering this function
+        current_linearization_point.block(block_vel) = unperturbed_linearization_point.block(block_vel);
+        current_linearization_point.block(block_p) = unperturbed_linearization_point.block(block_p);
+        system_rhs.block(block_vel) = unperturbed_rhs.block(block_vel);
+        system_rhs.block(block_p) = unperturbed_rhs.block(block_p);
+      }
+
+    // The residual vanishes in constrained rows. Use the rows of the
+    // assembled matrix there instead, which only contain a diagonal entry,
+    // to keep the operator invertible.
+    for (unsigned int block=0; block<2; ++block)
+      {
+        const IndexSet &locally_owned_dofs = introspection.index_sets.stokes_partitioning[block];
+        const types::global_dof_index block_start = dst.get_block_indices().block_start(block);
+        for (unsigned int i=0; i<locally_owned_dofs.n_elements(); ++i)
+          {
+            const types::global_dof_index index = block_start + locally_owned_dofs.nth_index_in_set(i);
+            if (current_constraints.is_constrained (index))
+              derivative_product(index) = dst(index);
+          }
+      }
+    derivative_product.compress (VectorOperation::insert);
+
+    dst.sadd (1.0 - derivative_scaling_factor, derivative_scaling_factor, derivative_product);
+
+    timer.stop ();
+    newton_handler->add_residual_evaluation (timer.wall_time());
+  }
+
+
+
   template <int dim>
   double
   Simulator<dim>::compute_Eisenstat_Walker_linear_tolerance(const bool EisenstatWalkerChoiceOne,
@@ -2367,6 +2507,8 @@ namespace aspect
   template void Simulator<dim>::restore_outflow_boundary_ids(const unsigned int boundary_id_offset); \
   template void Simulator<dim>::check_consistency_of_boundary_conditions() const; \
   template double Simulator<dim>::compute_initial_newton_residual(const LinearAlgebra::BlockVector &linearized_stokes_initial_guess); \
+  template void Simulator<dim>::compute_jacobian_free_newton_product(LinearAlgebra::BlockVector &dst, \
+                                                                     const LinearAlgebra::BlockVector &src); \
   template double Simulator<dim>::compute_Eisenstat_Walker_linear_tolerance(const bool EisenstatWalkerChoiceOne, \
                                                                             const double maximum_linear_stokes_solver_tolerance, \
                                                                             const double linear_stokes_solver_tolerance, \
@@ -27,9 +27,11 @@
 
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/function.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/numerics/vector_tools.h>
@@ -37,6 +39,98 @@
 
 namespace aspect
 {
+  template <int dim>
+  bool Simulator<dim>::initial_conditions_are_incremental () const
+  {
+    if (parameters.incremental_initial_refinement == false
+        ||
+        pre_refinement_step == 0
+        ||
+        pre_refinement_step > parameters.initial_adaptive_refinement)
+      return false;
+
+    // normalizing the compositional fields requires the global maximum
+    // of their sum, which we only know if we look at all cells
+    if (parameters.normalized_fields.size() > 0)
+      return false;
+
+    // plugins connected to these signals may change the mesh or the
+    // initial state in ways that are not restricted to the cells that
+    // were just refined or coarsened
+    if (pre_refinement_step == parameters.initial_adaptive_refinement
+        &&
+        !signals.pre_set_initial_state.empty())
+      return false;
+    if (!signals.post_set_initial_state.empty())
+      return false;
+
+    return true;
+  }
+
+
+
+  namespace
+  {
+    /**
+     * Scratch data for the interpolation of the initial temperature and
+     * compositional fields on a single cell.
+     */
+    template <int dim>
+    struct InitialConditionsScratch
+    {
+      InitialConditionsScratch (const Mapping<dim>             &mapping,
+                                const FiniteElement<dim>       &finite_element,
+                                const std::vector<Point<dim> > &temperature_support_points,
+                                const std::vector<Point<dim> > &composition_support_points,
+                                const unsigned int              n_compositional_fields)
+        :
+        temperature_fe_values (mapping, finite_element,
+                               Quadrature<dim>(temperature_support_points),
+                               update_quadrature_points),
+        composition_fe_values (mapping, finite_element,
+                               Quadrature<dim>(composition_support_points),
+                               update_quadrature_points),
+        local_dof_indices (finite_element.dofs_per_cell),
+        compositions (n_compositional_fields)
+      {}
+
+      InitialConditionsScratch (const InitialConditionsScratch &scratch)
+        :
+        temperature_fe_values (scratch.temperature_fe_values.get_mapping(),
+                               scratch.temperature_fe_values.get_fe(),
+                               scratch.temperature_fe_values.get_quadrature(),
+                               scratch.temperature_fe_values.get_update_flags()),
+        composition_fe_values (scratch.composition_fe_values.get_mapping(),
+                               scratch.composition_fe_values.get_fe(),
+                               scratch.composition_fe_values.get_quadrature(),
+                               scratch.composition_fe_values.get_update_flags()),
+        local_dof_indices (scratch.local_dof_indices),
+        compositions (scratch.compositions)
+      {}
+
+      FEValues<dim>                        temperature_fe_values;
+      FEValues<dim>                        composition_fe_values;
+      std::vector<types::global_dof_index> local_dof_indices;
+      std::vector<double>                  compositions;
+    };
+
+
+
+    /**
+     * The initial values of the temperature and compositional degrees of
+     * freedom of a single cell, and whether the compositional fields that
+     * should be normalized add up to more than one on this cell.
+     */
+    struct InitialConditionsCopyData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+      std::vector<double>                  values;
+      bool                                 normalize_composition;
+      double                               max_sum_comp;
+    };
+  }
+
+
 
   template <int dim>
   void Simulator<dim>::set_initial_temperature_and_compositional_fields ()
@@ -52,6 +146,15 @@ namespace aspect
 
     initial_solution.reinit(system_rhs, false);
 
+    // if we are in an initial refinement cycle in which the solvers were
+    // not run, the solution vectors still contain the initial conditions
+    // transferred from the previous mesh. these are exact on all cells
+    // that have not been refined or coarsened, so we only need to
+    // evaluate the initial conditions on the cells that changed
+    const bool incremental = initial_conditions_are_incremental();
+    if (incremental)
+      initial_solution = old_solution;
+
     // below, we would want to call VectorTools::interpolate on the
     // entire FESystem. there currently is no way to restrict the
     // interpolation operations to only a subset of vector
@@ -66,107 +169,154 @@ namespace aspect
     //
     // to work around this problem, the following code is essentially
     // a (simplified) copy of the code in VectorTools::interpolate
-    // that only works on the temperature component
-    //
-    // TODO: it would be great if we had a cleaner way than iterating to 1+n_fields.
-    // Additionally, the n==1 logic for normalization at the bottom is not pretty.
-    for (unsigned int n=0; n<1+introspection.n_compositional_fields; ++n)
-      {
-        AdvectionField advf = ((n == 0) ? AdvectionField::temperature()
-                               : AdvectionField::composition(n-1));
+    // that only works on the temperature and compositional components.
+    // rather than walking over the mesh once per field, it evaluates
+    // the temperature and all compositional fields in a single pass
+    // over the cells, and it does so in parallel. all compositional
+    // fields share one base element, so the initial composition
+    // manager can compute all fields at a support point at once.
+    const FiniteElement<dim> &temperature_fe
+      = finite_element.base_element(introspection.base_elements.temperature);
+    const std::vector<Point<dim> > temperature_support_points
+      = temperature_fe.get_unit_support_points();
+    Assert (temperature_support_points.size() != 0,
+            ExcInternalError());
 
-        const unsigned int base_element = advf.base_element(introspection);
+    const unsigned int n_compositional_fields = introspection.n_compositional_fields;
+    const unsigned int composition_dofs_per_cell
+      = (n_compositional_fields > 0
+         ?
+         finite_element.base_element(introspection.base_elements.compositional_fields).dofs_per_cell
+         :
+         0);
+    const std::vector<Point<dim> > composition_support_points
+      = (n_compositional_fields > 0
+         ?
+         finite_element.base_element(introspection.base_elements.compositional_fields).get_unit_support_points()
+         :
+         temperature_support_points);
+    Assert (composition_support_points.size() != 0,
+            ExcInternalError());
 
-        // get the temperature/composition support points
-        const std::vector<Point<dim> > support_points
-          = finite_element.base_element(base_element).get_unit_support_points();
-        Assert (support_points.size() != 0,
-                ExcInternalError());
+    // if temperature and compositional fields use the same element, they
+    // also share the support points and we only need to compute their
+    // locations once
+    const bool shared_support_points = (composition_support_points == temperature_support_points);
+
+    auto worker = [&] (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                       InitialConditionsScratch<dim> &scratch,
+                       InitialConditionsCopyData &data)
+    {
+      data.dof_indices.clear ();
+      data.values.clear ();
+      data.normalize_composition = false;
+      data.max_sum_comp = 0.0;
+
+      if (incremental
+          &&
+          cells_changed_by_initial_refinement.find(cell->id()) == cells_changed_by_initial_refinement.end())
+        return;
+
+      cell->get_dof_indices (scratch.local_dof_indices);
+
+      scratch.temperature_fe_values.reinit (cell);
+      for (unsigned int i=0; i<temperature_fe.dofs_per_cell; ++i)
+        {
+          const unsigned int system_local_dof
+            = finite_element.component_to_system_index(introspection.component_indices.temperature, i);
 
-        // create an FEValues object with just the temperature/composition element
-        FEValues<dim> fe_values (*mapping, finite_element,
-                                 support_points,
-                                 update_quadrature_points);
+          data.dof_indices.push_back (scratch.local_dof_indices[system_local_dof]);
+          data.values.push_back (initial_temperature_manager.initial_temperature(scratch.temperature_fe_values.quadrature_point(i)));
+        }
 
-        std::vector<types::global_dof_index> local_dof_indices (finite_element.dofs_per_cell);
+      if (n_compositional_fields == 0)
+        return;
+
+      if (!shared_support_points)
+        scratch.composition_fe_values.reinit (cell);
+      const FEValues<dim> &composition_fe_values = (shared_support_points
+                                                    ?
+                                                    scratch.temperature_fe_values
+                                                    :
+                                                    scratch.composition_fe_values);
 
-        const VectorFunctionFromScalarFunctionObject<dim, double> &advf_init_function
-          =
-            (advf.is_temperature()
-             ?
-             VectorFunctionFromScalarFunctionObject<dim, double>(
-               [&](const Point<dim> &p) -> double
+      for (unsigned int i=0; i<composition_dofs_per_cell; ++i)
         {
-          return initial_temperature_manager.initial_temperature(p);
-        },
-        introspection.component_indices.temperature,
-        introspection.n_components)
-        :
-        VectorFunctionFromScalarFunctionObject<dim, double>(
-          [&](const Point<dim> &p) -> double
+          initial_composition_manager.initial_compositions (composition_fe_values.quadrature_point(i),
+                                                            scratch.compositions);
+
+          for (unsigned int c=0; c<n_compositional_fields; ++c)
+            {
+              const unsigned int system_local_dof
+                = finite_element.component_to_system_index(introspection.component_indices.compositional_fields[c], i);
+
+              data.dof_indices.push_back (scratch.local_dof_indices[system_local_dof]);
+              data.values.push_back (scratch.compositions[c]);
+            }
+
+          // if it is specified in the parameter file that the sum of all compositional fields
+          // must not exceed one, this should be checked
+          if (parameters.normalized_fields.size()>0)
+            {
+              double sum = 0;
+              for (unsigned int m=0; m<parameters.normalized_fields.size(); ++m)
+                sum += scratch.compositions[parameters.normalized_fields[m]];
+
+              if (std::abs(sum) > 1.0+std::numeric_limits<double>::epsilon())
+                {
+                  data.max_sum_comp = std::max(sum, data.max_sum_comp);
+                  data.normalize_composition = true;
+                }
+            }
+        }
+    };
+
+    auto copier = [&] (const InitialConditionsCopyData &data)
+    {
+      for (unsigned int i=0; i<data.dof_indices.size(); ++i)
+        initial_solution(data.dof_indices[i]) = data.values[i];
+
+      if (data.normalize_composition)
         {
-          return initial_composition_manager.initial_composition(p, n-1);
-        },
-        introspection.component_indices.compositional_fields[n-1],
-        introspection.n_components));
-
-        const ComponentMask advf_mask =
-          (advf.is_temperature()
-           ?
-           introspection.component_masks.temperature
-           :
-           introspection.component_masks.compositional_fields[n-1]);
-
-        VectorTools::interpolate(*mapping,
-                                 dof_handler,
-                                 advf_init_function,
-                                 initial_solution,
-                                 advf_mask);
-
-        if (parameters.normalized_fields.size()>0 && n==1)
-          for (typename DoFHandler<dim>::active_cell_iterator cell = dof_handler.begin_active();
-               cell != dof_handler.end(); ++cell)
-            if (cell->is_locally_owned())
-              {
-                fe_values.reinit (cell);
-
-                // Go through the support points for each dof
-                for (unsigned int i=0; i<finite_element.base_element(base_element).dofs_per_cell; ++i)
-                  {
-                    // if it is specified in the parameter file that the sum of all compositional fields
-                    // must not exceed one, this should be checked
-                    double sum = 0;
-                    for (unsigned int m=0; m<parameters.normalized_fields.size(); ++m)
-                      sum += initial_composition_manager.initial_composition(fe_values.quadrature_point(i),
-                                                                             parameters.normalized_fields[m]);
-
-                    if (std::abs(sum) > 1.0+std::numeric_limits<double>::epsilon())
-                      {
-                        max_sum_comp = std::max(sum, max_sum_comp);
-                        normalize_composition = true;
-                      }
-                  }
-              }
-
-        initial_solution.compress(VectorOperation::insert);
-
-        // if at least one processor decides that it needs
-        // to normalize, do the same on all processors.
-        if (Utilities::MPI::max (normalize_composition ? 1 : 0,
-                                 mpi_communicator)
-            == 1)
-          {
-            const double global_max
-              = Utilities::MPI::max (max_sum_comp, mpi_communicator);
-
-            if (n==1)
-              pcout << "Sum of compositional fields is not one, fields will be normalized"
-                    << std::endl;
-
-            for (unsigned int m=0; m<parameters.normalized_fields.size(); ++m)
-              if (n-1==parameters.normalized_fields[m])
-                initial_solution.block(introspection.block_indices.compositional_fields[n-1]) /= global_max;
-          }
+          max_sum_comp = std::max(data.max_sum_comp, max_sum_comp);
+          normalize_composition = true;
+        }
+    };
+
+    typedef
+    FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>
+    CellFilter;
+
+    WorkStream::
+    run (CellFilter (IteratorFilters::LocallyOwnedCell(),
+                     dof_handler.begin_active()),
+         CellFilter (IteratorFilters::LocallyOwnedCell(),
+                     dof_handler.end()),
+         worker,
+         copier,
+         InitialConditionsScratch<dim> (*mapping,
+                                        finite_element,
+                                        temperature_support_points,
+                                        composition_support_points,
+                                        n_compositional_fields),
+         InitialConditionsCopyData ());
+
+    initial_solution.compress(VectorOperation::insert);
+
+    // if at least one processor decides that it needs
+    // to normalize, do the same on all processors.
+    if (Utilities::MPI::max (normalize_composition ? 1 : 0,
+                             mpi_communicator)
+        == 1)
+      {
+        const double global_max
+          = Utilities::MPI::max (max_sum_comp, mpi_communicator);
+
+        pcout << "Sum of compositional fields is not one, fields will be normalized"
+              << std::endl;
+
+        for (unsigned int m=0; m<parameters.normalized_fields.size(); ++m)
+          initial_solution.block(introspection.block_indices.compositional_fields[parameters.normalized_fields[m]]) /= global_max;
       }
 
     // then apply constraints and copy the
@@ -193,10 +343,58 @@ namespace aspect
   }
 
 
+  namespace
+  {
+    /**
+     * Scratch data for the interpolation of particle properties onto the
+     * support points of a single cell.
+     */
+    template <int dim>
+    struct ParticleInterpolationScratch
+    {
+      ParticleInterpolationScratch (const Mapping<dim>             &mapping,
+                                    const FiniteElement<dim>       &finite_element,
+                                    const std::vector<Point<dim> > &support_points)
+        :
+        fe_values (mapping, finite_element,
+                   Quadrature<dim>(support_points),
+                   update_quadrature_points),
+        local_dof_indices (finite_element.dofs_per_cell)
+      {}
+
+      ParticleInterpolationScratch (const ParticleInterpolationScratch &scratch)
+        :
+        fe_values (scratch.fe_values.get_mapping(),
+                   scratch.fe_values.get_fe(),
+                   scratch.fe_values.get_quadrature(),
+                   scratch.fe_values.get_update_flags()),
+        local_dof_indices (scratch.local_dof_indices)
+      {}
+
+      FEValues<dim>                        fe_values;
+      std::vector<types::global_dof_index> local_dof_indices;
+    };
+
+
+
+    /**
+     * The interpolated values of the degrees of freedom of the advected
+     * field on a single cell.
+     */
+    struct ParticleInterpolationCopyData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+      std::vector<double>                  values;
+    };
+  }
+
+
+
   template <int dim>
   void Simulator<dim>::interpolate_particle_properties (const AdvectionField &advection_field)
   {
     TimerOutput::Scope timer (computing_timer, "Particles: Interpolate");
+    const Profiler::Scope profiler_scope (profiler, "Particles: Interpolate");
 
     // below, we would want to call VectorTools::interpolate on the
     // entire FESystem. there currently is no way to restrict the
@@ -255,41 +453,64 @@ namespace aspect
     Assert (support_points.size() != 0,
             ExcInternalError());
 
-    // create an FEValues object with just the temperature/composition element
-    FEValues<dim> fe_values (*mapping, finite_element,
-                             support_points,
-                             update_quadrature_points);
-
-    std::vector<types::global_dof_index> local_dof_indices (finite_element.dofs_per_cell);
-
-    for (typename DoFHandler<dim>::active_cell_iterator cell = dof_handler.begin_active();
-         cell != dof_handler.end(); ++cell)
-      if (cell->is_locally_owned())
+    ComponentMask property_mask (particle_property_manager->get_data_info().n_components(),false);
+    property_mask.set(particle_property,true);
+
+    const unsigned int component_index = advection_field.component_index(introspection);
+    const unsigned int dofs_per_cell = finite_element.base_element(base_element).dofs_per_cell;
+
+    // the interpolation on different cells is independent, so we can
+    // work on several cells at the same time and only write the results
+    // into the global vector sequentially
+    auto worker = [&] (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                       ParticleInterpolationScratch<dim> &scratch,
+                       ParticleInterpolationCopyData &data)
+    {
+      scratch.fe_values.reinit (cell);
+
+      const std::vector<std::vector<double> > particle_properties =
+        particle_interpolator->properties_at_points(particle_postprocessor.get_particle_world().get_particle_handler(),
+                                                    scratch.fe_values.get_quadrature_points(),
+                                                    property_mask,
+                                                    cell);
+
+      // go through the composition dofs and set their global values
+      // to the particle field interpolated at these points
+      cell->get_dof_indices (scratch.local_dof_indices);
+      data.dof_indices.resize (dofs_per_cell);
+      data.values.resize (dofs_per_cell);
+      for (unsigned int i=0; i<dofs_per_cell; ++i)
         {
-          fe_values.reinit (cell);
-          const std::vector<Point<dim> > quadrature_points = fe_values.get_quadrature_points();
-
-          ComponentMask property_mask  (particle_property_manager->get_data_info().n_components(),false);
-          property_mask.set(particle_property,true);
-
-          const std::vector<std::vector<double> > particle_properties =
-            particle_interpolator->properties_at_points(particle_postprocessor.get_particle_world().get_particle_handler(),
-                                                        quadrature_points,
-                                                        property_mask,
-                                                        cell);
-
-          // go through the composition dofs and set their global values
-          // to the particle field interpolated at these points
-          cell->get_dof_indices (local_dof_indices);
-          for (unsigned int i=0; i<finite_element.base_element(base_element).dofs_per_cell; ++i)
-            {
-              const unsigned int system_local_dof
-                = finite_element.component_to_system_index(advection_field.component_index(introspection),
-                                                           /*dof index within component=*/i);
+          const unsigned int system_local_dof
+            = finite_element.component_to_system_index(component_index,
+                                                       /*dof index within component=*/i);
 
-              particle_solution(local_dof_indices[system_local_dof]) = particle_properties[i][particle_property];
-            }
+          data.dof_indices[i] = scratch.local_dof_indices[system_local_dof];
+          data.values[i] = particle_properties[i][particle_property];
         }
+    };
+
+    auto copier = [&] (const ParticleInterpolationCopyData &data)
+    {
+      for (unsigned int i=0; i<data.dof_indices.size(); ++i)
+        particle_solution(data.dof_indices[i]) = data.values[i];
+    };
+
+    typedef
+    FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>
+    CellFilter;
+
+    WorkStream::
+    run (CellFilter (IteratorFilters::LocallyOwnedCell(),
+                     dof_handler.begin_active()),
+         CellFilter (IteratorFilters::LocallyOwnedCell(),
+                     dof_handler.end()),
+         worker,
+         copier,
+         ParticleInterpolationScratch<dim> (*mapping,
+                                            finite_element,
+                                            support_points),
+         ParticleInterpolationCopyData ());
 
     particle_solution.compress(VectorOperation::insert);
 
@@ -324,6 +545,28 @@ namespace aspect
     // used). As the velocity is all zero anyway, this is currently not a
     // problem.
 
+    // if we are in an initial refinement cycle in which the solvers were
+    // not run, old_solution still contains the initial pressure of the
+    // previous cycle on all cells that have not been refined or
+    // coarsened, shifted by the pressure normalization computed there.
+    // we then only need to evaluate the pressure on the cells that
+    // changed, applying the same shift, and normalize the result again
+    const bool incremental = initial_conditions_are_incremental();
+    const double pressure_offset = (incremental
+                                    ?
+                                    last_pressure_normalization_adjustment
+                                    :
+                                    0.0);
+
+    auto cell_needs_update = [&] (const typename DoFHandler<dim>::active_cell_iterator &cell) -> bool
+    {
+      return (cell->is_locally_owned()
+              &&
+              (!incremental
+               ||
+               cells_changed_by_initial_refinement.find(cell->id()) != cells_changed_by_initial_refinement.end()));
+    };
+
     // we'd like to interpolate the initial pressure onto the pressure
     // variable but that's a bit involved because the pressure may either
     // be an FE_Q (for which we can interpolate) or an FE_DGP (for which
@@ -347,32 +590,47 @@ namespace aspect
             introspection.variable("fluid pressure")
             : introspection.variable("pressure");
         const unsigned int pressure_comp = pressure_variable.first_component_index;
-        const ComponentMask pressure_component_mask = pressure_variable.component_mask;
+        const unsigned int pressure_block = pressure_variable.block_index;
+
+        if (incremental)
+          system_tmp.block(pressure_block) = old_solution.block(pressure_block);
 
         // interpolate the pressure given by the adiabatic conditions
-        // object onto the solution space. note that interpolate
-        // wants a function that represents all components of the
-        // solution vector, so create such a function object
-        // that is simply zero for all velocity components
-        auto lambda = [&](const Point<dim> &p) -> double
-        {
-          return adiabatic_conditions->pressure(p);
-        };
+        // object onto the solution space. this is a simplified copy of
+        // VectorTools::interpolate that only works on the pressure
+        // component, and only on the cells we need to update
+        const FiniteElement<dim> &pressure_fe = finite_element.base_element(pressure_variable.base_index);
+        const std::vector<Point<dim> > support_points = pressure_fe.get_unit_support_points();
+        Assert (support_points.size() != 0,
+                ExcInternalError());
+
+        FEValues<dim> fe_values (*mapping, finite_element,
+                                 support_points,
+                                 update_quadrature_points);
 
-        VectorFunctionFromScalarFunctionObject<dim> vector_function_object(
-          lambda,
-          pressure_comp,
-          introspection.n_components);
+        std::vector<types::global_dof_index> local_dof_indices (finite_element.dofs_per_cell);
+
+        for (const auto &cell : dof_handler.active_cell_iterators())
+          if (cell_needs_update (cell))
+            {
+              fe_values.reinit (cell);
+              cell->get_dof_indices (local_dof_indices);
+
+              for (unsigned int i=0; i<pressure_fe.dofs_per_cell; ++i)
+                {
+                  const unsigned int system_local_dof
+                    = finite_element.component_to_system_index(pressure_comp, i);
 
-        VectorTools::interpolate (*mapping, dof_handler,
-                                  vector_function_object,
-                                  system_tmp,
-                                  pressure_component_mask);
+                  system_tmp(local_dof_indices[system_local_dof])
+                    = adiabatic_conditions->pressure(fe_values.quadrature_point(i)) + pressure_offset;
+                }
+            }
+
+        system_tmp.compress (VectorOperation::insert);
 
         // we may have hanging nodes, so apply constraints
         constraints.distribute (system_tmp);
 
-        const unsigned int pressure_block = pressure_variable.block_index;
         old_solution.block(pressure_block) = system_tmp.block(pressure_block);
       }
     else
@@ -386,6 +644,9 @@ namespace aspect
         LinearAlgebra::BlockVector system_tmp;
         system_tmp.reinit (system_rhs);
 
+        if (incremental)
+          system_tmp.block(introspection.block_indices.pressure) = old_solution.block(introspection.block_indices.pressure);
+
         QGauss<dim> quadrature(parameters.stokes_velocity_degree+1);
         UpdateFlags update_flags = UpdateFlags(update_values   |
                                                update_quadrature_points |
@@ -408,7 +669,7 @@ namespace aspect
         adiabatic_pressure (
           [&](const Point<dim> &p) -> double
         {
-          return adiabatic_conditions->pressure(p);
+          return adiabatic_conditions->pressure(p) + pressure_offset;
         });
 
 
@@ -417,7 +678,7 @@ namespace aspect
         endc = dof_handler.end();
 
         for (; cell!=endc; ++cell)
-          if (cell->is_locally_owned())
+          if (cell_needs_update (cell))
             {
               cell->get_dof_indices (local_dof_indices);
               fe_values.reinit(cell);
@@ -465,7 +726,10 @@ namespace aspect
 
     // normalize the pressure in such a way that the surface pressure
     // equals a known and desired value
-    this->last_pressure_normalization_adjustment = normalize_pressure(old_solution);
+    if (incremental)
+      this->last_pressure_normalization_adjustment += normalize_pressure(old_solution);
+    else
+      this->last_pressure_normalization_adjustment = normalize_pressure(old_solution);
 
     // set all solution vectors to the same value as the previous solution
     solution = old_solution;
@@ -479,6 +743,7 @@ namespace aspect
 namespace aspect
 {
 #define INSTANTIATE(dim) \
+  template bool Simulator<dim>::initial_conditions_are_incremental() const; \
   template void Simulator<dim>::set_initial_temperature_and_compositional_fields(); \
   template void Simulator<dim>::compute_initial_pressure_field(); \
   template void Simulator<dim>::interpolate_particle_properties(const AdvectionField &);
@@ -669,7 +669,6 @@ namespace aspect
       internal::Assembly::CopyData::AdvectionSystem<dim> &data = dynamic_cast<internal::Assembly::CopyData::AdvectionSystem<dim>& > (data_base);
 
       const Introspection<dim> &introspection = this->introspection();
-      const FiniteElement<dim> &fe = this->get_fe();
 
       const bool use_bdf2_scheme = (this->get_timestep_number() > 1);
       const unsigned int n_q_points = scratch.finite_element_values.n_quadrature_points;
@@ -678,8 +677,6 @@ namespace aspect
       const double time_step = this->get_timestep();
       const double old_time_step = this->get_old_timestep();
 
-      const unsigned int solution_component = scratch.advection_field->component_index(introspection);
-
       const FEValuesExtractors::Scalar solution_field = scratch.advection_field->scalar_extractor(introspection);
 
       MaterialModel::MeltOutputs<dim> *melt_outputs = scratch.material_model_outputs.template get_additional_output<MaterialModel::MeltOutputs<dim> >();
@@ -705,15 +702,11 @@ namespace aspect
           // We only need to look up values of shape functions if they
           // belong to 'our' component. They are zero otherwise anyway.
           // Note that we later only look at the values that we do set here.
-          for (unsigned int i=0, i_advection=0; i_advection<advection_dofs_per_cell; /*increment at end of loop*/)
+          for (unsigned int i_advection=0; i_advection<advection_dofs_per_cell; ++i_advection)
             {
-              if (fe.system_to_component_index(i).first == solution_component)
-                {
-                  scratch.grad_phi_field[i_advection] = scratch.finite_element_values[solution_field].gradient (i,q);
-                  scratch.phi_field[i_advection]      = scratch.finite_element_values[solution_field].value (i,q);
-                  ++i_advection;
-                }
-              ++i;
+              const unsigned int i = scratch.field_shape_function_indices[i_advection];
+              scratch.grad_phi_field[i_advection] = scratch.finite_element_values[solution_field].gradient (i,q);
+              scratch.phi_field[i_advection]      = scratch.finite_element_values[solution_field].value (i,q);
             }
 
           const unsigned int porosity_index = introspection.compositional_index_for_name("porosity");
@@ -1022,22 +1015,28 @@ namespace aspect
 
       const typename DoFHandler<dim>::face_iterator face = cell->face(face_no);
 
-      if (this->get_boundary_traction()
-          .find (face->boundary_id())
-          !=
-          this->get_boundary_traction().end())
+      const auto boundary_traction = this->get_boundary_traction().find (face->boundary_id());
+      if (boundary_traction != this->get_boundary_traction().end())
         {
           scratch.face_finite_element_values.reinit (cell, face_no);
 
+          // compute the tractions at all quadrature points of the face at once
+          scratch.face_tractions.resize (scratch.face_finite_element_values.n_quadrature_points);
+          {
+            const Profiler::Scope profiler_scope (this->get_profiler(), "Boundary traction model", "evaluate");
+            boundary_traction->second->boundary_tractions (face->boundary_id(),
+                                                           scratch.face_finite_element_values.get_quadrature_points(),
+#if DEAL_II_VERSION_GTE(9,0,0)
+                                                           scratch.face_finite_element_values.get_normal_vectors(),
+#else
+                                                           scratch.face_finite_element_values.get_all_normal_vectors(),
+#endif
+                                                           scratch.face_tractions);
+          }
+
           for (unsigned int q=0; q<scratch.face_finite_element_values.n_quadrature_points; ++q)
             {
-              const Tensor<1,dim> traction
-                = this->get_boundary_traction().find(
-                    face->boundary_id()
-                  )->second
-                  ->boundary_traction (face->boundary_id(),
-                                       scratch.face_finite_element_values.quadrature_point(q),
-                                       scratch.face_finite_element_values.normal_vector(q));
+              const Tensor<1,dim> &traction = scratch.face_tractions[q];
 
               for (unsigned int i=0, i_stokes=0; i_stokes<stokes_dofs_per_cell; /*increment at end of loop*/)
                 {
@@ -42,6 +42,16 @@ namespace aspect
 
 
 
+  template <int dim>
+  NewtonHandler<dim>::NewtonHandler ()
+    :
+    jacobian_free_derivative_scaling_factor (0.0),
+    n_residual_evaluations (0),
+    residual_evaluation_time (0.0)
+  {}
+
+
+
   template <int dim>
   void
   NewtonHandler<dim>::
@@ -145,6 +155,44 @@ namespace aspect
 
 
 
+  template <int dim>
+  void
+  NewtonHandler<dim>::reset_residual_evaluation_statistics ()
+  {
+    n_residual_evaluations = 0;
+    residual_evaluation_time = 0.0;
+  }
+
+
+
+  template <int dim>
+  void
+  NewtonHandler<dim>::add_residual_evaluation (const double seconds)
+  {
+    ++n_residual_evaluations;
+    residual_evaluation_time += seconds;
+  }
+
+
+
+  template <int dim>
+  unsigned int
+  NewtonHandler<dim>::get_n_residual_evaluations () const
+  {
+    return n_residual_evaluations;
+  }
+
+
+
+  template <int dim>
+  double
+  NewtonHandler<dim>::get_residual_evaluation_time () const
+  {
+    return residual_evaluation_time;
+  }
+
+
+
   namespace Newton
   {
     std::string
@@ -254,6 +302,29 @@ namespace aspect
                              "where Newton's method does not. "
                              "\n\n"
                              "Once derivatives are used in a Newton method, \\aspect{} always uses the Eisenstat Walker method.");
+
+          prm.declare_entry ("Use Jacobian-free Newton-Krylov method", "false",
+                             Patterns::Bool (),
+                             "If set to true, the Newton solver does not assemble the derivatives of the material "
+                             "model into the system matrix. Instead, the product of the Newton Jacobian with a vector "
+                             "that the iterative Stokes solver requires is approximated by a finite difference of "
+                             "two evaluations of the Newton residual, $J v \\approx (R(u+hv)-R(u))/h$, and the "
+                             "assembled matrix, which then is the Picard matrix, is only used to build the "
+                             "preconditioner. This avoids assembling the derivative terms in every nonlinear "
+                             "iteration, and the material model does not need to compute derivatives of the "
+                             "viscosity, at the cost of one assembly of the right hand side per iteration of the "
+                             "linear solver. The stabilization parameters of the Newton method have no effect "
+                             "in this case. The number of residual evaluations and the time spent in them are "
+                             "written to the statistics file. This method can not be used together with the "
+                             "direct Stokes solver.");
+
+          prm.declare_entry ("Jacobian-free perturbation factor", "1e-8",
+                             Patterns::Double (0),
+                             "The factor $b$ that determines the size of the finite difference step $h$ of the "
+                             "Jacobian-free Newton-Krylov method as $h=b(1+\\|u\\|)/\\|v\\|$, where $u$ is the "
+                             "current solution and $v$ the direction in which the Jacobian is applied. The "
+                             "default is approximately the square root of the machine precision, which balances "
+                             "truncation and round-off errors if the solution is well scaled.");
         }
         prm.leave_subsection ();
       }
@@ -302,6 +373,11 @@ namespace aspect
 
           SPD_safety_factor = prm.get_double("SPD safety factor");
           use_Eisenstat_Walker_method_for_Picard_iterations = prm.get_bool("Use Eisenstat Walker method for Picard iterations");
+          use_jacobian_free_newton_krylov = prm.get_bool("Use Jacobian-free Newton-Krylov method");
+          jacobian_free_perturbation_factor = prm.get_double("Jacobian-free perturbation factor");
+          AssertThrow(!use_jacobian_free_newton_krylov || jacobian_free_perturbation_factor > 0,
+                      ExcMessage("The perturbation factor of the Jacobian-free Newton-Krylov method "
+                                 "needs to be larger than zero."));
 
         }
         prm.leave_subsection ();
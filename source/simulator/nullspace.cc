@@ -245,18 +245,22 @@ namespace aspect
     // compute and remove net linear momentum from velocity field, by computing
     // \int \rho (v + v_const) = 0
 
+    // The density, JxW values, and positions at the quadrature points have
+    // been stored during the assembly of the Stokes system (which uses the
+    // same quadrature formula), so we only need to evaluate the velocity here
     QGauss<dim> quadrature(parameters.stokes_velocity_degree+1);
     const unsigned int n_q_points = quadrature.size();
     FEValues<dim> fe(*mapping, finite_element, quadrature,
-                     UpdateFlags(update_quadrature_points | update_JxW_values | update_values | update_gradients));
+                     update_values);
 
-    Tensor<1,dim> local_momentum;
-    double local_mass = 0.0;
+    AssertThrow (nullspace_quadrature_data.JxW_values.size() == triangulation.n_active_cells() * n_q_points,
+                 ExcMessage ("The nullspace removal requires the quadrature point data "
+                             "computed during the assembly of the Stokes system."));
 
+    // The mass followed by the dim components of the momentum. Collect them
+    // in one vector so that a single reduction suffices.
+    std::vector<double> local_integrals (dim+1, 0.0);
 
-    // Vectors for evaluating the finite element solution
-    std::vector<std::vector<double> > composition_values (introspection.n_compositional_fields,
-                                                          std::vector<double> (n_q_points));
     std::vector< Tensor<1,dim> > velocities( n_q_points );
 
     typename DoFHandler<dim>::active_cell_iterator cell;
@@ -269,44 +273,27 @@ namespace aspect
           // get the velocity at each quadrature point
           fe[introspection.extractors.velocities].get_function_values (relevant_dst, velocities);
 
-          // get the density at each quadrature point if necessary
-          MaterialModel::MaterialModelInputs<dim> in(n_q_points,
-                                                     introspection.n_compositional_fields);
-          MaterialModel::MaterialModelOutputs<dim> out(n_q_points,
-                                                       introspection.n_compositional_fields);
-          if ( ! use_constant_density)
-            {
-              fe[introspection.extractors.pressure].get_function_values (relevant_dst, in.pressure);
-              fe[introspection.extractors.temperature].get_function_values (relevant_dst, in.temperature);
-              in.velocity = velocities;
-              fe[introspection.extractors.pressure].get_function_gradients (relevant_dst, in.pressure_gradient);
-              for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
-                fe[introspection.extractors.compositional_fields[c]].get_function_values(relevant_dst,
-                                                                                         composition_values[c]);
-
-              for (unsigned int i=0; i<n_q_points; ++i)
-                {
-                  in.position[i] = fe.quadrature_point(i);
-                  for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
-                    in.composition[i][c] = composition_values[c][i];
-                }
-              material_model->evaluate(in, out);
-            }
+          const unsigned int first_index = cell->active_cell_index() * n_q_points;
 
           // actually compute the momentum and mass
           for (unsigned int k=0; k<n_q_points; ++k)
             {
               // get the density at this quadrature point
-              const double rho = (use_constant_density ? 1.0 : out.densities[k]);
+              const double rho = (use_constant_density ? 1.0 : nullspace_quadrature_data.densities[first_index+k]);
+              const double rho_JxW = rho * nullspace_quadrature_data.JxW_values[first_index+k];
 
-              local_momentum += velocities[k] * rho * fe.JxW(k);
-              local_mass += rho * fe.JxW(k);
+              local_integrals[0] += rho_JxW;
+              for (unsigned int d=0; d<dim; ++d)
+                local_integrals[1+d] += velocities[k][d] * rho_JxW;
             }
         }
 
     // Calculate the total mass and velocity correction
-    const double mass = Utilities::MPI::sum( local_mass, mpi_communicator);
-    Tensor<1,dim> velocity_correction = Utilities::MPI::sum(local_momentum, mpi_communicator)/mass;
+    const std::vector<double> integrals = Utilities::MPI::sum(local_integrals, mpi_communicator);
+    const double mass = integrals[0];
+    Tensor<1,dim> velocity_correction;
+    for (unsigned int d=0; d<dim; ++d)
+      velocity_correction[d] = integrals[1+d] / mass;
 
     // We may only want to remove the nullspace for a single component, so zero out
     // the velocity correction if it is not selected by the NullspaceRemoval flag
@@ -354,10 +341,16 @@ namespace aspect
     // \int \rho u \cdot r_orth = \omega  * \int \rho x^2    ( 2 dimensions)
     // \int \rho r \times u =  I \cdot \omega  (3 dimensions)
 
+    // As above, reuse the density, JxW values, and positions at the
+    // quadrature points from the assembly of the Stokes system
     QGauss<dim> quadrature(parameters.stokes_velocity_degree+1);
     const unsigned int n_q_points = quadrature.size();
     FEValues<dim> fe(*mapping, finite_element, quadrature,
-                     UpdateFlags(update_quadrature_points | update_JxW_values | update_values | update_gradients));
+                     update_values);
+
+    AssertThrow (nullspace_quadrature_data.JxW_values.size() == triangulation.n_active_cells() * n_q_points,
+                 ExcMessage ("The nullspace removal requires the quadrature point data "
+                             "computed during the assembly of the Stokes system."));
 
     typename DoFHandler<dim>::active_cell_iterator cell;
 
@@ -369,39 +362,26 @@ namespace aspect
     double local_scalar_moment = 0.0;
     double local_scalar_angular_momentum = 0.0;
 
-    // Vectors for evaluating the finite element solution
-    std::vector<std::vector<double> > composition_values (introspection.n_compositional_fields,
-                                                          std::vector<double> (n_q_points));
+    std::vector< Tensor<1,dim> > velocities( n_q_points );
 
     // loop over all local cells
     for (cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
       if (cell->is_locally_owned())
         {
           fe.reinit (cell);
-          const std::vector<Point<dim> > &q_points = fe.get_quadrature_points();
-
-          // get the density at each quadrature point if necessary
-          MaterialModel::MaterialModelInputs<dim> in(n_q_points,
-                                                     introspection.n_compositional_fields);
-          MaterialModel::MaterialModelOutputs<dim> out(n_q_points,
-                                                       introspection.n_compositional_fields);
 
           // Get the velocity at each quadrature point
-          fe[introspection.extractors.velocities].get_function_values (relevant_dst, in.velocity);
+          fe[introspection.extractors.velocities].get_function_values (relevant_dst, velocities);
 
-          if ( ! use_constant_density)
-            {
-              // Set use_strain_rates to false since we don't need viscosity
-              in.reinit(fe, cell, introspection, solution, false);
-              material_model->evaluate(in, out);
-            }
+          const unsigned int first_index = cell->active_cell_index() * n_q_points;
 
           // actually compute the moment of inertia and angular momentum
           for (unsigned int k=0; k<n_q_points; ++k)
             {
               // get the position and density at this quadrature point
-              const Point<dim> r_vec = q_points[k];
-              const double rho = (use_constant_density ? 1.0 : out.densities[k]);
+              const Point<dim> &r_vec = nullspace_quadrature_data.positions[first_index+k];
+              const double rho = (use_constant_density ? 1.0 : nullspace_quadrature_data.densities[first_index+k]);
+              const double rho_JxW = rho * nullspace_quadrature_data.JxW_values[first_index+k];
 
               if (dim == 2)
                 {
@@ -409,35 +389,53 @@ namespace aspect
                   Tensor<1,dim> r_perp = cross_product_2d(r_vec);
 
                   // calculate a signed scalar angular momentum
-                  local_scalar_angular_momentum += in.velocity[k] * r_perp * rho * fe.JxW(k);
+                  local_scalar_angular_momentum += velocities[k] * r_perp * rho_JxW;
                   // calculate a scalar moment of inertia
-                  local_scalar_moment += r_vec.norm_square() * rho * fe.JxW(k);
+                  local_scalar_moment += r_vec.norm_square() * rho_JxW;
                 }
               else
                 {
                   // calculate angular momentum vector
-                  Tensor<1,dim> r_cross_v = cross_product_3d(r_vec, in.velocity[k]);
+                  Tensor<1,dim> r_cross_v = cross_product_3d(r_vec, velocities[k]);
                   for (unsigned int i=0; i<dim; ++i)
-                    local_angular_momentum[i] += r_cross_v[i] * rho * fe.JxW(k);
+                    local_angular_momentum[i] += r_cross_v[i] * rho_JxW;
 
                   // calculate moment of inertia
-                  local_moment_of_inertia[0][0] += (r_vec.square() - r_vec[0] * r_vec[0]) * rho * fe.JxW(k);
-                  local_moment_of_inertia[1][1] += (r_vec.square() - r_vec[1] * r_vec[1]) * rho * fe.JxW(k);
-                  local_moment_of_inertia[2][2] += (r_vec.square() - r_vec[2] * r_vec[2]) * rho * fe.JxW(k);
-                  local_moment_of_inertia[0][1] -= (r_vec[0] * r_vec[1]) * rho * fe.JxW(k);
-                  local_moment_of_inertia[0][2] -= (r_vec[0] * r_vec[2]) * rho * fe.JxW(k);
-                  local_moment_of_inertia[1][2] -= (r_vec[1] * r_vec[2]) * rho * fe.JxW(k);
+                  local_moment_of_inertia[0][0] += (r_vec.square() - r_vec[0] * r_vec[0]) * rho_JxW;
+                  local_moment_of_inertia[1][1] += (r_vec.square() - r_vec[1] * r_vec[1]) * rho_JxW;
+                  local_moment_of_inertia[2][2] += (r_vec.square() - r_vec[2] * r_vec[2]) * rho_JxW;
+                  local_moment_of_inertia[0][1] -= (r_vec[0] * r_vec[1]) * rho_JxW;
+                  local_moment_of_inertia[0][2] -= (r_vec[0] * r_vec[2]) * rho_JxW;
+                  local_moment_of_inertia[1][2] -= (r_vec[1] * r_vec[2]) * rho_JxW;
                 }
             }
         }
 
+    // Sum up all local contributions with a single reduction: in 2D the
+    // scalar moment and angular momentum, in 3D the independent components
+    // of the moment of inertia followed by the angular momentum vector
+    std::vector<double> local_integrals;
+    if (dim == 2)
+      {
+        local_integrals.push_back (local_scalar_moment);
+        local_integrals.push_back (local_scalar_angular_momentum);
+      }
+    else
+      {
+        for (unsigned int i=0; i<SymmetricTensor<2,dim>::n_independent_components; ++i)
+          local_integrals.push_back (local_moment_of_inertia.access_raw_entry(i));
+        for (unsigned int i=0; i<dim; ++i)
+          local_integrals.push_back (local_angular_momentum[i]);
+      }
+    const std::vector<double> integrals = Utilities::MPI::sum(local_integrals, mpi_communicator);
+
     // vector for storing the correction to the velocity field
     LinearAlgebra::Vector correction(tmp_distributed_stokes.block(introspection.block_indices.velocities));
 
     if (dim == 2)
       {
-        const double scalar_moment = Utilities::MPI::sum(local_scalar_moment, mpi_communicator);
-        const double scalar_angular_momentum = Utilities::MPI::sum(local_scalar_angular_momentum, mpi_communicator);
+        const double scalar_moment = integrals[0];
+        const double scalar_angular_momentum = integrals[1];
 
         // Solve for the rotation rate to cancel the angular momentum
         const double rotation_rate = scalar_angular_momentum / scalar_moment;
@@ -449,11 +447,13 @@ namespace aspect
       }
     else
       {
-        // sum up the local contributions to moment of inertia
-        const SymmetricTensor<2,dim> moment_of_inertia = Utilities::MPI::sum(local_moment_of_inertia,
-                                                                             mpi_communicator);
-        // sum up the local contributions to angular momentum
-        const Tensor<1,dim> angular_momentum = Utilities::MPI::sum(local_angular_momentum, mpi_communicator );
+        SymmetricTensor<2,dim> moment_of_inertia;
+        for (unsigned int i=0; i<SymmetricTensor<2,dim>::n_independent_components; ++i)
+          moment_of_inertia.access_raw_entry(i) = integrals[i];
+
+        Tensor<1,dim> angular_momentum;
+        for (unsigned int i=0; i<dim; ++i)
+          angular_momentum[i] = integrals[SymmetricTensor<2,dim>::n_independent_components+i];
 
         // Solve for the rotation vector that cancels the net momentum
         const SymmetricTensor<2,dim> inverse_moment (invert( Tensor<2,dim>(moment_of_inertia)));
@@ -316,6 +316,22 @@ namespace aspect
                          "the composition system gets solved. See `Stokes solver "
                          "parameters/Linear solver tolerance' for more details.");
 
+      prm.declare_entry ("Cache sparsity patterns", "false",
+                         Patterns::Bool(),
+                         "Whether to build the sparsity patterns of the system matrix "
+                         "and of the Stokes preconditioner matrix only from the constraints "
+                         "that depend on the mesh (hanging nodes, periodic boundaries, and "
+                         "tangential velocity boundaries), keeping the matrix entries of "
+                         "constrained degrees of freedom. The resulting matrices have a "
+                         "few more entries in the rows that belong to boundary degrees "
+                         "of freedom, but they remain valid if the set of degrees of "
+                         "freedom that are constrained to prescribed values changes "
+                         "between time steps, for example because of time dependent "
+                         "boundary conditions, prescribed fields, or melt cells. In that "
+                         "case the sparsity patterns and matrices are kept instead of being "
+                         "rebuilt, and they are only set up again after the mesh has "
+                         "changed.");
+
       prm.enter_subsection ("Stokes solver parameters");
       {
         prm.declare_entry ("Use direct solver for Stokes system", "false",
@@ -417,6 +433,42 @@ namespace aspect
                            "in the preconditioning used in the GMRES solver. The exact definition of "
                            "this block preconditioner for the Stokes equation can be found in "
                            "\\cite{KHB12}.");
+
+        prm.declare_entry ("Use communication avoiding Krylov methods", "false",
+                           Patterns::Bool(),
+                           "If set to true, the iterative Stokes solver uses variants of its "
+                           "Krylov methods that need fewer global reductions per iteration, "
+                           "which dominate the cost of an iteration on large numbers of "
+                           "processes. The $A$ and $S$ blocks of the preconditioner are then "
+                           "solved with the pipelined conjugate gradient method of Ghysels "
+                           "and Vanroose (2014), which combines all inner products of an "
+                           "iteration into a single non-blocking reduction that overlaps with "
+                           "the application of the preconditioner and the matrix. The outer "
+                           "FGMRES solver orthogonalizes with classical instead of modified "
+                           "Gram-Schmidt, which needs a single reduction per iteration "
+                           "instead of one per basis vector, and reorthogonalizes only if a "
+                           "loss of orthogonality is detected. Both variants are slightly "
+                           "less robust with respect to round-off, and do more vector "
+                           "operations per iteration, so they only pay off for large "
+                           "parallel computations.");
+
+        prm.declare_entry ("Use single precision Schur complement preconditioner", "false",
+                           Patterns::Bool(),
+                           "If set to true, the incomplete LU decomposition that is used as "
+                           "preconditioner for the inner solves with the pressure mass matrix "
+                           "(the approximation of the Schur complement) is stored and applied "
+                           "in single precision. The application of this preconditioner is "
+                           "limited by the memory bandwidth, so this makes it about twice as "
+                           "fast. Since only the preconditioner is affected, the solution still "
+                           "converges to the same tolerance, but may need a few more iterations. "
+                           "The option trades memory for bandwidth in the pressure mass matrix "
+                           "solves only: the single precision decomposition replaces the double "
+                           "precision one, but the CG solver still multiplies with the double "
+                           "precision pressure mass matrix, which therefore stays allocated. "
+                           "The AMG preconditioner of the velocity block always works in double "
+                           "precision. This parameter is ignored for models with melt "
+                           "transport, which use an AMG preconditioner for the pressure "
+                           "block as well.");
       }
       prm.leave_subsection ();
       prm.enter_subsection ("AMG parameters");
@@ -748,6 +800,22 @@ namespace aspect
                          "Whether or not the initial conditions should be set up during the "
                          "the adaptive refinement cycles that are run at the start of the "
                          "simulation.");
+      prm.declare_entry ("Incremental initial refinement", "false",
+                         Patterns::Bool (),
+                         "Whether the initial conditions should only be evaluated on the cells "
+                         "that were created by the last of the initial adaptive refinement "
+                         "cycles, rather than on the whole mesh. All other cells keep the "
+                         "values that were computed in earlier cycles and transferred to the "
+                         "new mesh. This makes the initial refinement considerably cheaper "
+                         "if the initial conditions are expensive to evaluate. The whole mesh "
+                         "is still evaluated if compositional fields need to be normalized, "
+                         "and in the final cycle if the geometry is changed before the initial "
+                         "conditions are set (e.g., by adding initial topography). Particles "
+                         "are not treated incrementally: they are generated in the first "
+                         "cycle as before, and the properties of all particles are still "
+                         "initialized in every cycle. This "
+                         "option requires that the solvers are skipped during the initial "
+                         "refinement cycles, see 'Skip solvers on initial refinement'.");
     }
     prm.leave_subsection();
 
@@ -1202,6 +1270,7 @@ namespace aspect
     {
       temperature_solver_tolerance    = prm.get_double ("Temperature solver tolerance");
       composition_solver_tolerance    = prm.get_double ("Composition solver tolerance");
+      cache_sparsity_patterns         = prm.get_bool ("Cache sparsity patterns");
 
       prm.enter_subsection ("Stokes solver parameters");
       {
@@ -1213,6 +1282,8 @@ namespace aspect
         use_full_A_block_preconditioner = prm.get_bool ("Use full A block as preconditioner");
         linear_solver_S_block_tolerance = prm.get_double ("Linear solver S block tolerance");
         stokes_gmres_restart_length     = prm.get_integer("GMRES solver restart length");
+        use_communication_avoiding_krylov_methods = prm.get_bool("Use communication avoiding Krylov methods");
+        use_single_precision_schur_complement_preconditioner = prm.get_bool("Use single precision Schur complement preconditioner");
       }
       prm.leave_subsection ();
       prm.enter_subsection ("AMG parameters");
@@ -1322,6 +1393,18 @@ namespace aspect
         AssertThrow(false, ExcMessage("Cannot execute solvers if no initial conditions are set up. "
                                       "You must set skip_solvers_on_initial_refinement to true."));
 
+      incremental_initial_refinement = prm.get_bool("Incremental initial refinement");
+
+      if (incremental_initial_refinement == true && skip_solvers_on_initial_refinement == false)
+        AssertThrow(false, ExcMessage("Incremental initial refinement reuses the initial conditions "
+                                      "of the previous refinement cycle, which the solvers would modify. "
+                                      "You must set skip_solvers_on_initial_refinement to true."));
+
+      if (incremental_initial_refinement == true && skip_setup_initial_conditions_on_initial_refinement == true)
+        AssertThrow(false, ExcMessage("Incremental initial refinement requires that the initial conditions "
+                                      "are set up in every initial refinement cycle. You must set "
+                                      "skip_setup_initial_conditions_on_initial_refinement to false."));
+
       run_postprocessors_on_initial_refinement = prm.get_bool("Run postprocessors on initial refinement");
 
       if (skip_setup_initial_conditions_on_initial_refinement == true && run_postprocessors_on_initial_refinement == true)
@@ -1918,6 +2001,9 @@ namespace aspect
     Newton::Parameters::declare_parameters (prm);
     Postprocess::Manager<dim>::declare_parameters (prm);
     MeshRefinement::Manager<dim>::declare_parameters (prm);
+    CellCostModel<dim>::declare_parameters (prm);
+    QuadraturePointGeometry<dim>::declare_parameters (prm);
+    Profiler::declare_parameters (prm);
     TerminationCriteria::Manager<dim>::declare_parameters (prm);
     MaterialModel::declare_parameters<dim> (prm);
     HeatingModel::Manager<dim>::declare_parameters (prm);
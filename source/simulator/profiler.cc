@@ -0,0 +1,657 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <aspect/profiler.h>
+#include <aspect/utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace aspect
+{
+  namespace
+  {
+#ifdef __linux__
+    /**
+     * Open a hardware counter of the given type for the calling thread.
+     * Return -1 if this is not possible, e.g. because the kernel does not
+     * allow unprivileged users to read hardware counters.
+     */
+    int
+    open_hardware_counter (const unsigned int counter)
+    {
+      struct perf_event_attr attributes;
+      std::memset (&attributes, 0, sizeof(attributes));
+      attributes.size = sizeof(attributes);
+      attributes.type = PERF_TYPE_HARDWARE;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+
+      switch (counter)
+        {
+          case Profiler::cpu_cycles:
+            attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+          case Profiler::instructions:
+            attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+          case Profiler::cache_misses:
+            attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+          default:
+            Assert (false, ExcInternalError());
+        }
+
+      // measure the calling thread on any cpu
+      return static_cast<int>(syscall (__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+#endif
+
+
+
+    /**
+     * Escape the characters of @p text that have a special meaning in JSON
+     * strings.
+     */
+    std::string
+    escape_json (const std::string &text)
+    {
+      std::string escaped;
+      escaped.reserve (text.size());
+      for (const char c : text)
+        {
+          if (c == '"' || c == '\\')
+            escaped += '\\';
+          escaped += c;
+        }
+      return escaped;
+    }
+
+
+
+    /**
+     * Return the name of the innermost region of the region @p path.
+     */
+    std::string
+    region_name (const std::string &path)
+    {
+      const std::string::size_type last_separator = path.rfind('/');
+      return (last_separator == std::string::npos
+              ?
+              path
+              :
+              path.substr (last_separator+1));
+    }
+
+
+
+    /**
+     * Return the path of the region that contains the region @p path, or
+     * an empty string for regions on the top level.
+     */
+    std::string
+    parent_path (const std::string &path)
+    {
+      const std::string::size_type last_separator = path.rfind('/');
+      return (last_separator == std::string::npos
+              ?
+              std::string()
+              :
+              path.substr (0, last_separator));
+    }
+
+
+
+    const char *counter_names[Profiler::n_counters] = {"cpu_cycles", "instructions", "cache_misses"};
+  }
+
+
+
+  Profiler::Scope::Scope (const Profiler &profiler,
+                          const char *name)
+    :
+    profiler (profiler),
+    active (profiler.enabled)
+  {
+    if (active)
+      profiler.enter_region (nullptr, name);
+  }
+
+
+
+  Profiler::Scope::Scope (const Profiler &profiler,
+                          const std::string &name)
+    :
+    profiler (profiler),
+    active (profiler.enabled)
+  {
+    if (active)
+      profiler.enter_region (nullptr, name.c_str());
+  }
+
+
+
+  Profiler::Scope::Scope (const Profiler &profiler,
+                          const std::string &category,
+                          const std::string &name)
+    :
+    profiler (profiler),
+    active (profiler.enabled)
+  {
+    if (active)
+      profiler.enter_region (category.c_str(), name.c_str());
+  }
+
+
+
+  Profiler::Scope::Scope (const Profiler &profiler,
+                          const char *category,
+                          const std::string &name)
+    :
+    profiler (profiler),
+    active (profiler.enabled)
+  {
+    if (active)
+      profiler.enter_region (category, name.c_str());
+  }
+
+
+
+  Profiler::Scope::~Scope ()
+  {
+    if (active)
+      profiler.leave_region ();
+  }
+
+
+
+  Profiler::Measurement::Measurement ()
+    :
+    n_calls (0),
+    wall_time (0.0)
+  {
+    counters.fill (0);
+  }
+
+
+
+  Profiler::ThreadData::ThreadData ()
+    :
+    counters_initialized (false),
+    registered (false)
+  {
+    counter_file_descriptors.fill (-1);
+  }
+
+
+
+  Profiler::ThreadData::~ThreadData ()
+  {
+#ifdef __linux__
+    for (const int file_descriptor : counter_file_descriptors)
+      if (file_descriptor >= 0)
+        close (file_descriptor);
+#endif
+  }
+
+
+
+  Profiler::Profiler ()
+    :
+    enabled (false),
+    record_hardware_counters (false),
+    output_format (json),
+    output_frequency (0),
+    mpi_communicator (MPI_COMM_WORLD),
+    main_thread_id (std::this_thread::get_id()),
+    creation_time (std::chrono::steady_clock::now())
+  {}
+
+
+
+  void
+  Profiler::declare_parameters (ParameterHandler &prm)
+  {
+    prm.enter_subsection ("Profiling");
+    {
+      prm.declare_entry ("Enable profiling", "false",
+                         Patterns::Bool (),
+                         "Whether to record how much time is spent in each region of the "
+                         "code. In addition to the sections that are shown in the timing "
+                         "output at the end of the run, every call to a plugin is recorded "
+                         "in a separate region, nested into the section it was called from. "
+                         "This includes the material model evaluations during assembly, and "
+                         "all calls the managers of heating models, boundary temperature, "
+                         "composition, and velocity models, initial temperature and "
+                         "composition models, postprocessors, visualization postprocessors, "
+                         "particle properties, and mesh refinement criteria make into their "
+                         "plugins, as well as the evaluation of boundary tractions and the "
+                         "update() functions of the gravity model and the adiabatic "
+                         "conditions. Visualization postprocessors that compute their output "
+                         "while the graphical output is built are recorded together in one "
+                         "region. The minimum, average, "
+                         "and maximum over all processes of the number of calls and the "
+                         "time spent in each region are written to a file in the output "
+                         "directory in regular intervals. Times of regions that are executed "
+                         "on several threads are summed over all threads. Since plugins "
+                         "such as boundary and initial conditions are called once per point, "
+                         "enabling profiling adds a measurable overhead to these calls.");
+      prm.declare_entry ("Record hardware counters", "false",
+                         Patterns::Bool (),
+                         "Whether to also record the number of CPU cycles, instructions, and "
+                         "cache misses spent in each region. This uses the perf\\_event "
+                         "interface of the Linux kernel and is therefore only available on "
+                         "Linux systems that allow users to read hardware counters (see "
+                         "/proc/sys/kernel/perf\\_event\\_paranoid).");
+      prm.declare_entry ("Output format", "json",
+                         Patterns::Selection ("json|chrome trace"),
+                         "The format of the profile files. `json' writes a list of all "
+                         "regions with their statistics. `chrome trace' writes the same "
+                         "information in the trace event format, in which the regions are "
+                         "shown as nested blocks whose length is the average time over all "
+                         "processes, and that can be viewed with chrome://tracing or "
+                         "other trace viewers.");
+      prm.declare_entry ("Output frequency", "10",
+                         Patterns::Integer (0),
+                         "How often, in time steps, to write the profile. The profile "
+                         "always contains the data accumulated since the start of the "
+                         "model run. If set to zero, the profile is only written at the "
+                         "end of the model run.");
+    }
+    prm.leave_subsection ();
+  }
+
+
+
+  void
+  Profiler::parse_parameters (ParameterHandler &prm,
+                              const std::string &output_directory,
+                              const MPI_Comm mpi_communicator)
+  {
+    prm.enter_subsection ("Profiling");
+    {
+      enabled                  = prm.get_bool ("Enable profiling");
+      record_hardware_counters = enabled && prm.get_bool ("Record hardware counters");
+      output_format            = (prm.get ("Output format") == "json" ? json : chrome_trace);
+      output_frequency         = prm.get_integer ("Output frequency");
+    }
+    prm.leave_subsection ();
+
+    this->output_directory = output_directory;
+    this->mpi_communicator = mpi_communicator;
+
+    if (record_hardware_counters)
+      {
+#ifdef __linux__
+        // test whether we can actually read the counters, to fail early
+        const int file_descriptor = open_hardware_counter (cpu_cycles);
+        AssertThrow (file_descriptor >= 0,
+                     ExcMessage ("You have asked to record hardware counters, but the "
+                                 "hardware counters could not be opened. This is usually "
+                                 "because /proc/sys/kernel/perf_event_paranoid does not "
+                                 "allow unprivileged users to read them, or because the "
+                                 "processor or virtual machine does not provide them."));
+        close (file_descriptor);
+#else
+        AssertThrow (false,
+                     ExcMessage ("Hardware counters can only be recorded on Linux systems."));
+#endif
+      }
+  }
+
+
+
+  bool
+  Profiler::is_enabled () const
+  {
+    return enabled;
+  }
+
+
+
+  void
+  Profiler::enter_region (const char *category,
+                          const char *name) const
+  {
+    ThreadData &data = thread_data.get();
+    if (!data.registered)
+      {
+        std::lock_guard<std::mutex> lock (all_thread_data_mutex);
+        all_thread_data.push_back (&data);
+        data.registered = true;
+      }
+
+    const bool on_main_thread = (std::this_thread::get_id() == main_thread_id);
+
+    Frame frame;
+    if (!data.open_regions.empty())
+      frame.path = data.open_regions.back().path;
+    else if (!on_main_thread)
+      frame.path = get_main_thread_path();
+
+    if (!frame.path.empty())
+      frame.path += '/';
+    if (category != nullptr)
+      {
+        frame.path += category;
+        frame.path += ": ";
+      }
+    frame.path += name;
+
+    if (record_hardware_counters)
+      read_counters (data, frame.start_counters);
+
+    if (on_main_thread)
+      {
+        std::lock_guard<std::mutex> lock (main_thread_mutex);
+        main_thread_path = frame.path;
+      }
+
+    // start the clock as late as possible to not measure our own overhead
+    frame.start_time = std::chrono::steady_clock::now();
+    data.open_regions.push_back (std::move(frame));
+  }
+
+
+
+  void
+  Profiler::leave_region () const
+  {
+    const std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+    ThreadData &data = thread_data.get();
+    Assert (!data.open_regions.empty(),
+            ExcMessage ("There is no open region that could be closed."));
+
+    const Frame &frame = data.open_regions.back();
+    Measurement &measurement = data.measurements[frame.path];
+
+    ++measurement.n_calls;
+    measurement.wall_time += std::chrono::duration<double>(end_time - frame.start_time).count();
+
+    if (record_hardware_counters)
+      {
+        std::array<long long int,n_counters> end_counters;
+        read_counters (data, end_counters);
+        for (unsigned int c=0; c<n_counters; ++c)
+          measurement.counters[c] += end_counters[c] - frame.start_counters[c];
+      }
+
+    data.open_regions.pop_back();
+
+    if (std::this_thread::get_id() == main_thread_id)
+      {
+        std::lock_guard<std::mutex> lock (main_thread_mutex);
+        main_thread_path = (data.open_regions.empty()
+                            ?
+                            std::string()
+                            :
+                            data.open_regions.back().path);
+      }
+  }
+
+
+
+  void
+  Profiler::read_counters (ThreadData &thread_data,
+                           std::array<long long int,n_counters> &values) const
+  {
+    values.fill (0);
+
+#ifdef __linux__
+    // hardware counters are specific to a thread, so every thread needs
+    // to open its own set of counters
+    if (!thread_data.counters_initialized)
+      {
+        for (unsigned int c=0; c<n_counters; ++c)
+          thread_data.counter_file_descriptors[c] = open_hardware_counter (c);
+        thread_data.counters_initialized = true;
+      }
+
+    for (unsigned int c=0; c<n_counters; ++c)
+      if (thread_data.counter_file_descriptors[c] >= 0)
+        {
+          long long int value = 0;
+          if (read (thread_data.counter_file_descriptors[c], &value, sizeof(value)) == sizeof(value))
+            values[c] = value;
+        }
+#else
+    (void)thread_data;
+#endif
+  }
+
+
+
+  std::string
+  Profiler::get_main_thread_path () const
+  {
+    std::lock_guard<std::mutex> lock (main_thread_mutex);
+    return main_thread_path;
+  }
+
+
+
+  void
+  Profiler::maybe_write_profile (const unsigned int timestep_number,
+                                 const bool force_output) const
+  {
+    if (!enabled)
+      return;
+
+    if (!force_output
+        &&
+        (output_frequency == 0 || timestep_number % output_frequency != 0))
+      return;
+
+    // first combine the data of all threads of this process
+    std::map<std::string,Measurement> local_measurements;
+    {
+      std::lock_guard<std::mutex> lock (all_thread_data_mutex);
+      for (const ThreadData *data : all_thread_data)
+        for (const auto &measurement : data->measurements)
+          {
+            Measurement &combined = local_measurements[measurement.first];
+            combined.n_calls += measurement.second.n_calls;
+            combined.wall_time += measurement.second.wall_time;
+            for (unsigned int c=0; c<n_counters; ++c)
+              combined.counters[c] += measurement.second.counters[c];
+          }
+    }
+
+    // then find the union of all regions of all processes. different
+    // processes may have entered different regions, e.g. if some of them
+    // do not own any particles
+    const unsigned int my_rank = Utilities::MPI::this_mpi_process (mpi_communicator);
+    const unsigned int n_processes = Utilities::MPI::n_mpi_processes (mpi_communicator);
+
+    std::vector<std::string> paths;
+    {
+      std::string local_paths;
+      for (const auto &measurement : local_measurements)
+        local_paths += measurement.first + '\n';
+
+      const int local_length = local_paths.size();
+      std::vector<int> lengths (n_processes);
+      MPI_Gather (&local_length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, mpi_communicator);
+
+      std::vector<int> offsets (n_processes, 0);
+      for (unsigned int p=1; p<n_processes; ++p)
+        offsets[p] = offsets[p-1] + lengths[p-1];
+
+      std::vector<char> all_paths (my_rank == 0 ? offsets.back() + lengths.back() : 0);
+      MPI_Gatherv (const_cast<char *>(local_paths.data()), local_length, MPI_CHAR,
+                   all_paths.data(), lengths.data(), offsets.data(), MPI_CHAR,
+                   0, mpi_communicator);
+
+      std::string unique_paths;
+      if (my_rank == 0)
+        {
+          std::set<std::string> path_set;
+          std::string::size_type begin = 0;
+          const std::string all_paths_string (all_paths.begin(), all_paths.end());
+          while (begin < all_paths_string.size())
+            {
+              const std::string::size_type end = all_paths_string.find ('\n', begin);
+              path_set.insert (all_paths_string.substr (begin, end-begin));
+              begin = end + 1;
+            }
+          for (const std::string &path : path_set)
+            unique_paths += path + '\n';
+        }
+
+      int unique_length = unique_paths.size();
+      MPI_Bcast (&unique_length, 1, MPI_INT, 0, mpi_communicator);
+      unique_paths.resize (unique_length);
+      MPI_Bcast (&unique_paths[0], unique_length, MPI_CHAR, 0, mpi_communicator);
+
+      std::string::size_type begin = 0;
+      while (begin < unique_paths.size())
+        {
+          const std::string::size_type end = unique_paths.find ('\n', begin);
+          paths.push_back (unique_paths.substr (begin, end-begin));
+          begin = end + 1;
+        }
+    }
+
+    // now compute the minimum, maximum, and sum over all processes of
+    // the number of calls, the wall time, and the hardware counters of
+    // every region
+    const unsigned int n_values = 2 + n_counters;
+    std::vector<double> local_values (paths.size() * n_values, 0.0);
+    for (unsigned int i=0; i<paths.size(); ++i)
+      {
+        const auto measurement = local_measurements.find (paths[i]);
+        if (measurement != local_measurements.end())
+          {
+            local_values[i*n_values]   = measurement->second.n_calls;
+            local_values[i*n_values+1] = measurement->second.wall_time;
+            for (unsigned int c=0; c<n_counters; ++c)
+              local_values[i*n_values+2+c] = measurement->second.counters[c];
+          }
+      }
+
+    std::vector<double> min_values (local_values.size());
+    std::vector<double> max_values (local_values.size());
+    std::vector<double> sum_values (local_values.size());
+    MPI_Reduce (local_values.data(), min_values.data(), local_values.size(), MPI_DOUBLE, MPI_MIN, 0, mpi_communicator);
+    MPI_Reduce (local_values.data(), max_values.data(), local_values.size(), MPI_DOUBLE, MPI_MAX, 0, mpi_communicator);
+    MPI_Reduce (local_values.data(), sum_values.data(), local_values.size(), MPI_DOUBLE, MPI_SUM, 0, mpi_communicator);
+
+    if (my_rank != 0)
+      return;
+
+    const std::string filename = output_directory
+                                 + "profile-"
+                                 + Utilities::int_to_string (timestep_number, 5)
+                                 + (output_format == json ? ".json" : ".trace.json");
+    std::ofstream out (filename.c_str());
+    AssertThrow (out,
+                 ExcMessage ("Could not open the file <" + filename + "> for writing."));
+    out.precision (10);
+
+    // write the minimum, average, and maximum of one value as a JSON object
+    auto write_statistics = [&] (const unsigned int i, const unsigned int value)
+    {
+      out << "{\"min\": " << min_values[i*n_values+value]
+          << ", \"avg\": " << sum_values[i*n_values+value] / n_processes
+          << ", \"max\": " << max_values[i*n_values+value] << "}";
+    };
+
+    if (output_format == json)
+      {
+        out << "{\n"
+            << "  \"timestep\": " << timestep_number << ",\n"
+            << "  \"n_processes\": " << n_processes << ",\n"
+            << "  \"wall_time_since_start\": "
+            << std::chrono::duration<double>(std::chrono::steady_clock::now() - creation_time).count() << ",\n"
+            << "  \"regions\": [";
+
+        for (unsigned int i=0; i<paths.size(); ++i)
+          {
+            out << (i == 0 ? "\n" : ",\n")
+                << "    {\"path\": \"" << escape_json (paths[i])
+                << "\", \"name\": \"" << escape_json (region_name (paths[i]))
+                << "\", \"depth\": " << std::count (paths[i].begin(), paths[i].end(), '/')
+                << ",\n     \"calls\": ";
+            write_statistics (i, 0);
+            out << ",\n     \"wall_time\": ";
+            write_statistics (i, 1);
+            if (record_hardware_counters)
+              for (unsigned int c=0; c<n_counters; ++c)
+                {
+                  out << ",\n     \"" << counter_names[c] << "\": ";
+                  write_statistics (i, 2+c);
+                }
+            out << "}";
+          }
+        out << "\n  ]\n}\n";
+      }
+    else
+      {
+        // lay out the regions as nested blocks: every region starts where
+        // the previous region with the same parent ended, and the first
+        // child of a region starts where its parent starts. the paths are
+        // sorted, so parents always come before their children.
+        std::map<std::string,double> next_start_time;
+        next_start_time[""] = 0;
+
+        out << "{\"displayTimeUnit\": \"ms\",\n"
+            << " \"traceEvents\": [";
+        for (unsigned int i=0; i<paths.size(); ++i)
+          {
+            const double duration = sum_values[i*n_values+1] / n_processes * 1e6;
+            const std::string parent = parent_path (paths[i]);
+            const double start_time = next_start_time[parent];
+            next_start_time[parent] += duration;
+            next_start_time[paths[i]] = start_time;
+
+            out << (i == 0 ? "\n" : ",\n")
+                << "  {\"name\": \"" << escape_json (region_name (paths[i]))
+                << "\", \"cat\": \"aspect\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0"
+                << ", \"ts\": " << start_time
+                << ", \"dur\": " << duration
+                << ", \"args\": {\"path\": \"" << escape_json (paths[i]) << "\", \"calls\": ";
+            write_statistics (i, 0);
+            out << ", \"wall_time\": ";
+            write_statistics (i, 1);
+            if (record_hardware_counters)
+              for (unsigned int c=0; c<n_counters; ++c)
+                {
+                  out << ", \"" << counter_names[c] << "\": ";
+                  write_statistics (i, 2+c);
+                }
+            out << "}}";
+          }
+        out << "\n ]\n}\n";
+      }
+  }
+}
@@ -0,0 +1,214 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <aspect/quadrature_point_geometry.h>
+#include <aspect/geometry_model/interface.h>
+#include <aspect/gravity_model/interface.h>
+#include <aspect/adiabatic_conditions/interface.h>
+#include <aspect/utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <set>
+
+
+namespace aspect
+{
+  template <int dim>
+  QuadraturePointGeometry<dim>::QuadraturePointGeometry ()
+    :
+    enabled (false)
+  {}
+
+
+
+  template <int dim>
+  void
+  QuadraturePointGeometry<dim>::declare_parameters (ParameterHandler &prm)
+  {
+    prm.declare_entry ("Cache quadrature point geometry", "false",
+                       Patterns::Bool (),
+                       "Whether to compute the depth, the spherical coordinates, "
+                       "the gravity vector, and the adiabatic temperature and "
+                       "pressure at the quadrature points used to assemble the "
+                       "Stokes and advection systems once per time step, and to "
+                       "store them, so that plugins evaluated at these points "
+                       "(e.g., material and heating models) can look them up "
+                       "instead of computing them again. This costs memory for "
+                       "about a dozen numbers per quadrature point, and only "
+                       "saves time if the plugins used in the model make use "
+                       "of the stored values.");
+  }
+
+
+
+  template <int dim>
+  void
+  QuadraturePointGeometry<dim>::parse_parameters (ParameterHandler &prm)
+  {
+    enabled = prm.get_bool ("Cache quadrature point geometry");
+  }
+
+
+
+  template <int dim>
+  bool
+  QuadraturePointGeometry<dim>::is_enabled () const
+  {
+    return enabled;
+  }
+
+
+
+  template <int dim>
+  void
+  QuadraturePointGeometry<dim>::clear ()
+  {
+    quadrature_data.clear ();
+  }
+
+
+
+  template <int dim>
+  void
+  QuadraturePointGeometry<dim>::compute_positions ()
+  {
+    const Parameters<dim> &parameters = this->get_parameters();
+
+    // the quadrature degrees the Stokes and advection systems are assembled
+    // with, see the assemble_*_system() functions
+    std::set<unsigned int> quadrature_degrees;
+    quadrature_degrees.insert (parameters.stokes_velocity_degree+1);
+    quadrature_degrees.insert (parameters.temperature_degree + (parameters.stokes_velocity_degree+1)/2);
+    if (this->n_compositional_fields() > 0)
+      quadrature_degrees.insert (parameters.composition_degree + (parameters.stokes_velocity_degree+1)/2);
+
+    quadrature_data.clear ();
+    for (const unsigned int degree : quadrature_degrees)
+      {
+        QuadratureData data;
+        data.quadrature = QGauss<dim>(degree);
+
+        const unsigned int n_q_points = data.quadrature.size();
+        data.points.resize (this->get_triangulation().n_active_cells() * n_q_points);
+
+        FEValues<dim> fe_values (this->get_mapping(),
+                                 this->get_fe(),
+                                 data.quadrature,
+                                 update_quadrature_points);
+
+        for (const auto &cell : this->get_dof_handler().active_cell_iterators())
+          if (cell->is_locally_owned())
+            {
+              fe_values.reinit (cell);
+              for (unsigned int q=0; q<n_q_points; ++q)
+                {
+                  PointData &point = data.points[cell->active_cell_index() * n_q_points + q];
+                  point.position = fe_values.quadrature_point(q);
+                  point.depth = this->get_geometry_model().depth(point.position);
+                  point.spherical_coordinates = Utilities::Coordinates::cartesian_to_spherical_coordinates(point.position);
+                }
+            }
+
+        quadrature_data.push_back (data);
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  QuadraturePointGeometry<dim>::update ()
+  {
+    if (!enabled)
+      return;
+
+    // the positions only change with the mesh, unless the mesh is deformed
+    if (quadrature_data.empty() || this->get_parameters().free_surface_enabled)
+      compute_positions ();
+
+    for (auto &data : quadrature_data)
+      {
+        const unsigned int n_q_points = data.quadrature.size();
+
+        for (const auto &cell : this->get_triangulation().active_cell_iterators())
+          if (cell->is_locally_owned())
+            for (unsigned int q=0; q<n_q_points; ++q)
+              {
+                PointData &point = data.points[cell->active_cell_index() * n_q_points + q];
+                point.gravity = this->get_gravity_model().gravity_vector(point.position);
+                point.adiabatic_temperature = this->get_adiabatic_conditions().temperature(point.position);
+                point.adiabatic_pressure = this->get_adiabatic_conditions().pressure(point.position);
+              }
+      }
+  }
+
+
+
+  template <int dim>
+  const typename QuadraturePointGeometry<dim>::PointData *
+  QuadraturePointGeometry<dim>::get_point_data (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                                                const unsigned int q,
+                                                const Point<dim> &position) const
+  {
+    if (quadrature_data.empty()
+        ||
+        cell.state() != IteratorState::valid
+        ||
+        !cell->is_locally_owned())
+      return nullptr;
+
+    // we do not know which quadrature formula the caller uses, but the
+    // position identifies the point uniquely
+    for (const auto &data : quadrature_data)
+      if (q < data.quadrature.size())
+        {
+          const std::size_t index = cell->active_cell_index() * data.quadrature.size() + q;
+          if (index < data.points.size()
+              &&
+              data.points[index].position == position)
+            return &data.points[index];
+        }
+
+    return nullptr;
+  }
+
+
+
+  template <int dim>
+  const typename QuadraturePointGeometry<dim>::PointData *
+  QuadraturePointGeometry<dim>::get_point_data (const MaterialModel::MaterialModelInputs<dim> &in,
+                                                const unsigned int q) const
+  {
+    return get_point_data (in.current_cell, q, in.position[q]);
+  }
+}
+
+
+// explicit instantiation of the functions we implement in this file
+namespace aspect
+{
+#define INSTANTIATE(dim) \
+  template class QuadraturePointGeometry<dim>;
+
+  ASPECT_INSTANTIATE(INSTANTIATE)
+}
@@ -692,6 +692,27 @@ namespace aspect
     return simulator->lateral_averaging;
   }
 
+  template <int dim>
+  const QuadraturePointGeometry<dim> &
+  SimulatorAccess<dim>::get_quadrature_point_geometry() const
+  {
+    return simulator->quadrature_point_geometry;
+  }
+
+  template <int dim>
+  const CellLocator<dim> &
+  SimulatorAccess<dim>::get_cell_locator() const
+  {
+    return simulator->cell_locator;
+  }
+
+  template <int dim>
+  const Profiler &
+  SimulatorAccess<dim>::get_profiler() const
+  {
+    return simulator->profiler;
+  }
+
   template <int dim>
   const ConstraintMatrix &
   SimulatorAccess<dim>::get_current_constraints() const
@@ -0,0 +1,111 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <aspect/simulator/single_precision_ilu.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+
+namespace aspect
+{
+  void
+  SinglePrecisionILU::initialize (const LinearAlgebra::SparseMatrix &matrix)
+  {
+    clear ();
+
+    const std::pair<types::global_dof_index,types::global_dof_index> range = matrix.local_range();
+    const unsigned int n_local_rows = range.second - range.first;
+
+    // first find out which entries of the locally owned rows couple
+    // with other locally owned rows ...
+    DynamicSparsityPattern dsp (n_local_rows, n_local_rows);
+    for (types::global_dof_index row=range.first; row<range.second; ++row)
+      for (LinearAlgebra::SparseMatrix::const_iterator entry = matrix.begin(row);
+           entry != matrix.end(row); ++entry)
+        if (entry->column() >= range.first && entry->column() < range.second)
+          dsp.add (row - range.first, entry->column() - range.first);
+
+    // ... then copy these entries into a single precision matrix
+    // and decompose it. the decomposition stores its own copy of the
+    // entries, so the matrix is released at the end of this function
+    sparsity_pattern.copy_from (dsp);
+    SparseMatrix<float> local_matrix (sparsity_pattern);
+    for (types::global_dof_index row=range.first; row<range.second; ++row)
+      for (LinearAlgebra::SparseMatrix::const_iterator entry = matrix.begin(row);
+           entry != matrix.end(row); ++entry)
+        if (entry->column() >= range.first && entry->column() < range.second)
+          local_matrix.set (row - range.first,
+                            entry->column() - range.first,
+                            static_cast<float>(entry->value()));
+
+    decomposition.initialize (local_matrix);
+
+    local_src.reinit (n_local_rows);
+    local_dst.reinit (n_local_rows);
+  }
+
+
+
+  void
+  SinglePrecisionILU::vmult (LinearAlgebra::Vector       &dst,
+                             const LinearAlgebra::Vector &src) const
+  {
+    Assert (src.local_size() == local_src.size(),
+            ExcDimensionMismatch (src.local_size(), local_src.size()));
+    Assert (dst.local_size() == local_dst.size(),
+            ExcDimensionMismatch (dst.local_size(), local_dst.size()));
+
+#ifdef ASPECT_USE_PETSC
+    const PetscScalar *src_values;
+    PetscErrorCode ierr = VecGetArrayRead (src, &src_values);
+    AssertThrow (ierr == 0, ExcPETScError(ierr));
+    std::copy (src_values, src_values + local_src.size(), local_src.begin());
+    ierr = VecRestoreArrayRead (src, &src_values);
+    AssertThrow (ierr == 0, ExcPETScError(ierr));
+#else
+    std::copy (src.begin(), src.end(), local_src.begin());
+#endif
+
+    decomposition.vmult (local_dst, local_src);
+
+#ifdef ASPECT_USE_PETSC
+    PetscScalar *dst_values;
+    ierr = VecGetArray (dst, &dst_values);
+    AssertThrow (ierr == 0, ExcPETScError(ierr));
+    std::copy (local_dst.begin(), local_dst.end(), dst_values);
+    ierr = VecRestoreArray (dst, &dst_values);
+    AssertThrow (ierr == 0, ExcPETScError(ierr));
+#else
+    std::copy (local_dst.begin(), local_dst.end(), dst.begin());
+#endif
+  }
+
+
+
+  void
+  SinglePrecisionILU::clear ()
+  {
+    decomposition.clear ();
+    sparsity_pattern.reinit (0, 0, 0);
+    local_src.reinit (0);
+    local_dst.reinit (0);
+  }
+}
@@ -22,9 +22,12 @@
 #include <aspect/simulator.h>
 #include <aspect/global.h>
 #include <aspect/melt.h>
+#include <aspect/newton.h>
 
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/vector.h>
 
 #ifdef ASPECT_USE_PETSC
 #include <deal.II/lac/solver_cg.h>
@@ -36,6 +39,8 @@
 
 #include <deal.II/fe/fe_values.h>
 
+#include <numeric>
+
 namespace aspect
 {
   namespace internal
@@ -56,9 +61,15 @@ namespace aspect
         StokesBlock (const LinearAlgebra::BlockSparseMatrix  &S)
           : system_matrix(S) {}
 
+        /**
+         * Destructor.
+         */
+        virtual ~StokesBlock () {}
+
         /**
          * Matrix vector product with Stokes block.
          */
+        virtual
         void vmult (LinearAlgebra::BlockVector       &dst,
                     const LinearAlgebra::BlockVector &src) const;
 
@@ -169,6 +180,332 @@ namespace aspect
     }
 
 
+    /**
+     * Implement multiplication with the Jacobian of the Newton Stokes system
+     * in the Jacobian-free Newton-Krylov method. The product is computed by
+     * a function object, typically one that evaluates finite differences of
+     * the Newton residual. All other functions of the base class still use
+     * the assembled system matrix.
+     */
+    class JacobianFreeStokesBlock : public StokesBlock
+    {
+      public:
+        /**
+         * @brief Constructor
+         *
+         * @param S The entire system matrix
+         * @param jacobian_product The function that computes the product of
+         * the Jacobian with its second argument and stores it in its first
+         * argument
+         */
+        JacobianFreeStokesBlock (const LinearAlgebra::BlockSparseMatrix  &S,
+                                 const std::function<void (LinearAlgebra::BlockVector &,
+                                                           const LinearAlgebra::BlockVector &)> &jacobian_product)
+          : StokesBlock(S),
+            jacobian_product(jacobian_product) {}
+
+        /**
+         * Matrix vector product with the Jacobian.
+         */
+        virtual
+        void vmult (LinearAlgebra::BlockVector       &dst,
+                    const LinearAlgebra::BlockVector &src) const
+        {
+          jacobian_product (dst, src);
+        }
+
+      private:
+        /**
+         * The function that computes the product with the Jacobian.
+         */
+        const std::function<void (LinearAlgebra::BlockVector &,
+                                  const LinearAlgebra::BlockVector &)> jacobian_product;
+    };
+
+
+    /**
+     * Return the inner product of the locally owned parts of the two
+     * vectors @p a and @p b, i.e., the contribution of this process to
+     * the global inner product.
+     */
+    double
+    local_inner_product (const LinearAlgebra::Vector &a,
+                         const LinearAlgebra::Vector &b)
+    {
+      Assert (a.local_size() == b.local_size(),
+              ExcDimensionMismatch (a.local_size(), b.local_size()));
+#ifdef ASPECT_USE_PETSC
+      const PetscScalar *a_values, *b_values;
+      PetscErrorCode ierr = VecGetArrayRead (a, &a_values);
+      AssertThrow (ierr == 0, ExcPETScError(ierr));
+      ierr = VecGetArrayRead (b, &b_values);
+      AssertThrow (ierr == 0, ExcPETScError(ierr));
+
+      const double result = std::inner_product (a_values, a_values + a.local_size(), b_values, 0.0);
+
+      ierr = VecRestoreArrayRead (a, &a_values);
+      AssertThrow (ierr == 0, ExcPETScError(ierr));
+      ierr = VecRestoreArrayRead (b, &b_values);
+      AssertThrow (ierr == 0, ExcPETScError(ierr));
+
+      return result;
+#else
+      return std::inner_product (a.begin(), a.end(), b.begin(), 0.0);
+#endif
+    }
+
+
+
+    double
+    local_inner_product (const LinearAlgebra::BlockVector &a,
+                         const LinearAlgebra::BlockVector &b)
+    {
+      double result = 0;
+      for (unsigned int block=0; block<a.n_blocks(); ++block)
+        result += local_inner_product (a.block(block), b.block(block));
+      return result;
+    }
+
+
+
+    /**
+     * Solve the linear system $Ax=b$ with the pipelined preconditioned
+     * conjugate gradient method of Ghysels and Vanroose (2014). The method
+     * is mathematically equivalent to the classical preconditioned CG
+     * method, but combines the three inner products of each iteration into
+     * a single non-blocking global reduction, and uses the time until the
+     * reduction has finished to apply the preconditioner and the matrix
+     * for the next iteration. In exchange, it needs a few more vectors and
+     * vector updates per iteration.
+     *
+     * Convergence is determined from the norm of the unpreconditioned
+     * residual. If the method does not converge, a
+     * SolverControl::NoConvergence exception is thrown, like in the
+     * solvers of deal.II.
+     */
+    template <class MatrixType, class PreconditionerType>
+    void
+    solve_with_pipelined_cg (const MatrixType            &A,
+                             LinearAlgebra::Vector       &x,
+                             const LinearAlgebra::Vector &b,
+                             const PreconditionerType    &preconditioner,
+                             SolverControl               &solver_control)
+    {
+      const MPI_Comm mpi_communicator = b.get_mpi_communicator();
+
+      // r is the residual, u the preconditioned residual, and w=Au. all
+      // other vectors are the auxiliary vectors of the pipelined method,
+      // see Algorithm 4 of Ghysels and Vanroose (2014)
+      LinearAlgebra::Vector r(b), u(b), w(b), m(b), n(b);
+      LinearAlgebra::Vector z(b), q(b), s(b), p(b);
+      z = 0;
+      q = 0;
+      s = 0;
+      p = 0;
+
+      A.vmult (r, x);
+      r.sadd (-1., 1., b);
+      preconditioner.vmult (u, r);
+      A.vmult (w, u);
+
+      double previous_gamma = 0;
+      double previous_alpha = 0;
+      for (unsigned int iteration=0; ; ++iteration)
+        {
+          // start the reduction of (r,u), (w,u), and (r,r) ...
+          double inner_products[3] = {local_inner_product (r, u),
+                                      local_inner_product (w, u),
+                                      local_inner_product (r, r)
+                                     };
+          MPI_Request request;
+          int ierr = MPI_Iallreduce (MPI_IN_PLACE, inner_products, 3, MPI_DOUBLE, MPI_SUM,
+                                     mpi_communicator, &request);
+          AssertThrowMPI (ierr);
+
+          // ... and overlap it with the application of the
+          // preconditioner and the matrix
+          preconditioner.vmult (m, w);
+          A.vmult (n, m);
+
+          ierr = MPI_Wait (&request, MPI_STATUS_IGNORE);
+          AssertThrowMPI (ierr);
+
+          const double gamma = inner_products[0];
+          const double delta = inner_products[1];
+          const double residual_norm = std::sqrt (inner_products[2]);
+
+          const SolverControl::State state = solver_control.check (iteration, residual_norm);
+          if (state == SolverControl::success)
+            return;
+          else if (state == SolverControl::failure)
+            throw SolverControl::NoConvergence (iteration, residual_norm);
+
+          const double beta = (iteration == 0 ? 0. : gamma / previous_gamma);
+          const double alpha = (iteration == 0
+                                ?
+                                gamma / delta
+                                :
+                                gamma / (delta - beta * gamma / previous_alpha));
+
+          AssertThrow (numbers::is_finite (alpha) && numbers::is_finite (beta),
+                       ExcMessage ("The pipelined CG method broke down."));
+
+          z.sadd (beta, 1., n);
+          q.sadd (beta, 1., m);
+          s.sadd (beta, 1., w);
+          p.sadd (beta, 1., u);
+
+          x.add (alpha, p);
+          r.add (-alpha, s);
+          u.add (-alpha, q);
+          w.add (-alpha, z);
+
+          previous_gamma = gamma;
+          previous_alpha = alpha;
+        }
+    }
+
+
+
+    /**
+     * Solve the linear system $Ax=b$ with a restarted, flexible GMRES method
+     * that uses classical instead of modified Gram-Schmidt
+     * orthogonalization. The inner products of a new basis vector with all
+     * previous basis vectors and with itself are computed in a single
+     * global reduction, and the norm of the orthogonalized vector is
+     * computed from them with the Pythagorean theorem. If this indicates a
+     * loss of orthogonality (because the norm of the vector decreased by
+     * more than a factor of $\sqrt 2$), the orthogonalization is repeated
+     * once. Consequently, the method needs one or two global reductions per
+     * iteration, instead of one per basis vector.
+     *
+     * As in deal.II's SolverFGMRES, @p max_basis_size is the number of
+     * iterations after which the method is restarted.
+     */
+    template <class MatrixType, class PreconditionerType>
+    void
+    solve_with_single_reduction_fgmres (const MatrixType                 &A,
+                                        LinearAlgebra::BlockVector       &x,
+                                        const LinearAlgebra::BlockVector &b,
+                                        const PreconditionerType         &preconditioner,
+                                        SolverControl                    &solver_control,
+                                        const unsigned int                max_basis_size)
+    {
+      const MPI_Comm mpi_communicator = b.block(0).get_mpi_communicator();
+
+      std::vector<LinearAlgebra::BlockVector> basis (max_basis_size+1);
+      std::vector<LinearAlgebra::BlockVector> preconditioned_basis (max_basis_size);
+      LinearAlgebra::BlockVector w (b);
+
+      FullMatrix<double> H (max_basis_size+1, max_basis_size);
+      Vector<double> g (max_basis_size+1);
+      Vector<double> givens_cos (max_basis_size), givens_sin (max_basis_size);
+      std::vector<double> inner_products (max_basis_size+1);
+
+      unsigned int iteration = 0;
+      while (true)
+        {
+          // compute the residual and start a new Krylov space
+          A.vmult (w, x);
+          w.sadd (-1., 1., b);
+          const double residual_norm = w.l2_norm();
+
+          SolverControl::State state = solver_control.check (iteration, residual_norm);
+          if (state == SolverControl::success)
+            return;
+          else if (state == SolverControl::failure)
+            throw SolverControl::NoConvergence (iteration, residual_norm);
+
+          if (basis[0].n_blocks() == 0)
+            basis[0].reinit (b);
+          basis[0].equ (1./residual_norm, w);
+          H = 0;
+          g = 0;
+          g(0) = residual_norm;
+
+          unsigned int k = 0;
+          for (; k<max_basis_size; ++k)
+            {
+              if (preconditioned_basis[k].n_blocks() == 0)
+                preconditioned_basis[k].reinit (b);
+              preconditioner.vmult (preconditioned_basis[k], basis[k]);
+              A.vmult (w, preconditioned_basis[k]);
+
+              // orthogonalize w against all basis vectors, at most twice
+              double norm_squared = 0;
+              for (unsigned int pass=0; pass<2; ++pass)
+                {
+                  for (unsigned int i=0; i<=k; ++i)
+                    inner_products[i] = local_inner_product (basis[i], w);
+                  inner_products[k+1] = local_inner_product (w, w);
+                  const int ierr = MPI_Allreduce (MPI_IN_PLACE, inner_products.data(), k+2,
+                                                  MPI_DOUBLE, MPI_SUM, mpi_communicator);
+                  AssertThrowMPI (ierr);
+
+                  const double norm_squared_before = inner_products[k+1];
+                  norm_squared = norm_squared_before;
+                  for (unsigned int i=0; i<=k; ++i)
+                    {
+                      w.add (-inner_products[i], basis[i]);
+                      H(i,k) += inner_products[i];
+                      norm_squared -= inner_products[i] * inner_products[i];
+                    }
+
+                  if (norm_squared > 0.5 * norm_squared_before)
+                    break;
+                }
+              const double norm = std::sqrt (std::max (norm_squared, 0.));
+              H(k+1,k) = norm;
+
+              // apply the previous Givens rotations to the new column of H,
+              // then compute and apply the one that eliminates H(k+1,k)
+              for (unsigned int i=0; i<k; ++i)
+                {
+                  const double h_i = H(i,k);
+                  H(i,k)   =  givens_cos(i) * h_i + givens_sin(i) * H(i+1,k);
+                  H(i+1,k) = -givens_sin(i) * h_i + givens_cos(i) * H(i+1,k);
+                }
+              const double denominator = std::sqrt (H(k,k) * H(k,k) + norm * norm);
+              givens_cos(k) = H(k,k) / denominator;
+              givens_sin(k) = norm / denominator;
+              H(k,k) = denominator;
+              H(k+1,k) = 0;
+              g(k+1) = -givens_sin(k) * g(k);
+              g(k)   =  givens_cos(k) * g(k);
+
+              ++iteration;
+              state = solver_control.check (iteration, std::fabs (g(k+1)));
+              if (state != SolverControl::iterate || norm == 0)
+                {
+                  ++k;
+                  break;
+                }
+
+              if (basis[k+1].n_blocks() == 0)
+                basis[k+1].reinit (b);
+              basis[k+1].equ (1./norm, w);
+            }
+
+          // solve the upper triangular least squares problem and update
+          // the solution with the preconditioned basis vectors
+          for (int i=static_cast<int>(k)-1; i>=0; --i)
+            {
+              double y = g(i);
+              for (unsigned int j=i+1; j<k; ++j)
+                y -= H(i,j) * g(j);
+              g(i) = y / H(i,i);
+              x.add (g(i), preconditioned_basis[i]);
+            }
+
+          if (state == SolverControl::success)
+            return;
+          else if (state == SolverControl::failure)
+            throw SolverControl::NoConvergence (solver_control.last_step(),
+                                                solver_control.last_value());
+        }
+    }
+
+
     /**
      * Implement the block Schur preconditioner for the Stokes system.
      */
@@ -184,7 +521,8 @@ namespace aspect
          *     the preconditioning of the Stokes matrix, i.e. containing approximations
          *     of the A and S blocks.
          * @param Mppreconditioner Preconditioner object for the Schur complement,
-         *     typically chosen as the mass matrix.
+         *     typically chosen as the mass matrix. May be a null pointer if
+         *     @p Mppreconditioner_single_precision is given instead.
          * @param Apreconditioner Preconditioner object for the matrix A.
          * @param do_solve_A A flag indicating whether we should actually solve with
          *     the matrix $A$, or only apply one preconditioner step with it.
@@ -192,14 +530,21 @@ namespace aspect
          *     the inverse of the A block.
          * @param S_block_tolerance The tolerance for the CG solver which computes
          *     the inverse of the S block (Schur complement matrix).
+         * @param use_pipelined_cg Whether to use the pipelined CG method instead
+         *     of the classical one for the inverses of the A and S blocks.
+         * @param Mppreconditioner_single_precision A single precision
+         *     preconditioner for the Schur complement that is used instead of
+         *     @p Mppreconditioner if it is not a null pointer.
          **/
         BlockSchurPreconditioner (const LinearAlgebra::BlockSparseMatrix  &S,
                                   const LinearAlgebra::BlockSparseMatrix  &Spre,
-                                  const PreconditionerMp                     &Mppreconditioner,
+                                  const PreconditionerMp                     *Mppreconditioner,
                                   const PreconditionerA                      &Apreconditioner,
                                   const bool                                  do_solve_A,
                                   const double                                A_block_tolerance,
-                                  const double                                S_block_tolerance);
+                                  const double                                S_block_tolerance,
+                                  const bool                                  use_pipelined_cg = false,
+                                  const SinglePrecisionILU                   *Mppreconditioner_single_precision = nullptr);
 
         /**
          * Matrix vector product with this preconditioner object.
@@ -216,8 +561,9 @@ namespace aspect
          */
         const LinearAlgebra::BlockSparseMatrix &stokes_matrix;
         const LinearAlgebra::BlockSparseMatrix &stokes_preconditioner_matrix;
-        const PreconditionerMp                    &mp_preconditioner;
+        const PreconditionerMp                    *mp_preconditioner;
         const PreconditionerA                     &a_preconditioner;
+        const SinglePrecisionILU                  *mp_preconditioner_single_precision;
 
         /**
          * Whether to actually invert the $\tilde A$ part of the preconditioner matrix
@@ -228,6 +574,7 @@ namespace aspect
         mutable unsigned int n_iterations_S_;
         const double A_block_tolerance;
         const double S_block_tolerance;
+        const bool use_pipelined_cg;
     };
 
 
@@ -235,22 +582,30 @@ namespace aspect
     BlockSchurPreconditioner<PreconditionerA, PreconditionerMp>::
     BlockSchurPreconditioner (const LinearAlgebra::BlockSparseMatrix  &S,
                               const LinearAlgebra::BlockSparseMatrix  &Spre,
-                              const PreconditionerMp                     &Mppreconditioner,
+                              const PreconditionerMp                     *Mppreconditioner,
                               const PreconditionerA                      &Apreconditioner,
                               const bool                                  do_solve_A,
                               const double                                A_block_tolerance,
-                              const double                                S_block_tolerance)
+                              const double                                S_block_tolerance,
+                              const bool                                  use_pipelined_cg,
+                              const SinglePrecisionILU                   *Mppreconditioner_single_precision)
       :
       stokes_matrix     (S),
       stokes_preconditioner_matrix     (Spre),
       mp_preconditioner (Mppreconditioner),
       a_preconditioner  (Apreconditioner),
+      mp_preconditioner_single_precision (Mppreconditioner_single_precision),
       do_solve_A        (do_solve_A),
       n_iterations_A_(0),
       n_iterations_S_(0),
       A_block_tolerance(A_block_tolerance),
-      S_block_tolerance(S_block_tolerance)
-    {}
+      S_block_tolerance(S_block_tolerance),
+      use_pipelined_cg(use_pipelined_cg)
+    {
+      Assert ((mp_preconditioner != nullptr) != (mp_preconditioner_single_precision != nullptr),
+              ExcMessage ("Exactly one of the two Schur complement preconditioners "
+                          "has to be given."));
+    }
 
     template <class PreconditionerA, class PreconditionerMp>
     unsigned int
@@ -297,9 +652,30 @@ namespace aspect
             try
               {
                 dst.block(1) = 0.0;
-                solver.solve(stokes_preconditioner_matrix.block(1,1),
-                             dst.block(1), src.block(1),
-                             mp_preconditioner);
+                if (mp_preconditioner_single_precision != nullptr)
+                  {
+                    // the Trilinos solvers can only work with Trilinos
+                    // preconditioners, so use the deal.II solver here
+                    if (use_pipelined_cg)
+                      solve_with_pipelined_cg (stokes_preconditioner_matrix.block(1,1),
+                                               dst.block(1), src.block(1),
+                                               *mp_preconditioner_single_precision, solver_control);
+                    else
+                      {
+                        SolverCG<LinearAlgebra::Vector> single_precision_solver(solver_control);
+                        single_precision_solver.solve(stokes_preconditioner_matrix.block(1,1),
+                                                      dst.block(1), src.block(1),
+                                                      *mp_preconditioner_single_precision);
+                      }
+                  }
+                else if (use_pipelined_cg)
+                  solve_with_pipelined_cg (stokes_preconditioner_matrix.block(1,1),
+                                           dst.block(1), src.block(1),
+                                           *mp_preconditioner, solver_control);
+                else
+                  solver.solve(stokes_preconditioner_matrix.block(1,1),
+                               dst.block(1), src.block(1),
+                               *mp_preconditioner);
                 n_iterations_S_ += solver_control.last_step();
               }
             // if the solver fails, report the error from processor 0 with some additional
@@ -344,8 +720,12 @@ namespace aspect
           try
             {
               dst.block(0) = 0.0;
-              solver.solve(stokes_matrix.block(0,0), dst.block(0), utmp,
-                           a_preconditioner);
+              if (use_pipelined_cg)
+                solve_with_pipelined_cg (stokes_matrix.block(0,0), dst.block(0), utmp,
+                                         a_preconditioner, solver_control);
+              else
+                solver.solve(stokes_matrix.block(0,0), dst.block(0), utmp,
+                             a_preconditioner);
               n_iterations_A_ += solver_control.last_step();
             }
           // if the solver fails, report the error from processor 0 with some additional
@@ -429,6 +809,9 @@ namespace aspect
     TimerOutput::Scope timer (computing_timer, (advection_field.is_temperature() ?
                                                 "Solve temperature system" :
                                                 "Solve composition system"));
+    const Profiler::Scope profiler_scope (profiler, (advection_field.is_temperature() ?
+                                                     "Solve temperature system" :
+                                                     "Solve composition system"));
     if (advection_field.is_temperature())
       {
         pcout << "   Solving temperature system... " << std::flush;
@@ -525,6 +908,7 @@ namespace aspect
   Simulator<dim>::solve_stokes ()
   {
     TimerOutput::Scope timer (computing_timer, "Solve Stokes system");
+    const Profiler::Scope profiler_scope (profiler, "Solve Stokes system");
     pcout << "   Solving Stokes system... " << std::flush;
 
     // extract Stokes parts of solution vector, without any ghost elements
@@ -655,6 +1039,31 @@ namespace aspect
 
         const internal::StokesBlock stokes_block(system_matrix);
 
+        // In the Jacobian-free Newton-Krylov method, the Krylov solver
+        // applies the Newton Jacobian through finite differences of the
+        // residual, while the preconditioner below is built from the
+        // assembled Picard matrix
+        const bool use_jacobian_free_newton_krylov = (assemble_newton_stokes_system
+                                                      && newton_handler
+                                                      && newton_handler->parameters.use_jacobian_free_newton_krylov
+                                                      && newton_handler->jacobian_free_derivative_scaling_factor > 0);
+        if (newton_handler)
+          newton_handler->reset_residual_evaluation_statistics();
+
+        const internal::JacobianFreeStokesBlock
+        jacobian_free_stokes_block (system_matrix,
+                                    [&] (LinearAlgebra::BlockVector       &dst,
+                                         const LinearAlgebra::BlockVector &src)
+        {
+          this->compute_jacobian_free_newton_product (dst, src);
+        });
+
+        const internal::StokesBlock &stokes_operator = (use_jacobian_free_newton_krylov
+                                                        ?
+                                                        jacobian_free_stokes_block
+                                                        :
+                                                        stokes_block);
+
         // create a completely distributed vector that will be used for
         // the scaled and denormalized solution and later used as a
         // starting guess for the linear solver
@@ -764,19 +1173,23 @@ namespace aspect
         const internal::BlockSchurPreconditioner<LinearAlgebra::PreconditionAMG,
               LinearAlgebra::PreconditionBase>
               preconditioner_cheap (system_matrix, system_preconditioner_matrix,
-                                    *Mp_preconditioner, *Amg_preconditioner,
+                                    Mp_preconditioner.get(), *Amg_preconditioner,
                                     false,
                                     parameters.linear_solver_A_block_tolerance,
-                                    parameters.linear_solver_S_block_tolerance);
+                                    parameters.linear_solver_S_block_tolerance,
+                                    parameters.use_communication_avoiding_krylov_methods,
+                                    Mp_preconditioner_single_precision.get());
 
         // create an expensive preconditioner that solves for the A block with CG
         const internal::BlockSchurPreconditioner<LinearAlgebra::PreconditionAMG,
               LinearAlgebra::PreconditionBase>
               preconditioner_expensive (system_matrix, system_preconditioner_matrix,
-                                        *Mp_preconditioner, *Amg_preconditioner,
+                                        Mp_preconditioner.get(), *Amg_preconditioner,
                                         true,
                                         parameters.linear_solver_A_block_tolerance,
-                                        parameters.linear_solver_S_block_tolerance);
+                                        parameters.linear_solver_S_block_tolerance,
+                                        parameters.use_communication_avoiding_krylov_methods,
+                                        Mp_preconditioner_single_precision.get());
 
         // step 1a: try if the simple and fast solver
         // succeeds in n_cheap_stokes_solver_steps steps or less.
@@ -787,15 +1200,25 @@ namespace aspect
             if (parameters.n_cheap_stokes_solver_steps == 0)
               throw SolverControl::NoConvergence(0,0);
 
-            SolverFGMRES<LinearAlgebra::BlockVector>
-            solver(solver_control_cheap, mem,
-                   SolverFGMRES<LinearAlgebra::BlockVector>::
-                   AdditionalData(parameters.stokes_gmres_restart_length));
+            if (parameters.use_communication_avoiding_krylov_methods)
+              internal::solve_with_single_reduction_fgmres (stokes_operator,
+                                                            distributed_stokes_solution,
+                                                            distributed_stokes_rhs,
+                                                            preconditioner_cheap,
+                                                            solver_control_cheap,
+                                                            parameters.stokes_gmres_restart_length);
+            else
+              {
+                SolverFGMRES<LinearAlgebra::BlockVector>
+                solver(solver_control_cheap, mem,
+                       SolverFGMRES<LinearAlgebra::BlockVector>::
+                       AdditionalData(parameters.stokes_gmres_restart_length));
 
-            solver.solve (stokes_block,
-                          distributed_stokes_solution,
-                          distributed_stokes_rhs,
-                          preconditioner_cheap);
+                solver.solve (stokes_operator,
+                              distributed_stokes_solution,
+                              distributed_stokes_rhs,
+                              preconditioner_cheap);
+              }
 
             final_linear_residual = solver_control_cheap.last_value();
           }
@@ -819,10 +1242,18 @@ namespace aspect
 
             try
               {
-                solver.solve(stokes_block,
-                             distributed_stokes_solution,
-                             distributed_stokes_rhs,
-                             preconditioner_expensive);
+                if (parameters.use_communication_avoiding_krylov_methods)
+                  internal::solve_with_single_reduction_fgmres (stokes_operator,
+                                                                distributed_stokes_solution,
+                                                                distributed_stokes_rhs,
+                                                                preconditioner_expensive,
+                                                                solver_control_expensive,
+                                                                number_of_temporary_vectors);
+                else
+                  solver.solve(stokes_operator,
+                               distributed_stokes_solution,
+                               distributed_stokes_rhs,
+                               preconditioner_expensive);
 
                 final_linear_residual = solver_control_expensive.last_value();
               }
@@ -916,6 +1347,12 @@ namespace aspect
                   solver_control_expensive.last_step():
                   0)
               << " iterations.";
+        if (use_jacobian_free_newton_krylov)
+          pcout << " Jacobian-free: "
+                << newton_handler->get_n_residual_evaluations()
+                << " residual evaluations in "
+                << newton_handler->get_residual_evaluation_time()
+                << " s.";
         pcout << std::endl;
       }
 
@@ -509,6 +509,11 @@ namespace aspect
   template <int dim>
   void Simulator<dim>::solve_iterated_advection_and_newton_stokes ()
   {
+    AssertThrow (!newton_handler->parameters.use_jacobian_free_newton_krylov
+                 || (!parameters.use_direct_stokes_solver && !parameters.include_melt_transport),
+                 ExcMessage ("The Jacobian-free Newton-Krylov method can not be used together "
+                             "with the direct Stokes solver or with melt transport."));
+
     // Now store the linear_tolerance we started out with, because we might change
     // it within this timestep.
     double begin_linear_tolerance = parameters.linear_stokes_solver_tolerance;
@@ -562,10 +567,21 @@ namespace aspect
               newton_residual_for_derivative_scaling_factor = 0;
           }
 
-        newton_handler->parameters.newton_derivative_scaling_factor
+        const double derivative_scaling_factor
           = (std::max(0.0,
                       (1.0-(newton_residual_for_derivative_scaling_factor/switch_initial_residual))));
 
+        if (newton_handler->parameters.use_jacobian_free_newton_krylov)
+          {
+            // Only assemble the Picard matrix, which is used for the
+            // preconditioner. The derivative terms are instead applied by
+            // finite differences of the residual within the linear solver.
+            newton_handler->parameters.newton_derivative_scaling_factor = 0;
+            newton_handler->jacobian_free_derivative_scaling_factor = derivative_scaling_factor;
+          }
+        else
+          newton_handler->parameters.newton_derivative_scaling_factor = derivative_scaling_factor;
+
 
         /**
          * copied from solver.cc
@@ -787,7 +803,7 @@ namespace aspect
                   {
                     pcout << "      Relative nonlinear residual (total Newton system) after nonlinear iteration " << nonlinear_iteration+1
                           << ": " << test_residual/initial_residual << ", norm of the rhs: " << test_residual
-                          << ", newton_derivative_scaling_factor: " << newton_handler->parameters.newton_derivative_scaling_factor
+                          << ", newton_derivative_scaling_factor: " << derivative_scaling_factor
                           << std::endl;
                     residual = test_residual;
                     break;
@@ -854,6 +870,10 @@ namespace aspect
           }
       }
 
+    // Make sure that no other solve uses the Jacobian-free Newton-Krylov
+    // method before the scaling factor is set again above.
+    newton_handler->jacobian_free_derivative_scaling_factor = 0;
+
     // Reset the Newton stabilization at the end of the timestep.
     newton_handler->parameters.preconditioner_stabilization = starting_preconditioner_stabilization;
     newton_handler->parameters.velocity_block_stabilization = starting_velocity_block_stabilization;
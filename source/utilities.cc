@@ -30,6 +30,7 @@
 #include <deal.II/base/function_lib.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/base/parallel.h>
 
 #if DEAL_II_VERSION_GTE(9,0,0)
 #include <deal.II/base/patterns.h>
@@ -52,6 +53,10 @@
 #include <boost/math/special_functions/spherical_harmonic.hpp>
 #include <boost/lexical_cast.hpp>
 
+#ifdef DEAL_II_WITH_ZLIB
+#  include <zlib.h>
+#endif
+
 namespace aspect
 {
   /**
@@ -999,6 +1004,131 @@ namespace aspect
         }
     }
 
+
+
+#ifdef DEAL_II_WITH_ZLIB
+    void write_compressed_file (const std::string &data,
+                                const std::string &filename,
+                                const unsigned int compression_block_size)
+    {
+      AssertThrow (compression_block_size > 0,
+                   ExcMessage ("The block size for compressing data must be positive."));
+
+      const uint32_t n_blocks = std::max<std::size_t> ((data.size() + compression_block_size - 1) / compression_block_size,
+                                                       1);
+      const uint32_t last_block_size = data.size() - (n_blocks-1) * compression_block_size;
+
+      // compress all blocks in parallel, each into its own buffer
+      std::vector<std::vector<char> > compressed_blocks (n_blocks);
+      std::vector<uint32_t> compression_header (3 + n_blocks);
+      compression_header[0] = n_blocks;
+      compression_header[1] = (n_blocks == 1 ? last_block_size : compression_block_size);
+      compression_header[2] = last_block_size;
+
+      parallel::apply_to_subranges (0U, n_blocks,
+                                    [&] (const unsigned int begin,
+                                         const unsigned int end)
+      {
+        for (unsigned int block=begin; block<end; ++block)
+          {
+            const uLong block_size = (block == n_blocks-1 ? last_block_size : compression_block_size);
+            uLongf compressed_size = compressBound (block_size);
+            compressed_blocks[block].resize (compressed_size);
+
+            const int err = compress2 ((Bytef *) compressed_blocks[block].data(),
+                                       &compressed_size,
+                                       (const Bytef *) data.data() + static_cast<std::size_t>(block) * compression_block_size,
+                                       block_size,
+                                       Z_BEST_COMPRESSION);
+            AssertThrow (err == Z_OK,
+                         ExcMessage (std::string("Compressing the data buffer resulted in an error with code <")
+                                     +
+                                     Utilities::int_to_string(err) + ">."));
+
+            compressed_blocks[block].resize (compressed_size);
+            compression_header[3+block] = compressed_size;
+          }
+      },
+      1);
+
+      std::size_t file_size = compression_header.size() * sizeof(compression_header[0]);
+      std::ofstream f (filename.c_str(), std::ios::binary);
+      f.write ((const char *)compression_header.data(), compression_header.size() * sizeof(compression_header[0]));
+      for (const std::vector<char> &block : compressed_blocks)
+        {
+          f.write (block.data(), block.size());
+          file_size += block.size();
+        }
+      f.close();
+
+      // We check the fail state of the stream _after_ closing the file to
+      // make sure the writes were completed correctly. This also catches
+      // the cases where the file could not be opened in the first place
+      // or one of the write() commands fails, as the fail state is
+      // "sticky".
+      if (!f)
+        AssertThrow(false, ExcMessage ("Writing of the compressed file '" + filename
+                                       + "' with size "
+                                       + Utilities::to_string(file_size)
+                                       + " failed."));
+    }
+
+
+
+    std::string read_compressed_file (const std::string &filename)
+    {
+      std::ifstream ifs (filename.c_str(), std::ios::binary);
+      AssertThrow(ifs.is_open(),
+                  ExcMessage("Cannot open the compressed file <" + filename + ">."));
+
+      uint32_t block_sizes[3];
+      ifs.read ((char *)block_sizes, 3 * sizeof(block_sizes[0]));
+      const uint32_t n_blocks = block_sizes[0];
+      AssertThrow (ifs && n_blocks > 0,
+                   ExcMessage ("The header of the compressed file <" + filename + "> is corrupted."));
+
+      std::vector<uint32_t> compressed_sizes (n_blocks);
+      ifs.read ((char *)compressed_sizes.data(), n_blocks * sizeof(compressed_sizes[0]));
+
+      // read all compressed blocks in one go, and remember where each of
+      // them starts
+      std::vector<std::size_t> compressed_offsets (n_blocks+1, 0);
+      for (unsigned int block=0; block<n_blocks; ++block)
+        compressed_offsets[block+1] = compressed_offsets[block] + compressed_sizes[block];
+
+      std::vector<char> compressed (compressed_offsets[n_blocks]);
+      ifs.read (compressed.data(), compressed.size());
+      AssertThrow (ifs,
+                   ExcMessage ("The compressed file <" + filename + "> is shorter than its header says."));
+
+      std::string uncompressed (static_cast<std::size_t>(n_blocks-1) * block_sizes[1] + block_sizes[2], '\0');
+
+      parallel::apply_to_subranges (0U, n_blocks,
+                                    [&] (const unsigned int begin,
+                                         const unsigned int end)
+      {
+        for (unsigned int block=begin; block<end; ++block)
+          {
+            const uLongf expected_size = (block == n_blocks-1 ? block_sizes[2] : block_sizes[1]);
+            uLongf uncompressed_size = expected_size;
+            const int err = uncompress ((Bytef *) &uncompressed[static_cast<std::size_t>(block) * block_sizes[1]],
+                                        &uncompressed_size,
+                                        (const Bytef *) &compressed[compressed_offsets[block]],
+                                        compressed_sizes[block]);
+            AssertThrow (err == Z_OK,
+                         ExcMessage (std::string("Uncompressing the data buffer resulted in an error with code <")
+                                     +
+                                     Utilities::int_to_string(err) + ">."));
+            AssertThrow (uncompressed_size == expected_size,
+                         ExcMessage ("A block of the compressed file <" + filename + "> has the wrong size."));
+          }
+      },
+      1);
+
+      return uncompressed;
+    }
+#endif
+
 // tk does the cubic spline interpolation that can be used between different spherical layers in the mantle.
 // This interpolation is based on the script spline.h, which was downloaded from
 // http://kluge.in-chemnitz.de/opensource/spline/spline.h   //
@@ -2812,6 +2942,50 @@ namespace aspect
 
 
 
+    UniformDepthProfile::UniformDepthProfile ()
+      :
+      delta_z (numbers::signaling_nan<double>()),
+      one_over_delta_z (numbers::signaling_nan<double>())
+    {}
+
+
+
+    void
+    UniformDepthProfile::reinit (const double maximal_depth,
+                                 const std::vector<double> &new_values)
+    {
+      AssertThrow (new_values.size() > 1,
+                   ExcMessage ("A depth profile needs at least two points."));
+      AssertThrow (maximal_depth > 0,
+                   ExcMessage ("The maximal depth of a depth profile needs to be positive."));
+
+      values = new_values;
+      delta_z = maximal_depth / (values.size()-1);
+      one_over_delta_z = 1. / delta_z;
+
+      slopes.resize (values.size()-1);
+      for (unsigned int i=0; i<slopes.size(); ++i)
+        slopes[i] = (values[i+1] - values[i]) * one_over_delta_z;
+    }
+
+
+
+    const std::vector<double> &
+    UniformDepthProfile::get_values () const
+    {
+      return values;
+    }
+
+
+
+    double
+    UniformDepthProfile::get_depth_spacing () const
+    {
+      return delta_z;
+    }
+
+
+
     std::vector<Operator> create_model_operator_list(const std::vector<std::string> &operator_names)
     {
       std::vector<Operator> operator_list(operator_names.size());
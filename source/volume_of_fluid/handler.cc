@@ -52,6 +52,8 @@ namespace aspect
     assembler.initialize_simulator(sim);
     parse_parameters (prm);
 
+    reconstruction_stencil.is_valid = false;
+
     this->get_signals().edit_finite_element_variables.connect(std::bind(&aspect::VolumeOfFluidHandler<dim>::edit_finite_element_variables,
                                                                         std::ref(*this),
                                                                         std::placeholders::_1));
@@ -292,6 +294,18 @@ namespace aspect
       }
   }
 
+  template <int dim>
+  void VolumeOfFluidHandler<dim>::setup_dofs ()
+  {
+    // The reconstruction stencils refer to cells and their neighbors, so
+    // recompute them the next time they are needed
+    reconstruction_stencil.is_valid = false;
+    reconstruction_stencil.cells.clear ();
+    reconstruction_stencil.locally_owned_cells.clear ();
+    reconstruction_stencil.neighbors.clear ();
+    reconstruction_stencil.JxW_values.clear ();
+  }
+
   template <int dim>
   unsigned int VolumeOfFluidHandler<dim>::get_n_fields() const
   {
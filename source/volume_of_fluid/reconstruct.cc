@@ -23,10 +23,192 @@
 #include <aspect/volume_of_fluid/handler.h>
 #include <aspect/volume_of_fluid/utilities.h>
 
+#include <deal.II/base/work_stream.h>
+
+#include <numeric>
+
 namespace aspect
 {
   using namespace dealii;
 
+  namespace
+  {
+    /**
+     * Scratch data for the reconstruction of the interface in a single
+     * cell.
+     */
+    template <int dim>
+    struct ReconstructionScratch
+    {
+      ReconstructionScratch (const unsigned int dofs_per_cell,
+                             const unsigned int n_cells_local_stencil,
+                             const unsigned int n_candidate_normals,
+                             const unsigned int n_q_points)
+        :
+        local_dof_indices (dofs_per_cell),
+        local_volume_of_fluids (n_cells_local_stencil),
+        stencil_unit_cell_centers (n_cells_local_stencil),
+        normals (n_candidate_normals),
+        candidate_is_valid (n_candidate_normals),
+        d_vals (n_candidate_normals),
+        errs (n_candidate_normals),
+        weights (n_q_points)
+      {}
+
+      std::vector<types::global_dof_index> local_dof_indices;
+      std::vector<double>                  local_volume_of_fluids;
+      std::vector<Point<dim> >             stencil_unit_cell_centers;
+      std::vector<Tensor<1, dim, double> > normals;
+      std::vector<bool>                    candidate_is_valid;
+      std::vector<double>                  d_vals;
+      std::vector<double>                  errs;
+      std::vector<double>                  weights;
+    };
+
+
+
+    /**
+     * The values the reconstruction computes for the degrees of freedom of
+     * a single cell.
+     */
+    struct ReconstructionCopyData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+      std::vector<double>                  values;
+    };
+  }
+
+
+
+  template <>
+  void VolumeOfFluidHandler<2>::update_reconstruction_stencil (const Quadrature<2> &quadrature)
+  {
+    const unsigned int dim = 2;
+
+    // Number of cells in the local reconstruction stencil
+    const unsigned int n_cells_local_stencil = 9;
+    const unsigned int stencil_side_cell_count = 3;
+
+    const unsigned int n_active_cells = this->get_triangulation().n_active_cells();
+    const unsigned int n_q_points = quadrature.size();
+
+    reconstruction_stencil.cells.assign (n_active_cells, typename DoFHandler<dim>::active_cell_iterator());
+    reconstruction_stencil.locally_owned_cells.clear ();
+    reconstruction_stencil.neighbors.assign (n_cells_local_stencil * n_active_cells, numbers::invalid_unsigned_int);
+    reconstruction_stencil.JxW_values.assign (n_q_points * n_active_cells, 0.0);
+
+    // Boundary reference
+    const typename DoFHandler<dim>::active_cell_iterator endc =
+      this->get_dof_handler().end ();
+
+    FEValues<dim> fevalues(this->get_mapping(), this->get_fe(), quadrature,
+                           update_JxW_values);
+
+    for (auto cell : this->get_dof_handler().active_cell_iterators ())
+      {
+        if (cell->is_artificial ())
+          continue;
+
+        const unsigned int cell_index = cell->active_cell_index();
+        reconstruction_stencil.cells[cell_index] = cell;
+
+        fevalues.reinit (cell);
+        std::copy (fevalues.get_JxW_values().begin(), fevalues.get_JxW_values().end(),
+                   reconstruction_stencil.JxW_values.begin() + n_q_points * cell_index);
+
+        if (!cell->is_locally_owned ())
+          continue;
+
+        reconstruction_stencil.locally_owned_cells.push_back (cell_index);
+
+        // Get references to neighboring cells to build stencil references
+        //
+        // Due to mesh structure, we need to obtain the cells by
+        // considering the pattern of neighboring cells
+        //
+        // Indicies used for the stencil references follow the
+        // pattern
+        //
+        // 6 7 8
+        // 3 4 5
+        // 0 1 2
+        for (unsigned int i = 0; i < stencil_side_cell_count; ++i)
+          {
+            typename DoFHandler<dim>::active_cell_iterator cen; // holding variable for cell at column center
+            if (i == 0 || i == 2)
+              {
+                // Not on center column, so obtain the center cell of the appropriate row
+                const unsigned int neighbor_no = (i/2);
+                const typename DoFHandler<dim>::face_iterator face = cell->face (neighbor_no);
+                if (face->at_boundary() && !cell->has_periodic_neighbor(neighbor_no)||
+                    face->has_children())
+                  cen = endc;
+                else
+                  {
+                    const typename DoFHandler<dim>::cell_iterator neighbor =
+                      cell->neighbor_or_periodic_neighbor(neighbor_no);
+                    if (neighbor->level() == cell->level() &&
+                        neighbor->active())
+                      cen = neighbor;
+                    else
+                      cen = endc;
+                  }
+              }
+            else
+              {
+                // On center column, so current cell is center of column
+                cen = cell;
+              }
+
+            for (unsigned int j = 0; j < stencil_side_cell_count; ++j)
+              {
+                typename DoFHandler<dim>::active_cell_iterator curr; // Variable for cell at current stencil location
+                if (cen == endc)
+                  {
+                    // Current column center is not in mesh, so assume that
+                    // the desired piece of the stencil is also outside.
+                    curr = endc;
+                  }
+                else
+                  {
+                    // Current column center exists, so obtain correct cell reference
+                    if (j == 0 || j == 2)
+                      {
+                        const unsigned int neighbor_no = 2+(j/2);
+                        const typename DoFHandler<dim>::face_iterator face = cen->face (neighbor_no);
+                        if (face->at_boundary() && !cen->has_periodic_neighbor(neighbor_no)||
+                            face->has_children())
+                          curr = endc;
+                        else
+                          {
+                            const typename DoFHandler<dim>::cell_iterator neighbor =
+                              cen->neighbor_or_periodic_neighbor(neighbor_no);
+                            if (neighbor->level() == cell->level() &&
+                                neighbor->active())
+                              curr = neighbor;
+                            else
+                              curr = endc;
+                          }
+                      }
+                    else
+                      {
+                        // Current stencil reference is column center column center
+                        curr = cen;
+                      }
+                  }
+
+                if (curr != endc)
+                  reconstruction_stencil.neighbors[n_cells_local_stencil * cell_index
+                                                   + stencil_side_cell_count * j + i] = curr->active_cell_index();
+              }
+          }
+      }
+
+    reconstruction_stencil.is_valid = true;
+  }
+
+
+
   template <>
   void VolumeOfFluidHandler<2>::update_volume_of_fluid_normals (const VolumeOfFluidField<2> &field,
                                                                 LinearAlgebra::BlockVector &solution)
@@ -40,48 +222,32 @@ namespace aspect
 
     initial_solution.reinit(sim.system_rhs, false);
 
-    // Boundary reference
-    typename DoFHandler<dim>::active_cell_iterator endc =
-      this->get_dof_handler().end ();
-
     // Number of cells in the local reconstruction stencil
     const unsigned int n_cells_local_stencil = 9;
-
-    Vector<double> local_volume_of_fluids (n_cells_local_stencil);
-    std::vector<Point<dim>> stencil_unit_cell_centers (n_cells_local_stencil);
-    std::vector<typename DoFHandler<dim>::active_cell_iterator> neighbor_cells(n_cells_local_stencil);
+    const unsigned int stencil_side_cell_count = 3;
 
     const unsigned int n_candidate_normals_per_dim = 3; // Named variable for number of candidate sums for each dimension
-    std::vector<double> strip_sums (dim * n_candidate_normals_per_dim);
 
     // Named variable for number of candidate interface normal vectors for the reconstruction
     const unsigned int n_candidate_normals = dim*n_candidate_normals_per_dim+1;
-    std::vector<Tensor<1, dim, double>> normals (n_candidate_normals);
-    std::vector<double> d_vals (n_candidate_normals);
-    std::vector<double> errs (n_candidate_normals);
 
     // Variables to do volume calculations
 
     QGauss<dim> quadrature(max_degree);
+    const unsigned int n_q_points = quadrature.size();
 
-    std::vector<double> xFEM_values(quadrature.size());
+    // The stencils only depend on the mesh, so they are reused until the
+    // next call to setup_dofs()
+    if (!reconstruction_stencil.is_valid)
+      update_reconstruction_stencil (quadrature);
 
     const FiniteElement<dim> &system_fe = this->get_fe();
 
-    FEValues<dim> fevalues(this->get_mapping(), system_fe, quadrature,
-                           update_JxW_values);
-
-    // Normal holding vars
     Point<dim> reconstruction_stencil_unit_cell_center;
-    Tensor<1, dim, double> normal;
-    double d;
 
     for (unsigned int i=0; i<dim; ++i)
       reconstruction_stencil_unit_cell_center[i] = 0.5;
 
-    std::vector<types::global_dof_index> cell_dof_indicies (system_fe.dofs_per_cell);
-    std::vector<types::global_dof_index> local_dof_indices (system_fe.dofs_per_cell);
-
     const FEVariable<dim> &volume_of_fluid_var = field.volume_fraction;
     const unsigned int volume_of_fluid_c_index = volume_of_fluid_var.first_component_index;
     const unsigned int volume_of_fluid_ind
@@ -96,317 +262,273 @@ namespace aspect
     const unsigned int n_volume_of_fluidLS_dofs = volume_of_fluidLS_var.fe->dofs_per_cell;
     const unsigned int volume_of_fluidLS_blockidx = volume_of_fluidLS_var.block_index;
 
-    //Iterate over cells
-    for (auto cell : this->get_dof_handler().active_cell_iterators ())
-      {
-        if (!cell->is_locally_owned ())
-          continue;
-
-        // Obtain data for this cell and neighbors
-        cell->get_dof_indices (local_dof_indices);
-        const double cell_volume_of_fluid = solution(local_dof_indices[volume_of_fluid_ind]);
-
-        normal[0] = 0.0;
-        normal[1] = 0.0;
-        d = -1.0;
-
-        if (cell_volume_of_fluid > 1.0 - volume_fraction_threshold)
-          {
-            d = 1.0;
-            initial_solution(local_dof_indices[volume_of_fluid_ind]) = 1.0;
-          }
-        else if (cell_volume_of_fluid < volume_fraction_threshold)
+    // Every cell is part of the stencils of up to 9 other cells, so look up
+    // the volume fractions of all locally owned and ghost cells only once
+    // and index them by their active cell index
+    std::vector<double> volume_fractions (reconstruction_stencil.cells.size(), 0.0);
+    {
+      std::vector<types::global_dof_index> cell_dof_indices (system_fe.dofs_per_cell);
+      for (const unsigned int cell_index : reconstruction_stencil.locally_owned_cells)
+        {
+          reconstruction_stencil.cells[cell_index]->get_dof_indices (cell_dof_indices);
+          volume_fractions[cell_index] = solution(cell_dof_indices[volume_of_fluid_ind]);
+        }
+      for (auto cell : this->get_dof_handler().active_cell_iterators ())
+        if (cell->is_ghost ())
           {
-            d = -1.0;
-            initial_solution(local_dof_indices[volume_of_fluid_ind]) = 0.0;
+            cell->get_dof_indices (cell_dof_indices);
+            volume_fractions[cell->active_cell_index()] = solution(cell_dof_indices[volume_of_fluid_ind]);
           }
-        else
-          {
-            initial_solution(local_dof_indices[volume_of_fluid_ind]) = cell_volume_of_fluid;
-
-            // Get references to neighboring cells to build stencil references
-            //
-            // Due to mesh structure, we need to obtain the cells by
-            // considering the pattern of neighboring cells
-            //
-            // Indicies used for the stencil references follow the
-            // pattern
-            //
-            // 6 7 8
-            // 3 4 5
-            // 0 1 2
-            const unsigned int stencil_side_cell_count = 3;
-            for (unsigned int i = 0; i < stencil_side_cell_count; ++i)
-              {
-                typename DoFHandler<dim>::active_cell_iterator cen; // holding variable for cell at column center
-                if (i == 0 || i == 2)
-                  {
-                    // Not on center column, so obtain the center cell of the appropriate row
-                    const unsigned int neighbor_no = (i/2);
-                    const typename DoFHandler<dim>::face_iterator face = cell->face (neighbor_no);
-                    if (face->at_boundary() && !cell->has_periodic_neighbor(neighbor_no)||
-                        face->has_children())
-                      cen = endc;
-                    else
-                      {
-                        const typename DoFHandler<dim>::cell_iterator neighbor =
-                          cell->neighbor_or_periodic_neighbor(neighbor_no);
-                        if (neighbor->level() == cell->level() &&
-                            neighbor->active())
-                          cen = neighbor;
-                        else
-                          cen = endc;
-                      }
-                  }
-                else
-                  {
-                    // On center column, so current cell is center of column
-                    cen = cell;
-                  }
-
-                for (unsigned int j = 0; j < stencil_side_cell_count; ++j)
-                  {
-                    typename DoFHandler<dim>::active_cell_iterator curr; // Variable for cell at current stencil location
-                    if (cen == endc)
-                      {
-                        // Current column center is not in mesh, so assume that
-                        // the desired piece of the stencil is also outside.
-                        curr = endc;
-                      }
-                    else
-                      {
-                        // Current column center exists, so obtain correct cell reference
-                        if (j == 0 || j == 2)
-                          {
-                            //
-                            const unsigned int neighbor_no = 2+(j/2);
-                            const typename DoFHandler<dim>::face_iterator face = cen->face (neighbor_no);
-                            if (face->at_boundary() && !cen->has_periodic_neighbor(neighbor_no)||
-                                face->has_children())
-                              curr = endc;
-                            else
-                              {
-                                const typename DoFHandler<dim>::cell_iterator neighbor =
-                                  cen->neighbor_or_periodic_neighbor(neighbor_no);
-                                if (neighbor->level() == cell->level() &&
-                                    neighbor->active())
-                                  curr = neighbor;
-                                else
-                                  curr = endc;
-                              }
-                          }
-                        else
-                          {
-                            // Current stencil reference is column center column center
-                            curr = cen;
-                          }
-                      }
-                    if (curr != endc)
-                      {
-                        // Cell reference is valid, so get data
-                        curr->get_dof_indices (cell_dof_indicies);
-                        stencil_unit_cell_centers[3 * j + i] = Point<dim> (-1.0 + i,
-                                                                           -1.0 + j);
-                      }
-                    else
-                      {
-                        // Cell reference is invalid, so replace with current
-                        // cell to reduce branching complexity in the later
-                        // algorithm
-                        cell->get_dof_indices (cell_dof_indicies);
-                        stencil_unit_cell_centers[3 * j + i] = Point<dim> (0.0,
-                                                                           0.0);
-                      }
-                    local_volume_of_fluids (3 * j + i) = solution (cell_dof_indicies[volume_of_fluid_ind]);
-                    neighbor_cells[3 * j + i] = curr;
-                  }
-              }
-
-            // Gather cell strip sums
-            //
-            // Sums are indexed as
-            // [n_sums_per_dim * parallel_dim + ind]
-            const unsigned int n_sums_per_dim = 3;
-            for (unsigned int i = 0; i < dim * n_candidate_normals_per_dim; ++i)
-              strip_sums[i] = 0.0;
-
-            for (unsigned int i = 0; i < stencil_side_cell_count; ++i)
+    }
+
+    auto reconstruct_cell = [&] (const std::vector<unsigned int>::const_iterator &cell_index,
+                                 ReconstructionScratch<dim> &scratch,
+                                 ReconstructionCopyData &data)
+    {
+      const typename DoFHandler<dim>::active_cell_iterator &cell = reconstruction_stencil.cells[*cell_index];
+      const unsigned int *neighbors = &reconstruction_stencil.neighbors[n_cells_local_stencil * (*cell_index)];
+
+      // Obtain data for this cell and neighbors
+      cell->get_dof_indices (scratch.local_dof_indices);
+      const double cell_volume_of_fluid = volume_fractions[*cell_index];
+
+      Tensor<1, dim, double> normal;
+      double d = -1.0;
+      double reconstructed_volume_of_fluid = cell_volume_of_fluid;
+
+      if (cell_volume_of_fluid > 1.0 - volume_fraction_threshold)
+        {
+          d = 1.0;
+          reconstructed_volume_of_fluid = 1.0;
+        }
+      else if (cell_volume_of_fluid < volume_fraction_threshold)
+        {
+          d = -1.0;
+          reconstructed_volume_of_fluid = 0.0;
+        }
+      else
+        {
+          // Stencil positions that are not in the mesh (or not on the
+          // level of the current cell) are replaced by the current cell
+          // to reduce branching complexity in the later algorithm
+          for (unsigned int i = 0; i < n_cells_local_stencil; ++i)
+            if (neighbors[i] != numbers::invalid_unsigned_int)
               {
-                for (unsigned int j = 0; j < stencil_side_cell_count; ++j)
-                  {
-                    strip_sums[n_sums_per_dim * 0 + i] += local_volume_of_fluids (stencil_side_cell_count * j + i);
-                    strip_sums[n_sums_per_dim * 1 + j] += local_volume_of_fluids (stencil_side_cell_count * j + i);
-                  }
+                scratch.local_volume_of_fluids[i] = volume_fractions[neighbors[i]];
+                scratch.stencil_unit_cell_centers[i] = Point<dim> (-1.0 + i % stencil_side_cell_count,
+                                                                   -1.0 + i / stencil_side_cell_count);
               }
-
-            // Calculate normal vectors for the 6 candidates from the efficient
-            // least squares approach
-            //
-            // Labeling the sums of the perpendicular strips as
-            // 0 1 2
-            // L C R
-            //
-            // For each dimension consider the interface normals implied by the
-            // 3 divided differences
-            //
-            // L-C/1
-            // C-R/2
-            // L-R/1
-            //
-            for (unsigned int di = 0; di < dim; ++di)
+            else
               {
-                // Get index other dimension
-                unsigned int di2 = (di == 0) ? 1 : 0;
-                for (unsigned int i = 0; i < 3; ++i)
-                  {
-                    normals[n_candidate_normals_per_dim * di + i][di] = 0.0;
-                    normals[n_candidate_normals_per_dim * di + i][di2] = 0.0;
-                    if (i==0 || i == 2)
-                      {
-                        // Positive sum in difference is L
-                        normals[n_candidate_normals_per_dim * di + i][di] += strip_sums[n_sums_per_dim * di + 0];
-                        normals[3 * di + i][di2] += 1.0;
-                      }
-                    else
-                      {
-                        // Positive sum in difference is C
-                        normals[3 * di + i][di] += strip_sums[3 * di + 1];
-                        normals[3 * di + i][di2] += 0.0;
-                      }
-                    if (i == 0)
-                      {
-                        // Negative sum in difference is C
-                        normals[3 * di + i][di] -= strip_sums[3 * di + 1];
-                        normals[3 * di + i][di2] += 0.0;
-                      }
-                    else
-                      {
-                        // Negative sum in difference is R
-                        normals[3 * di + i][di] -= strip_sums[3 * di + 2];
-                        normals[3 * di + i][di2] += 1.0;
-                      }
-
-                    if (strip_sums[3 * di2 + 2] > strip_sums[3 * di2 + 0])
-                      {
-                        // There is more fluid in in area above the interface on the stencil,
-                        // so flip normal direction
-                        normals[3 * di + i][di2] *= -1.0;
-                      }
-                  }
+                scratch.local_volume_of_fluids[i] = cell_volume_of_fluid;
+                scratch.stencil_unit_cell_centers[i] = Point<dim> (0.0,
+                                                                   0.0);
               }
 
-            // Add time extrapolated local normal as candidate
-            // this is not expected to be the best candidate in general, but
-            // should result in exact reconstruction for linear interface
-            // translations
-            // Inclusion of this candidate will not reduce accuracy due to it
-            // only being selected if it produces a better interface
-            // approximation than the ELS candidates. Note that this will
-            // render linear translation problems less dependent on the
-            // interface reconstruction, so other tests will also be necessary.
-            for (unsigned int i=0; i<dim; ++i)
-              normals[6][i] = solution(local_dof_indices[system_fe
-                                                         .component_to_system_index(volume_of_fluidN_c_index+i, 0)]);
-
-            // If candidate normal too small, remove from consideration
-            if (normals[6]*normals[6]< volume_fraction_threshold)
-              {
-                normals[6][0] = 0;
-                normals[6][1] = 0;
-              }
+          // Gather cell strip sums
+          //
+          // Sums are indexed as
+          // [n_sums_per_dim * parallel_dim + ind]
+          const unsigned int n_sums_per_dim = 3;
+          double strip_sums[dim * n_sums_per_dim] = {};
 
-            unsigned int index_of_best_normal = 0;
+          for (unsigned int i = 0; i < stencil_side_cell_count; ++i)
             {
-              fevalues.reinit(cell);
-              const std::vector<double> weights = fevalues.get_JxW_values();
-
-              double cell_vol = 0.0;
-              for (unsigned int j=0; j<weights.size(); ++j)
+              for (unsigned int j = 0; j < stencil_side_cell_count; ++j)
                 {
-                  cell_vol+=weights[j];
+                  strip_sums[n_sums_per_dim * 0 + i] += scratch.local_volume_of_fluids[stencil_side_cell_count * j + i];
+                  strip_sums[n_sums_per_dim * 1 + j] += scratch.local_volume_of_fluids[stencil_side_cell_count * j + i];
                 }
-              for (unsigned int nind = 0; nind < n_candidate_normals; ++nind)
-                {
-                  errs[nind] = 0.0;
-                  const double normal_norm = normals[nind].norm_square();
+            }
 
-                  if (normal_norm > volume_fraction_threshold) // If candidate normal too small set error to maximum
+          std::vector<Tensor<1, dim, double>> &normals = scratch.normals;
+
+          // Calculate normal vectors for the 6 candidates from the efficient
+          // least squares approach
+          //
+          // Labeling the sums of the perpendicular strips as
+          // 0 1 2
+          // L C R
+          //
+          // For each dimension consider the interface normals implied by the
+          // 3 divided differences
+          //
+          // L-C/1
+          // C-R/2
+          // L-R/1
+          //
+          for (unsigned int di = 0; di < dim; ++di)
+            {
+              // Get index other dimension
+              unsigned int di2 = (di == 0) ? 1 : 0;
+              for (unsigned int i = 0; i < 3; ++i)
+                {
+                  normals[n_candidate_normals_per_dim * di + i][di] = 0.0;
+                  normals[n_candidate_normals_per_dim * di + i][di2] = 0.0;
+                  if (i==0 || i == 2)
+                    {
+                      // Positive sum in difference is L
+                      normals[n_candidate_normals_per_dim * di + i][di] += strip_sums[n_sums_per_dim * di + 0];
+                      normals[3 * di + i][di2] += 1.0;
+                    }
+                  else
+                    {
+                      // Positive sum in difference is C
+                      normals[3 * di + i][di] += strip_sums[3 * di + 1];
+                      normals[3 * di + i][di2] += 0.0;
+                    }
+                  if (i == 0)
                     {
-                      d_vals[nind] = VolumeOfFluid::Utilities::compute_interface_location_newton<dim> (
-                                       max_degree,
-                                       normals[nind],
-                                       cell_volume_of_fluid,
-                                       cell_vol,
-                                       volume_of_fluid_reconstruct_epsilon,
-                                       quadrature.get_points(), weights);
+                      // Negative sum in difference is C
+                      normals[3 * di + i][di] -= strip_sums[3 * di + 1];
+                      normals[3 * di + i][di2] += 0.0;
                     }
                   else
                     {
-                      errs[nind] = 9.0;
+                      // Negative sum in difference is R
+                      normals[3 * di + i][di] -= strip_sums[3 * di + 2];
+                      normals[3 * di + i][di2] += 1.0;
+                    }
+
+                  if (strip_sums[3 * di2 + 2] > strip_sums[3 * di2 + 0])
+                    {
+                      // There is more fluid in in area above the interface on the stencil,
+                      // so flip normal direction
+                      normals[3 * di + i][di2] *= -1.0;
                     }
                 }
             }
 
-            for (unsigned int i = 0; i < n_cells_local_stencil; ++i)
-              {
-                if (neighbor_cells[i] == endc)
-                  {
-                    continue;
-                  }
+          // Add time extrapolated local normal as candidate
+          // this is not expected to be the best candidate in general, but
+          // should result in exact reconstruction for linear interface
+          // translations
+          // Inclusion of this candidate will not reduce accuracy due to it
+          // only being selected if it produces a better interface
+          // approximation than the ELS candidates. Note that this will
+          // render linear translation problems less dependent on the
+          // interface reconstruction, so other tests will also be necessary.
+          for (unsigned int i=0; i<dim; ++i)
+            normals[6][i] = solution(scratch.local_dof_indices[system_fe
+                                                               .component_to_system_index(volume_of_fluidN_c_index+i, 0)]);
+
+          // If candidate normal too small, remove from consideration
+          if (normals[6]*normals[6]< volume_fraction_threshold)
+            {
+              normals[6][0] = 0;
+              normals[6][1] = 0;
+            }
 
-                fevalues.reinit(neighbor_cells[i]);
+          // Decide once which candidates are too small to be considered,
+          // rather than for every cell of the stencil
+          for (unsigned int nind = 0; nind < n_candidate_normals; ++nind)
+            scratch.candidate_is_valid[nind] = (normals[nind].norm_square() > volume_fraction_threshold);
 
-                const std::vector<double> weights = fevalues.get_JxW_values();
+          unsigned int index_of_best_normal = 0;
+          {
+            const std::vector<double>::const_iterator cell_JxW
+              = reconstruction_stencil.JxW_values.begin() + n_q_points * (*cell_index);
+            std::copy (cell_JxW, cell_JxW + n_q_points, scratch.weights.begin());
+            const double cell_vol = std::accumulate (scratch.weights.begin(), scratch.weights.end(), 0.0);
 
-                double cell_vol = 0.0;
-                for (unsigned int j=0; j<weights.size(); ++j)
+            for (unsigned int nind = 0; nind < n_candidate_normals; ++nind)
+              {
+                if (scratch.candidate_is_valid[nind])
                   {
-                    cell_vol+=weights[j];
+                    scratch.errs[nind] = 0.0;
+                    scratch.d_vals[nind] = VolumeOfFluid::Utilities::compute_interface_location_newton<dim> (
+                                             max_degree,
+                                             normals[nind],
+                                             cell_volume_of_fluid,
+                                             cell_vol,
+                                             volume_of_fluid_reconstruct_epsilon,
+                                             quadrature.get_points(), scratch.weights);
                   }
-
-                for (unsigned int nind = 0; nind < n_candidate_normals; ++nind)
+                else
                   {
-                    const double normal_norm = normals[nind]*normals[nind];
-
-                    if (normal_norm > volume_fraction_threshold) // If candidate normal too small skip as set to max already
-                      {
-                        double dot = 0.0;
-                        for (unsigned int di = 0; di < dim; ++di)
-                          dot += normals[nind][di] * stencil_unit_cell_centers[i][di];
-                        const double n_volume_of_fluid = VolumeOfFluid::Utilities::compute_fluid_volume<dim> (max_degree, normals[nind], d_vals[nind]-dot,
-                                                         quadrature.get_points(), weights)/cell_vol;
-                        const double cell_err = local_volume_of_fluids (i) - n_volume_of_fluid;
-                        errs[nind] += cell_err * cell_err;
-                      }
+                    // If candidate normal too small set error to maximum
+                    scratch.errs[nind] = 9.0;
                   }
               }
+          }
 
-            for (unsigned int nind = 0; nind < n_candidate_normals; ++nind)
-              {
-                if (errs[index_of_best_normal] >= errs[nind])
-                  index_of_best_normal = nind;
-              }
+          for (unsigned int i = 0; i < n_cells_local_stencil; ++i)
+            {
+              if (neighbors[i] == numbers::invalid_unsigned_int)
+                {
+                  continue;
+                }
 
-            normal = normals[index_of_best_normal];
-            d = d_vals[index_of_best_normal];
-          }
+              const std::vector<double>::const_iterator neighbor_JxW
+                = reconstruction_stencil.JxW_values.begin() + n_q_points * neighbors[i];
+              std::copy (neighbor_JxW, neighbor_JxW + n_q_points, scratch.weights.begin());
+              const double cell_vol = std::accumulate (scratch.weights.begin(), scratch.weights.end(), 0.0);
 
-        for (unsigned int i=0; i<dim; ++i)
-          initial_solution (local_dof_indices[system_fe
-                                              .component_to_system_index(volume_of_fluidN_c_index+i, 0)]) = normal[i];
+              for (unsigned int nind = 0; nind < n_candidate_normals; ++nind)
+                {
+                  if (scratch.candidate_is_valid[nind])
+                    {
+                      const double dot = normals[nind] * scratch.stencil_unit_cell_centers[i];
+                      const double n_volume_of_fluid = VolumeOfFluid::Utilities::compute_fluid_volume<dim> (max_degree, normals[nind], scratch.d_vals[nind]-dot,
+                                                       quadrature.get_points(), scratch.weights)/cell_vol;
+                      const double cell_err = scratch.local_volume_of_fluids[i] - n_volume_of_fluid;
+                      scratch.errs[nind] += cell_err * cell_err;
+                    }
+                }
+            }
 
-        initial_solution (local_dof_indices[system_fe
-                                            .component_to_system_index(volume_of_fluidN_c_index+dim, 0)]) = d;
+          for (unsigned int nind = 0; nind < n_candidate_normals; ++nind)
+            {
+              if (scratch.errs[index_of_best_normal] >= scratch.errs[nind])
+                index_of_best_normal = nind;
+            }
 
-        for (unsigned int i=0; i<n_volume_of_fluidLS_dofs; ++i)
-          {
-            // Recenter unit cell on origin
-            Tensor<1, dim, double> recentered_support_point = volume_of_fluidLS_var.fe->unit_support_point(i)-reconstruction_stencil_unit_cell_center;
-            initial_solution (local_dof_indices[system_fe
-                                                .component_to_system_index(volume_of_fluidLS_c_index, i)])
-              = d-recentered_support_point*normal;
-          }
-      }
+          normal = normals[index_of_best_normal];
+          d = scratch.d_vals[index_of_best_normal];
+        }
+
+      data.dof_indices.clear ();
+      data.values.clear ();
+
+      data.dof_indices.push_back (scratch.local_dof_indices[volume_of_fluid_ind]);
+      data.values.push_back (reconstructed_volume_of_fluid);
+
+      for (unsigned int i=0; i<dim; ++i)
+        {
+          data.dof_indices.push_back (scratch.local_dof_indices[system_fe
+                                                                .component_to_system_index(volume_of_fluidN_c_index+i, 0)]);
+          data.values.push_back (normal[i]);
+        }
+
+      data.dof_indices.push_back (scratch.local_dof_indices[system_fe
+                                                            .component_to_system_index(volume_of_fluidN_c_index+dim, 0)]);
+      data.values.push_back (d);
+
+      for (unsigned int i=0; i<n_volume_of_fluidLS_dofs; ++i)
+        {
+          // Recenter unit cell on origin
+          Tensor<1, dim, double> recentered_support_point = volume_of_fluidLS_var.fe->unit_support_point(i)-reconstruction_stencil_unit_cell_center;
+          data.dof_indices.push_back (scratch.local_dof_indices[system_fe
+                                                                .component_to_system_index(volume_of_fluidLS_c_index, i)]);
+          data.values.push_back (d-recentered_support_point*normal);
+        }
+    };
+
+    auto copy_cell = [&] (const ReconstructionCopyData &data)
+    {
+      for (unsigned int i=0; i<data.dof_indices.size(); ++i)
+        initial_solution(data.dof_indices[i]) = data.values[i];
+    };
+
+    WorkStream::run (reconstruction_stencil.locally_owned_cells.cbegin(),
+                     reconstruction_stencil.locally_owned_cells.cend(),
+                     reconstruct_cell,
+                     copy_cell,
+                     ReconstructionScratch<dim> (system_fe.dofs_per_cell,
+                                                 n_cells_local_stencil,
+                                                 n_candidate_normals,
+                                                 n_q_points),
+                     ReconstructionCopyData ());
 
     initial_solution.compress(VectorOperation::insert);
 
@@ -420,6 +542,13 @@ namespace aspect
   }
 
 
+  template <>
+  void VolumeOfFluidHandler<3>::update_reconstruction_stencil (const Quadrature<3> &/*quadrature*/)
+  {
+    Assert(false, ExcNotImplemented());
+  }
+
+
   template <>
   void VolumeOfFluidHandler<3>::update_volume_of_fluid_normals (const VolumeOfFluidField<3> &/*field*/,
                                                                 LinearAlgebra::BlockVector &/*solution*/)
@@ -47,21 +47,6 @@ namespace aspect
     sim.computing_timer.enter_section ("Solve volume of fluid system");
     this->get_pcout() << "   Solving volume of fluid system... " << std::flush;
 
-    const double tolerance = std::max(1e-50,
-                                      volume_of_fluid_solver_tolerance*sim.system_rhs.block(block_idx).l2_norm());
-
-    SolverControl solver_control (1000, tolerance);
-
-#ifdef ASPECT_USE_PETSC
-    SolverCG<LinearAlgebra::Vector> solver(solver_control);
-    LinearAlgebra::PreconditionJacobi precondition;
-    precondition.initialize(sim.system_matrix.block(block_idx, block_idx));
-#else
-    TrilinosWrappers::SolverCG solver(solver_control);
-    TrilinosWrappers::PreconditionJacobi precondition;
-    precondition.initialize(sim.system_matrix.block(block_idx, block_idx));
-#endif
-
     // Create distributed vector (we need all blocks here even though we only
     // solve for the current block) because only have a ConstraintMatrix
     // for the whole system, current_linearization_point contains our initial guess.
@@ -72,27 +57,83 @@ namespace aspect
 
     sim.current_constraints.set_zero(distributed_solution);
 
-    // solve the linear system:
-    try
+    unsigned int n_iterations = 0;
+
+    const double tolerance = std::max(1e-50,
+                                      volume_of_fluid_solver_tolerance*sim.system_rhs.block(block_idx).l2_norm());
+
+    if (field.volume_fraction.fe->dofs_per_cell == 1)
       {
-        solver.solve (sim.system_matrix.block(block_idx,block_idx),
-                      distributed_solution.block(block_idx),
-                      sim.system_rhs.block(block_idx),
-                      precondition);
+        // The volume fraction is piecewise constant, so the matrix only
+        // couples each cell's degree of freedom with itself (the face flux
+        // terms are added to the diagonal entries of the cell and its
+        // neighbor, see the assembler) and is diagonal. Rather than running
+        // a Jacobi preconditioned CG solver on it, simply apply the inverse
+        // of the diagonal.
+        const LinearAlgebra::SparseMatrix &matrix = sim.system_matrix.block(block_idx, block_idx);
+        const LinearAlgebra::Vector &rhs = sim.system_rhs.block(block_idx);
+        LinearAlgebra::Vector &dst = distributed_solution.block(block_idx);
+
+        // The CG solver converges in a single iteration for a diagonal
+        // matrix, or in none if the initial guess already satisfies the
+        // tolerance. Report the same number of iterations, and keep the
+        // initial guess in the latter case, so that the output does not
+        // depend on which of the two solvers is used.
+        LinearAlgebra::Vector residual (rhs);
+        if (matrix.residual (residual, dst, rhs) > tolerance)
+          {
+            const IndexSet locally_owned_dofs = rhs.locally_owned_elements();
+            for (const types::global_dof_index i : locally_owned_dofs)
+              {
+                const double diagonal = matrix.diag_element(i);
+                AssertThrow (diagonal > 0.0,
+                             ExcMessage ("The volume of fluid system matrix has a non-positive "
+                                         "diagonal entry."));
+                dst(i) = rhs(i) / diagonal;
+              }
+            dst.compress (VectorOperation::insert);
+
+            n_iterations = 1;
+          }
       }
-    // if the solver fails, report the error from processor 0 with some additional
-    // information about its location, and throw a quiet exception on all other
-    // processors
-    catch (const std::exception &exc)
+    else
       {
-        if (Utilities::MPI::this_mpi_process(this->get_mpi_communicator()) == 0)
-          AssertThrow (false,
-                       ExcMessage (std::string("The iterative advection solver "
-                                               "did not converge. It reported the following error:\n\n")
-                                   +
-                                   exc.what()))
-          else
-            throw QuietException();
+        SolverControl solver_control (1000, tolerance);
+
+#ifdef ASPECT_USE_PETSC
+        SolverCG<LinearAlgebra::Vector> solver(solver_control);
+        LinearAlgebra::PreconditionJacobi precondition;
+        precondition.initialize(sim.system_matrix.block(block_idx, block_idx));
+#else
+        TrilinosWrappers::SolverCG solver(solver_control);
+        TrilinosWrappers::PreconditionJacobi precondition;
+        precondition.initialize(sim.system_matrix.block(block_idx, block_idx));
+#endif
+
+        // solve the linear system:
+        try
+          {
+            solver.solve (sim.system_matrix.block(block_idx,block_idx),
+                          distributed_solution.block(block_idx),
+                          sim.system_rhs.block(block_idx),
+                          precondition);
+          }
+        // if the solver fails, report the error from processor 0 with some additional
+        // information about its location, and throw a quiet exception on all other
+        // processors
+        catch (const std::exception &exc)
+          {
+            if (Utilities::MPI::this_mpi_process(this->get_mpi_communicator()) == 0)
+              AssertThrow (false,
+                           ExcMessage (std::string("The iterative advection solver "
+                                                   "did not converge. It reported the following error:\n\n")
+                                       +
+                                       exc.what()))
+              else
+                throw QuietException();
+          }
+
+        n_iterations = solver_control.last_step();
       }
 
     sim.current_constraints.distribute (distributed_solution);
@@ -100,7 +141,7 @@ namespace aspect
 
     // print number of iterations and also record it in the
     // statistics file
-    this->get_pcout() << solver_control.last_step()
+    this->get_pcout() << n_iterations
                       << " iterations." << std::endl;
 
     // Do not add VolumeOfFluid solver iterations to statistics, duplication due to
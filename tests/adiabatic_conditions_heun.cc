@@ -0,0 +1,174 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_access.h>
+#include <aspect/adiabatic_conditions/compute_profile.h>
+#include <aspect/geometry_model/interface.h>
+
+#include <iomanip>
+
+
+namespace aspect
+{
+  namespace AdiabaticConditionsHeun
+  {
+    using namespace dealii;
+
+    /**
+     * A postprocessor that compares the adiabatic profile of the model
+     * with a profile computed with the explicit Euler method on a much finer
+     * set of points, and with a profile computed with the explicit Euler
+     * method on the same number of points. It aborts if the adiabatic
+     * profile of the model is not close to the fine profile, or if it is not
+     * much closer to it than the coarse Euler profile. The model is expected
+     * to use Heun's method to compute its profile.
+     */
+    template <int dim>
+    class CompareWithEulerProfile : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+
+        virtual
+        void
+        parse_parameters (ParameterHandler &prm);
+
+      private:
+        /**
+         * The number of points of the adiabatic profile of the model.
+         */
+        unsigned int n_points;
+
+        /**
+         * Return the largest differences of the temperatures and pressures of
+         * the model's adiabatic profile and of @p profile, relative to the
+         * temperature and pressure of @p profile at the bottom of the model.
+         */
+        std::pair<double,double>
+        difference (const AdiabaticConditions::Interface<dim> &profile) const;
+    };
+
+
+
+    namespace
+    {
+      /**
+       * Create an adiabatic profile with the parameters of the model, but
+       * computed with @p n_points points and the explicit Euler method.
+       */
+      template <int dim>
+      std::unique_ptr<AdiabaticConditions::ComputeProfile<dim> >
+      create_euler_profile (const SimulatorAccess<dim> &simulator_access,
+                            const unsigned int n_points)
+      {
+        ParameterHandler prm;
+        AdiabaticConditions::ComputeProfile<dim>::declare_parameters (prm);
+
+        prm.enter_subsection("Adiabatic conditions model");
+        {
+          prm.enter_subsection("Compute profile");
+          {
+            prm.set ("Number of points", Utilities::int_to_string(n_points));
+            prm.set ("Integration scheme", "Euler");
+          }
+          prm.leave_subsection();
+        }
+        prm.leave_subsection();
+
+        std::unique_ptr<AdiabaticConditions::ComputeProfile<dim> > profile
+          = std_cxx14::make_unique<AdiabaticConditions::ComputeProfile<dim> >();
+        profile->initialize_simulator (simulator_access.get_simulator());
+        profile->parse_parameters (prm);
+        profile->initialize ();
+
+        return profile;
+      }
+    }
+
+
+
+    template <int dim>
+    std::pair<double,double>
+    CompareWithEulerProfile<dim>::difference (const AdiabaticConditions::Interface<dim> &profile) const
+    {
+      const double maximal_depth = this->get_geometry_model().maximal_depth();
+      const Point<dim> bottom = this->get_geometry_model().representative_point (maximal_depth);
+
+      double temperature_difference = 0;
+      double pressure_difference = 0;
+
+      const unsigned int n_evaluation_points = 101;
+      for (unsigned int i=0; i<n_evaluation_points; ++i)
+        {
+          const Point<dim> p = this->get_geometry_model().representative_point (maximal_depth * i / (n_evaluation_points-1));
+
+          temperature_difference = std::max (temperature_difference,
+                                             std::abs (this->get_adiabatic_conditions().temperature(p) - profile.temperature(p)));
+          pressure_difference = std::max (pressure_difference,
+                                          std::abs (this->get_adiabatic_conditions().pressure(p) - profile.pressure(p)));
+        }
+
+      return std::make_pair (temperature_difference / profile.temperature(bottom),
+                             pressure_difference / profile.pressure(bottom));
+    }
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CompareWithEulerProfile<dim>::execute (TableHandler &)
+    {
+      const std::pair<double,double> fine_difference
+        = difference (*create_euler_profile (*this, 200000));
+      const std::pair<double,double> coarse_difference
+        = difference (*create_euler_profile (*this, n_points));
+
+      AssertThrow (fine_difference.first < 1e-4 && fine_difference.second < 1e-4,
+                   ExcMessage ("The adiabatic profile differs from the one computed "
+                               "with the explicit Euler method on a fine set of points."));
+      AssertThrow (10 * fine_difference.first < coarse_difference.first
+                   &&
+                   10 * fine_difference.second < coarse_difference.second,
+                   ExcMessage ("The adiabatic profile is not more accurate than the one "
+                               "computed with the explicit Euler method on the same "
+                               "number of points."));
+
+      std::ostringstream os;
+      os << std::scientific << std::setprecision(2)
+         << fine_difference.first << ", " << fine_difference.second;
+      return std::make_pair ("Relative difference to fine Euler profile T, p:", os.str());
+    }
+
+
+
+    template <int dim>
+    void
+    CompareWithEulerProfile<dim>::parse_parameters (ParameterHandler &prm)
+    {
+      prm.enter_subsection("Adiabatic conditions model");
+      {
+        prm.enter_subsection("Compute profile");
+        {
+          n_points = prm.get_integer ("Number of points");
+        }
+        prm.leave_subsection();
+      }
+      prm.leave_subsection();
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace AdiabaticConditionsHeun
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CompareWithEulerProfile,
+                                  "compare with euler profile",
+                                  "A postprocessor that compares the adiabatic profile with "
+                                  "one computed with the explicit Euler method on a fine "
+                                  "set of points.")
+  }
+}
@@ -0,0 +1,110 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_access.h>
+#include <aspect/material_model/interface.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+
+namespace aspect
+{
+  namespace AverageProjectToQ1AffineCache
+  {
+    using namespace dealii;
+
+    /**
+     * A postprocessor that compares, on every locally owned cell, the
+     * projection and expansion matrices that MaterialAveraging uses for the
+     * project_to_Q1 operation on affine cells, which are computed only once
+     * per quadrature formula, with the ones computed by
+     * MaterialAveraging::compute_projection_matrix() for this cell. It
+     * aborts if they differ. This only works for models whose cells are
+     * all parallelograms or parallelepipeds.
+     */
+    template <int dim>
+    class CheckAffineProjectionMatrices : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+    };
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CheckAffineProjectionMatrices<dim>::execute (TableHandler &)
+    {
+      // the quadrature formula used to assemble the Stokes system
+      const QGauss<dim> quadrature_formula (this->introspection().polynomial_degree.velocities+1);
+
+      unsigned int n_differences = 0;
+      unsigned int n_checked_cells = 0;
+      for (const auto &cell : this->get_dof_handler().active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            ++n_checked_cells;
+
+            const MaterialModel::MaterialAveraging::AffineProjectionMatrices<dim> &cached_matrices
+              = MaterialModel::MaterialAveraging::get_affine_projection_matrices<dim> (cell,
+                  quadrature_formula,
+                  this->get_mapping());
+
+            FullMatrix<double> projection_matrix;
+            FullMatrix<double> expansion_matrix;
+            MaterialModel::MaterialAveraging::compute_projection_matrix<dim> (cell,
+                quadrature_formula,
+                this->get_mapping(),
+                projection_matrix,
+                expansion_matrix);
+
+            AssertThrow (cached_matrices.projection_matrix.m() == projection_matrix.m()
+                         &&
+                         cached_matrices.projection_matrix.n() == projection_matrix.n()
+                         &&
+                         cached_matrices.expansion_matrix.m() == expansion_matrix.m()
+                         &&
+                         cached_matrices.expansion_matrix.n() == expansion_matrix.n(),
+                         ExcMessage ("The cached projection matrices have the wrong size."));
+
+            for (unsigned int i=0; i<projection_matrix.m(); ++i)
+              for (unsigned int j=0; j<projection_matrix.n(); ++j)
+                if (std::abs (cached_matrices.projection_matrix(i,j) - projection_matrix(i,j))
+                    > 1e-10 * std::max (1.0, std::abs (projection_matrix(i,j))))
+                  ++n_differences;
+
+            for (unsigned int i=0; i<expansion_matrix.m(); ++i)
+              for (unsigned int j=0; j<expansion_matrix.n(); ++j)
+                if (std::abs (cached_matrices.expansion_matrix(i,j) - expansion_matrix(i,j))
+                    > 1e-10 * std::max (1.0, std::abs (expansion_matrix(i,j))))
+                  ++n_differences;
+          }
+
+      n_differences = Utilities::MPI::sum (n_differences, this->get_mpi_communicator());
+      n_checked_cells = Utilities::MPI::sum (n_checked_cells, this->get_mpi_communicator());
+
+      AssertThrow (n_differences == 0,
+                   ExcMessage ("The cached projection matrices for affine cells differ from "
+                               "the ones computed for the individual cells in "
+                               + Utilities::int_to_string (n_differences) + " entries."));
+
+      return std::make_pair ("Number of checked cells:",
+                             Utilities::int_to_string (n_checked_cells));
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace AverageProjectToQ1AffineCache
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CheckAffineProjectionMatrices,
+                                  "check affine projection matrices",
+                                  "A postprocessor that checks that the cached projection "
+                                  "matrices of the project to Q1 averaging are the same as "
+                                  "the ones computed for each cell.")
+  }
+}
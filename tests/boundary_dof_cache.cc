@@ -0,0 +1,214 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_access.h>
+#include <aspect/boundary_velocity/interface.h>
+#include <aspect/boundary_temperature/interface.h>
+#include <aspect/boundary_composition/interface.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/numerics/vector_tools.h>
+
+
+namespace aspect
+{
+  namespace BoundaryDoFCache
+  {
+    using namespace dealii;
+
+    /**
+     * A postprocessor that computes the constraints of the current time
+     * step a second time, using the hanging node constraints and
+     * VectorTools::interpolate_boundary_values() for all prescribed
+     * velocity, fixed temperature and fixed composition boundaries, and
+     * aborts if they differ from the constraints the simulator computed
+     * with its cache of boundary degrees of freedom. This only works for
+     * models without tangential or zero velocity boundaries and without
+     * velocity component selectors, and that allow Dirichlet boundary
+     * conditions on outflow boundaries.
+     */
+    template <int dim>
+    class CheckBoundaryConstraints : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+    };
+
+
+
+    namespace
+    {
+      /**
+       * A function that returns the prescribed boundary velocity of
+       * @p boundary_id in the velocity components and zero in all others.
+       */
+      template <int dim>
+      class BoundaryVelocityFunction : public Function<dim>
+      {
+        public:
+          BoundaryVelocityFunction (const BoundaryVelocity::Manager<dim> &manager,
+                                    const types::boundary_id boundary_id,
+                                    const Introspection<dim> &introspection)
+            :
+            Function<dim> (introspection.n_components),
+            manager (manager),
+            boundary_id (boundary_id),
+            introspection (introspection)
+          {}
+
+          virtual
+          void
+          vector_value (const Point<dim> &p,
+                        Vector<double> &values) const
+          {
+            values = 0;
+            const Tensor<1,dim> velocity = manager.boundary_velocity (boundary_id, p);
+            for (unsigned int d=0; d<dim; ++d)
+              values[introspection.component_indices.velocities[d]] = velocity[d];
+          }
+
+        private:
+          const BoundaryVelocity::Manager<dim> &manager;
+          const types::boundary_id boundary_id;
+          const Introspection<dim> &introspection;
+      };
+    }
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CheckBoundaryConstraints<dim>::execute (TableHandler &)
+    {
+      const Introspection<dim> &introspection = this->introspection();
+
+      AssertThrow (this->get_boundary_velocity_manager().get_zero_boundary_velocity_indicators().empty()
+                   &&
+                   this->get_boundary_velocity_manager().get_tangential_boundary_velocity_indicators().empty()
+                   &&
+                   this->get_boundary_temperature_manager().allows_fixed_temperature_on_outflow_boundaries()
+                   &&
+                   this->get_boundary_composition_manager().allows_fixed_composition_on_outflow_boundaries(),
+                   ExcMessage ("This postprocessor does not support the boundary conditions of this model."));
+
+      ConstraintMatrix reference_constraints;
+      reference_constraints.reinit (introspection.index_sets.system_relevant_set);
+      DoFTools::make_hanging_node_constraints (this->get_dof_handler(),
+                                               reference_constraints);
+
+      for (const auto &p : this->get_boundary_velocity_manager().get_active_boundary_velocity_names())
+        {
+          AssertThrow (p.second.first.empty(),
+                       ExcMessage ("This postprocessor does not support velocity component selectors."));
+
+          VectorTools::interpolate_boundary_values (this->get_mapping(),
+                                                    this->get_dof_handler(),
+                                                    p.first,
+                                                    BoundaryVelocityFunction<dim> (this->get_boundary_velocity_manager(),
+                                                                                   p.first,
+                                                                                   introspection),
+                                                    reference_constraints,
+                                                    introspection.component_masks.velocities);
+        }
+
+      for (const auto boundary_id : this->get_boundary_temperature_manager().get_fixed_temperature_boundary_indicators())
+        {
+          VectorFunctionFromScalarFunctionObject<dim> temperature (
+            [&] (const Point<dim> &x) -> double
+          {
+            return this->get_boundary_temperature_manager().boundary_temperature (boundary_id, x);
+          },
+          introspection.component_masks.temperature.first_selected_component(),
+          introspection.n_components);
+
+          VectorTools::interpolate_boundary_values (this->get_mapping(),
+                                                    this->get_dof_handler(),
+                                                    boundary_id,
+                                                    temperature,
+                                                    reference_constraints,
+                                                    introspection.component_masks.temperature);
+        }
+
+      for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
+        for (const auto boundary_id : this->get_boundary_composition_manager().get_fixed_composition_boundary_indicators())
+          {
+            VectorFunctionFromScalarFunctionObject<dim> composition (
+              [&] (const Point<dim> &x) -> double
+            {
+              return this->get_boundary_composition_manager().boundary_composition (boundary_id, x, c);
+            },
+            introspection.component_masks.compositional_fields[c].first_selected_component(),
+            introspection.n_components);
+
+            VectorTools::interpolate_boundary_values (this->get_mapping(),
+                                                      this->get_dof_handler(),
+                                                      boundary_id,
+                                                      composition,
+                                                      reference_constraints,
+                                                      introspection.component_masks.compositional_fields[c]);
+          }
+
+      reference_constraints.close ();
+
+      const ConstraintMatrix &current_constraints = this->get_current_constraints();
+
+      unsigned int n_differences = 0;
+      unsigned int n_constrained_dofs = 0;
+      for (const auto i : this->get_dof_handler().locally_owned_dofs())
+        {
+          if (reference_constraints.is_constrained (i) != current_constraints.is_constrained (i))
+            {
+              ++n_differences;
+              continue;
+            }
+
+          if (!reference_constraints.is_constrained (i))
+            continue;
+
+          ++n_constrained_dofs;
+
+          const double reference_value = reference_constraints.get_inhomogeneity (i);
+          const double value = current_constraints.get_inhomogeneity (i);
+          if (std::abs (reference_value - value) > 1e-12 * std::max (1.0, std::abs (reference_value)))
+            ++n_differences;
+
+          const std::vector<std::pair<types::global_dof_index,double> > *reference_entries
+            = reference_constraints.get_constraint_entries (i);
+          const std::vector<std::pair<types::global_dof_index,double> > *entries
+            = current_constraints.get_constraint_entries (i);
+          if ((reference_entries == nullptr) != (entries == nullptr)
+              ||
+              (reference_entries != nullptr && *reference_entries != *entries))
+            ++n_differences;
+        }
+
+      n_differences = Utilities::MPI::sum (n_differences, this->get_mpi_communicator());
+      n_constrained_dofs = Utilities::MPI::sum (n_constrained_dofs, this->get_mpi_communicator());
+
+      AssertThrow (n_differences == 0,
+                   ExcMessage ("The constraints computed from the boundary degree of freedom "
+                               "cache differ from the ones computed by "
+                               "VectorTools::interpolate_boundary_values() in "
+                               + Utilities::int_to_string (n_differences) + " degrees of freedom."));
+
+      return std::make_pair ("Number of constrained degrees of freedom:",
+                             Utilities::int_to_string (n_constrained_dofs));
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace BoundaryDoFCache
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CheckBoundaryConstraints,
+                                  "check boundary constraints",
+                                  "A postprocessor that checks that the constraints for "
+                                  "Dirichlet boundary conditions are the same as the ones "
+                                  "computed by VectorTools::interpolate_boundary_values.")
+  }
+}
@@ -0,0 +1,84 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_access.h>
+#include <aspect/simulator_signals.h>
+
+
+namespace aspect
+{
+  namespace CellCostModelRepartition
+  {
+    using namespace dealii;
+
+    namespace
+    {
+      /**
+       * The number of times the mesh was changed after the initial
+       * refinement. The model does not refine its mesh, so every mesh
+       * change is a repartitioning requested by the cell cost model.
+       */
+      unsigned int n_mesh_changes = 0;
+    }
+
+    /**
+     * A postprocessor that aborts if the mesh has not been repartitioned
+     * after the previous time step. The model uses a load imbalance
+     * threshold so small that the measured assembly costs of several
+     * processes always exceed it.
+     */
+    template <int dim>
+    class CheckRepartitioning : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+    };
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CheckRepartitioning<dim>::execute (TableHandler &)
+    {
+      AssertThrow (n_mesh_changes == this->get_timestep_number(),
+                   ExcMessage ("The mesh was repartitioned "
+                               + Utilities::int_to_string (n_mesh_changes)
+                               + " times before time step "
+                               + Utilities::int_to_string (this->get_timestep_number())
+                               + ", but the cell cost model should have requested "
+                               "a repartitioning after every time step."));
+
+      return std::make_pair ("Number of repartitionings:",
+                             Utilities::int_to_string (n_mesh_changes));
+    }
+
+
+
+    template <int dim>
+    void signal_connector (SimulatorSignals<dim> &signals)
+    {
+      signals.post_refinement_load_user_data.connect (
+        [] (typename parallel::distributed::Triangulation<dim> &)
+      {
+        ++n_mesh_changes;
+      });
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace CellCostModelRepartition
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CheckRepartitioning,
+                                  "check repartitioning",
+                                  "A postprocessor that checks that the mesh was "
+                                  "repartitioned after every time step.")
+
+    ASPECT_REGISTER_SIGNALS_CONNECTOR(signal_connector<2>,
+                                      signal_connector<3>)
+  }
+}
@@ -0,0 +1,64 @@
+#include <aspect/global.h>
+#include <aspect/simulator_signals.h>
+#include <aspect/boundary_velocity/gplates.h>
+#include <aspect/utilities.h>
+
+#include <deal.II/base/parameter_handler.h>
+
+
+namespace aspect
+{
+  namespace GPlatesBinary
+  {
+    using namespace dealii;
+
+    /**
+     * Read the velocity file given in the parameters of the GPlates
+     * plugin, write it in the binary format into the output directory,
+     * and let the plugin read the binary file instead of the original
+     * one.
+     */
+    template <int dim>
+    void write_binary_velocity_file (const Parameters<dim> &parameters,
+                                     ParameterHandler &prm)
+    {
+      prm.enter_subsection ("Boundary velocity model");
+      {
+        prm.enter_subsection ("GPlates model");
+        {
+          const std::string data_directory
+            = Utilities::expand_ASPECT_SOURCE_DIR (prm.get ("Data directory"));
+          const std::string velocity_file_name = prm.get ("Velocity file name");
+
+          Tensor<1,2> point_one, point_two;
+          char sep;
+          std::stringstream streampoint (prm.get ("Point one"));
+          streampoint >> point_one[0] >> sep >> point_one[1];
+          std::stringstream streampoint2 (prm.get ("Point two"));
+          streampoint2 >> point_two[0] >> sep >> point_two[1];
+
+          BoundaryVelocity::internal::GPlatesLookup<dim> lookup (point_one, point_two);
+          lookup.load_file (data_directory + velocity_file_name, MPI_COMM_WORLD);
+          lookup.write_binary_file (parameters.output_directory + velocity_file_name + ".bin",
+                                    MPI_COMM_WORLD);
+          MPI_Barrier (MPI_COMM_WORLD);
+
+          prm.set ("Data directory", parameters.output_directory);
+          prm.set ("Velocity file name", velocity_file_name + ".bin");
+        }
+        prm.leave_subsection ();
+      }
+      prm.leave_subsection ();
+    }
+
+
+
+    void parameter_connector ()
+    {
+      SimulatorSignals<2>::parse_additional_parameters.connect (&write_binary_velocity_file<2>);
+      SimulatorSignals<3>::parse_additional_parameters.connect (&write_binary_velocity_file<3>);
+    }
+
+    ASPECT_REGISTER_SIGNALS_PARAMETER_CONNECTOR(parameter_connector)
+  }
+}
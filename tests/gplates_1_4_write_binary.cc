@@ -0,0 +1,156 @@
+#include <aspect/global.h>
+#include <aspect/simulator_signals.h>
+#include <aspect/simulator_access.h>
+#include <aspect/postprocess/interface.h>
+#include <aspect/boundary_velocity/gplates.h>
+#include <aspect/utilities.h>
+
+#include <deal.II/base/parameter_handler.h>
+
+#include <fstream>
+
+
+namespace aspect
+{
+  namespace GPlatesWriteBinary
+  {
+    using namespace dealii;
+
+    namespace
+    {
+      /**
+       * The original velocity file, the velocity file in the output
+       * directory, and the points that define the plane of a 2D model.
+       */
+      std::string original_file_name;
+      std::string file_name;
+      Tensor<1,2> point_one, point_two;
+    }
+
+
+
+    /**
+     * Copy the velocity file given in the parameters of the GPlates plugin
+     * into the output directory and let the plugin read it from there, so
+     * that the binary file it writes ends up in the output directory as
+     * well.
+     */
+    template <int dim>
+    void copy_velocity_file (const Parameters<dim> &parameters,
+                             ParameterHandler &prm)
+    {
+      prm.enter_subsection ("Boundary velocity model");
+      {
+        prm.enter_subsection ("GPlates model");
+        {
+          const std::string velocity_file_name = prm.get ("Velocity file name");
+          original_file_name = Utilities::expand_ASPECT_SOURCE_DIR (prm.get ("Data directory"))
+                               + velocity_file_name;
+          file_name = parameters.output_directory + velocity_file_name;
+
+          char sep;
+          std::stringstream streampoint (prm.get ("Point one"));
+          streampoint >> point_one[0] >> sep >> point_one[1];
+          std::stringstream streampoint2 (prm.get ("Point two"));
+          streampoint2 >> point_two[0] >> sep >> point_two[1];
+
+          if (Utilities::MPI::this_mpi_process (MPI_COMM_WORLD) == 0)
+            {
+              std::ifstream in (original_file_name.c_str(), std::ios::binary);
+              std::ofstream out (file_name.c_str(), std::ios::binary);
+              out << in.rdbuf();
+            }
+          MPI_Barrier (MPI_COMM_WORLD);
+
+          prm.set ("Data directory", parameters.output_directory);
+        }
+        prm.leave_subsection ();
+      }
+      prm.leave_subsection ();
+    }
+
+
+
+    /**
+     * A postprocessor that reads the binary velocity file written by the
+     * GPlates plugin and the original velocity file, and aborts if the
+     * velocities of the two files differ at any vertex of the boundary of
+     * the model.
+     */
+    template <int dim>
+    class CheckBinaryVelocityFile : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+    };
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CheckBinaryVelocityFile<dim>::execute (TableHandler &)
+    {
+      AssertThrow (Utilities::fexists (file_name + ".bin"),
+                   ExcMessage ("The GPlates plugin did not write the binary velocity file <"
+                               + file_name + ".bin>."));
+
+      BoundaryVelocity::internal::GPlatesLookup<dim> original_lookup (point_one, point_two);
+      original_lookup.load_file (original_file_name, this->get_mpi_communicator());
+
+      BoundaryVelocity::internal::GPlatesLookup<dim> binary_lookup (point_one, point_two);
+      binary_lookup.load_file (file_name + ".bin", this->get_mpi_communicator());
+
+      unsigned int n_differences = 0;
+      unsigned int n_checked_points = 0;
+      for (const auto &cell : this->get_triangulation().active_cell_iterators())
+        if (cell->is_locally_owned() && cell->at_boundary())
+          for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+            if (cell->face(f)->at_boundary())
+              for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_face; ++v)
+                {
+                  const Point<dim> position = cell->face(f)->vertex(v);
+                  if (original_lookup.surface_velocity (position) != binary_lookup.surface_velocity (position))
+                    ++n_differences;
+                  ++n_checked_points;
+                }
+
+      n_differences = Utilities::MPI::sum (n_differences, this->get_mpi_communicator());
+      n_checked_points = Utilities::MPI::sum (n_checked_points, this->get_mpi_communicator());
+
+      AssertThrow (n_differences == 0,
+                   ExcMessage ("The velocities read from the binary velocity file differ "
+                               "from the ones read from the original file at "
+                               + Utilities::int_to_string (n_differences) + " points."));
+
+      return std::make_pair ("Number of checked points:",
+                             Utilities::int_to_string (n_checked_points));
+    }
+
+
+
+    void parameter_connector ()
+    {
+      SimulatorSignals<2>::parse_additional_parameters.connect (&copy_velocity_file<2>);
+      SimulatorSignals<3>::parse_additional_parameters.connect (&copy_velocity_file<3>);
+    }
+
+    ASPECT_REGISTER_SIGNALS_PARAMETER_CONNECTOR(parameter_connector)
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace GPlatesWriteBinary
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CheckBinaryVelocityFile,
+                                  "check binary velocity file",
+                                  "A postprocessor that checks that the binary velocity "
+                                  "file written by the GPlates plugin contains the same "
+                                  "velocities as the original file.")
+  }
+}
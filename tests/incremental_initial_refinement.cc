@@ -0,0 +1,110 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_access.h>
+#include <aspect/initial_temperature/interface.h>
+#include <aspect/initial_composition/interface.h>
+
+#include <deal.II/fe/fe_values.h>
+
+
+namespace aspect
+{
+  namespace IncrementalInitialRefinement
+  {
+    using namespace dealii;
+
+    /**
+     * A postprocessor that evaluates the initial temperature and
+     * composition at the support points of all unconstrained temperature
+     * and composition degrees of freedom of the final mesh, i.e., computes
+     * the values the initial conditions would have if they had been
+     * evaluated on the whole mesh, and aborts if the solution differs from
+     * them. Together with 'Incremental initial refinement', this checks that
+     * only evaluating the initial conditions on the cells changed by each
+     * refinement cycle gives the same initial fields.
+     */
+    template <int dim>
+    class CheckInitialFields : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+    };
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CheckInitialFields<dim>::execute (TableHandler &)
+    {
+      const Introspection<dim> &introspection = this->introspection();
+      const FiniteElement<dim> &fe = this->get_fe();
+      const unsigned int n_compositional_fields = this->n_compositional_fields();
+
+      // all advected fields use the same element in this test
+      const FiniteElement<dim> &temperature_fe = fe.base_element(introspection.base_elements.temperature);
+      FEValues<dim> fe_values (this->get_mapping(), fe,
+                               Quadrature<dim>(temperature_fe.get_unit_support_points()),
+                               update_quadrature_points);
+
+      std::vector<types::global_dof_index> local_dof_indices (fe.dofs_per_cell);
+      std::vector<double> compositions (n_compositional_fields);
+
+      double max_difference = 0;
+      for (const auto &cell : this->get_dof_handler().active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            fe_values.reinit (cell);
+            cell->get_dof_indices (local_dof_indices);
+
+            for (unsigned int i=0; i<temperature_fe.dofs_per_cell; ++i)
+              {
+                const Point<dim> &position = fe_values.quadrature_point(i);
+
+                const types::global_dof_index temperature_dof
+                  = local_dof_indices[fe.component_to_system_index(introspection.component_indices.temperature, i)];
+                if (!this->get_current_constraints().is_constrained (temperature_dof))
+                  max_difference = std::max (max_difference,
+                                             std::abs(this->get_solution()(temperature_dof)
+                                                      - this->get_initial_temperature_manager().initial_temperature(position)));
+
+                this->get_initial_composition_manager().initial_compositions (position, compositions);
+                for (unsigned int c=0; c<n_compositional_fields; ++c)
+                  {
+                    const types::global_dof_index composition_dof
+                      = local_dof_indices[fe.component_to_system_index(introspection.component_indices.compositional_fields[c], i)];
+                    if (!this->get_current_constraints().is_constrained (composition_dof))
+                      max_difference = std::max (max_difference,
+                                                 std::abs(this->get_solution()(composition_dof) - compositions[c]));
+                  }
+              }
+          }
+
+      max_difference = Utilities::MPI::max (max_difference, this->get_mpi_communicator());
+
+      AssertThrow (max_difference < 1e-10,
+                   ExcMessage ("The initial temperature or compositional fields computed with "
+                               "'Incremental initial refinement' differ from the initial "
+                               "conditions evaluated on the whole mesh."));
+
+      std::ostringstream os;
+      os << std::scientific << max_difference;
+      return std::make_pair ("Max difference to the initial conditions:", os.str());
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace IncrementalInitialRefinement
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CheckInitialFields,
+                                  "check initial fields",
+                                  "A postprocessor that checks that the temperature and "
+                                  "compositional fields are equal to the initial conditions "
+                                  "evaluated at their support points.")
+  }
+}
@@ -0,0 +1,166 @@
+#include "../benchmarks/nonlinear_channel_flow/simple_nonlinear.cc"
+
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_signals.h>
+#include <aspect/newton.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/function_lib.h>
+#include <deal.II/numerics/vector_tools.h>
+
+
+namespace aspect
+{
+  namespace JFNKChannelFlow
+  {
+    using namespace dealii;
+
+    namespace
+    {
+      /**
+       * The number of residual evaluations of the Jacobian-free
+       * Newton-Krylov method in all Stokes solves so far.
+       */
+      unsigned int n_residual_evaluations = 0;
+    }
+
+
+
+    /**
+     * The analytical velocity of the nonlinear channel flow with stress
+     * exponent n=3 that is also prescribed on the top and bottom
+     * boundaries in the input file.
+     */
+    template <int dim>
+    class ChannelFlowSolution : public Function<dim>
+    {
+      public:
+        ChannelFlowSolution (const unsigned int n_components)
+          : Function<dim>(n_components)
+        {}
+
+        virtual
+        void
+        vector_value (const Point<dim> &p,
+                      Vector<double>   &values) const
+        {
+          const double n = 3;
+          values = 0;
+          values[1] = (1e-37/(n+1)) * std::pow(1e9/8e3, n)
+                      * (std::pow(5e3, n+1) - std::pow(p[0]-5e3, n+1));
+        }
+    };
+
+
+
+    /**
+     * A postprocessor that computes the relative L2 error of the velocity
+     * computed with the Jacobian-free Newton-Krylov method and aborts the
+     * computation if it is larger than the discretization error we expect
+     * for this mesh. It also aborts if the Stokes solver never evaluated
+     * the residual, i.e., if the Jacobian-free Newton-Krylov method was
+     * not used.
+     */
+    template <int dim>
+    class ChannelFlowError : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+    };
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    ChannelFlowError<dim>::execute (TableHandler &)
+    {
+      const unsigned int n_components = this->introspection().n_components;
+      const ChannelFlowSolution<dim> exact_solution (n_components);
+      const Functions::ZeroFunction<dim> zero (n_components);
+
+      AssertThrow (n_residual_evaluations > 0,
+                   ExcMessage ("The Stokes solver did not use the Jacobian-free "
+                               "Newton-Krylov method."));
+
+      const QGauss<dim> quadrature_formula (this->introspection().polynomial_degree.velocities+2);
+      const ComponentSelectFunction<dim> comp_u (std::pair<unsigned int, unsigned int>(0,dim),
+                                                 n_components);
+
+      Vector<float> cellwise_errors_u (this->get_triangulation().n_active_cells());
+      Vector<float> cellwise_norms_u (this->get_triangulation().n_active_cells());
+
+      VectorTools::integrate_difference (this->get_mapping(),this->get_dof_handler(),
+                                         this->get_solution(),
+                                         exact_solution,
+                                         cellwise_errors_u,
+                                         quadrature_formula,
+                                         VectorTools::L2_norm,
+                                         &comp_u);
+      VectorTools::integrate_difference (this->get_mapping(),this->get_dof_handler(),
+                                         this->get_solution(),
+                                         zero,
+                                         cellwise_norms_u,
+                                         quadrature_formula,
+                                         VectorTools::L2_norm,
+                                         &comp_u);
+
+      const double u_l2 = std::sqrt(Utilities::MPI::sum(cellwise_errors_u.norm_sqr(),this->get_mpi_communicator()));
+      const double u_norm = std::sqrt(Utilities::MPI::sum(cellwise_norms_u.norm_sqr(),this->get_mpi_communicator()));
+
+      AssertThrow (u_l2 <= 1e-3 * u_norm,
+                   ExcMessage ("The Jacobian-free Newton-Krylov method did not converge "
+                               "to the analytical solution of the channel flow."));
+
+      std::ostringstream os;
+      os << std::scientific << u_l2 / u_norm;
+
+      return std::make_pair("Relative velocity error u_L2:", os.str());
+    }
+
+
+
+    /**
+     * Add up the residual evaluations of every Stokes solve. The Newton
+     * handler resets its count at the beginning of every Stokes solve that
+     * uses the Jacobian-free Newton-Krylov method.
+     */
+    template <int dim>
+    void count_residual_evaluations (const SimulatorAccess<dim> &simulator_access,
+                                     const unsigned int,
+                                     const unsigned int,
+                                     const SolverControl &,
+                                     const SolverControl &)
+    {
+      if (simulator_access.get_newton_handler().parameters.use_jacobian_free_newton_krylov)
+        n_residual_evaluations += simulator_access.get_newton_handler().get_n_residual_evaluations();
+    }
+
+
+
+    template <int dim>
+    void signal_connector (SimulatorSignals<dim> &signals)
+    {
+      signals.post_stokes_solver.connect (&count_residual_evaluations<dim>);
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace JFNKChannelFlow
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(ChannelFlowError,
+                                  "channel flow error",
+                                  "A postprocessor that compares the velocity of the nonlinear "
+                                  "channel flow with the analytical solution and aborts if "
+                                  "the relative error is too large.")
+
+    ASPECT_REGISTER_SIGNALS_CONNECTOR(signal_connector<2>,
+                                      signal_connector<3>)
+  }
+}
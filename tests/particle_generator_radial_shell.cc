@@ -0,0 +1,141 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/postprocess/particles.h>
+#include <aspect/particle/world.h>
+#include <aspect/simulator_access.h>
+
+#include <deal.II/grid/grid_tools.h>
+
+
+namespace aspect
+{
+  namespace ParticleGeneratorRadialShell
+  {
+    using namespace dealii;
+
+    /**
+     * A postprocessor that checks the cells in which the particles were
+     * generated. It aborts if a particle is not in a locally owned cell, if
+     * its reference location is not the one of its position in its cell, or
+     * if GridTools::find_active_cell_around_point() does not find the same
+     * cell for a particle in the interior of its cell. It also
+     * aborts if the particle indices are not 0, 1, ..., i.e., if a particle
+     * was lost or generated on more than one process.
+     */
+    template <int dim>
+    class CheckParticleCells : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+
+        virtual
+        std::list<std::string>
+        required_other_postprocessors () const;
+    };
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CheckParticleCells<dim>::execute (TableHandler &)
+    {
+      const Postprocess::Particles<dim> &particle_postprocessor =
+        this->get_postprocess_manager().template get_matching_postprocessor<Postprocess::Particles<dim> >();
+
+      const Particle::ParticleHandler<dim> &particle_handler =
+        particle_postprocessor.get_particle_world().get_particle_handler();
+
+      unsigned int n_errors = 0;
+      double n_particles = 0;
+      double sum_of_ids = 0;
+      double max_id = 0;
+      for (auto particle = particle_handler.begin(); particle != particle_handler.end(); ++particle)
+        {
+          n_particles += 1;
+          sum_of_ids += particle->get_id();
+          max_id = std::max (max_id, static_cast<double>(particle->get_id()));
+
+          const typename parallel::distributed::Triangulation<dim>::active_cell_iterator
+          cell (particle->get_surrounding_cell(this->get_triangulation()));
+          if (!cell->is_locally_owned())
+            {
+              ++n_errors;
+              continue;
+            }
+
+          const Point<dim> unit_point = this->get_mapping().transform_real_to_unit_cell (cell, particle->get_location());
+          if (unit_point.distance (particle->get_reference_location()) > 1e-10
+              ||
+              !GeometryInfo<dim>::is_inside_unit_cell (unit_point, 1e-10))
+            {
+              ++n_errors;
+              continue;
+            }
+
+          // the cell the deal.II function finds may only differ if the
+          // particle is on a face (or vertex) of its cell, and the deal.II
+          // function may not find particles on the boundary of the domain
+          // at all
+          if (GeometryInfo<dim>::is_inside_unit_cell (unit_point, -1e-10))
+            {
+              try
+                {
+                  const std::pair<typename parallel::distributed::Triangulation<dim>::active_cell_iterator, Point<dim> > reference
+                    = GridTools::find_active_cell_around_point (this->get_mapping(),
+                                                                this->get_triangulation(),
+                                                                particle->get_location());
+                  if (reference.first != cell)
+                    ++n_errors;
+                }
+              catch (const GridTools::ExcPointNotFound<dim> &)
+                {
+                  ++n_errors;
+                }
+            }
+        }
+
+      n_errors = Utilities::MPI::sum (n_errors, this->get_mpi_communicator());
+      n_particles = Utilities::MPI::sum (n_particles, this->get_mpi_communicator());
+      sum_of_ids = Utilities::MPI::sum (sum_of_ids, this->get_mpi_communicator());
+      max_id = Utilities::MPI::max (max_id, this->get_mpi_communicator());
+
+      AssertThrow (n_errors == 0,
+                   ExcMessage (Utilities::int_to_string (n_errors)
+                               + " particles are not in the cells that contain them."));
+      AssertThrow (n_particles == particle_postprocessor.get_particle_world().n_global_particles()
+                   &&
+                   max_id + 1 == n_particles
+                   &&
+                   sum_of_ids == n_particles * (n_particles - 1) / 2,
+                   ExcMessage ("The particle indices are not the numbers from zero "
+                               "to the number of particles minus one."));
+
+      return std::make_pair ("Number of checked particles:",
+                             Utilities::int_to_string (static_cast<unsigned int>(n_particles)));
+    }
+
+
+
+    template <int dim>
+    std::list<std::string>
+    CheckParticleCells<dim>::required_other_postprocessors() const
+    {
+      return std::list<std::string> (1, "particles");
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace ParticleGeneratorRadialShell
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CheckParticleCells,
+                                  "check particle cells",
+                                  "A postprocessor that checks that all particles are "
+                                  "located in the cells that contain them.")
+  }
+}
@@ -0,0 +1,206 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_access.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+
+namespace aspect
+{
+  namespace ProfilerTest
+  {
+    using namespace dealii;
+
+    /**
+     * A postprocessor that reads the profile the model wrote after the
+     * previous time step and aborts if it does not contain the regions
+     * every model run enters, if the regions do not form a tree, or if it
+     * contains hardware counters although the model does not record them.
+     * Only the paths, names, and numbers of calls of the regions are
+     * checked, because the times are different in every run.
+     */
+    template <int dim>
+    class CheckProfile : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+    };
+
+
+
+    namespace
+    {
+      /**
+       * Return the text of @p text between the first occurrence of
+       * @p begin after position @p position and the next occurrence of
+       * @p end, and move @p position behind it. Return an empty string and
+       * set @p position to std::string::npos if there is no such text.
+       */
+      std::string
+      extract (const std::string &text,
+               const std::string &begin,
+               const std::string &end,
+               std::string::size_type &position)
+      {
+        const std::string::size_type start = text.find (begin, position);
+        if (start == std::string::npos)
+          {
+            position = std::string::npos;
+            return "";
+          }
+
+        const std::string::size_type stop = text.find (end, start + begin.size());
+        if (stop == std::string::npos)
+          {
+            position = std::string::npos;
+            return "";
+          }
+
+        position = stop + end.size();
+        return text.substr (start + begin.size(), stop - start - begin.size());
+      }
+    }
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CheckProfile<dim>::execute (TableHandler &)
+    {
+      // the profile of the current time step is only written after the
+      // postprocessors have run
+      if (this->get_timestep_number() == 0)
+        return std::pair<std::string,std::string>();
+
+      const unsigned int previous_timestep = this->get_timestep_number() - 1;
+
+      std::ostringstream errors;
+      unsigned int n_regions = 0;
+
+      // only the first process writes the profile
+      if (Utilities::MPI::this_mpi_process (this->get_mpi_communicator()) == 0)
+        {
+          const std::string filename = this->get_output_directory()
+                                       + "profile-"
+                                       + Utilities::int_to_string (previous_timestep, 5)
+                                       + ".json";
+          std::ifstream in (filename.c_str());
+          if (!in)
+            errors << "Could not open the profile <" << filename << ">." << std::endl;
+          std::ostringstream contents;
+          contents << in.rdbuf();
+          const std::string profile = contents.str();
+
+          if (profile.find ("\"timestep\": " + Utilities::int_to_string (previous_timestep) + ",") == std::string::npos)
+            errors << "The profile does not contain the number of its time step." << std::endl;
+          if (profile.find ("\"n_processes\": "
+                            + Utilities::int_to_string (Utilities::MPI::n_mpi_processes (this->get_mpi_communicator()))
+                            + ",") == std::string::npos)
+            errors << "The profile does not contain the number of processes." << std::endl;
+          if (profile.find ("cpu_cycles") != std::string::npos
+              ||
+              profile.find ("instructions") != std::string::npos
+              ||
+              profile.find ("cache_misses") != std::string::npos)
+            errors << "The profile contains hardware counters although they are not recorded." << std::endl;
+
+          // read the path, name, and depth of every region, and the
+          // minimum and maximum number of calls over all processes
+          std::map<std::string,std::pair<std::string,std::string> > calls;
+          std::string::size_type position = 0;
+          while (true)
+            {
+              const std::string path = extract (profile, "{\"path\": \"", "\"", position);
+              if (position == std::string::npos)
+                break;
+              const std::string name = extract (profile, "\"name\": \"", "\"", position);
+              const std::string depth = extract (profile, "\"depth\": ", ",", position);
+              const std::string min_calls = extract (profile, "\"calls\": {\"min\": ", ",", position);
+              const std::string max_calls = extract (profile, "\"max\": ", "}", position);
+              if (position == std::string::npos)
+                {
+                  errors << "The entry of the region <" << path << "> is incomplete." << std::endl;
+                  break;
+                }
+
+              ++n_regions;
+              calls[path] = std::make_pair (min_calls, max_calls);
+
+              const std::string::size_type last_separator = path.rfind ('/');
+              if (name != (last_separator == std::string::npos ? path : path.substr (last_separator+1)))
+                errors << "The region <" << path << "> has the name <" << name << ">." << std::endl;
+              if (depth != Utilities::int_to_string (static_cast<unsigned int>(std::count (path.begin(), path.end(), '/'))))
+                errors << "The region <" << path << "> has the depth " << depth << "." << std::endl;
+            }
+
+          // every region that is nested into another one is only closed
+          // after the region that contains it was opened, so the profile
+          // also needs to contain the containing region
+          for (const auto &region : calls)
+            {
+              const std::string::size_type last_separator = region.first.rfind ('/');
+              if (last_separator != std::string::npos
+                  &&
+                  calls.find (region.first.substr (0, last_separator)) == calls.end())
+                errors << "The region <" << region.first << "> is not nested into a region "
+                       << "of the profile." << std::endl;
+            }
+
+          // the regions of the simulator and of the plugin managers that
+          // every time step of this model enters. the postprocessors run
+          // once per time step on every process
+          const char *expected_regions[] =
+          {
+            "Initialization",
+            "Setup dof systems",
+            "Setup initial conditions",
+            "Setup initial conditions/Initial temperature model: function",
+            "Assemble Stokes system",
+            "Assemble Stokes system/Material model",
+            "Solve Stokes system",
+            "Postprocessing",
+            "Postprocessing/Postprocessor: velocity statistics",
+            "Postprocessing/Postprocessor: check profile"
+          };
+          for (const char *region : expected_regions)
+            if (calls.find (region) == calls.end())
+              errors << "The profile does not contain the region <" << region << ">." << std::endl;
+
+          const std::string n_postprocessing_calls = Utilities::int_to_string (previous_timestep + 1);
+          if (calls.find ("Postprocessing") != calls.end()
+              &&
+              calls["Postprocessing"] != std::make_pair (n_postprocessing_calls, n_postprocessing_calls))
+            errors << "The region <Postprocessing> was not entered once per time step "
+                   << "on every process." << std::endl;
+        }
+
+      const unsigned int n_errors = Utilities::MPI::sum (errors.str().empty() ? 0U : 1U,
+                                                         this->get_mpi_communicator());
+      AssertThrow (n_errors == 0,
+                   ExcMessage ("The profile of time step "
+                               + Utilities::int_to_string (previous_timestep)
+                               + " is not correct:\n" + errors.str()));
+
+      return std::make_pair ("Number of profile regions:",
+                             Utilities::int_to_string (n_regions));
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace ProfilerTest
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CheckProfile,
+                                  "check profile",
+                                  "A postprocessor that checks the regions of the profile "
+                                  "written after the previous time step.")
+  }
+}
@@ -0,0 +1,103 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_access.h>
+#include <aspect/quadrature_point_geometry.h>
+#include <aspect/geometry_model/interface.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/fe/fe_values.h>
+
+
+namespace aspect
+{
+  namespace QuadraturePointGeometryCache
+  {
+    using namespace dealii;
+
+    /**
+     * A postprocessor that looks up all quadrature points of the Stokes,
+     * temperature and composition assembly on all locally owned cells in the cache of
+     * quadrature point geometry, and aborts if any lookup fails or returns
+     * a wrong depth. This makes sure that the plugins that use the cache
+     * actually find their values in it, rather than silently falling back
+     * to computing them. The postprocessor does not produce any output, so
+     * that the output of the model is the same as without it.
+     */
+    template <int dim>
+    class CheckCacheHits : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+    };
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CheckCacheHits<dim>::execute (TableHandler &)
+    {
+      AssertThrow (this->get_quadrature_point_geometry().is_enabled(),
+                   ExcMessage ("This postprocessor requires the cache of quadrature "
+                               "point geometry to be enabled."));
+
+      const Parameters<dim> &parameters = this->get_parameters();
+      std::vector<unsigned int> quadrature_degrees;
+      quadrature_degrees.push_back (parameters.stokes_velocity_degree+1);
+      quadrature_degrees.push_back (parameters.temperature_degree + (parameters.stokes_velocity_degree+1)/2);
+      if (parameters.n_compositional_fields > 0)
+        quadrature_degrees.push_back (parameters.composition_degree + (parameters.stokes_velocity_degree+1)/2);
+
+      unsigned int n_misses = 0;
+      for (const unsigned int degree : quadrature_degrees)
+        {
+          const QGauss<dim> quadrature_formula (degree);
+          FEValues<dim> fe_values (this->get_mapping(),
+                                   this->get_fe(),
+                                   quadrature_formula,
+                                   update_quadrature_points);
+
+          for (const auto &cell : this->get_dof_handler().active_cell_iterators())
+            if (cell->is_locally_owned())
+              {
+                fe_values.reinit (cell);
+                for (unsigned int q=0; q<quadrature_formula.size(); ++q)
+                  {
+                    const typename QuadraturePointGeometry<dim>::PointData *point_data
+                      = this->get_quadrature_point_geometry().get_point_data (cell,
+                                                                               q,
+                                                                               fe_values.quadrature_point(q));
+                    if (point_data == nullptr
+                        ||
+                        point_data->depth != this->get_geometry_model().depth(fe_values.quadrature_point(q)))
+                      ++n_misses;
+                  }
+              }
+        }
+
+      n_misses = Utilities::MPI::sum (n_misses, this->get_mpi_communicator());
+      AssertThrow (n_misses == 0,
+                   ExcMessage ("The cache of quadrature point geometry did not contain "
+                               "the correct values for "
+                               + Utilities::int_to_string (n_misses)
+                               + " quadrature points of the assembly."));
+
+      return std::pair<std::string,std::string>();
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace QuadraturePointGeometryCache
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CheckCacheHits,
+                                  "check quadrature point geometry cache hits",
+                                  "A postprocessor that checks that the quadrature points "
+                                  "of the assembly are found in the cache of quadrature "
+                                  "point geometry.")
+  }
+}
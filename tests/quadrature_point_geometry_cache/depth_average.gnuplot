@@ -0,0 +1,147 @@
+# This file was generated by the deal.II library.
+
+
+#
+# For a description of the GNUPLOT format see the GNUPLOT manual.
+#
+# <x> <y> <temperature> <adiabatic_temperature> <adiabatic_pressure> <adiabatic_density> <adiabatic_density_derivative> <velocity_magnitude> <sinking_velocity> <viscosity> <vertical_heat_flux> 
+0 -1e+07 398 0 0 3300 0 9.26353e-09 7.38108e-10 1e+21 0.00333333 
+300000 -1e+07 398 0 0 3300 0 9.26353e-09 7.38108e-10 1e+21 0.00333333 
+
+0 0 398 0 0 3300 0 9.26353e-09 7.38108e-10 1e+21 0.00333333 
+300000 0 398 0 0 3300 0 9.26353e-09 7.38108e-10 1e+21 0.00333333 
+
+
+300000 -1e+07 648 0 22000 3300 0 6.26512e-09 1.79074e-09 1e+21 0.00333334 
+600000 -1e+07 648 0 22000 3300 0 6.26512e-09 1.79074e-09 1e+21 0.00333334 
+
+300000 0 648 0 22000 3300 0 6.26512e-09 1.79074e-09 1e+21 0.00333334 
+600000 0 648 0 22000 3300 0 6.26512e-09 1.79074e-09 1e+21 0.00333334 
+
+
+600000 -1e+07 898 0 43801.8 3300 0 4.5035e-09 2.14901e-09 2.275e+22 0.00333334 
+900000 -1e+07 898 0 43801.8 3300 0 4.5035e-09 2.14901e-09 2.275e+22 0.00333334 
+
+600000 0 898 0 43801.8 3300 0 4.5035e-09 2.14901e-09 2.275e+22 0.00333334 
+900000 0 898 0 43801.8 3300 0 4.5035e-09 2.14901e-09 2.275e+22 0.00333334 
+
+
+900000 -1e+07 1148 0 66000 3300 0 4.40525e-09 2.15821e-09 3e+22 0.00333334 
+1.2e+06 -1e+07 1148 0 66000 3300 0 4.40525e-09 2.15821e-09 3e+22 0.00333334 
+
+900000 0 1148 0 66000 3300 0 4.40525e-09 2.15821e-09 3e+22 0.00333334 
+1.2e+06 0 1148 0 66000 3300 0 4.40525e-09 2.15821e-09 3e+22 0.00333334 
+
+
+1.2e+06 -1e+07 1398 0 88000 3300 0 4.45951e-09 2.0215e-09 3e+22 0.00333334 
+1.5e+06 -1e+07 1398 0 88000 3300 0 4.45951e-09 2.0215e-09 3e+22 0.00333334 
+
+1.2e+06 0 1398 0 88000 3300 0 4.45951e-09 2.0215e-09 3e+22 0.00333334 
+1.5e+06 0 1398 0 88000 3300 0 4.45951e-09 2.0215e-09 3e+22 0.00333334 
+
+
+1.5e+06 -1e+07 1648 0 110000 3300 0 4.34517e-09 1.77607e-09 3e+22 0.00333334 
+1.8e+06 -1e+07 1648 0 110000 3300 0 4.34517e-09 1.77607e-09 3e+22 0.00333334 
+
+1.5e+06 0 1648 0 110000 3300 0 4.34517e-09 1.77607e-09 3e+22 0.00333334 
+1.8e+06 0 1648 0 110000 3300 0 4.34517e-09 1.77607e-09 3e+22 0.00333334 
+
+
+1.8e+06 -1e+07 1898 0 132000 3300 0 4.07347e-09 1.45248e-09 3e+22 0.00333333 
+2.1e+06 -1e+07 1898 0 132000 3300 0 4.07347e-09 1.45248e-09 3e+22 0.00333333 
+
+1.8e+06 0 1898 0 132000 3300 0 4.07347e-09 1.45248e-09 3e+22 0.00333333 
+2.1e+06 0 1898 0 132000 3300 0 4.07347e-09 1.45248e-09 3e+22 0.00333333 
+
+
+2.1e+06 -1e+07 2148 0 154000 3300 0 3.69673e-09 1.07374e-09 3e+22 0.00333333 
+2.4e+06 -1e+07 2148 0 154000 3300 0 3.69673e-09 1.07374e-09 3e+22 0.00333333 
+
+2.1e+06 0 2148 0 154000 3300 0 3.69673e-09 1.07374e-09 3e+22 0.00333333 
+2.4e+06 0 2148 0 154000 3300 0 3.69673e-09 1.07374e-09 3e+22 0.00333333 
+
+
+2.4e+06 -1e+07 2398 0 176000 3300 0 3.28028e-09 6.58265e-10 3e+22 0.00333333 
+2.7e+06 -1e+07 2398 0 176000 3300 0 3.28028e-09 6.58265e-10 3e+22 0.00333333 
+
+2.4e+06 0 2398 0 176000 3300 0 3.28028e-09 6.58265e-10 3e+22 0.00333333 
+2.7e+06 0 2398 0 176000 3300 0 3.28028e-09 6.58265e-10 3e+22 0.00333333 
+
+
+2.7e+06 -1e+07 2648 0 198000 3300 0 2.92812e-09 2.2172e-10 3e+22 0.00333333 
+3e+06 -1e+07 2648 0 198000 3300 0 2.92812e-09 2.2172e-10 3e+22 0.00333333 
+
+2.7e+06 0 2648 0 198000 3300 0 2.92812e-09 2.2172e-10 3e+22 0.00333333 
+3e+06 0 2648 0 198000 3300 0 2.92812e-09 2.2172e-10 3e+22 0.00333333 
+
+
+0 0 398 0 0 3300 0 9.13657e-09 7.26982e-10 1e+21 0.00333333 
+300000 0 398 0 0 3300 0 9.13657e-09 7.26982e-10 1e+21 0.00333333 
+
+0 1e+08 398 0 0 3300 0 9.13657e-09 7.26982e-10 1e+21 0.00333333 
+300000 1e+08 398 0 0 3300 0 9.13657e-09 7.26982e-10 1e+21 0.00333333 
+
+
+300000 0 648 0 22000 3300 0 6.22864e-09 1.77038e-09 1e+21 0.00333334 
+600000 0 648 0 22000 3300 0 6.22864e-09 1.77038e-09 1e+21 0.00333334 
+
+300000 1e+08 648 0 22000 3300 0 6.22864e-09 1.77038e-09 1e+21 0.00333334 
+600000 1e+08 648 0 22000 3300 0 6.22864e-09 1.77038e-09 1e+21 0.00333334 
+
+
+600000 0 898 0 43801.8 3300 0 4.4673e-09 2.12958e-09 2.275e+22 0.00333334 
+900000 0 898 0 43801.8 3300 0 4.4673e-09 2.12958e-09 2.275e+22 0.00333334 
+
+600000 1e+08 898 0 43801.8 3300 0 4.4673e-09 2.12958e-09 2.275e+22 0.00333334 
+900000 1e+08 898 0 43801.8 3300 0 4.4673e-09 2.12958e-09 2.275e+22 0.00333334 
+
+
+900000 0 1148 0 66000 3300 0 4.36631e-09 2.13994e-09 3e+22 0.00333334 
+1.2e+06 0 1148 0 66000 3300 0 4.36631e-09 2.13994e-09 3e+22 0.00333334 
+
+900000 1e+08 1148 0 66000 3300 0 4.36631e-09 2.13994e-09 3e+22 0.00333334 
+1.2e+06 1e+08 1148 0 66000 3300 0 4.36631e-09 2.13994e-09 3e+22 0.00333334 
+
+
+1.2e+06 0 1398 0 88000 3300 0 4.42128e-09 2.00527e-09 3e+22 0.00333334 
+1.5e+06 0 1398 0 88000 3300 0 4.42128e-09 2.00527e-09 3e+22 0.00333334 
+
+1.2e+06 1e+08 1398 0 88000 3300 0 4.42128e-09 2.00527e-09 3e+22 0.00333334 
+1.5e+06 1e+08 1398 0 88000 3300 0 4.42128e-09 2.00527e-09 3e+22 0.00333334 
+
+
+1.5e+06 0 1648 0 110000 3300 0 4.30968e-09 1.76239e-09 3e+22 0.00333334 
+1.8e+06 0 1648 0 110000 3300 0 4.30968e-09 1.76239e-09 3e+22 0.00333334 
+
+1.5e+06 1e+08 1648 0 110000 3300 0 4.30968e-09 1.76239e-09 3e+22 0.00333334 
+1.8e+06 1e+08 1648 0 110000 3300 0 4.30968e-09 1.76239e-09 3e+22 0.00333334 
+
+
+1.8e+06 0 1898 0 132000 3300 0 4.04169e-09 1.44164e-09 3e+22 0.00333333 
+2.1e+06 0 1898 0 132000 3300 0 4.04169e-09 1.44164e-09 3e+22 0.00333333 
+
+1.8e+06 1e+08 1898 0 132000 3300 0 4.04169e-09 1.44164e-09 3e+22 0.00333333 
+2.1e+06 1e+08 1898 0 132000 3300 0 4.04169e-09 1.44164e-09 3e+22 0.00333333 
+
+
+2.1e+06 0 2148 0 154000 3300 0 3.66899e-09 1.06591e-09 3e+22 0.00333333 
+2.4e+06 0 2148 0 154000 3300 0 3.66899e-09 1.06591e-09 3e+22 0.00333333 
+
+2.1e+06 1e+08 2148 0 154000 3300 0 3.66899e-09 1.06591e-09 3e+22 0.00333333 
+2.4e+06 1e+08 2148 0 154000 3300 0 3.66899e-09 1.06591e-09 3e+22 0.00333333 
+
+
+2.4e+06 0 2398 0 176000 3300 0 3.25642e-09 6.53538e-10 3e+22 0.00333333 
+2.7e+06 0 2398 0 176000 3300 0 3.25642e-09 6.53538e-10 3e+22 0.00333333 
+
+2.4e+06 1e+08 2398 0 176000 3300 0 3.25642e-09 6.53538e-10 3e+22 0.00333333 
+2.7e+06 1e+08 2398 0 176000 3300 0 3.25642e-09 6.53538e-10 3e+22 0.00333333 
+
+
+2.7e+06 0 2648 0 198000 3300 0 2.90722e-09 2.2014e-10 3e+22 0.00333333 
+3e+06 0 2648 0 198000 3300 0 2.90722e-09 2.2014e-10 3e+22 0.00333333 
+
+2.7e+06 1e+08 2648 0 198000 3300 0 2.90722e-09 2.2014e-10 3e+22 0.00333333 
+3e+06 1e+08 2648 0 198000 3300 0 2.90722e-09 2.2014e-10 3e+22 0.00333333 
+
+
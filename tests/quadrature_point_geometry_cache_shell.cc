@@ -0,0 +1 @@
+#include "quadrature_point_geometry_cache.cc"
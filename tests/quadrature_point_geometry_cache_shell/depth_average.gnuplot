@@ -0,0 +1,147 @@
+# This file was generated by the deal.II library.
+
+
+#
+# For a description of the GNUPLOT format see the GNUPLOT manual.
+#
+# <x> <y> <temperature> <adiabatic_temperature> <adiabatic_pressure> <adiabatic_density> <adiabatic_density_derivative> <velocity_magnitude> <sinking_velocity> <viscosity> <vertical_heat_flux> 
+0 -100000 1361.27 1600 1446.53 3205.54 0.000979439 0.0314707 0.00103489 1e+21 0.0913781 
+285500 -100000 1361.27 1600 1446.53 3205.54 0.000979439 0.0314707 0.00103489 1e+21 0.0913781 
+
+0 0 1361.27 1600 1446.53 3205.54 0.000979439 0.0314707 0.00103489 1e+21 0.0913781 
+285500 0 1361.27 1600 1446.53 3205.54 0.000979439 0.0314707 0.00103489 1e+21 0.0913781 
+
+
+285500 -100000 1803.67 1739.15 1.04817e+10 3483.39 0.00114882 0.021868 0.00297498 1e+21 0.35706 
+571000 -100000 1803.67 1739.15 1.04817e+10 3483.39 0.00114882 0.021868 0.00297498 1e+21 0.35706 
+
+285500 0 1803.67 1739.15 1.04817e+10 3483.39 0.00114882 0.021868 0.00297498 1e+21 0.35706 
+571000 0 1803.67 1739.15 1.04817e+10 3483.39 0.00114882 0.021868 0.00297498 1e+21 0.35706 
+
+
+571000 -100000 1876.42 1846.06 2.23377e+10 3971.03 0.000380179 0.0172922 0.00156042 1e+21 -1.38538 
+856500 -100000 1876.42 1846.06 2.23377e+10 3971.03 0.000380179 0.0172922 0.00156042 1e+21 -1.38538 
+
+571000 0 1876.42 1846.06 2.23377e+10 3971.03 0.000380179 0.0172922 0.00156042 1e+21 -1.38538 
+856500 0 1876.42 1846.06 2.23377e+10 3971.03 0.000380179 0.0172922 0.00156042 1e+21 -1.38538 
+
+
+856500 -100000 1978.49 1962.58 3.62116e+10 4497.52 0.000608079 0.0147838 0.00465243 1e+21 1.00646 
+1.142e+06 -100000 1978.49 1962.58 3.62116e+10 4497.52 0.000608079 0.0147838 0.00465243 1e+21 1.00646 
+
+856500 0 1978.49 1962.58 3.62116e+10 4497.52 0.000608079 0.0147838 0.00465243 1e+21 1.00646 
+1.142e+06 0 1978.49 1962.58 3.62116e+10 4497.52 0.000608079 0.0147838 0.00465243 1e+21 1.00646 
+
+
+1.142e+06 -100000 2073.94 2069.55 5.07219e+10 4683.67 0.000567323 0.0143283 0.00314997 1e+21 -0.0800494 
+1.4275e+06 -100000 2073.94 2069.55 5.07219e+10 4683.67 0.000567323 0.0143283 0.00314997 1e+21 -0.0800494 
+
+1.142e+06 0 2073.94 2069.55 5.07219e+10 4683.67 0.000567323 0.0143283 0.00314997 1e+21 -0.0800494 
+1.4275e+06 0 2073.94 2069.55 5.07219e+10 4683.67 0.000567323 0.0143283 0.00314997 1e+21 -0.0800494 
+
+
+1.4275e+06 -100000 2162.21 2167.67 6.57916e+10 4858.47 0.000535611 0.0541129 0.000147141 1e+21 -21.2275 
+1.713e+06 -100000 2162.21 2167.67 6.57916e+10 4858.47 0.000535611 0.0541129 0.000147141 1e+21 -21.2275 
+
+1.4275e+06 0 2162.21 2167.67 6.57916e+10 4858.47 0.000535611 0.0541129 0.000147141 1e+21 -21.2275 
+1.713e+06 0 2162.21 2167.67 6.57916e+10 4858.47 0.000535611 0.0541129 0.000147141 1e+21 -21.2275 
+
+
+1.713e+06 -100000 2245.21 2259.07 8.14463e+10 5024.44 0.000511576 0.0458389 0.0112085 1e+21 -7.86455 
+1.9985e+06 -100000 2245.21 2259.07 8.14463e+10 5024.44 0.000511576 0.0458389 0.0112085 1e+21 -7.86455 
+
+1.713e+06 0 2245.21 2259.07 8.14463e+10 5024.44 0.000511576 0.0458389 0.0112085 1e+21 -7.86455 
+1.9985e+06 0 2245.21 2259.07 8.14463e+10 5024.44 0.000511576 0.0458389 0.0112085 1e+21 -7.86455 
+
+
+1.9985e+06 -100000 2287.3 2345.43 9.77589e+10 5183.92 0.000495006 0.151647 0.150351 1e+21 68.7385 
+2.284e+06 -100000 2287.3 2345.43 9.77589e+10 5183.92 0.000495006 0.151647 0.150351 1e+21 68.7385 
+
+1.9985e+06 0 2287.3 2345.43 9.77589e+10 5183.92 0.000495006 0.151647 0.150351 1e+21 68.7385 
+2.284e+06 0 2287.3 2345.43 9.77589e+10 5183.92 0.000495006 0.151647 0.150351 1e+21 68.7385 
+
+
+2.284e+06 -100000 2343.16 2428.26 1.14866e+11 5339.36 0.000486558 0.0500273 0.01036 1e+21 -12.2248 
+2.5695e+06 -100000 2343.16 2428.26 1.14866e+11 5339.36 0.000486558 0.0500273 0.01036 1e+21 -12.2248 
+
+2.284e+06 0 2343.16 2428.26 1.14866e+11 5339.36 0.000486558 0.0500273 0.01036 1e+21 -12.2248 
+2.5695e+06 0 2343.16 2428.26 1.14866e+11 5339.36 0.000486558 0.0500273 0.01036 1e+21 -12.2248 
+
+
+2.5695e+06 -100000 2967.53 2503.47 1.29971e+11 5517.7 0 0.0651684 0 1e+21 -37.0731 
+2.855e+06 -100000 2967.53 2503.47 1.29971e+11 5517.7 0 0.0651684 0 1e+21 -37.0731 
+
+2.5695e+06 0 2967.53 2503.47 1.29971e+11 5517.7 0 0.0651684 0 1e+21 -37.0731 
+2.855e+06 0 2967.53 2503.47 1.29971e+11 5517.7 0 0.0651684 0 1e+21 -37.0731 
+
+
+0 0 1332.04 1600 1446.53 3205.54 0.000979439 0.0321411 0.00103282 1e+21 0.0900869 
+285500 0 1332.04 1600 1446.53 3205.54 0.000979439 0.0321411 0.00103282 1e+21 0.0900869 
+
+0 1e+06 1332.04 1600 1446.53 3205.54 0.000979439 0.0321411 0.00103282 1e+21 0.0900869 
+285500 1e+06 1332.04 1600 1446.53 3205.54 0.000979439 0.0321411 0.00103282 1e+21 0.0900869 
+
+
+285500 0 1805.83 1739.15 1.04817e+10 3483.39 0.00114882 0.0230176 0.00279164 1e+21 0.324838 
+571000 0 1805.83 1739.15 1.04817e+10 3483.39 0.00114882 0.0230176 0.00279164 1e+21 0.324838 
+
+285500 1e+06 1805.83 1739.15 1.04817e+10 3483.39 0.00114882 0.0230176 0.00279164 1e+21 0.324838 
+571000 1e+06 1805.83 1739.15 1.04817e+10 3483.39 0.00114882 0.0230176 0.00279164 1e+21 0.324838 
+
+
+571000 0 1876.1 1846.06 2.23377e+10 3971.03 0.000380179 0.0180219 0.00135737 1e+21 -1.4119 
+856500 0 1876.1 1846.06 2.23377e+10 3971.03 0.000380179 0.0180219 0.00135737 1e+21 -1.4119 
+
+571000 1e+06 1876.1 1846.06 2.23377e+10 3971.03 0.000380179 0.0180219 0.00135737 1e+21 -1.4119 
+856500 1e+06 1876.1 1846.06 2.23377e+10 3971.03 0.000380179 0.0180219 0.00135737 1e+21 -1.4119 
+
+
+856500 0 1978.22 1962.58 3.62116e+10 4497.52 0.000608079 0.0146255 0.0043426 1e+21 0.949822 
+1.142e+06 0 1978.22 1962.58 3.62116e+10 4497.52 0.000608079 0.0146255 0.0043426 1e+21 0.949822 
+
+856500 1e+06 1978.22 1962.58 3.62116e+10 4497.52 0.000608079 0.0146255 0.0043426 1e+21 0.949822 
+1.142e+06 1e+06 1978.22 1962.58 3.62116e+10 4497.52 0.000608079 0.0146255 0.0043426 1e+21 0.949822 
+
+
+1.142e+06 0 2073.87 2069.55 5.07219e+10 4683.67 0.000567323 0.0140301 0.0030058 1e+21 -0.109737 
+1.4275e+06 0 2073.87 2069.55 5.07219e+10 4683.67 0.000567323 0.0140301 0.0030058 1e+21 -0.109737 
+
+1.142e+06 1e+06 2073.87 2069.55 5.07219e+10 4683.67 0.000567323 0.0140301 0.0030058 1e+21 -0.109737 
+1.4275e+06 1e+06 2073.87 2069.55 5.07219e+10 4683.67 0.000567323 0.0140301 0.0030058 1e+21 -0.109737 
+
+
+1.4275e+06 0 2170.65 2167.67 6.57916e+10 4858.47 0.000535611 0.0526327 0.000136901 1e+21 -20.8956 
+1.713e+06 0 2170.65 2167.67 6.57916e+10 4858.47 0.000535611 0.0526327 0.000136901 1e+21 -20.8956 
+
+1.4275e+06 1e+06 2170.65 2167.67 6.57916e+10 4858.47 0.000535611 0.0526327 0.000136901 1e+21 -20.8956 
+1.713e+06 1e+06 2170.65 2167.67 6.57916e+10 4858.47 0.000535611 0.0526327 0.000136901 1e+21 -20.8956 
+
+
+1.713e+06 0 2237.52 2259.07 8.14463e+10 5024.44 0.000511576 0.0442264 0.0115999 1e+21 -7.27552 
+1.9985e+06 0 2237.52 2259.07 8.14463e+10 5024.44 0.000511576 0.0442264 0.0115999 1e+21 -7.27552 
+
+1.713e+06 1e+06 2237.52 2259.07 8.14463e+10 5024.44 0.000511576 0.0442264 0.0115999 1e+21 -7.27552 
+1.9985e+06 1e+06 2237.52 2259.07 8.14463e+10 5024.44 0.000511576 0.0442264 0.0115999 1e+21 -7.27552 
+
+
+1.9985e+06 0 2221.95 2345.43 9.77589e+10 5183.92 0.000495006 0.151932 0.150908 1e+21 67.0644 
+2.284e+06 0 2221.95 2345.43 9.77589e+10 5183.92 0.000495006 0.151932 0.150908 1e+21 67.0644 
+
+1.9985e+06 1e+06 2221.95 2345.43 9.77589e+10 5183.92 0.000495006 0.151932 0.150908 1e+21 67.0644 
+2.284e+06 1e+06 2221.95 2345.43 9.77589e+10 5183.92 0.000495006 0.151932 0.150908 1e+21 67.0644 
+
+
+2.284e+06 0 2264.66 2428.26 1.14866e+11 5339.36 0.000486558 0.050455 0.00999607 1e+21 -12.8311 
+2.5695e+06 0 2264.66 2428.26 1.14866e+11 5339.36 0.000486558 0.050455 0.00999607 1e+21 -12.8311 
+
+2.284e+06 1e+06 2264.66 2428.26 1.14866e+11 5339.36 0.000486558 0.050455 0.00999607 1e+21 -12.8311 
+2.5695e+06 1e+06 2264.66 2428.26 1.14866e+11 5339.36 0.000486558 0.050455 0.00999607 1e+21 -12.8311 
+
+
+2.5695e+06 0 2930.15 2503.47 1.29971e+11 5517.7 0 0.0663822 0 1e+21 -37.4258 
+2.855e+06 0 2930.15 2503.47 1.29971e+11 5517.7 0 0.0663822 0 1e+21 -37.4258 
+
+2.5695e+06 1e+06 2930.15 2503.47 1.29971e+11 5517.7 0 0.0663822 0 1e+21 -37.4258 
+2.855e+06 1e+06 2930.15 2503.47 1.29971e+11 5517.7 0 0.0663822 0 1e+21 -37.4258 
+
+
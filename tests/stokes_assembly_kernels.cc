@@ -0,0 +1,244 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_access.h>
+#include <aspect/simulator/assemblers/interface.h>
+#include <aspect/simulator/assemblers/stokes.h>
+#include <aspect/material_model/interface.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/lac/full_matrix.h>
+
+
+namespace aspect
+{
+  namespace StokesAssemblyKernels
+  {
+    using namespace dealii;
+
+    /**
+     * A postprocessor that runs the generic StokesIncompressibleTerms,
+     * StokesCompressibleStrainRateViscosityTerm, StokesPreconditioner and
+     * StokesCompressiblePreconditioner assemblers and the specialized
+     * StokesSystemKernel and StokesPreconditionerKernel classes on the same
+     * scratch data of every locally owned cell, and aborts if the local
+     * matrices or right hand sides they compute differ by more than
+     * round-off.
+     */
+    template <int dim>
+    class CompareStokesKernels : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+
+      private:
+        /**
+         * Run the assemblers in @p generic_assemblers and the assembler
+         * @p kernel on @p scratch and return the relative difference between
+         * the local matrices and right hand sides they computed.
+         */
+        template <class CopyDataType>
+        double
+        compare (const std::vector<const Assemblers::Interface<dim> *> &generic_assemblers,
+                 const Assemblers::Interface<dim>                      &kernel,
+                 internal::Assembly::Scratch::StokesSystem<dim>         &scratch,
+                 CopyDataType                                           &generic_data,
+                 CopyDataType                                           &kernel_data) const;
+    };
+
+
+
+    namespace
+    {
+      /**
+       * Return the norm of the difference between @p a and @p b, relative
+       * to the norm of @p a, both measured in the l-infinity norm.
+       */
+      template <class VectorOrMatrix>
+      double
+      relative_difference (const VectorOrMatrix &a,
+                           const VectorOrMatrix &b)
+      {
+        VectorOrMatrix difference (a);
+        difference.add (-1.0, b);
+
+        const double norm = a.linfty_norm();
+        return (norm > 0 ? difference.linfty_norm() / norm : difference.linfty_norm());
+      }
+
+
+
+      template <int dim>
+      double
+      relative_difference (const internal::Assembly::CopyData::StokesPreconditioner<dim> &a,
+                           const internal::Assembly::CopyData::StokesPreconditioner<dim> &b)
+      {
+        return relative_difference (a.local_matrix, b.local_matrix);
+      }
+
+
+
+      template <int dim>
+      double
+      relative_difference (const internal::Assembly::CopyData::StokesSystem<dim> &a,
+                           const internal::Assembly::CopyData::StokesSystem<dim> &b)
+      {
+        return std::max (relative_difference (a.local_matrix, b.local_matrix),
+                         relative_difference (a.local_rhs, b.local_rhs));
+      }
+
+
+
+      template <int dim>
+      void
+      clear (internal::Assembly::CopyData::StokesPreconditioner<dim> &data)
+      {
+        data.local_matrix = 0;
+      }
+
+
+
+      template <int dim>
+      void
+      clear (internal::Assembly::CopyData::StokesSystem<dim> &data)
+      {
+        data.local_matrix = 0;
+        data.local_rhs = 0;
+      }
+    }
+
+
+
+    template <int dim>
+    template <class CopyDataType>
+    double
+    CompareStokesKernels<dim>::compare (const std::vector<const Assemblers::Interface<dim> *> &generic_assemblers,
+                                        const Assemblers::Interface<dim>                      &kernel,
+                                        internal::Assembly::Scratch::StokesSystem<dim>         &scratch,
+                                        CopyDataType                                           &generic_data,
+                                        CopyDataType                                           &kernel_data) const
+    {
+      clear (generic_data);
+      clear (kernel_data);
+
+      for (const auto assembler : generic_assemblers)
+        assembler->execute (scratch, generic_data);
+      kernel.execute (scratch, kernel_data);
+
+      return relative_difference<dim> (generic_data, kernel_data);
+    }
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CompareStokesKernels<dim>::execute (TableHandler &)
+    {
+      const Introspection<dim> &introspection = this->introspection();
+      const FiniteElement<dim> &fe = this->get_fe();
+
+      const QGauss<dim> quadrature (introspection.polynomial_degree.velocities+1);
+      const QGauss<dim-1> face_quadrature (introspection.polynomial_degree.velocities+1);
+
+      const unsigned int stokes_dofs_per_cell = dim * fe.base_element(introspection.base_elements.velocities).dofs_per_cell
+                                                + fe.base_element(introspection.base_elements.pressure).dofs_per_cell;
+
+      internal::Assembly::Scratch::StokesSystem<dim> scratch (fe, this->get_mapping(), quadrature, face_quadrature,
+                                                              update_values | update_gradients |
+                                                              update_quadrature_points | update_JxW_values,
+                                                              update_default,
+                                                              this->n_compositional_fields(),
+                                                              stokes_dofs_per_cell,
+                                                              false, false, true, false);
+
+      internal::Assembly::CopyData::StokesSystem<dim> generic_system (stokes_dofs_per_cell, false);
+      internal::Assembly::CopyData::StokesSystem<dim> kernel_system (stokes_dofs_per_cell, false);
+      internal::Assembly::CopyData::StokesPreconditioner<dim> generic_preconditioner (stokes_dofs_per_cell);
+      internal::Assembly::CopyData::StokesPreconditioner<dim> kernel_preconditioner (stokes_dofs_per_cell);
+
+      Assemblers::StokesIncompressibleTerms<dim> incompressible_terms;
+      Assemblers::StokesCompressibleStrainRateViscosityTerm<dim> compressible_terms;
+      Assemblers::StokesPreconditioner<dim> preconditioner;
+      Assemblers::StokesCompressiblePreconditioner<dim> compressible_preconditioner;
+      incompressible_terms.initialize_simulator (this->get_simulator());
+      compressible_terms.initialize_simulator (this->get_simulator());
+      preconditioner.initialize_simulator (this->get_simulator());
+      compressible_preconditioner.initialize_simulator (this->get_simulator());
+
+      Assemblers::StokesSystemKernel<dim,false> incompressible_system_kernel;
+      Assemblers::StokesSystemKernel<dim,true> compressible_system_kernel;
+      Assemblers::StokesPreconditionerKernel<dim,false> incompressible_preconditioner_kernel;
+      Assemblers::StokesPreconditionerKernel<dim,true> compressible_preconditioner_kernel;
+      incompressible_system_kernel.initialize_simulator (this->get_simulator());
+      incompressible_system_kernel.initialize ();
+      compressible_system_kernel.initialize_simulator (this->get_simulator());
+      compressible_system_kernel.initialize ();
+      incompressible_preconditioner_kernel.initialize_simulator (this->get_simulator());
+      incompressible_preconditioner_kernel.initialize ();
+      compressible_preconditioner_kernel.initialize_simulator (this->get_simulator());
+      compressible_preconditioner_kernel.initialize ();
+
+      incompressible_terms.create_additional_material_model_outputs (scratch.material_model_outputs);
+
+      double max_difference = 0;
+      for (const auto &cell : this->get_dof_handler().active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            cell->get_dof_indices (scratch.local_dof_indices);
+            generic_system.extract_stokes_dof_indices (scratch.local_dof_indices, introspection, fe);
+            kernel_system.extract_stokes_dof_indices (scratch.local_dof_indices, introspection, fe);
+            generic_preconditioner.extract_stokes_dof_indices (scratch.local_dof_indices, introspection, fe);
+            kernel_preconditioner.extract_stokes_dof_indices (scratch.local_dof_indices, introspection, fe);
+
+            scratch.reinit (cell);
+            scratch.material_model_inputs.reinit (scratch.finite_element_values,
+                                                  cell,
+                                                  introspection,
+                                                  this->get_solution());
+            this->get_material_model().evaluate (scratch.material_model_inputs,
+                                                 scratch.material_model_outputs);
+
+            max_difference = std::max (max_difference,
+                                       compare ({&incompressible_terms},
+                                                incompressible_system_kernel,
+                                                scratch, generic_system, kernel_system));
+            max_difference = std::max (max_difference,
+                                       compare ({&incompressible_terms, &compressible_terms},
+                                                compressible_system_kernel,
+                                                scratch, generic_system, kernel_system));
+            max_difference = std::max (max_difference,
+                                       compare ({&preconditioner},
+                                                incompressible_preconditioner_kernel,
+                                                scratch, generic_preconditioner, kernel_preconditioner));
+            max_difference = std::max (max_difference,
+                                       compare ({&preconditioner, &compressible_preconditioner},
+                                                compressible_preconditioner_kernel,
+                                                scratch, generic_preconditioner, kernel_preconditioner));
+          }
+
+      max_difference = Utilities::MPI::max (max_difference, this->get_mpi_communicator());
+
+      AssertThrow (max_difference < 1e-12,
+                   ExcMessage ("The specialized Stokes assembly kernels do not compute "
+                               "the same local matrices and right hand sides as the "
+                               "generic assemblers."));
+
+      return std::make_pair ("Kernels match the generic assemblers:", "yes");
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace StokesAssemblyKernels
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CompareStokesKernels,
+                                  "compare stokes kernels",
+                                  "A postprocessor that checks that the specialized Stokes "
+                                  "assembly kernels compute the same local matrices as the "
+                                  "generic assemblers.")
+  }
+}
@@ -0,0 +1,97 @@
+#include "../benchmarks/inclusion/inclusion.cc"
+
+
+namespace aspect
+{
+  namespace StokesCommunicationAvoidingKrylov
+  {
+    using namespace dealii;
+
+    /**
+     * A postprocessor that computes the L2 errors of velocity and pressure
+     * for the inclusion benchmark, and aborts if they differ from the ones
+     * of the inclusion_2 test, which solves the same problem with the
+     * default Krylov methods. The errors are dominated by the
+     * discretization, so both solvers have to give the same values up to
+     * the solver tolerance.
+     */
+    template <int dim>
+    class CheckInclusionErrors : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+    {
+      public:
+        virtual
+        std::pair<std::string,std::string>
+        execute (TableHandler &statistics);
+    };
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CheckInclusionErrors<dim>::execute (TableHandler &)
+    {
+      const InclusionBenchmark::InclusionMaterial<dim> *material_model
+        = dynamic_cast<const InclusionBenchmark::InclusionMaterial<dim> *>(&this->get_material_model());
+      AssertThrow (material_model != nullptr,
+                   ExcMessage ("This postprocessor only works with the inclusion material model."));
+
+      const InclusionBenchmark::AnalyticSolutions::FunctionInclusion<dim> ref_func (material_model->get_eta_B());
+      const QGauss<dim> quadrature_formula (this->introspection().polynomial_degree.velocities+2);
+
+      ComponentSelectFunction<dim> comp_u(std::pair<unsigned int, unsigned int>(0,dim),
+                                          this->get_fe().n_components());
+      ComponentSelectFunction<dim> comp_p(dim,
+                                          this->get_fe().n_components());
+
+      Vector<float> cellwise_errors_ul2 (this->get_triangulation().n_active_cells());
+      Vector<float> cellwise_errors_pl2 (this->get_triangulation().n_active_cells());
+      VectorTools::integrate_difference (this->get_mapping(),this->get_dof_handler(),
+                                         this->get_solution(),
+                                         ref_func,
+                                         cellwise_errors_ul2,
+                                         quadrature_formula,
+                                         VectorTools::L2_norm,
+                                         &comp_u);
+      VectorTools::integrate_difference (this->get_mapping(),this->get_dof_handler(),
+                                         this->get_solution(),
+                                         ref_func,
+                                         cellwise_errors_pl2,
+                                         quadrature_formula,
+                                         VectorTools::L2_norm,
+                                         &comp_p);
+
+      const double u_l2 = std::sqrt(Utilities::MPI::sum(cellwise_errors_ul2.norm_sqr(),this->get_mpi_communicator()));
+      const double p_l2 = std::sqrt(Utilities::MPI::sum(cellwise_errors_pl2.norm_sqr(),this->get_mpi_communicator()));
+
+      // the errors reported in tests/inclusion_2/screen-output
+      const double reference_u_l2 = 2.432440e-02;
+      const double reference_p_l2 = 3.912138e-01;
+
+      AssertThrow (std::abs(u_l2 - reference_u_l2) < 1e-5 * reference_u_l2
+                   &&
+                   std::abs(p_l2 - reference_p_l2) < 1e-5 * reference_p_l2,
+                   ExcMessage ("The errors of the solution computed with the communication "
+                               "avoiding Krylov methods differ from the ones computed with "
+                               "the default Krylov methods."));
+
+      std::ostringstream os;
+      os << std::scientific << u_l2 << ", " << p_l2;
+      return std::make_pair ("Errors u_L2, p_L2:", os.str());
+    }
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  namespace StokesCommunicationAvoidingKrylov
+  {
+    ASPECT_REGISTER_POSTPROCESSOR(CheckInclusionErrors,
+                                  "check inclusion errors",
+                                  "A postprocessor that checks that the errors of the "
+                                  "inclusion benchmark are the same as with the default "
+                                  "Stokes solver.")
+  }
+}
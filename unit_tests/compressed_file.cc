@@ -0,0 +1,126 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+#include "common.h"
+#include <aspect/utilities.h>
+
+#ifdef DEAL_II_WITH_ZLIB
+#include <zlib.h>
+
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+  // Some data that compresses, but not trivially.
+  std::string create_data (const std::size_t size)
+  {
+    std::string data (size, '\0');
+    for (std::size_t i=0; i<size; ++i)
+      data[i] = static_cast<char>((i * i + 7 * i) % 251);
+    return data;
+  }
+}
+
+
+
+TEST_CASE("Utilities::write_compressed_file several blocks")
+{
+  const std::string filename = "compressed_file_several_blocks.z";
+
+  // a partial last block
+  const std::string data = create_data (5 * 1000 + 123);
+  aspect::Utilities::write_compressed_file (data, filename, 1000);
+
+  // the header starts with the number of blocks and the sizes of the
+  // full and the last block
+  {
+    std::ifstream ifs (filename.c_str(), std::ios::binary);
+    uint32_t header[3];
+    ifs.read ((char *)header, 3 * sizeof(header[0]));
+    REQUIRE(header[0] == 6);
+    REQUIRE(header[1] == 1000);
+    REQUIRE(header[2] == 123);
+  }
+
+  REQUIRE(aspect::Utilities::read_compressed_file (filename) == data);
+
+  // only full blocks
+  const std::string full_blocks_data = create_data (3 * 1000);
+  aspect::Utilities::write_compressed_file (full_blocks_data, filename, 1000);
+  REQUIRE(aspect::Utilities::read_compressed_file (filename) == full_blocks_data);
+
+  // a single partial block
+  const std::string short_data = create_data (10);
+  aspect::Utilities::write_compressed_file (short_data, filename, 1000);
+  REQUIRE(aspect::Utilities::read_compressed_file (filename) == short_data);
+
+  std::remove (filename.c_str());
+}
+
+
+
+TEST_CASE("Utilities::read_compressed_file legacy format")
+{
+  const std::string filename = "compressed_file_legacy.z";
+  const std::string data = create_data (12345);
+
+  // write the data as a single block, the way previous versions of
+  // ASPECT wrote their checkpoint files
+  {
+    uLongf compressed_data_length = compressBound (data.length());
+    std::vector<char> compressed_data (compressed_data_length);
+    const int err = compress2 ((Bytef *) &compressed_data[0],
+                               &compressed_data_length,
+                               (const Bytef *) data.data(),
+                               data.length(),
+                               Z_BEST_COMPRESSION);
+    REQUIRE(err == Z_OK);
+
+    const uint32_t compression_header[4]
+      = { 1,                            /* number of blocks */
+          (uint32_t)data.length(),      /* size of block */
+          (uint32_t)data.length(),      /* size of last block */
+          (uint32_t)compressed_data_length
+        }; /* list of compressed sizes of blocks */
+
+    std::ofstream f (filename.c_str(), std::ios::binary);
+    f.write((const char *)compression_header, 4 * sizeof(compression_header[0]));
+    f.write(&compressed_data[0], compressed_data_length);
+  }
+
+  REQUIRE(aspect::Utilities::read_compressed_file (filename) == data);
+
+  // the default block size is larger than the data, so the file is
+  // written in the legacy format
+  aspect::Utilities::write_compressed_file (data, filename);
+  {
+    std::ifstream ifs (filename.c_str(), std::ios::binary);
+    uint32_t header[3];
+    ifs.read ((char *)header, 3 * sizeof(header[0]));
+    REQUIRE(header[0] == 1);
+    REQUIRE(header[1] == data.length());
+    REQUIRE(header[2] == data.length());
+  }
+  REQUIRE(aspect::Utilities::read_compressed_file (filename) == data);
+
+  std::remove (filename.c_str());
+}
+#endif
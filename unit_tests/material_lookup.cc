@@ -0,0 +1,132 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+#include "common.h"
+#include <aspect/material_model/grain_size.h>
+
+namespace
+{
+  // The table used here has 21 temperature points between 850 K and 1250 K
+  // and 51 pressure points between 0 and 40 GPa, with a phase transition
+  // around 17 GPa that is about two table points wide. It is the table used
+  // by the latent heat tests of the grain size model.
+  const std::string table_name = ASPECT_SOURCE_DIR "/data/material-model/latent-heat-enthalpy-test/testdata.txt";
+  const double delta_pressure = 8e8;
+
+  // Fill the temperatures and pressures at the support points of a
+  // cell with n_points_per_direction points per direction, in which the
+  // temperature varies in x-direction, and the pressure in y- and
+  // z-direction.
+  void
+  fill_cell_points (const double min_temperature,
+                    const double min_pressure,
+                    const unsigned int n_points_per_direction,
+                    std::vector<double> &temperatures,
+                    std::vector<double> &pressures)
+  {
+    temperatures.clear();
+    pressures.clear();
+
+    const double step = 1.0 / (n_points_per_direction-1);
+    for (unsigned int k=0; k<n_points_per_direction; ++k)
+      for (unsigned int j=0; j<n_points_per_direction; ++j)
+        for (unsigned int i=0; i<n_points_per_direction; ++i)
+          {
+            temperatures.push_back (min_temperature + 40.0 * i * step);
+            pressures.push_back (min_pressure
+                                 + 2.0 * delta_pressure * j * step
+                                 + 0.5 * delta_pressure * k * step);
+          }
+  }
+}
+
+
+TEST_CASE("MaterialLookup smoothed enthalpy derivatives")
+{
+  aspect::MaterialModel::Lookup::PerplexReader lookup (table_name, true, MPI_COMM_WORLD);
+
+  REQUIRE(lookup.has_smoothed_enthalpy_derivatives() == false);
+  lookup.compute_smoothed_enthalpy_derivatives (1);
+  REQUIRE(lookup.has_smoothed_enthalpy_derivatives() == true);
+
+  std::vector<double> temperatures, pressures;
+
+  // away from the phase transition the enthalpy is linear in temperature
+  // and pressure, and both estimates have to agree with the specific heat
+  // of the table
+  fill_cell_points (900, 2e9, 2, temperatures, pressures);
+  {
+    const std::array<std::pair<double, unsigned int>,2> pairwise
+      = lookup.enthalpy_derivatives (temperatures, pressures, 1);
+    const std::array<std::pair<double, unsigned int>,2> smoothed
+      = lookup.smoothed_enthalpy_derivatives (temperatures, pressures);
+
+    REQUIRE(smoothed[0].second == temperatures.size());
+    REQUIRE(smoothed[1].second == temperatures.size());
+    REQUIRE(pairwise[0].first == Approx(1000.0));
+    REQUIRE(smoothed[0].first == Approx(1000.0));
+    REQUIRE(smoothed[1].first == Approx(pairwise[1].first));
+  }
+
+  // in all cells that lie within the table, including the ones in the
+  // phase transition, the smoothed derivatives have to be close to the
+  // pairwise finite difference estimate
+  for (double min_temperature = 860; min_temperature <= 1180; min_temperature += 40)
+    for (double min_pressure = 1e9; min_pressure <= 3.6e10; min_pressure += 1e9)
+      {
+        INFO("T=" << min_temperature << " p=" << min_pressure);
+        fill_cell_points (min_temperature, min_pressure, 2, temperatures, pressures);
+
+        const std::array<std::pair<double, unsigned int>,2> pairwise
+          = lookup.enthalpy_derivatives (temperatures, pressures, 1);
+        const std::array<std::pair<double, unsigned int>,2> smoothed
+          = lookup.smoothed_enthalpy_derivatives (temperatures, pressures);
+
+        REQUIRE(smoothed[0].first == Approx(pairwise[0].first).epsilon(0.05));
+        REQUIRE(smoothed[1].first == Approx(pairwise[1].first).epsilon(0.05));
+      }
+}
+
+
+TEST_CASE("MaterialLookup enthalpy derivatives benchmark", "[.benchmark]")
+{
+  aspect::MaterialModel::Lookup::PerplexReader lookup (table_name, true, MPI_COMM_WORLD);
+  lookup.compute_smoothed_enthalpy_derivatives (1);
+
+  // the 27 support points of a three-dimensional quadratic cell
+  // inside the phase transition
+  std::vector<double> temperatures, pressures;
+  fill_cell_points (1000, 1.6e10, 3, temperatures, pressures);
+
+  double sum = 0;
+  BENCHMARK("pairwise finite differences, 1 substep")
+  {
+    sum += lookup.enthalpy_derivatives (temperatures, pressures, 1)[0].first;
+  }
+  BENCHMARK("pairwise finite differences, 10 substeps")
+  {
+    sum += lookup.enthalpy_derivatives (temperatures, pressures, 10)[0].first;
+  }
+  BENCHMARK("smoothed derivative tables")
+  {
+    sum += lookup.smoothed_enthalpy_derivatives (temperatures, pressures)[0].first;
+  }
+  REQUIRE(sum > 0);
+}
@@ -0,0 +1,135 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+#include "common.h"
+#include <aspect/material_model/simple.h>
+
+namespace
+{
+  using namespace aspect;
+
+  // A material model that does not implement evaluate_batch(), and that
+  // records how many points it was called with.
+  template <int dim>
+  class CountingModel : public MaterialModel::Simple<dim>
+  {
+    public:
+      virtual void evaluate(const MaterialModel::MaterialModelInputs<dim> &in,
+                            MaterialModel::MaterialModelOutputs<dim> &out) const
+      {
+        n_points_per_call.push_back (in.position.size());
+        MaterialModel::Simple<dim>::evaluate (in, out);
+      }
+
+      virtual void evaluate_batch(const MaterialModel::MaterialModelBatchInputs<dim> &in,
+                                  MaterialModel::MaterialModelOutputs<dim> &out) const
+      {
+        MaterialModel::Interface<dim>::evaluate_batch (in, out);
+      }
+
+      mutable std::vector<unsigned int> n_points_per_call;
+  };
+
+
+
+  // Fill a batch with three cells with 4, 4, and 2 points, with
+  // temperatures and compositions that vary from point to point.
+  template <int dim>
+  void
+  fill_batch (MaterialModel::MaterialModelBatchInputs<dim> &batch)
+  {
+    const unsigned int n_points_per_cell[3] = {4, 4, 2};
+    unsigned int n_points = 0;
+    for (unsigned int cell=0; cell<3; ++cell)
+      {
+        for (unsigned int q=0; q<n_points_per_cell[cell]; ++q, ++n_points)
+          {
+            batch.position.push_back (Point<dim>());
+            batch.temperature.push_back (300.0 + 100.0 * n_points);
+            batch.pressure.push_back (1e5 * n_points);
+            batch.pressure_gradient.push_back (Tensor<1,dim>());
+            batch.velocity.push_back (Tensor<1,dim>());
+            batch.strain_rate.push_back (SymmetricTensor<2,dim>());
+            for (unsigned int c=0; c<batch.composition.size(); ++c)
+              batch.composition[c].push_back (0.1 * n_points - 0.2 * c);
+          }
+        batch.cells.push_back (typename DoFHandler<dim>::active_cell_iterator());
+        batch.cell_offsets.push_back (n_points);
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  setup_model (MaterialModel::Simple<dim> &model)
+  {
+    ParameterHandler prm;
+    MaterialModel::Simple<dim>::declare_parameters (prm);
+    prm.enter_subsection ("Material model");
+    prm.enter_subsection ("Simple model");
+    prm.set ("Thermal viscosity exponent", "5");
+    prm.set ("Composition viscosity prefactor", "10");
+    prm.set ("Density differential for compositional field 1", "100");
+    prm.leave_subsection ();
+    prm.leave_subsection ();
+    model.parse_parameters (prm);
+  }
+}
+
+
+TEST_CASE("MaterialModel evaluate_batch")
+{
+  const int dim = 2;
+  const unsigned int n_comp = 2;
+
+  MaterialModel::MaterialModelBatchInputs<dim> batch (n_comp);
+  fill_batch (batch);
+  REQUIRE(batch.n_cells() == 3);
+  REQUIRE(batch.n_points() == 10);
+
+  CountingModel<dim> model;
+  setup_model (model);
+
+  // the native implementation of the simple model and the default
+  // implementation that evaluates cell by cell have to agree
+  MaterialModel::MaterialModelOutputs<dim> native_out (batch.n_points(), n_comp);
+  model.MaterialModel::Simple<dim>::evaluate_batch (batch, native_out);
+  REQUIRE(model.n_points_per_call.empty());
+
+  MaterialModel::MaterialModelOutputs<dim> default_out (batch.n_points(), n_comp);
+  model.evaluate_batch (batch, default_out);
+  REQUIRE(model.n_points_per_call == std::vector<unsigned int> {4, 4, 2});
+
+  for (unsigned int i=0; i<batch.n_points(); ++i)
+    {
+      INFO("i=" << i);
+      REQUIRE(native_out.viscosities[i] == default_out.viscosities[i]);
+      REQUIRE(native_out.densities[i] == default_out.densities[i]);
+      REQUIRE(native_out.thermal_expansion_coefficients[i] == default_out.thermal_expansion_coefficients[i]);
+      REQUIRE(native_out.reaction_terms[i] == default_out.reaction_terms[i]);
+    }
+
+  // a cleared batch keeps the number of compositional fields
+  batch.clear ();
+  REQUIRE(batch.n_cells() == 0);
+  REQUIRE(batch.n_points() == 0);
+  REQUIRE(batch.composition.size() == n_comp);
+}
@@ -0,0 +1,70 @@
+/*
+  Copyright (C) 2019 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+#include "common.h"
+#include <aspect/simulator/single_precision_ilu.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+TEST_CASE("SinglePrecisionILU")
+{
+  using namespace aspect;
+
+  // the ILU without fill-in of a tridiagonal matrix is its exact LU
+  // decomposition, so the preconditioner has to invert the matrix up to
+  // the accuracy of single precision
+  const unsigned int n = 50;
+  const IndexSet locally_owned = complete_index_set (n);
+
+  DynamicSparsityPattern dsp (n, n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=(i>0 ? i-1 : 0); j<std::min(i+2,n); ++j)
+      dsp.add (i, j);
+
+  LinearAlgebra::SparseMatrix matrix;
+  matrix.reinit (locally_owned, locally_owned, dsp, MPI_COMM_SELF);
+  for (unsigned int i=0; i<n; ++i)
+    {
+      matrix.set (i, i, 2.0 + 0.1 * i);
+      if (i > 0)
+        matrix.set (i, i-1, -1.0);
+      if (i+1 < n)
+        matrix.set (i, i+1, -1.0);
+    }
+  matrix.compress (VectorOperation::insert);
+
+  LinearAlgebra::Vector src (locally_owned, MPI_COMM_SELF);
+  LinearAlgebra::Vector dst (locally_owned, MPI_COMM_SELF);
+  LinearAlgebra::Vector product (locally_owned, MPI_COMM_SELF);
+  for (unsigned int i=0; i<n; ++i)
+    src(i) = std::sin (1.0 * i);
+  src.compress (VectorOperation::insert);
+
+  SinglePrecisionILU preconditioner;
+  preconditioner.initialize (matrix);
+  preconditioner.vmult (dst, src);
+  matrix.vmult (product, dst);
+
+  for (unsigned int i=0; i<n; ++i)
+    {
+      INFO("i=" << i);
+      REQUIRE(product(i) == Approx(src(i)).margin(1e-5));
+    }
+}
@@ -35,3 +35,29 @@ TEST_CASE("Utilities::weighted_p_norm_average")
     }
 
 }
+
+TEST_CASE("Utilities::UniformDepthProfile")
+{
+  // the profile 1 + z^2 at the depths 0, 1, 2, 3, 4
+  aspect::Utilities::UniformDepthProfile profile;
+  profile.reinit (4.0, {1., 2., 5., 10., 17.});
+
+  REQUIRE(profile.get_depth_spacing() == Approx(1.0));
+
+  // values at the points, in between, and clamped outside of the profile
+  REQUIRE(profile.value(0.0) == Approx(1.0));
+  REQUIRE(profile.value(2.0) == Approx(5.0));
+  REQUIRE(profile.value(4.0) == Approx(17.0));
+  REQUIRE(profile.value(1.5) == Approx(3.5));
+  REQUIRE(profile.value(3.75) == Approx(15.25));
+  REQUIRE(profile.value(-1.0) == Approx(1.0));
+  REQUIRE(profile.value(5.0) == Approx(17.0));
+
+  // derivatives within the intervals, and the one of the interval
+  // above a point at the point itself
+  REQUIRE(profile.derivative(0.5) == Approx(1.0));
+  REQUIRE(profile.derivative(2.5) == Approx(5.0));
+  REQUIRE(profile.derivative(2.0) == Approx(3.0));
+  REQUIRE(profile.derivative(4.0) == Approx(7.0));
+  REQUIRE(profile.derivative(-1.0) == Approx(1.0));
+}